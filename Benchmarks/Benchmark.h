@@ -0,0 +1,97 @@
+/**
+ * @file Benchmark.h
+ * @author JoyatY
+ * @brief 无依赖的微基准测试框架
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        /**
+         * @brief 基准测试运行上下文
+         *
+         */
+        struct BenchmarkContext
+        {
+            /**
+             * @brief 本次运行需要执行的迭代次数
+             *
+             */
+            int64_t iterations = 1;
+
+            /**
+             * @brief 本次运行处理的元素数量(可选，用于输出吞吐量)
+             *
+             */
+            int64_t itemsProcessed = 0;
+        };
+
+        using BenchmarkFunc = void (*)(BenchmarkContext&);
+
+        /**
+         * @brief 注册的基准测试用例
+         *
+         */
+        struct BenchmarkEntry
+        {
+            const char*   name;
+            BenchmarkFunc func;
+        };
+
+        /**
+         * @brief 全局基准测试注册表
+         *
+         * @return std::vector<BenchmarkEntry>&
+         */
+        inline std::vector<BenchmarkEntry>& GetRegistry()
+        {
+            static std::vector<BenchmarkEntry> registry;
+            return registry;
+        }
+
+        /**
+         * @brief 静态注册辅助
+         *
+         */
+        struct BenchmarkRegistrar
+        {
+            BenchmarkRegistrar(const char* name, BenchmarkFunc func) { GetRegistry().push_back(BenchmarkEntry{name, func}); }
+        };
+
+        /**
+         * @brief 阻止编译器优化掉计算结果
+         *
+         * @tparam T
+         * @param value
+         */
+        template<typename T> inline void DoNotOptimize(const T& value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r,m"(value) : "memory");
+#else
+            const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+            (void)*sink;
+#endif
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+/**
+ * @brief 定义并注册一个基准测试，函数体内通过context访问迭代次数
+ *
+ */
+#define JOY_BENCHMARK(NAME)                                                                                                                  \
+    static void                                  NAME(::Joy::Benchmark::BenchmarkContext& context);                                          \
+    static ::Joy::Benchmark::BenchmarkRegistrar s_##NAME##Registrar(#NAME, NAME);                                                           \
+    static void                                  NAME(::Joy::Benchmark::BenchmarkContext& context)
@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+#include "Core/CommandBuffer.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int COMMAND_RESOLUTION   = 512;
+        constexpr int COMMAND_OBJECT_COUNT = 4096;
+        constexpr int COMMAND_STATE_COUNT  = 4;
+
+        struct CommandShader
+        {
+            constexpr static int VARYING_COUNT = 0;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float*) const
+            {
+                return mvp * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float*) const { return color; }
+
+            Vec4f   color;
+            Mat4x4f mvp = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 交错使用若干网格与着色器的物体场景
+         *
+         */
+        struct CommandScene
+        {
+            CommandScene()
+                : camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 200.f, 60.f)
+            {
+                for (int state = 0; state < COMMAND_STATE_COUNT; ++state)
+                {
+                    // 不同细分的立方体
+                    const float halfSize = 0.2f + 0.05f * static_cast<float>(state);
+                    Mesh        mesh;
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        const Vec3f position{(i & 1) ? halfSize : -halfSize, (i & 2) ? halfSize : -halfSize, (i & 4) ? halfSize : -halfSize};
+                        mesh.vertices.push_back(Vertex{position, Vec3f{}, Vec2f{}});
+                    }
+                    mesh.indices = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+                    meshes.push_back(mesh);
+                    shaders.push_back(CommandShader{Vec4f{0.25f * static_cast<float>(state), 0.5f, 1.f, 1.f}});
+                }
+                std::mt19937                          random(20251224u);
+                std::uniform_real_distribution<float> unit(-1.f, 1.f);
+                for (int i = 0; i < COMMAND_OBJECT_COUNT; ++i)
+                {
+                    Mat4x4f model = MAT4X4F_IDENTITY;
+                    model[3]      = Vec4f{unit(random) * 40.f, unit(random) * 30.f, -60.f + unit(random) * 50.f, 1.f};
+                    models.push_back(model);
+                }
+            }
+
+            Camera                     camera;
+            std::vector<Mesh>          meshes;
+            std::vector<CommandShader> shaders;
+            std::vector<Mat4x4f>       models;
+        };
+
+        static const CommandScene& GetCommandScene()
+        {
+            static const CommandScene scene;
+            return scene;
+        }
+
+        static int GetRecordThreadCount()
+        {
+            return static_cast<int>(std::max(1u, std::min(8u, std::thread::hardware_concurrency())));
+        }
+
+        /**
+         * @brief 以多个线程并行录制整个场景，每个线程录制连续的一段物体
+         *
+         */
+        static void RecordScene(const CommandScene& scene, std::vector<CommandBuffer>& buffers)
+        {
+            const int                threadCount = static_cast<int>(buffers.size());
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&scene, &buffers, t, threadCount] {
+                    CommandBuffer& buffer = buffers[t];
+                    buffer.Reset();
+                    buffer.SetCamera(scene.camera);
+                    const int begin = COMMAND_OBJECT_COUNT * t / threadCount;
+                    const int end   = COMMAND_OBJECT_COUNT * (t + 1) / threadCount;
+                    for (int i = begin; i < end; ++i)
+                    {
+                        buffer.BindMesh(scene.meshes[i % COMMAND_STATE_COUNT]);
+                        buffer.BindShader(scene.shaders[(i / COMMAND_STATE_COUNT) % COMMAND_STATE_COUNT]);
+                        buffer.Draw(scene.models[i]);
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        static void RunRecorded(BenchmarkContext& context, bool cached)
+        {
+            const CommandScene&        scene = GetCommandScene();
+            std::vector<CommandBuffer> buffers(GetRecordThreadCount());
+            CommandQueue               queue;
+            Renderer                   renderer(COMMAND_RESOLUTION, COMMAND_RESOLUTION);
+            RecordScene(scene, buffers);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                if (!cached)
+                {
+                    RecordScene(scene, buffers);
+                }
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                for (const CommandBuffer& buffer : buffers)
+                {
+                    queue.Submit(buffer);
+                }
+                queue.Execute(renderer);
+                DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+            }
+            context.itemsProcessed = context.iterations * COMMAND_OBJECT_COUNT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Command_Immediate)
+{
+    using namespace Joy;
+    using namespace Joy::Benchmark;
+    const CommandScene& scene    = GetCommandScene();
+    const Mat4x4f       viewProj = scene.camera.GetViewProjMatrix();
+    Renderer            renderer(COMMAND_RESOLUTION, COMMAND_RESOLUTION);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+        for (int i = 0; i < COMMAND_OBJECT_COUNT; ++i)
+        {
+            CommandShader shader = scene.shaders[(i / COMMAND_STATE_COUNT) % COMMAND_STATE_COUNT];
+            shader.mvp           = viewProj * scene.models[i];
+            renderer.Draw(scene.meshes[i % COMMAND_STATE_COUNT], shader);
+        }
+        DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations * COMMAND_OBJECT_COUNT;
+}
+
+JOY_BENCHMARK(Command_RecordAndReplay)
+{
+    Joy::Benchmark::RunRecorded(context, false);
+}
+
+JOY_BENCHMARK(Command_CachedReplay)
+{
+    Joy::Benchmark::RunRecorded(context, true);
+}
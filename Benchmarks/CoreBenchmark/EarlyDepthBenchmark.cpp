@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+#include "Core/Renderer.h"
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int EARLY_DEPTH_RESOLUTION = 256;
+        constexpr int EARLY_DEPTH_LAYERS     = 8;
+
+        /**
+         * @brief 由近到远叠放的全屏四边形，只有最近的一层可见
+         *
+         */
+        static const Mesh& GetLayeredMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                for (int layer = 0; layer < EARLY_DEPTH_LAYERS; ++layer)
+                {
+                    const float    depth = 0.1f + 0.1f * static_cast<float>(layer);
+                    const uint32_t base  = static_cast<uint32_t>(ret.vertices.size());
+                    const Vec3f    color{static_cast<float>(layer) / EARLY_DEPTH_LAYERS, 0.5f, 1.f};
+                    ret.vertices.push_back(Vertex{Vec3f{-1.f, -1.f, depth}, color, Vec2f{0.f, 0.f}});
+                    ret.vertices.push_back(Vertex{Vec3f{1.f, -1.f, depth}, color, Vec2f{1.f, 0.f}});
+                    ret.vertices.push_back(Vertex{Vec3f{1.f, 1.f, depth}, color, Vec2f{1.f, 1.f}});
+                    ret.vertices.push_back(Vertex{Vec3f{-1.f, 1.f, depth}, color, Vec2f{0.f, 1.f}});
+                    ret.indices.insert(ret.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        /**
+         * @brief 片元开销较大的着色器: 对纹理坐标做若干次迭代
+         *
+         */
+        struct ExpensiveShader
+        {
+            constexpr static int VARYING_COUNT = 5;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                varyings[3] = vertex.uv[0];
+                varyings[4] = vertex.uv[1];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const
+            {
+                float value = 0.f;
+                for (int i = 1; i <= 16; ++i)
+                {
+                    value += std::sin(varyings[3] * static_cast<float>(i)) * std::cos(varyings[4] * static_cast<float>(i));
+                }
+                return Vec4f{varyings[0], varyings[1] * value, varyings[2], 1.f};
+            }
+        };
+
+        /**
+         * @brief 同一着色器声明为改写深度(输出插值深度本身)，强制走late-Z
+         *
+         */
+        struct LateDepthExpensiveShader : ExpensiveShader
+        {
+            constexpr static bool WRITES_DEPTH = true;
+
+            bool Fragment(const float* varyings, Vec4f& color, float&) const
+            {
+                color = ExpensiveShader::Fragment(varyings);
+                return true;
+            }
+        };
+
+        template<typename TShader> static void RunLayered(BenchmarkContext& context)
+        {
+            const Mesh& mesh = GetLayeredMesh();
+            Renderer    renderer(EARLY_DEPTH_RESOLUTION, EARLY_DEPTH_RESOLUTION);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer.Draw(mesh, TShader{});
+                DoNotOptimize(renderer.GetFrameBuffer().GetColorData());
+            }
+            context.itemsProcessed = context.iterations * EARLY_DEPTH_RESOLUTION * EARLY_DEPTH_RESOLUTION * EARLY_DEPTH_LAYERS;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(DepthTest_LateZ)
+{
+    Joy::Benchmark::RunLayered<Joy::Benchmark::LateDepthExpensiveShader>(context);
+}
+
+JOY_BENCHMARK(DepthTest_EarlyZ)
+{
+    Joy::Benchmark::RunLayered<Joy::Benchmark::ExpensiveShader>(context);
+}
@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+#include "Core/Camera.h"
+#include "Core/DirtyTileTracker.h"
+#include "Core/Renderer.h"
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int INCREMENTAL_RESOLUTION = 512;
+        constexpr int INCREMENTAL_GRID_SIZE  = 8;
+        constexpr int OBJECT_TESSELLATION    = 16;
+
+        /**
+         * @brief 细分的单位正方形，模拟每个物体的顶点开销
+         *
+         */
+        static const Mesh& GetIncrementalObjectMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                for (int y = 0; y <= OBJECT_TESSELLATION; ++y)
+                {
+                    for (int x = 0; x <= OBJECT_TESSELLATION; ++x)
+                    {
+                        const float fx = static_cast<float>(x) / OBJECT_TESSELLATION - 0.5f;
+                        const float fy = static_cast<float>(y) / OBJECT_TESSELLATION - 0.5f;
+                        ret.vertices.push_back(Vertex{Vec3f{fx, fy, 0.f}, Vec3f{fx + 0.5f, fy + 0.5f, 1.f}, Vec2f{}});
+                    }
+                }
+                for (uint32_t y = 0; y < OBJECT_TESSELLATION; ++y)
+                {
+                    for (uint32_t x = 0; x < OBJECT_TESSELLATION; ++x)
+                    {
+                        const uint32_t i0 = y * (OBJECT_TESSELLATION + 1) + x;
+                        const uint32_t i1 = i0 + OBJECT_TESSELLATION + 1;
+                        ret.indices.insert(ret.indices.end(), {i0, i0 + 1, i1 + 1, i0, i1 + 1, i1});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        struct IncrementalShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return modelViewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f modelViewProj = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 网格排布的物体，第0个物体每帧移动
+         *
+         */
+        static std::vector<Mat4x4f> GetIncrementalTransforms(int64_t frame)
+        {
+            std::vector<Mat4x4f> ret(INCREMENTAL_GRID_SIZE * INCREMENTAL_GRID_SIZE, MAT4X4F_IDENTITY);
+            for (int i = 0; i < static_cast<int>(ret.size()); ++i)
+            {
+                const float x = static_cast<float>(i % INCREMENTAL_GRID_SIZE) - INCREMENTAL_GRID_SIZE * 0.5f + 0.5f;
+                const float y = static_cast<float>(i / INCREMENTAL_GRID_SIZE) - INCREMENTAL_GRID_SIZE * 0.5f + 0.5f;
+                ret[i][3]     = Vec4f{x, y, 0.f, 1.f};
+            }
+            ret[0][3][0] += static_cast<float>(frame % 8) * 0.0625f;
+            return ret;
+        }
+
+        static Camera GetIncrementalCamera()
+        {
+            return Camera(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 0.f, 5.f}, Vec3f{0.f, 0.f, 0.f}, 0.1f, 10.f, INCREMENTAL_GRID_SIZE * 0.5f);
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Incremental_FullFrame)
+{
+    using namespace Joy;
+    const Mesh&   mesh     = Benchmark::GetIncrementalObjectMesh();
+    const Mat4x4f viewProj = Benchmark::GetIncrementalCamera().GetViewProjMatrix();
+    Renderer      renderer(Benchmark::INCREMENTAL_RESOLUTION, Benchmark::INCREMENTAL_RESOLUTION);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+        for (const Mat4x4f& model : Benchmark::GetIncrementalTransforms(iteration))
+        {
+            renderer.Draw(mesh, Benchmark::IncrementalShader{viewProj * model});
+        }
+        Benchmark::DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations;
+}
+
+JOY_BENCHMARK(Incremental_DirtyTiles)
+{
+    using namespace Joy;
+    const Mesh&      mesh     = Benchmark::GetIncrementalObjectMesh();
+    const Camera     camera   = Benchmark::GetIncrementalCamera();
+    const Mat4x4f    viewProj = camera.GetViewProjMatrix();
+    Renderer         renderer(Benchmark::INCREMENTAL_RESOLUTION, Benchmark::INCREMENTAL_RESOLUTION);
+    DirtyTileTracker tracker(Benchmark::INCREMENTAL_RESOLUTION, Benchmark::INCREMENTAL_RESOLUTION);
+    renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+    std::vector<RasterRect> bounds;
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        const std::vector<Mat4x4f> transforms = Benchmark::GetIncrementalTransforms(iteration);
+        bounds.resize(transforms.size());
+        tracker.BeginFrame(camera.GetVersion());
+        for (size_t i = 0; i < transforms.size(); ++i)
+        {
+            bounds[i] = DirtyTileTracker::ComputeScreenBounds(Vec3f{-0.5f, -0.5f, 0.f}, Vec3f{0.5f, 0.5f, 0.f}, viewProj * transforms[i], renderer.GetWidth(),
+                                                              renderer.GetHeight());
+            tracker.SubmitObject(static_cast<uint32_t>(i), transforms[i], 0, bounds[i]);
+        }
+        tracker.EndFrame();
+        renderer.RenderDirtyRegions(tracker, [&](const RasterRect&) {
+            for (size_t i = 0; i < transforms.size(); ++i)
+            {
+                if (tracker.Intersects(bounds[i]))
+                {
+                    renderer.Draw(mesh, Benchmark::IncrementalShader{viewProj * transforms[i]});
+                }
+            }
+        });
+        Benchmark::DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations;
+}
@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+#include "Core/Camera.h"
+#include "Core/Instancing.h"
+#include "Core/Renderer.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int INSTANCING_RESOLUTION = 512;
+        constexpr int INSTANCE_COUNT        = 8192;
+
+        /**
+         * @brief 草叶: 两个三角形组成的细长四边形
+         *
+         */
+        static const Mesh& GetBladeMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                ret.vertices.push_back(Vertex{Vec3f{-0.05f, 0.f, 0.f}, Vec3f{0.1f, 0.4f, 0.1f}, Vec2f{}});
+                ret.vertices.push_back(Vertex{Vec3f{0.05f, 0.f, 0.f}, Vec3f{0.1f, 0.4f, 0.1f}, Vec2f{}});
+                ret.vertices.push_back(Vertex{Vec3f{0.03f, 0.6f, 0.f}, Vec3f{0.3f, 0.8f, 0.2f}, Vec2f{}});
+                ret.vertices.push_back(Vertex{Vec3f{-0.02f, 0.6f, 0.f}, Vec3f{0.3f, 0.8f, 0.2f}, Vec2f{}});
+                ret.indices = {0, 1, 2, 0, 2, 3};
+                return ret;
+            }();
+            return mesh;
+        }
+
+        /**
+         * @brief 散布在相机四周地面上的草叶，约三分之二位于视野之外
+         *
+         */
+        static const std::vector<Mat4x4f>& GetBladeModels()
+        {
+            static const std::vector<Mat4x4f> models = [] {
+                std::mt19937                          random(20251223u);
+                std::uniform_real_distribution<float> unit(-1.f, 1.f);
+                std::vector<InstanceTransform>        instances(INSTANCE_COUNT);
+                for (InstanceTransform& instance : instances)
+                {
+                    const float angle    = unit(random) * 3.1415926f;
+                    instance.translation = Vec3f{unit(random) * 30.f, -1.f, unit(random) * 30.f};
+                    instance.rotation    = Quat{0.f, std::sin(angle * 0.5f), 0.f, std::cos(angle * 0.5f)};
+                    instance.scale       = Vec3f{1.f, 0.7f + 0.3f * unit(random), 1.f};
+                }
+                std::vector<Mat4x4f> ret(INSTANCE_COUNT);
+                MakeInstanceMatrices(instances.data(), INSTANCE_COUNT, ret.data());
+                return ret;
+            }();
+            return models;
+        }
+
+        struct BladeShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return mvp * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f mvp = MAT4X4F_IDENTITY;
+        };
+
+        static const Camera& GetInstancingCamera()
+        {
+            static const Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.5f, 0.f}, Vec3f{0.f, 0.f, -10.f}, 0.1f, 100.f, 60.f);
+            return camera;
+        }
+
+        static void RunInstancing(BenchmarkContext& context, bool instanced)
+        {
+            const Mesh&                 mesh     = GetBladeMesh();
+            const std::vector<Mat4x4f>& models   = GetBladeModels();
+            const Mat4x4f               viewProj = GetInstancingCamera().GetViewProjMatrix();
+            Renderer                    renderer(INSTANCING_RESOLUTION, INSTANCING_RESOLUTION);
+            renderer.SetCullMode(EnumCullMode::NONE);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                if (instanced)
+                {
+                    renderer.DrawInstanced(mesh, BladeShader{}, viewProj, models.data(), INSTANCE_COUNT);
+                }
+                else
+                {
+                    for (const Mat4x4f& model : models)
+                    {
+                        renderer.Draw(mesh, BladeShader{viewProj * model});
+                    }
+                }
+                DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+            }
+            context.itemsProcessed = context.iterations * INSTANCE_COUNT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Instancing_DrawPerInstance)
+{
+    Joy::Benchmark::RunInstancing(context, false);
+}
+
+JOY_BENCHMARK(Instancing_DrawInstanced)
+{
+    Joy::Benchmark::RunInstancing(context, true);
+}
@@ -0,0 +1,121 @@
+#include "Benchmark.h"
+#include "Core/Camera.h"
+#include "Core/MeshSimplifier.h"
+#include "Core/Renderer.h"
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int LOD_RESOLUTION   = 512;
+        constexpr int LOD_RINGS        = 48;
+        constexpr int LOD_SEGMENTS     = 96;
+        constexpr int LOD_OBJECT_COUNT = 64;
+
+        /**
+         * @brief 顶点共享的闭合单位球面，约9000个三角形
+         *
+         */
+        static const Mesh& GetLodSourceMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                ret.vertices.push_back(Vertex{Vec3f{0.f, 1.f, 0.f}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}});
+                for (int ring = 1; ring < LOD_RINGS; ++ring)
+                {
+                    const float theta = 3.1415926f * static_cast<float>(ring) / LOD_RINGS;
+                    for (int segment = 0; segment < LOD_SEGMENTS; ++segment)
+                    {
+                        const float phi = 2.f * 3.1415926f * static_cast<float>(segment) / LOD_SEGMENTS;
+                        const Vec3f normal{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                        ret.vertices.push_back(Vertex{normal, normal * 0.5f + Vec3f{0.5f, 0.5f, 0.5f}, Vec2f{}});
+                    }
+                }
+                ret.vertices.push_back(Vertex{Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, -1.f, 0.f}, Vec2f{}});
+                const uint32_t south = static_cast<uint32_t>(ret.vertices.size() - 1);
+                auto index = [](int ring, int segment) { return static_cast<uint32_t>(1 + (ring - 1) * LOD_SEGMENTS + segment % LOD_SEGMENTS); };
+                for (int segment = 0; segment < LOD_SEGMENTS; ++segment)
+                {
+                    ret.indices.insert(ret.indices.end(), {0u, index(1, segment + 1), index(1, segment)});
+                    ret.indices.insert(ret.indices.end(), {south, index(LOD_RINGS - 1, segment), index(LOD_RINGS - 1, segment + 1)});
+                    for (int ring = 1; ring < LOD_RINGS - 1; ++ring)
+                    {
+                        const uint32_t i0 = index(ring, segment);
+                        const uint32_t i1 = index(ring, segment + 1);
+                        const uint32_t i2 = index(ring + 1, segment);
+                        const uint32_t i3 = index(ring + 1, segment + 1);
+                        ret.indices.insert(ret.indices.end(), {i0, i1, i3, i0, i3, i2});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        static const MeshLodChain& GetLodChain()
+        {
+            static const MeshLodChain chain(GetLodSourceMesh(), 6, 0.35f, 64);
+            return chain;
+        }
+
+        struct LodShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return modelViewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f modelViewProj = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 第i个物体的位置，沿视线方向20到200单位分布成一片
+         *
+         */
+        static Vec3f GetLodObjectPosition(int i)
+        {
+            const float distance = 20.f + 180.f * static_cast<float>(i / 8) / 7.f;
+            return Vec3f{(static_cast<float>(i % 8) - 3.5f) * distance * 0.1f, 0.f, -distance};
+        }
+
+        template<typename TSelectFunc> static void RunLodScene(BenchmarkContext& context, TSelectFunc&& selectMesh)
+        {
+            const Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 500.f, 60.f);
+            Renderer     renderer(LOD_RESOLUTION, LOD_RESOLUTION);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                for (int i = 0; i < LOD_OBJECT_COUNT; ++i)
+                {
+                    const Vec3f position = GetLodObjectPosition(i);
+                    Mat4x4f     model    = MAT4X4F_IDENTITY;
+                    model[3]             = Vec4f{position.X(), position.Y(), position.Z(), 1.f};
+                    renderer.Draw(selectMesh(camera, position), LodShader{camera.GetViewProjMatrix() * model});
+                }
+                DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+            }
+            context.itemsProcessed = context.iterations * LOD_OBJECT_COUNT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Lod_FullDetail)
+{
+    Joy::Benchmark::RunLodScene(context, [](const Joy::Camera&, const Joy::Vec3f&) -> const Joy::Mesh& { return Joy::Benchmark::GetLodSourceMesh(); });
+}
+
+JOY_BENCHMARK(Lod_ScreenSpaceError)
+{
+    Joy::Benchmark::GetLodChain();
+    Joy::Benchmark::RunLodScene(context, [](const Joy::Camera& camera, const Joy::Vec3f& position) -> const Joy::Mesh& {
+        return Joy::Benchmark::GetLodChain().Select(camera, position, 1.f, Joy::Benchmark::LOD_RESOLUTION);
+    });
+}
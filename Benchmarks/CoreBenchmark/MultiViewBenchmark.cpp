@@ -0,0 +1,127 @@
+#include "Benchmark.h"
+#include "Core/Camera.h"
+#include "Core/Renderer.h"
+#include <memory>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int PROBE_RESOLUTION = 32;
+        constexpr int PROBE_GRID_SIZE  = 96;
+
+        /**
+         * @brief 环绕探针的高细分球面，顶点处理占主要开销
+         *
+         */
+        static const Mesh& GetProbeSceneMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                for (int row = 0; row <= PROBE_GRID_SIZE; ++row)
+                {
+                    const float theta = 3.1415926f * static_cast<float>(row) / PROBE_GRID_SIZE;
+                    for (int col = 0; col <= PROBE_GRID_SIZE; ++col)
+                    {
+                        const float phi = 2.f * 3.1415926f * static_cast<float>(col) / PROBE_GRID_SIZE;
+                        const Vec3f normal{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                        ret.vertices.push_back(Vertex{normal * 5.f, normal, Vec2f{}});
+                    }
+                }
+                for (uint32_t row = 0; row < PROBE_GRID_SIZE; ++row)
+                {
+                    for (uint32_t col = 0; col < PROBE_GRID_SIZE; ++col)
+                    {
+                        const uint32_t i0 = row * (PROBE_GRID_SIZE + 1) + col;
+                        const uint32_t i1 = i0 + PROBE_GRID_SIZE + 1;
+                        ret.indices.insert(ret.indices.end(), {i0, i1, i1 + 1, i0, i1 + 1, i0 + 1});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        struct ProbeShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return viewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f viewProj = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 立方体贴图6个面的渲染目标与相机
+         *
+         */
+        struct ProbeFaces
+        {
+            ProbeFaces()
+            {
+                const Vec3f directions[6] = {Vec3f{1.f, 0.f, 0.f},  Vec3f{-1.f, 0.f, 0.f}, Vec3f{0.f, 1.f, 0.f},
+                                             Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, 0.f, 1.f},  Vec3f{0.f, 0.f, -1.f}};
+                for (int face = 0; face < 6; ++face)
+                {
+                    const Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{}, directions[face], 0.1f, 100.f, 90.f);
+                    targets.push_back(std::make_unique<Renderer>(PROBE_RESOLUTION, PROBE_RESOLUTION));
+                    targets.back()->SetCullMode(EnumCullMode::NONE);
+                    views[face] = RenderView{camera.GetViewProjMatrix(), targets.back().get()};
+                }
+            }
+
+            void Clear()
+            {
+                for (const std::unique_ptr<Renderer>& target : targets)
+                {
+                    target->Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                }
+            }
+
+            std::vector<std::unique_ptr<Renderer>> targets;
+            RenderView                             views[6];
+        };
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(MultiView_CubemapSeparatePasses)
+{
+    using namespace Joy;
+    const Mesh&           mesh = Benchmark::GetProbeSceneMesh();
+    Benchmark::ProbeFaces faces;
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        faces.Clear();
+        for (const RenderView& view : faces.views)
+        {
+            Benchmark::ProbeShader shader;
+            shader.viewProj = view.viewProj;
+            view.target->Draw(mesh, shader);
+        }
+        Benchmark::DoNotOptimize(faces.targets[0]->GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations * 6;
+}
+
+JOY_BENCHMARK(MultiView_CubemapSinglePass)
+{
+    using namespace Joy;
+    const Mesh&           mesh = Benchmark::GetProbeSceneMesh();
+    Benchmark::ProbeFaces faces;
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        faces.Clear();
+        Renderer::DrawMultiView(mesh, Benchmark::ProbeShader{}, faces.views, 6);
+        Benchmark::DoNotOptimize(faces.targets[0]->GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations * 6;
+}
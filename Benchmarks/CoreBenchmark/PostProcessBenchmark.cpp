@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+#include "Core/PostProcess.h"
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int POST_WIDTH  = 1280;
+        constexpr int POST_HEIGHT = 720;
+
+        /**
+         * @brief 带高亮光斑与硬边的HDR画面
+         *
+         */
+        static const FrameBuffer& GetHdrFrame()
+        {
+            static const FrameBuffer frame = [] {
+                FrameBuffer ret(POST_WIDTH, POST_HEIGHT, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+                for (int y = 0; y < POST_HEIGHT; ++y)
+                {
+                    for (int x = 0; x < POST_WIDTH; ++x)
+                    {
+                        const float wave  = 0.5f + 0.5f * std::sin(static_cast<float>(x) * 0.05f) * std::cos(static_cast<float>(y) * 0.07f);
+                        const bool  spot  = ((x / 80) + (y / 80)) % 5 == 0;
+                        const bool  edge  = 2 * (x % 160) > 3 * (y % 120);
+                        const float scale = spot ? 8.f : 1.f;
+                        ret.SetColor(x, y, Vec4f{wave * scale, (edge ? 0.8f : 0.1f) * scale, 0.3f * scale, 1.f});
+                    }
+                }
+                return ret;
+            }();
+            return frame;
+        }
+
+        static PostProcessSettings GetFullChainSettings()
+        {
+            PostProcessSettings settings;
+            settings.bloom = true;
+            settings.fxaa  = true;
+            return settings;
+        }
+
+        static void RunFused(BenchmarkContext& context, ThreadPool* threadPool)
+        {
+            const FrameBuffer& source = GetHdrFrame();
+            FrameBuffer        destination(POST_WIDTH, POST_HEIGHT);
+            PostProcessor      processor(threadPool);
+            processor.SetSettings(GetFullChainSettings());
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                processor.Process(source, destination);
+                DoNotOptimize(destination.GetColorData());
+            }
+            context.itemsProcessed = context.iterations * POST_WIDTH * POST_HEIGHT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(PostProcess_SeparatePasses)
+{
+    // 每个效果单独遍历整帧，中间结果写回帧缓冲
+    using namespace Joy;
+    using namespace Joy::Benchmark;
+    const FrameBuffer&  source = GetHdrFrame();
+    FrameBuffer         bloomed(POST_WIDTH, POST_HEIGHT, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+    FrameBuffer         mapped(POST_WIDTH, POST_HEIGHT);
+    FrameBuffer         destination(POST_WIDTH, POST_HEIGHT);
+    PostProcessSettings bloomOnly = GetFullChainSettings();
+    bloomOnly.toneMapping         = false;
+    bloomOnly.gammaCorrection     = false;
+    bloomOnly.fxaa                = false;
+    PostProcessSettings mapOnly;
+    PostProcessSettings fxaaOnly;
+    fxaaOnly.toneMapping     = false;
+    fxaaOnly.gammaCorrection = false;
+    fxaaOnly.fxaa            = true;
+    PostProcessor bloomPass;
+    PostProcessor mapPass;
+    PostProcessor fxaaPass;
+    bloomPass.SetSettings(bloomOnly);
+    mapPass.SetSettings(mapOnly);
+    fxaaPass.SetSettings(fxaaOnly);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        bloomPass.Process(source, bloomed);
+        mapPass.Process(bloomed, mapped);
+        fxaaPass.Process(mapped, destination);
+        DoNotOptimize(destination.GetColorData());
+    }
+    context.itemsProcessed = context.iterations * POST_WIDTH * POST_HEIGHT;
+}
+
+JOY_BENCHMARK(PostProcess_Fused)
+{
+    Joy::Benchmark::RunFused(context, nullptr);
+}
+
+JOY_BENCHMARK(PostProcess_FusedThreaded)
+{
+    Joy::ThreadPool threadPool;
+    Joy::Benchmark::RunFused(context, &threadPool);
+}
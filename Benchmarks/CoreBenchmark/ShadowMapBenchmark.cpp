@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+#include "Core/Renderer.h"
+#include "Core/ShadowMap.h"
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int SHADOW_RESOLUTION = 1024;
+        constexpr int SHADOW_GRID_SIZE  = 64;
+
+        /**
+         * @brief 起伏的网格，覆盖整个光源视口
+         *
+         */
+        static const Mesh& GetShadowCasterMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                for (int z = 0; z <= SHADOW_GRID_SIZE; ++z)
+                {
+                    for (int x = 0; x <= SHADOW_GRID_SIZE; ++x)
+                    {
+                        const float fx = static_cast<float>(x) / SHADOW_GRID_SIZE * 2.f - 1.f;
+                        const float fz = static_cast<float>(z) / SHADOW_GRID_SIZE * 2.f - 1.f;
+                        ret.vertices.push_back(Vertex{Vec3f{fx, 0.5f + 0.25f * ((x + z) % 3), fz}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}});
+                    }
+                }
+                for (uint32_t z = 0; z < SHADOW_GRID_SIZE; ++z)
+                {
+                    for (uint32_t x = 0; x < SHADOW_GRID_SIZE; ++x)
+                    {
+                        const uint32_t i0 = z * (SHADOW_GRID_SIZE + 1) + x;
+                        const uint32_t i1 = i0 + SHADOW_GRID_SIZE + 1;
+                        ret.indices.insert(ret.indices.end(), {i0, i1, i1 + 1, i0, i1 + 1, i0 + 1});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        static Mat4x4f GetShadowLightViewProj()
+        {
+            const Camera light(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 2.f, 0.f}, Vec3f{0.f, 0.f, 0.f}, 0.f, 4.f, 1.f);
+            return light.GetViewProjMatrix();
+        }
+
+        /**
+         * @brief 完整着色路径的对照着色器: 仅输出常量颜色
+         *
+         */
+        struct ShadowDepthShader
+        {
+            constexpr static int VARYING_COUNT = 0;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float*) const
+            {
+                return lightViewProj * Vec4f{vertex.position.X(), vertex.position.Y(), vertex.position.Z(), 1.f};
+            }
+
+            Vec4f Fragment(const float*) const { return Vec4f{1.f, 1.f, 1.f, 1.f}; }
+
+            Mat4x4f lightViewProj;
+        };
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(ShadowMap_DepthOnly)
+{
+    using namespace Joy;
+    const Mesh&   mesh          = Benchmark::GetShadowCasterMesh();
+    const Mat4x4f lightViewProj = Benchmark::GetShadowLightViewProj();
+    ShadowMap     shadowMap(Benchmark::SHADOW_RESOLUTION);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        shadowMap.Clear();
+        shadowMap.RenderDepth(mesh, lightViewProj);
+        Benchmark::DoNotOptimize(shadowMap.GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations * static_cast<int64_t>(mesh.indices.size() / 3);
+}
+
+JOY_BENCHMARK(ShadowMap_FullShading)
+{
+    using namespace Joy;
+    const Mesh&                  mesh = Benchmark::GetShadowCasterMesh();
+    Renderer                     renderer(Benchmark::SHADOW_RESOLUTION, Benchmark::SHADOW_RESOLUTION);
+    Benchmark::ShadowDepthShader shader{Benchmark::GetShadowLightViewProj()};
+    renderer.SetCullMode(EnumCullMode::NONE);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+        renderer.Draw(mesh, shader);
+        Benchmark::DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+    }
+    context.itemsProcessed = context.iterations * static_cast<int64_t>(mesh.indices.size() / 3);
+}
+
+JOY_BENCHMARK(ShadowMap_PcfLookup)
+{
+    using namespace Joy;
+    ShadowMap shadowMap(Benchmark::SHADOW_RESOLUTION);
+    shadowMap.RenderDepth(Benchmark::GetShadowCasterMesh(), Benchmark::GetShadowLightViewProj());
+    constexpr int lookupCount = 256 * 256;
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        float sum = 0.f;
+        for (int i = 0; i < lookupCount; ++i)
+        {
+            const float u = static_cast<float>(i & 255) * (1.f / 256.f);
+            const float v = static_cast<float>(i >> 8) * (1.f / 256.f);
+            sum += shadowMap.SampleCompare(u, v, 0.3f);
+        }
+        Benchmark::DoNotOptimize(sum);
+    }
+    context.itemsProcessed = context.iterations * lookupCount;
+}
@@ -0,0 +1,73 @@
+#include "Benchmark.h"
+#include "Core/SharedFrameRing.h"
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int OUTPUT_WIDTH  = 1280;
+        constexpr int OUTPUT_HEIGHT = 720;
+
+        /**
+         * @brief 模拟一帧渲染: 清除后写入一半的行
+         *
+         */
+        static void RenderOutputFrame(FrameBuffer& frameBuffer, const std::vector<Vec4f>& row, int64_t iteration)
+        {
+            frameBuffer.ClearColor(Vec4f{0.1f, 0.2f, static_cast<float>(iteration % 2), 1.f});
+            for (int y = 0; y < OUTPUT_HEIGHT; y += 2)
+            {
+                frameBuffer.SetColorSpan(0, y, OUTPUT_WIDTH, row.data());
+            }
+        }
+
+        static void RunCopyToConsumer(BenchmarkContext& context)
+        {
+            // 渲染到私有帧缓冲后整帧拷贝到交付给消费者的缓冲
+            FrameBuffer          frameBuffer(OUTPUT_WIDTH, OUTPUT_HEIGHT, EnumColorFormat::RGBA8);
+            std::vector<Vec4f>   row(OUTPUT_WIDTH, Vec4f{0.5f, 0.25f, 0.75f, 1.f});
+            std::vector<uint8_t> output(static_cast<size_t>(frameBuffer.GetColorPitch()) * OUTPUT_HEIGHT);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                RenderOutputFrame(frameBuffer, row, iteration);
+                frameBuffer.ResolveColorFastClear();
+                std::memcpy(output.data(), frameBuffer.GetColorData(), output.size());
+                DoNotOptimize(output.data());
+            }
+            context.itemsProcessed = context.iterations * OUTPUT_WIDTH * OUTPUT_HEIGHT;
+        }
+
+        static void RunSharedFrameRing(BenchmarkContext& context)
+        {
+            // 直接渲染到共享内存帧环中的帧，发布时无拷贝；无法创建共享内存时不计吞吐量
+            SharedFrameRing ring;
+            if (!ring.Create("/JoySharedFrameBenchmark_" + std::to_string(getpid()), OUTPUT_WIDTH, OUTPUT_HEIGHT, EnumColorFormat::RGBA8))
+            {
+                return;
+            }
+            FrameBuffer        frameBuffer(OUTPUT_WIDTH, OUTPUT_HEIGHT, EnumColorFormat::RGBA8);
+            std::vector<Vec4f> row(OUTPUT_WIDTH, Vec4f{0.5f, 0.25f, 0.75f, 1.f});
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                ring.BeginFrame(frameBuffer);
+                RenderOutputFrame(frameBuffer, row, iteration);
+                DoNotOptimize(ring.PublishFrame(frameBuffer));
+            }
+            context.itemsProcessed = context.iterations * OUTPUT_WIDTH * OUTPUT_HEIGHT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(FrameOutput_CopyToConsumer)
+{
+    Joy::Benchmark::RunCopyToConsumer(context);
+}
+
+JOY_BENCHMARK(FrameOutput_SharedFrameRing)
+{
+    Joy::Benchmark::RunSharedFrameRing(context);
+}
@@ -0,0 +1,132 @@
+#include "Benchmark.h"
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+#include <cmath>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int KERNEL_POSITION_COUNT = 65536;
+        constexpr int KERNEL_ROW_WIDTH      = 1280;
+        constexpr int KERNEL_TAP_COUNT      = 13;
+
+        /**
+         * @brief 在指定路径下运行基准，结束后恢复原路径；本机不支持时不计吞吐量
+         *
+         */
+        template<typename TFunc> static void RunWithSimdLevel(EnumSimdLevel level, TFunc&& func)
+        {
+            const EnumSimdLevel previous = GetSimdLevel();
+            if (!SetSimdLevel(level))
+            {
+                return;
+            }
+            func();
+            SetSimdLevel(previous);
+        }
+
+        static void RunTransformPositions(BenchmarkContext& context, EnumSimdLevel level)
+        {
+            std::vector<Vec4f> positions(KERNEL_POSITION_COUNT);
+            std::vector<Vec4f> out(KERNEL_POSITION_COUNT);
+            for (int i = 0; i < KERNEL_POSITION_COUNT; ++i)
+            {
+                positions[i] = Vec4f{std::sin(i * 0.1f), std::cos(i * 0.2f), i * 1e-4f, 1.f};
+            }
+            Mat4x4f mat = MAT4X4F_IDENTITY;
+            mat[3]      = Vec4f{1.f, 2.f, 3.f, 1.f};
+            RunWithSimdLevel(level, [&] {
+                const SimdKernels& kernels = GetSimdKernels();
+                for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+                {
+                    kernels.transformPositions(mat, positions.data(), positions.size(), out.data());
+                    DoNotOptimize(out.data());
+                }
+                context.itemsProcessed = context.iterations * KERNEL_POSITION_COUNT;
+            });
+        }
+
+        static void RunConvolveRow(BenchmarkContext& context, EnumSimdLevel level)
+        {
+            std::vector<Vec4f> taps(KERNEL_ROW_WIDTH + KERNEL_TAP_COUNT - 1, Vec4f{0.5f, 0.25f, 0.125f, 0.f});
+            std::vector<Vec4f> out(KERNEL_ROW_WIDTH);
+            std::vector<float> weights(KERNEL_TAP_COUNT, 1.f / KERNEL_TAP_COUNT);
+            RunWithSimdLevel(level, [&] {
+                const SimdKernels& kernels = GetSimdKernels();
+                for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+                {
+                    kernels.convolveRow(taps.data(), weights.data(), KERNEL_TAP_COUNT, KERNEL_ROW_WIDTH, out.data());
+                    DoNotOptimize(out.data());
+                }
+                context.itemsProcessed = context.iterations * KERNEL_ROW_WIDTH;
+            });
+        }
+
+        static void RunCoverSpan(BenchmarkContext& context, EnumSimdLevel level)
+        {
+            // 跨越整行的细长三角形，每行的覆盖以SPAN_SIZE为一段计算
+            EdgeSpan span{{0.01f, -0.01f, 0.f}, {5.f, 8.f, 1.f}, {true, false, true}, 1e-4f, 0.25f};
+            float    depths[SimdKernels::SPAN_SIZE];
+            RunWithSimdLevel(level, [&] {
+                const SimdKernels& kernels = GetSimdKernels();
+                for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+                {
+                    uint64_t coverage = 0;
+                    for (int x = 0; x < KERNEL_ROW_WIDTH; x += SimdKernels::SPAN_SIZE)
+                    {
+                        coverage ^= kernels.coverSpan(span, x, SimdKernels::SPAN_SIZE, depths);
+                    }
+                    DoNotOptimize(coverage);
+                }
+                context.itemsProcessed = context.iterations * KERNEL_ROW_WIDTH;
+            });
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(SimdKernels_TransformPositions_SSE2)
+{
+    Joy::Benchmark::RunTransformPositions(context, Joy::EnumSimdLevel::SSE2);
+}
+
+JOY_BENCHMARK(SimdKernels_TransformPositions_AVX2)
+{
+    Joy::Benchmark::RunTransformPositions(context, Joy::EnumSimdLevel::AVX2);
+}
+
+JOY_BENCHMARK(SimdKernels_TransformPositions_AVX512)
+{
+    Joy::Benchmark::RunTransformPositions(context, Joy::EnumSimdLevel::AVX512);
+}
+
+JOY_BENCHMARK(SimdKernels_ConvolveRow_SSE2)
+{
+    Joy::Benchmark::RunConvolveRow(context, Joy::EnumSimdLevel::SSE2);
+}
+
+JOY_BENCHMARK(SimdKernels_ConvolveRow_AVX2)
+{
+    Joy::Benchmark::RunConvolveRow(context, Joy::EnumSimdLevel::AVX2);
+}
+
+JOY_BENCHMARK(SimdKernels_ConvolveRow_AVX512)
+{
+    Joy::Benchmark::RunConvolveRow(context, Joy::EnumSimdLevel::AVX512);
+}
+
+JOY_BENCHMARK(SimdKernels_CoverSpan_SSE2)
+{
+    Joy::Benchmark::RunCoverSpan(context, Joy::EnumSimdLevel::SSE2);
+}
+
+JOY_BENCHMARK(SimdKernels_CoverSpan_AVX2)
+{
+    Joy::Benchmark::RunCoverSpan(context, Joy::EnumSimdLevel::AVX2);
+}
+
+JOY_BENCHMARK(SimdKernels_CoverSpan_AVX512)
+{
+    Joy::Benchmark::RunCoverSpan(context, Joy::EnumSimdLevel::AVX512);
+}
@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "Core/Renderer.h"
+#include <random>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int SMALL_TRIANGLE_RESOLUTION = 512;
+        constexpr int SMALL_TRIANGLE_CELLS      = 400;
+
+        /**
+         * @brief 带随机扰动的细密网格，模拟扫描网格，每个三角形约0.8平方像素
+         *
+         */
+        static const Mesh& GetScannedMesh()
+        {
+            static const Mesh mesh = [] {
+                std::mt19937                          random(20251222u);
+                std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+                std::uniform_real_distribution<float> height(0.4f, 0.6f);
+                Mesh                                  ret;
+                for (int y = 0; y <= SMALL_TRIANGLE_CELLS; ++y)
+                {
+                    for (int x = 0; x <= SMALL_TRIANGLE_CELLS; ++x)
+                    {
+                        const float ndcX = -1.f + 2.f * (static_cast<float>(x) + jitter(random)) / SMALL_TRIANGLE_CELLS;
+                        const float ndcY = -1.f + 2.f * (static_cast<float>(y) + jitter(random)) / SMALL_TRIANGLE_CELLS;
+                        const float z    = height(random);
+                        ret.vertices.push_back(Vertex{Vec3f{ndcX, ndcY, z}, Vec3f{z, 0.5f, 1.f - z}, Vec2f{}});
+                    }
+                }
+                for (uint32_t y = 0; y < SMALL_TRIANGLE_CELLS; ++y)
+                {
+                    for (uint32_t x = 0; x < SMALL_TRIANGLE_CELLS; ++x)
+                    {
+                        const uint32_t i0 = y * (SMALL_TRIANGLE_CELLS + 1) + x;
+                        const uint32_t i1 = i0 + SMALL_TRIANGLE_CELLS + 1;
+                        ret.indices.insert(ret.indices.end(), {i0, i0 + 1, i1 + 1, i0, i1 + 1, i1});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        struct ScannedMeshShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+        };
+
+        static void RunScannedMesh(BenchmarkContext& context, bool fastPath)
+        {
+            const Mesh& mesh = GetScannedMesh();
+            Renderer    renderer(SMALL_TRIANGLE_RESOLUTION, SMALL_TRIANGLE_RESOLUTION);
+            renderer.SetCullMode(EnumCullMode::NONE);
+            renderer.SetSmallTriangleFastPath(fastPath);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer.Draw(mesh, ScannedMeshShader{});
+                DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+            }
+            context.itemsProcessed = context.iterations * static_cast<int64_t>(mesh.indices.size() / 3);
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(SmallTriangle_GeneralSetup)
+{
+    Joy::Benchmark::RunScannedMesh(context, false);
+}
+
+JOY_BENCHMARK(SmallTriangle_MicroBatch)
+{
+    Joy::Benchmark::RunScannedMesh(context, true);
+}
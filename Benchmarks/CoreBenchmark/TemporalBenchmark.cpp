@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+#include "Core/Camera.h"
+#include "Core/Renderer.h"
+#include "Core/TemporalAccumulator.h"
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int TEMPORAL_RESOLUTION = 512;
+        constexpr int TEMPORAL_GRID_SIZE  = 64;
+
+        /**
+         * @brief 占满大部分屏幕的球面，边缘较多
+         *
+         */
+        static const Mesh& GetTemporalSceneMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh ret;
+                for (int row = 0; row <= TEMPORAL_GRID_SIZE; ++row)
+                {
+                    const float theta = 3.1415926f * static_cast<float>(row) / TEMPORAL_GRID_SIZE;
+                    for (int col = 0; col <= TEMPORAL_GRID_SIZE; ++col)
+                    {
+                        const float phi = 2.f * 3.1415926f * static_cast<float>(col) / TEMPORAL_GRID_SIZE;
+                        const Vec3f normal{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                        ret.vertices.push_back(Vertex{normal, normal * 0.5f + Vec3f{0.5f, 0.5f, 0.5f}, Vec2f{}});
+                    }
+                }
+                for (uint32_t row = 0; row < TEMPORAL_GRID_SIZE; ++row)
+                {
+                    for (uint32_t col = 0; col < TEMPORAL_GRID_SIZE; ++col)
+                    {
+                        const uint32_t i0 = row * (TEMPORAL_GRID_SIZE + 1) + col;
+                        const uint32_t i1 = i0 + TEMPORAL_GRID_SIZE + 1;
+                        ret.indices.insert(ret.indices.end(), {i0, i0 + 1, i1 + 1, i0, i1 + 1, i1});
+                    }
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        struct TemporalShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return viewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f viewProj = MAT4X4F_IDENTITY;
+        };
+
+        static Camera GetTemporalCamera()
+        {
+            return Camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 2.5f}, Vec3f{0.f, 0.f, 0.f}, 0.1f, 10.f, 60.f);
+        }
+
+        /**
+         * @brief 每帧以MSAA超采样渲染的对照组
+         *
+         */
+        static void RunSupersample(BenchmarkContext& context, int sampleCount)
+        {
+            const Mesh& mesh   = GetTemporalSceneMesh();
+            Camera      camera = GetTemporalCamera();
+            Renderer    renderer(TEMPORAL_RESOLUTION, TEMPORAL_RESOLUTION);
+            renderer.SetSampleCount(sampleCount);
+            renderer.SetCullMode(EnumCullMode::NONE);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer.Draw(mesh, TemporalShader{camera.GetViewProjMatrix()});
+                renderer.Resolve();
+                DoNotOptimize(renderer.GetFrameBuffer().GetDepth(0, 0));
+            }
+            context.itemsProcessed = context.iterations;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Temporal_JitteredFrame)
+{
+    using namespace Joy;
+    const Mesh&         mesh   = Benchmark::GetTemporalSceneMesh();
+    Camera              camera = Benchmark::GetTemporalCamera();
+    Renderer            renderer(Benchmark::TEMPORAL_RESOLUTION, Benchmark::TEMPORAL_RESOLUTION);
+    TemporalAccumulator accumulator(Benchmark::TEMPORAL_RESOLUTION, Benchmark::TEMPORAL_RESOLUTION, 1 << 30);
+    renderer.SetCullMode(EnumCullMode::NONE);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        accumulator.Update(camera.GetVersion());
+        camera.SetJitter(accumulator.GetNdcJitter());
+        renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+        renderer.Draw(mesh, Benchmark::TemporalShader{camera.GetViewProjMatrix()});
+        accumulator.Accumulate(renderer.GetFrameBuffer());
+        Benchmark::DoNotOptimize(accumulator.GetColor(0, 0));
+    }
+    context.itemsProcessed = context.iterations;
+}
+
+JOY_BENCHMARK(Temporal_Supersample4x)
+{
+    Joy::Benchmark::RunSupersample(context, 4);
+}
+
+JOY_BENCHMARK(Temporal_Supersample8x)
+{
+    Joy::Benchmark::RunSupersample(context, 8);
+}
@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+#include "Core/PostProcess.h"
+#include "Core/TileSchedule.h"
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int SCHEDULE_WIDTH  = 1920;
+        constexpr int SCHEDULE_HEIGHT = 1080;
+
+        /**
+         * @brief 带高亮区域的HDR画面
+         *
+         */
+        static const FrameBuffer& GetScheduleSource()
+        {
+            static const FrameBuffer frame = [] {
+                FrameBuffer ret(SCHEDULE_WIDTH, SCHEDULE_HEIGHT, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+                for (int y = 0; y < SCHEDULE_HEIGHT; ++y)
+                {
+                    for (int x = 0; x < SCHEDULE_WIDTH; ++x)
+                    {
+                        const float wave  = 0.5f + 0.5f * std::sin(static_cast<float>(x) * 0.03f) * std::cos(static_cast<float>(y) * 0.05f);
+                        const float scale = ((x / 96) + (y / 96)) % 4 == 0 ? 6.f : 1.f;
+                        ret.SetColor(x, y, Vec4f{wave * scale, (1.f - wave) * scale, 0.25f * scale, 1.f});
+                    }
+                }
+                return ret;
+            }();
+            return frame;
+        }
+
+        /**
+         * @brief 完整后处理链，分块按给定的顺序与方式调度
+         *
+         */
+        static void RunScheduledPostProcess(BenchmarkContext& context, EnumTileOrder order, EnumTileScheduling scheduling, bool pinThreads)
+        {
+            ThreadPool          threadPool(0, pinThreads);
+            const FrameBuffer&  source = GetScheduleSource();
+            FrameBuffer         destination(SCHEDULE_WIDTH, SCHEDULE_HEIGHT);
+            PostProcessor       processor(&threadPool);
+            PostProcessSettings settings;
+            settings.bloom = true;
+            settings.fxaa  = true;
+            processor.SetSettings(settings);
+            processor.SetTileOrder(order, scheduling);
+            // 目标帧缓冲由负责各区域的线程首次触碰
+            destination.ResolveFastClear(TileSchedule(destination.GetTileCountX(), destination.GetTileCountY(), order, scheduling), &threadPool);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                processor.Process(source, destination);
+                DoNotOptimize(destination.GetColorData());
+            }
+            context.itemsProcessed = context.iterations * SCHEDULE_WIDTH * SCHEDULE_HEIGHT;
+        }
+
+        /**
+         * @brief 新建帧缓冲并落地清除，threadPool为空时由调用线程触碰全部内存
+         *
+         */
+        static void RunFirstTouch(BenchmarkContext& context, ThreadPool* threadPool)
+        {
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                FrameBuffer  frameBuffer(SCHEDULE_WIDTH, SCHEDULE_HEIGHT, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+                TileSchedule schedule(frameBuffer.GetTileCountX(), frameBuffer.GetTileCountY());
+                frameBuffer.ResolveFastClear(schedule, threadPool);
+                DoNotOptimize(frameBuffer.GetColorData());
+            }
+            context.itemsProcessed = context.iterations * SCHEDULE_WIDTH * SCHEDULE_HEIGHT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(TileSchedule_RoundRobin)
+{
+    // 对照: 未绑定的线程按行优先轮流领取分块
+    Joy::Benchmark::RunScheduledPostProcess(context, Joy::EnumTileOrder::ROW_MAJOR, Joy::EnumTileScheduling::DYNAMIC, false);
+}
+
+JOY_BENCHMARK(TileSchedule_MortonAffine)
+{
+    Joy::Benchmark::RunScheduledPostProcess(context, Joy::EnumTileOrder::MORTON, Joy::EnumTileScheduling::AFFINE, true);
+}
+
+JOY_BENCHMARK(TileSchedule_HilbertAffine)
+{
+    Joy::Benchmark::RunScheduledPostProcess(context, Joy::EnumTileOrder::HILBERT, Joy::EnumTileScheduling::AFFINE, true);
+}
+
+JOY_BENCHMARK(TileSchedule_FirstTouchSerial)
+{
+    Joy::Benchmark::RunFirstTouch(context, nullptr);
+}
+
+JOY_BENCHMARK(TileSchedule_FirstTouchScheduled)
+{
+    Joy::ThreadPool threadPool(0, true);
+    Joy::Benchmark::RunFirstTouch(context, &threadPool);
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "Core/Renderer.h"
+#include "Core/TransparencyBuffer.h"
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int TRANSPARENCY_RESOLUTION     = 256;
+        constexpr int TRANSPARENCY_PARTICLE_COUNT = 2000;
+
+        /**
+         * @brief 粒子场景: 大量深度随机、相互重叠的小四边形，未排序
+         *
+         */
+        static const Mesh& GetParticleMesh()
+        {
+            static const Mesh mesh = [] {
+                Mesh     ret;
+                uint32_t seed = 12345u;
+                auto     next = [&seed] {
+                    seed = seed * 1664525u + 1013904223u;
+                    return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+                };
+                for (int particle = 0; particle < TRANSPARENCY_PARTICLE_COUNT; ++particle)
+                {
+                    const float    x     = next() * 2.f - 1.f;
+                    const float    y     = next() * 2.f - 1.f;
+                    const float    depth = 0.05f + 0.9f * next();
+                    const float    size  = 0.03f + 0.05f * next();
+                    const Vec3f    color{next(), next(), next()};
+                    const Vec2f    alpha{0.2f + 0.3f * next(), 0.f};
+                    const uint32_t base = static_cast<uint32_t>(ret.vertices.size());
+                    ret.vertices.push_back(Vertex{Vec3f{x - size, y - size, depth}, color, alpha});
+                    ret.vertices.push_back(Vertex{Vec3f{x + size, y - size, depth}, color, alpha});
+                    ret.vertices.push_back(Vertex{Vec3f{x + size, y + size, depth}, color, alpha});
+                    ret.vertices.push_back(Vertex{Vec3f{x - size, y + size, depth}, color, alpha});
+                    ret.indices.insert(ret.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+                }
+                return ret;
+            }();
+            return mesh;
+        }
+
+        /**
+         * @brief 法线作为RGB，纹理坐标u作为Alpha
+         *
+         */
+        struct ParticleShader
+        {
+            constexpr static int VARYING_COUNT = 4;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                varyings[3] = vertex.uv[0];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], varyings[3]}; }
+        };
+
+        static void RunTransparency(BenchmarkContext& context, EnumTransparencyMode mode, ThreadPool* threadPool)
+        {
+            const Mesh&        mesh = GetParticleMesh();
+            Renderer           renderer(TRANSPARENCY_RESOLUTION, TRANSPARENCY_RESOLUTION);
+            TransparencyBuffer transparency(TRANSPARENCY_RESOLUTION, TRANSPARENCY_RESOLUTION, mode, threadPool);
+            size_t             fragmentCount = 0;
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                transparency.Clear();
+                renderer.SetTransparencyTarget(&transparency);
+                renderer.Draw(mesh, ParticleShader{});
+                renderer.SetTransparencyTarget(nullptr);
+                fragmentCount = transparency.GetFragmentCount();
+                transparency.Resolve(renderer.GetFrameBuffer());
+                DoNotOptimize(renderer.GetFrameBuffer().GetColorData());
+            }
+            context.itemsProcessed = context.iterations * static_cast<int64_t>(fragmentCount);
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Transparency_WeightedBlended)
+{
+    Joy::Benchmark::RunTransparency(context, Joy::EnumTransparencyMode::WEIGHTED_BLENDED, nullptr);
+}
+
+JOY_BENCHMARK(Transparency_FragmentList)
+{
+    Joy::Benchmark::RunTransparency(context, Joy::EnumTransparencyMode::FRAGMENT_LIST, nullptr);
+}
+
+JOY_BENCHMARK(Transparency_FragmentListThreaded)
+{
+    Joy::ThreadPool threadPool;
+    Joy::Benchmark::RunTransparency(context, Joy::EnumTransparencyMode::FRAGMENT_LIST, &threadPool);
+}
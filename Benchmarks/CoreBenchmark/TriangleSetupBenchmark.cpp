@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+#include "Core/Rasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int SETUP_TRIANGLE_COUNT = 16384;
+
+        /**
+         * @brief 随机分布在1920x1080屏幕内的小三角形
+         *
+         */
+        static const std::vector<RasterVertex>& GetSetupVertices()
+        {
+            static const std::vector<RasterVertex> vertices = [] {
+                std::mt19937                          random(20251219u);
+                std::uniform_real_distribution<float> position(0.f, 1.f);
+                std::uniform_real_distribution<float> offset(-24.f, 24.f);
+                std::vector<RasterVertex>             ret;
+                for (int i = 0; i < SETUP_TRIANGLE_COUNT; ++i)
+                {
+                    const float x = position(random) * 1920.f;
+                    const float y = position(random) * 1080.f;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        ret.push_back(RasterVertex{x + offset(random), y + offset(random), position(random), 1.f});
+                    }
+                }
+                return ret;
+            }();
+            return vertices;
+        }
+
+        /**
+         * @brief 对照组: 以浮点吸附与浮点面积计算的三角形建立
+         *
+         */
+        static bool SetupTriangleFloat(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2, const RasterRect& scissor, RasterTriangle& tri)
+        {
+            const RasterVertex* v[3] = {&v0, &v1, &v2};
+            float               x[3];
+            float               y[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                x[i] = std::round(v[i]->x * 256.f) * (1.f / 256.f);
+                y[i] = std::round(v[i]->y * 256.f) * (1.f / 256.f);
+            }
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+            if (area == 0.f || !std::isfinite(area))
+            {
+                return false;
+            }
+            tri.bounds.minX = std::max(scissor.minX, static_cast<int>(std::floor(std::min({x[0], x[1], x[2]}))));
+            tri.bounds.minY = std::max(scissor.minY, static_cast<int>(std::floor(std::min({y[0], y[1], y[2]}))));
+            tri.bounds.maxX = std::min(scissor.maxX, static_cast<int>(std::ceil(std::max({x[0], x[1], x[2]}))));
+            tri.bounds.maxY = std::min(scissor.maxY, static_cast<int>(std::ceil(std::max({y[0], y[1], y[2]}))));
+            if (tri.bounds.minX >= tri.bounds.maxX || tri.bounds.minY >= tri.bounds.maxY)
+            {
+                return false;
+            }
+            const float orientation = area > 0.f ? 1.f : -1.f;
+            for (int k = 0; k < 3; ++k)
+            {
+                const int from     = (k + 1) % 3;
+                const int to       = (k + 2) % 3;
+                tri.edgeA[k]       = (y[from] - y[to]) * orientation;
+                tri.edgeB[k]       = (x[to] - x[from]) * orientation;
+                tri.edgeC[k]       = -(tri.edgeA[k] * x[from] + tri.edgeB[k] * y[from]);
+                tri.edgeTopLeft[k] = tri.edgeA[k] > 0.f || (tri.edgeA[k] == 0.f && tri.edgeB[k] > 0.f);
+                tri.invW[k]        = v[k]->invW;
+            }
+            tri.invArea = 1.f / (area * orientation);
+            tri.depthA  = (tri.edgeA[0] * v0.z + tri.edgeA[1] * v1.z + tri.edgeA[2] * v2.z) * tri.invArea;
+            tri.depthB  = (tri.edgeB[0] * v0.z + tri.edgeB[1] * v1.z + tri.edgeB[2] * v2.z) * tri.invArea;
+            tri.depthC  = (tri.edgeC[0] * v0.z + tri.edgeC[1] * v1.z + tri.edgeC[2] * v2.z) * tri.invArea;
+            return true;
+        }
+
+        template<typename TSetupFunc> static void RunTriangleSetup(BenchmarkContext& context, TSetupFunc&& setupFunc)
+        {
+            const std::vector<RasterVertex>& vertices = GetSetupVertices();
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                int accepted = 0;
+                for (size_t i = 0; i < vertices.size(); i += 3)
+                {
+                    RasterTriangle tri{};
+                    accepted += setupFunc(vertices[i], vertices[i + 1], vertices[i + 2], tri) ? 1 : 0;
+                    DoNotOptimize(tri.edgeC[0]);
+                }
+                DoNotOptimize(accepted);
+            }
+            context.itemsProcessed = context.iterations * SETUP_TRIANGLE_COUNT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(TriangleSetup_Float)
+{
+    const Joy::RasterRect scissor{0, 0, 1920, 1080};
+    Joy::Benchmark::RunTriangleSetup(context, [&](const Joy::RasterVertex& v0, const Joy::RasterVertex& v1, const Joy::RasterVertex& v2, Joy::RasterTriangle& tri) {
+        return Joy::Benchmark::SetupTriangleFloat(v0, v1, v2, scissor, tri);
+    });
+}
+
+JOY_BENCHMARK(TriangleSetup_Fixed24_8)
+{
+    const Joy::RasterRect scissor{0, 0, 1920, 1080};
+    Joy::Benchmark::RunTriangleSetup(context, [&](const Joy::RasterVertex& v0, const Joy::RasterVertex& v1, const Joy::RasterVertex& v2, Joy::RasterTriangle& tri) {
+        return Joy::SetupTriangle(v0, v1, v2, Joy::EnumCullMode::NONE, scissor, tri);
+    });
+}
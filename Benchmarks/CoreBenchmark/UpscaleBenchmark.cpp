@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+#include "Core/Upscaler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int UPSCALE_SOURCE_WIDTH  = 960;
+        constexpr int UPSCALE_SOURCE_HEIGHT = 540;
+        constexpr int UPSCALE_OUTPUT_WIDTH  = 1920;
+        constexpr int UPSCALE_OUTPUT_HEIGHT = 1080;
+
+        static const FrameBuffer& GetUpscaleSource()
+        {
+            static const FrameBuffer frame = [] {
+                FrameBuffer ret(UPSCALE_SOURCE_WIDTH, UPSCALE_SOURCE_HEIGHT);
+                for (int y = 0; y < UPSCALE_SOURCE_HEIGHT; ++y)
+                {
+                    for (int x = 0; x < UPSCALE_SOURCE_WIDTH; ++x)
+                    {
+                        const float wave = 0.5f + 0.5f * std::sin(static_cast<float>(x) * 0.05f) * std::cos(static_cast<float>(y) * 0.07f);
+                        ret.SetColor(x, y, Vec4f{wave, 1.f - wave, static_cast<float>((x / 32 + y / 32) % 2), 1.f});
+                    }
+                }
+                return ret;
+            }();
+            return frame;
+        }
+
+        static void RunUpscaler(BenchmarkContext& context, ThreadPool* threadPool)
+        {
+            const FrameBuffer& source = GetUpscaleSource();
+            FrameBuffer        destination(UPSCALE_OUTPUT_WIDTH, UPSCALE_OUTPUT_HEIGHT);
+            BilinearUpscaler   upscaler(threadPool);
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                upscaler.Process(source, destination);
+                DoNotOptimize(destination.GetColorData());
+            }
+            context.itemsProcessed = context.iterations * UPSCALE_OUTPUT_WIDTH * UPSCALE_OUTPUT_HEIGHT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Upscale_PerPixel)
+{
+    // 对照: 每个目标像素逐个读取4个源像素后插值写入
+    using namespace Joy;
+    using namespace Joy::Benchmark;
+    const FrameBuffer& source = GetUpscaleSource();
+    FrameBuffer        destination(UPSCALE_OUTPUT_WIDTH, UPSCALE_OUTPUT_HEIGHT);
+    const float        scaleX = static_cast<float>(UPSCALE_SOURCE_WIDTH) / UPSCALE_OUTPUT_WIDTH;
+    const float        scaleY = static_cast<float>(UPSCALE_SOURCE_HEIGHT) / UPSCALE_OUTPUT_HEIGHT;
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        for (int y = 0; y < UPSCALE_OUTPUT_HEIGHT; ++y)
+        {
+            const float sy = std::min(std::max((y + 0.5f) * scaleY - 0.5f, 0.f), static_cast<float>(UPSCALE_SOURCE_HEIGHT - 1));
+            const int   y0 = static_cast<int>(sy);
+            const int   y1 = std::min(y0 + 1, UPSCALE_SOURCE_HEIGHT - 1);
+            const float fy = sy - static_cast<float>(y0);
+            for (int x = 0; x < UPSCALE_OUTPUT_WIDTH; ++x)
+            {
+                const float sx     = std::min(std::max((x + 0.5f) * scaleX - 0.5f, 0.f), static_cast<float>(UPSCALE_SOURCE_WIDTH - 1));
+                const int   x0     = static_cast<int>(sx);
+                const int   x1     = std::min(x0 + 1, UPSCALE_SOURCE_WIDTH - 1);
+                const float fx     = sx - static_cast<float>(x0);
+                const Vec4f top    = source.GetColor(x0, y0) * (1.f - fx) + source.GetColor(x1, y0) * fx;
+                const Vec4f bottom = source.GetColor(x0, y1) * (1.f - fx) + source.GetColor(x1, y1) * fx;
+                destination.SetColor(x, y, top * (1.f - fy) + bottom * fy);
+            }
+        }
+        DoNotOptimize(destination.GetColorData());
+    }
+    context.itemsProcessed = context.iterations * UPSCALE_OUTPUT_WIDTH * UPSCALE_OUTPUT_HEIGHT;
+}
+
+JOY_BENCHMARK(Upscale_Bilinear)
+{
+    Joy::Benchmark::RunUpscaler(context, nullptr);
+}
+
+JOY_BENCHMARK(Upscale_BilinearThreaded)
+{
+    Joy::ThreadPool threadPool;
+    Joy::Benchmark::RunUpscaler(context, &threadPool);
+}
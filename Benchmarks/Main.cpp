@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief 运行单个基准测试: 自动放大迭代次数使单次运行足够长，重复多次取最短耗时
+     *
+     */
+    void RunBenchmark(const Joy::Benchmark::BenchmarkEntry& entry)
+    {
+        using Clock                      = std::chrono::steady_clock;
+        constexpr double minRunSeconds   = 0.05;
+        constexpr int    repetitionCount = 5;
+
+        Joy::Benchmark::BenchmarkContext context;
+        double                           seconds = 0.0;
+        while (true)
+        {
+            context.itemsProcessed = 0;
+            auto start             = Clock::now();
+            entry.func(context);
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (seconds >= minRunSeconds || context.iterations >= (int64_t{1} << 40))
+            {
+                break;
+            }
+            context.iterations *= seconds > 0.0 ? std::max<int64_t>(2, static_cast<int64_t>(minRunSeconds * 1.2 / seconds)) : 10;
+        }
+
+        double bestSeconds = seconds;
+        for (int repetition = 1; repetition < repetitionCount; ++repetition)
+        {
+            context.itemsProcessed = 0;
+            auto start             = Clock::now();
+            entry.func(context);
+            bestSeconds = std::min(bestSeconds, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        const double nsPerIteration = bestSeconds * 1e9 / static_cast<double>(context.iterations);
+        if (context.itemsProcessed > 0)
+        {
+            std::printf("%-48s %14.2f ns/iter %14.3f M items/s\n", entry.name, nsPerIteration, context.itemsProcessed / bestSeconds * 1e-6);
+        }
+        else
+        {
+            std::printf("%-48s %14.2f ns/iter\n", entry.name, nsPerIteration);
+        }
+    }
+}   // namespace
+
+int main(int argc, char** argv)
+{
+    // 可选参数: 只运行名称包含该子串的基准测试
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    for (const Joy::Benchmark::BenchmarkEntry& entry : Joy::Benchmark::GetRegistry())
+    {
+        if (filter == nullptr || std::strstr(entry.name, filter) != nullptr)
+        {
+            RunBenchmark(entry);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+#include "Math/Mat.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        /**
+         * @brief 模拟每帧需要求逆的实例矩阵数量
+         *
+         */
+        constexpr int INSTANCE_COUNT = 4096;
+
+        /**
+         * @brief 生成随机的刚体变换实例矩阵(绕任意轴旋转 + 平移)
+         *
+         */
+        static const std::vector<Mat4x4f>& GetInstanceMatrices()
+        {
+            static const std::vector<Mat4x4f> matrices = [] {
+                std::mt19937                          random(20251212u);
+                std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+                std::vector<Mat4x4f>                  ret(INSTANCE_COUNT);
+                for (Mat4x4f& mat : ret)
+                {
+                    Vec3f axis  = Normalized(Vec3f{distribution(random), distribution(random), distribution(random) + 2.f});
+                    float angle = distribution(random) * 3.1415926f;
+                    float c     = std::cos(angle);
+                    float s     = std::sin(angle);
+                    float t     = 1.f - c;
+                    float x     = axis.X();
+                    float y     = axis.Y();
+                    float z     = axis.Z();
+                    mat         = MAT4X4F_IDENTITY;
+                    mat[0]      = Vec4f{t * x * x + c, t * x * y + s * z, t * x * z - s * y, 0.f};
+                    mat[1]      = Vec4f{t * x * y - s * z, t * y * y + c, t * y * z + s * x, 0.f};
+                    mat[2]      = Vec4f{t * x * z + s * y, t * y * z - s * x, t * z * z + c, 0.f};
+                    mat[3]      = Vec4f{distribution(random) * 100.f, distribution(random) * 100.f, distribution(random) * 100.f, 1.f};
+                }
+                return ret;
+            }();
+            return matrices;
+        }
+
+        template<typename TInverseFunc> static void RunInverse(BenchmarkContext& context, TInverseFunc&& inverseFunc)
+        {
+            const std::vector<Mat4x4f>& matrices = GetInstanceMatrices();
+            std::vector<Mat4x4f>        results(matrices.size());
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                for (size_t i = 0; i < matrices.size(); ++i)
+                {
+                    results[i] = inverseFunc(matrices[i]);
+                }
+                DoNotOptimize(results.data());
+            }
+            context.itemsProcessed = context.iterations * static_cast<int64_t>(matrices.size());
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(MatInverse_General4x4)
+{
+    Joy::Benchmark::RunInverse(context, [](const Joy::Mat4x4f& mat) { return Joy::Inverse<4, float>(mat); });
+}
+
+JOY_BENCHMARK(MatInverse_Unrolled4x4)
+{
+    Joy::Benchmark::RunInverse(context, [](const Joy::Mat4x4f& mat) { return Joy::Inverse(mat); });
+}
+
+JOY_BENCHMARK(MatInverse_Affine4x4)
+{
+    Joy::Benchmark::RunInverse(context, [](const Joy::Mat4x4f& mat) { return Joy::InverseAffine(mat); });
+}
+
+JOY_BENCHMARK(MatInverse_Rigid4x4)
+{
+    Joy::Benchmark::RunInverse(context, [](const Joy::Mat4x4f& mat) { return Joy::InverseRigid(mat); });
+}
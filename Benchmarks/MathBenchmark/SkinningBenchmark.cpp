@@ -0,0 +1,136 @@
+#include "Benchmark.h"
+#include "Core/Skinning.h"
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int SKIN_VERTEX_COUNT = 16384;
+        constexpr int SKIN_BONE_COUNT   = 64;
+
+        /**
+         * @brief 随机蒙皮数据，每顶点受4根骨骼影响
+         *
+         */
+        struct SkinningData
+        {
+            std::vector<Mat4x4f>        boneMatrices;
+            std::vector<SkinningMatrix> palette;
+            std::vector<float>          positions[3];
+            std::vector<float>          normals[3];
+            std::vector<uint16_t>       indices[MAX_BONE_INFLUENCES];
+            std::vector<float>          weights[MAX_BONE_INFLUENCES];
+        };
+
+        static const SkinningData& GetSkinningData()
+        {
+            static const SkinningData data = [] {
+                std::mt19937                          random(20251213u);
+                std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+                std::uniform_int_distribution<int>    boneDistribution(0, SKIN_BONE_COUNT - 1);
+                SkinningData                          ret;
+                for (int bone = 0; bone < SKIN_BONE_COUNT; ++bone)
+                {
+                    const Vec3f axis = Normalized(Vec3f{distribution(random), distribution(random), distribution(random) + 2.f});
+                    const Quat  rotation = Quat::FromAxisAngle(axis, distribution(random) * 3.1415926f);
+                    const Vec3f translation{distribution(random), distribution(random), distribution(random)};
+                    Mat4x4f     mat = ToMat4x4f(rotation);
+                    mat[3]          = Vec4f{translation.X(), translation.Y(), translation.Z(), 1.f};
+                    ret.boneMatrices.push_back(mat);
+                    ret.palette.push_back(MakeSkinningMatrix(rotation, translation));
+                }
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    ret.positions[axis].resize(SKIN_VERTEX_COUNT);
+                    ret.normals[axis].resize(SKIN_VERTEX_COUNT);
+                }
+                for (int influence = 0; influence < MAX_BONE_INFLUENCES; ++influence)
+                {
+                    ret.indices[influence].resize(SKIN_VERTEX_COUNT);
+                    ret.weights[influence].resize(SKIN_VERTEX_COUNT);
+                }
+                for (int i = 0; i < SKIN_VERTEX_COUNT; ++i)
+                {
+                    float weightSum = 0.f;
+                    for (int influence = 0; influence < MAX_BONE_INFLUENCES; ++influence)
+                    {
+                        ret.indices[influence][i] = static_cast<uint16_t>(boneDistribution(random));
+                        ret.weights[influence][i] = distribution(random) + 1.1f;
+                        weightSum += ret.weights[influence][i];
+                    }
+                    for (int influence = 0; influence < MAX_BONE_INFLUENCES; ++influence)
+                    {
+                        ret.weights[influence][i] /= weightSum;
+                    }
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        ret.positions[axis][i] = distribution(random);
+                        ret.normals[axis][i]   = distribution(random);
+                    }
+                }
+                return ret;
+            }();
+            return data;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(Skinning_NaiveMat4x4)
+{
+    using namespace Joy;
+    const Benchmark::SkinningData& data = Benchmark::GetSkinningData();
+    std::vector<Vec3f>             positions(Benchmark::SKIN_VERTEX_COUNT);
+    std::vector<Vec3f>             normals(Benchmark::SKIN_VERTEX_COUNT);
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        for (int i = 0; i < Benchmark::SKIN_VERTEX_COUNT; ++i)
+        {
+            // 逐顶点混合四阶矩阵后变换(AoS，无SIMD)
+            Mat4x4f blended = data.boneMatrices[data.indices[0][i]] * data.weights[0][i];
+            for (int influence = 1; influence < MAX_BONE_INFLUENCES; ++influence)
+            {
+                blended = blended + data.boneMatrices[data.indices[influence][i]] * data.weights[influence][i];
+            }
+            const Vec4f position = blended * Vec4f{data.positions[0][i], data.positions[1][i], data.positions[2][i], 1.f};
+            const Vec4f normal   = blended * Vec4f{data.normals[0][i], data.normals[1][i], data.normals[2][i], 0.f};
+            positions[i]         = Vec3f{position[0], position[1], position[2]};
+            normals[i]           = Normalized(Vec3f{normal[0], normal[1], normal[2]});
+        }
+        Benchmark::DoNotOptimize(positions.data());
+        Benchmark::DoNotOptimize(normals.data());
+    }
+    context.itemsProcessed = context.iterations * Benchmark::SKIN_VERTEX_COUNT;
+}
+
+JOY_BENCHMARK(Skinning_SoASimd)
+{
+    using namespace Joy;
+    const Benchmark::SkinningData& data = Benchmark::GetSkinningData();
+    SkinningInput                  input;
+    input.vertexCount = Benchmark::SKIN_VERTEX_COUNT;
+    input.positionX   = data.positions[0].data();
+    input.positionY   = data.positions[1].data();
+    input.positionZ   = data.positions[2].data();
+    input.normalX     = data.normals[0].data();
+    input.normalY     = data.normals[1].data();
+    input.normalZ     = data.normals[2].data();
+    for (int influence = 0; influence < MAX_BONE_INFLUENCES; ++influence)
+    {
+        input.boneIndices[influence] = data.indices[influence].data();
+        input.boneWeights[influence] = data.weights[influence].data();
+    }
+    std::vector<float> outputs[6];
+    for (std::vector<float>& output : outputs)
+    {
+        output.resize(Benchmark::SKIN_VERTEX_COUNT);
+    }
+    const SkinningOutput output{outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data(), outputs[4].data(), outputs[5].data()};
+    for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+    {
+        SkinVertices(data.palette.data(), input, output);
+        Benchmark::DoNotOptimize(outputs[0].data());
+    }
+    context.itemsProcessed = context.iterations * Benchmark::SKIN_VERTEX_COUNT;
+}
@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+#include "Math/Expr.h"
+#include "Math/Vec.h"
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace Benchmark
+    {
+        constexpr int EXPR_VEC_COUNT = 4096;
+
+        /**
+         * @brief 随机输入向量 a、b、c
+         *
+         */
+        static const std::vector<Vec4f>& GetExprInputs()
+        {
+            static const std::vector<Vec4f> inputs = [] {
+                std::mt19937                          random(20251214u);
+                std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+                std::vector<Vec4f>                    ret(EXPR_VEC_COUNT * 3);
+                for (Vec4f& vec : ret)
+                {
+                    vec = Vec4f{distribution(random), distribution(random), distribution(random), distribution(random)};
+                }
+                return ret;
+            }();
+            return inputs;
+        }
+
+        /**
+         * @brief 对每组输入计算 a * s + b * t - c
+         *
+         */
+        template<typename TKernel> static void RunExpr(BenchmarkContext& context, TKernel&& kernel)
+        {
+            const std::vector<Vec4f>& inputs = GetExprInputs();
+            std::vector<Vec4f>        results(EXPR_VEC_COUNT);
+            const float               s = 0.75f;
+            const float               t = -1.25f;
+            for (int64_t iteration = 0; iteration < context.iterations; ++iteration)
+            {
+                for (int i = 0; i < EXPR_VEC_COUNT; ++i)
+                {
+                    results[i] = kernel(inputs[i * 3], inputs[i * 3 + 1], inputs[i * 3 + 2], s, t);
+                }
+                DoNotOptimize(results.data());
+            }
+            context.itemsProcessed = context.iterations * EXPR_VEC_COUNT;
+        }
+    }   // namespace Benchmark
+}   // namespace Joy
+
+JOY_BENCHMARK(VecExpr_Eager)
+{
+    Joy::Benchmark::RunExpr(context, [](const Joy::Vec4f& a, const Joy::Vec4f& b, const Joy::Vec4f& c, float s, float t) { return a * s + b * t - c; });
+}
+
+JOY_BENCHMARK(VecExpr_Lazy)
+{
+    Joy::Benchmark::RunExpr(context, [](const Joy::Vec4f& a, const Joy::Vec4f& b, const Joy::Vec4f& c, float s, float t) {
+        return (Joy::Lazy(a) * s + Joy::Lazy(b) * t - Joy::Lazy(c)).Eval();
+    });
+}
+
+JOY_BENCHMARK(VecExpr_MulAdd)
+{
+    Joy::Benchmark::RunExpr(context, [](const Joy::Vec4f& a, const Joy::Vec4f& b, const Joy::Vec4f& c, float s, float t) {
+        return Joy::MulAdd(a, s, Joy::MulAdd(b, t, c * -1.f));
+    });
+}
+
+JOY_BENCHMARK(VecExpr_HandWritten)
+{
+    Joy::Benchmark::RunExpr(context, [](const Joy::Vec4f& a, const Joy::Vec4f& b, const Joy::Vec4f& c, float s, float t) {
+        return Joy::Vec4f{a[0] * s + b[0] * t - c[0], a[1] * s + b[1] * t - c[1], a[2] * s + b[2] * t - c[2], a[3] * s + b[3] * t - c[3]};
+    });
+}
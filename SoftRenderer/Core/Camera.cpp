@@ -1,6 +1,9 @@
-
 #include "Core/Camera.h"
+#include "Math/Transform.h"
 #include "Math/Vec.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
 namespace Joy
 {
@@ -8,20 +11,24 @@ namespace Joy
         : m_CameraType(cameraType)
         , m_Position(position)
         , m_LookPosition(lookPosition)
-        , m_FarPlane(1000.f)
+        , m_WorldPosition(VecCast<double>(position))
+        , m_WorldLookPosition(VecCast<double>(lookPosition))
         , m_NearPlane(0.3f)
+        , m_FarPlane(1000.f)
         , m_UnionParam({cameraType == EnumCameraType::PERSPECTIVE ? 60.f : 5.f})
     {
         UpdateViewMatrix();
         UpdateProjectionMatrix();
     }
 
-    Camera::Camera(EnumCameraType cameraType, const Vec3f& position, const Vec3f& lookPosition, float far, float near, float viewportParam)
+    Camera::Camera(EnumCameraType cameraType, const Vec3f& position, const Vec3f& lookPosition, float near, float far, float viewportParam)
         : m_CameraType(cameraType)
         , m_Position(position)
         , m_LookPosition(lookPosition)
-        , m_FarPlane(1000.f)
-        , m_NearPlane(0.3f)
+        , m_WorldPosition(VecCast<double>(position))
+        , m_WorldLookPosition(VecCast<double>(lookPosition))
+        , m_NearPlane(near)
+        , m_FarPlane(far)
         , m_UnionParam({viewportParam})
     {
         UpdateViewMatrix();
@@ -30,12 +37,73 @@ namespace Joy
 
     void Camera::UpdateViewMatrix()
     {
-        // TODO 计算观察矩阵
-        Vec3f forward = Normalized(m_LookPosition - m_Position);
+        // 朝向在双精度下求差，远离原点时也不受单精度位置的舍入影响
+        const Vec3f forward = GetForward();
+        // 朝向接近竖直时改用Z轴作为参考上方向
+        const Vec3f worldUp = std::abs(forward.Y()) > 0.999f ? Vec3f{0.f, 0.f, 1.f} : Vec3f{0.f, 1.f, 0.f};
+
+        // 相机相对观察矩阵即去掉平移的观察矩阵
+        m_ViewMatrix            = LookTo(m_Position, forward, worldUp);
+        m_RelativeViewMatrix    = m_ViewMatrix;
+        m_RelativeViewMatrix[3] = Vec4f{0.f, 0.f, 0.f, 1.f};
+        ++m_Version;
+    }
+
+    Mat4x4f Camera::GetRelativeModelMatrix(const Mat4x4d& worldModel) const
+    {
+        // 旋转缩放部分数值较小，直接转为单精度；平移在双精度下减去相机位置后再转换
+        Mat4x4f ret = MatCast<float>(worldModel);
+        ret[3]      = Vec4f{static_cast<float>(worldModel[3][0] - m_WorldPosition[0]),
+                            static_cast<float>(worldModel[3][1] - m_WorldPosition[1]),
+                            static_cast<float>(worldModel[3][2] - m_WorldPosition[2]),
+                            static_cast<float>(worldModel[3][3])};
+        return ret;
     }
 
     void Camera::UpdateProjectionMatrix()
     {
-        // TODO 计算投影矩阵
+        assert(m_FarPlane != m_NearPlane && m_Aspect > 0.f);
+        const bool reversed = m_DepthRange == EnumDepthRange::REVERSED;
+        ++m_Version;
+        // 正交投影深度本就线性分布，无穷远平面不适用
+        m_UnjitteredProjectionMatrix = m_CameraType == EnumCameraType::PERSPECTIVE
+                                           ? Perspective(m_UnionParam.fov, m_Aspect, m_NearPlane, m_FarPlane, reversed, m_InfiniteFar)
+                                           : Orthographic(m_UnionParam.size, m_Aspect, m_NearPlane, m_FarPlane, reversed);
+        ApplyJitter();
+    }
+
+    void Camera::ApplyJitter()
+    {
+        // 左乘裁剪空间平移: 第0、1行加上第3行(w)的倍数
+        m_ProjectionMatrix = m_UnjitteredProjectionMatrix;
+        for (int col = 0; col < 4; ++col)
+        {
+            m_ProjectionMatrix[col][0] += m_Jitter.X() * m_ProjectionMatrix[col][3];
+            m_ProjectionMatrix[col][1] += m_Jitter.Y() * m_ProjectionMatrix[col][3];
+        }
+    }
+
+    void Camera::GetFrustumCorners(float distance, Vec3f* corners) const
+    {
+        const Vec3f right{m_ViewMatrix[0][0], m_ViewMatrix[1][0], m_ViewMatrix[2][0]};
+        const Vec3f up{m_ViewMatrix[0][1], m_ViewMatrix[1][1], m_ViewMatrix[2][1]};
+        const Vec3f center     = m_Position + GetForward() * distance;
+        const float halfHeight = m_CameraType == EnumCameraType::PERSPECTIVE ? distance * std::tan(m_UnionParam.fov * 0.5f * 3.14159265f / 180.f)
+                                                                            : m_UnionParam.size;
+        const float halfWidth  = halfHeight * m_Aspect;
+        for (int i = 0; i < 4; ++i)
+        {
+            corners[i] = center + right * ((i & 1) ? halfWidth : -halfWidth) + up * ((i & 2) ? halfHeight : -halfHeight);
+        }
+    }
+
+    float Camera::GetPixelsPerUnit(float distance, int viewportHeight) const
+    {
+        if (m_CameraType == EnumCameraType::ORTHOGRAPHIC)
+        {
+            return static_cast<float>(viewportHeight) / (2.f * m_UnionParam.size);
+        }
+        const float halfHeight = std::max(distance, m_NearPlane) * std::tan(m_UnionParam.fov * 0.5f * 3.14159265f / 180.f);
+        return static_cast<float>(viewportHeight) / (2.f * halfHeight);
     }
-}   // namespace Joy
\ No newline at end of file
+}   // namespace Joy
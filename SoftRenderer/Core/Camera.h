@@ -13,12 +13,14 @@
 
 #include "Math/Mat.h"
 #include "Math/Vec.h"
+#include <cstdint>
 
 namespace Joy
 {
     /**
      * @brief 相机类
      *
+     * 观察空间为右手系(相机朝向-Z，Y轴向上)，投影到x、y在[-w, w]、z在[0, w]的裁剪空间。
      */
     class Camera
     {
@@ -42,6 +44,25 @@ namespace Joy
             ORTHOGRAPHIC = 1,
         };
 
+        /**
+         * @brief 深度映射约定
+         *
+         */
+        enum class EnumDepthRange
+        {
+            /**
+             * @brief 近平面映射到0，远平面映射到1
+             *
+             */
+            STANDARD = 0,
+
+            /**
+             * @brief 反向Z: 近平面映射到1，远平面映射到0，配合浮点深度缓冲使深度精度在远处分布更均匀
+             *
+             */
+            REVERSED = 1,
+        };
+
     public:
         /**
          * @brief 默认构造
@@ -64,35 +85,82 @@ namespace Joy
          * @param cameraType
          * @param position
          * @param lookPosition
-         * @param near
-         * @param far
-         * @param viewportParam
+         * @param near 近平面距离
+         * @param far 远平面距离
+         * @param viewportParam 透视相机为垂直FOV(角度)，正交相机为半高尺寸
          */
         Camera(EnumCameraType cameraType, const Vec3f& position, const Vec3f& lookPosition, float near, float far, float viewportParam);
 
     public:
+        /**
+         * @brief 设置相机类型
+         *
+         * @param cameraType
+         */
+        void SetCameraType(EnumCameraType cameraType)
+        {
+            m_CameraType = cameraType;
+            UpdateProjectionMatrix();
+        }
+
+        /**
+         * @brief 获取相机类型
+         *
+         * @return EnumCameraType
+         */
+        EnumCameraType GetCameraType() const { return m_CameraType; }
+
         /**
          * @brief 设置相机的放置位置
          *
          * @param position
          */
-        void SetPosition(const Vec3f& position)
+        void SetPosition(const Vec3f& position) { SetWorldPosition(VecCast<double>(position)); }
+
+        /**
+         * @brief 设置相机的观察位置
+         *
+         * @param lookPosition
+         */
+        void SetLookPosition(const Vec3f& lookPosition) { SetWorldLookPosition(VecCast<double>(lookPosition)); }
+
+        const Vec3f& GetPosition() const { return m_Position; }
+        const Vec3f& GetLookPosition() const { return m_LookPosition; }
+
+        /**
+         * @brief 以双精度设置相机的世界位置，用于远离原点的大世界场景
+         *
+         * @param position
+         */
+        void SetWorldPosition(const Vec3d& position)
         {
-            m_Position = position;
+            m_WorldPosition = position;
+            m_Position      = VecCast<float>(position);
             UpdateViewMatrix();
         }
 
         /**
-         * @brief 设置相机的观察位置
+         * @brief 以双精度设置相机的观察位置
          *
          * @param lookPosition
          */
-        void SetLookPosition(const Vec3f& lookPosition)
+        void SetWorldLookPosition(const Vec3d& lookPosition)
         {
-            m_LookPosition = lookPosition;
+            m_WorldLookPosition = lookPosition;
+            m_LookPosition      = VecCast<float>(lookPosition);
             UpdateViewMatrix();
         }
 
+        const Vec3d& GetWorldPosition() const { return m_WorldPosition; }
+        const Vec3d& GetWorldLookPosition() const { return m_WorldLookPosition; }
+
+        /**
+         * @brief 获取相机朝向(单位向量)，在双精度下求差，与观察矩阵一致
+         *
+         * @return Vec3f
+         */
+        Vec3f GetForward() const { return VecCast<float>(Normalized(m_WorldLookPosition - m_WorldPosition)); }
+
         /**
          * @brief 获取观察矩阵
          *
@@ -111,6 +179,8 @@ namespace Joy
             UpdateProjectionMatrix();
         }
 
+        float GetNearPlane() const { return m_NearPlane; }
+
         /**
          * @brief 设置远平面
          *
@@ -122,10 +192,12 @@ namespace Joy
             UpdateProjectionMatrix();
         }
 
+        float GetFarPlane() const { return m_FarPlane; }
+
         /**
-         * @brief 设置透视相机的FOV
+         * @brief 设置透视相机的垂直FOV
          *
-         * @param fov
+         * @param fov 角度
          */
         void SetFov(float fov)
         {
@@ -133,8 +205,10 @@ namespace Joy
             UpdateProjectionMatrix();
         }
 
+        float GetFov() const { return m_UnionParam.fov; }
+
         /**
-         * @brief 设置正交相机的对接尺寸
+         * @brief 设置正交相机的尺寸(视口半高)
          *
          * @param size
          */
@@ -144,13 +218,157 @@ namespace Joy
             UpdateProjectionMatrix();
         }
 
+        float GetSize() const { return m_UnionParam.size; }
+
+        /**
+         * @brief 设置深度映射约定
+         *
+         * @param depthRange
+         */
+        void SetDepthRange(EnumDepthRange depthRange)
+        {
+            m_DepthRange = depthRange;
+            UpdateProjectionMatrix();
+        }
+
+        EnumDepthRange GetDepthRange() const { return m_DepthRange; }
+
+        /**
+         * @brief 获取无穷远处的深度值，即渲染前深度缓冲的清除值
+         *
+         * @return float
+         */
+        float GetFarDepth() const { return m_DepthRange == EnumDepthRange::REVERSED ? 0.f : 1.f; }
+
+        /**
+         * @brief 设置透视投影是否使用无穷远平面，开启后远平面只用于阴影等需要有限距离的计算
+         *
+         * @param infiniteFar
+         */
+        void SetInfiniteFar(bool infiniteFar)
+        {
+            m_InfiniteFar = infiniteFar;
+            UpdateProjectionMatrix();
+        }
+
+        bool IsInfiniteFar() const { return m_InfiniteFar; }
+
+        /**
+         * @brief 设置视口宽高比(宽 / 高)
+         *
+         * @param aspect
+         */
+        void SetAspect(float aspect)
+        {
+            m_Aspect = aspect;
+            UpdateProjectionMatrix();
+        }
+
+        float GetAspect() const { return m_Aspect; }
+
+        /**
+         * @brief 设置投影的子像素抖动，用于时间累积抗锯齿
+         *
+         * 抖动以NDC偏移表示，在裁剪空间中平移x、y(x_clip += jitter.x * w_clip)，对透视与正交投影均适用。
+         * 抖动是逐帧的采样偏移而非视图变化，因此不改变版本号。
+         *
+         * @param jitter NDC偏移，像素偏移(px, py)对应(2 * px / width, -2 * py / height)
+         */
+        void SetJitter(const Vec2f& jitter)
+        {
+            m_Jitter = jitter;
+            ApplyJitter();
+        }
+
+        const Vec2f& GetJitter() const { return m_Jitter; }
+
         /**
-         * @brief 获取投影矩阵
+         * @brief 获取投影矩阵(含抖动)
          *
          * @return const Mat4x4f&
          */
         const Mat4x4f& GetProjMatrix() const { return m_ProjectionMatrix; }
 
+        /**
+         * @brief 获取不含抖动的投影矩阵
+         *
+         * @return const Mat4x4f&
+         */
+        const Mat4x4f& GetUnjitteredProjMatrix() const { return m_UnjitteredProjectionMatrix; }
+
+        /**
+         * @brief 获取观察投影矩阵 Proj * View
+         *
+         * @return Mat4x4f
+         */
+        Mat4x4f GetViewProjMatrix() const { return m_ProjectionMatrix * m_ViewMatrix; }
+
+        /**
+         * @brief 获取相机相对空间的观察矩阵，即以相机位置为原点的观察矩阵，只含旋转
+         *
+         * 大世界场景中世界坐标可达数万单位，单精度的绝对观察矩阵与模型矩阵在相乘时两个大平移相互抵消，
+         * 有效位数丢失表现为顶点抖动。相机相对渲染每帧以相机位置为原点重新定基:
+         * 物体平移在双精度下减去相机位置后再转为单精度，着色器使用的矩阵始终只含小数值。
+         *
+         * @return const Mat4x4f&
+         */
+        const Mat4x4f& GetRelativeViewMatrix() const { return m_RelativeViewMatrix; }
+
+        /**
+         * @brief 获取相机相对空间的观察投影矩阵 Proj * RelativeView
+         *
+         * @return Mat4x4f
+         */
+        Mat4x4f GetRelativeViewProjMatrix() const { return m_ProjectionMatrix * m_RelativeViewMatrix; }
+
+        /**
+         * @brief 将双精度世界坐标转换到相机相对空间(世界坐标减去相机位置)
+         *
+         * @param worldPosition
+         * @return Vec3f
+         */
+        Vec3f ToCameraRelative(const Vec3d& worldPosition) const { return VecCast<float>(worldPosition - m_WorldPosition); }
+
+        /**
+         * @brief 将双精度模型矩阵重定基为相机相对空间的单精度模型矩阵
+         *
+         * @param worldModel 双精度模型矩阵(仿射)
+         * @return Mat4x4f
+         */
+        Mat4x4f GetRelativeModelMatrix(const Mat4x4d& worldModel) const;
+
+        /**
+         * @brief 获取相机相对空间的模型观察投影矩阵 Proj * RelativeView * RelativeModel，结果只含单精度小数值
+         *
+         * @param worldModel 双精度模型矩阵(仿射)
+         * @return Mat4x4f
+         */
+        Mat4x4f GetRelativeModelViewProjMatrix(const Mat4x4d& worldModel) const { return GetRelativeViewProjMatrix() * GetRelativeModelMatrix(worldModel); }
+
+        /**
+         * @brief 获取沿朝向距离为distance处的视锥截面四角(世界空间)
+         *
+         * @param distance 观察空间深度
+         * @param corners 输出四角，依次为左下、右下、左上、右上
+         */
+        void GetFrustumCorners(float distance, Vec3f* corners) const;
+
+        /**
+         * @brief 获取观察空间深度distance处单位世界长度投影到屏幕上的像素数，用于屏幕空间误差估计
+         *
+         * @param distance 观察空间深度，透视相机下不小于近平面
+         * @param viewportHeight 视口高度(像素)
+         * @return float
+         */
+        float GetPixelsPerUnit(float distance, int viewportHeight) const;
+
+        /**
+         * @brief 获取相机版本号，观察或投影矩阵每次更新时递增，用于判断缓存的渲染结果是否失效
+         *
+         * @return uint32_t
+         */
+        uint32_t GetVersion() const { return m_Version; }
+
     private:
         /**
          * @brief 更新相机的观察变换矩阵
@@ -164,48 +382,108 @@ namespace Joy
          */
         void UpdateProjectionMatrix();
 
+        /**
+         * @brief 将抖动叠加到投影矩阵
+         *
+         */
+        void ApplyJitter();
+
     private:
         /**
          * @brief 相机类型
          *
          */
-        EnumCameraType m_CameraType;
+        EnumCameraType m_CameraType = EnumCameraType::PERSPECTIVE;
 
         /**
          * @brief 相机位置
          *
          */
-        Vec3f m_Position;
+        Vec3f m_Position{0.f, 0.f, 0.f};
 
         /**
          * @brief 相机的视点
          *
          */
-        Vec3f m_LookPosition;
+        Vec3f m_LookPosition{0.f, 0.f, -1.f};
+
+        /**
+         * @brief 相机位置(双精度)，m_Position为其单精度副本
+         *
+         */
+        Vec3d m_WorldPosition{0.0, 0.0, 0.0};
+
+        /**
+         * @brief 相机的视点(双精度)
+         *
+         */
+        Vec3d m_WorldLookPosition{0.0, 0.0, -1.0};
 
         /**
          * @brief 相机观察变换矩阵
          *
          */
-        Mat4x4f m_ViewMatrix;
+        Mat4x4f m_ViewMatrix = MAT4X4F_IDENTITY;
+
+        /**
+         * @brief 以相机位置为原点的观察矩阵
+         *
+         */
+        Mat4x4f m_RelativeViewMatrix = MAT4X4F_IDENTITY;
 
         /**
          * @brief 相机投影变换矩阵
          *
          */
-        Mat4x4f m_ProjectionMatrix;
+        Mat4x4f m_ProjectionMatrix = MAT4X4F_IDENTITY;
+
+        /**
+         * @brief 不含抖动的投影变换矩阵
+         *
+         */
+        Mat4x4f m_UnjitteredProjectionMatrix = MAT4X4F_IDENTITY;
+
+        /**
+         * @brief 投影抖动(NDC偏移)
+         *
+         */
+        Vec2f m_Jitter{0.f, 0.f};
 
         /**
          * @brief 近平面
          *
          */
-        float m_NearPlane;
+        float m_NearPlane = 0.3f;
 
         /**
          * @brief 远平面
          *
          */
-        float m_FarPlane;
+        float m_FarPlane = 1000.f;
+
+        /**
+         * @brief 视口宽高比
+         *
+         */
+        float m_Aspect = 1.f;
+
+        /**
+         * @brief 深度映射约定
+         *
+         */
+        EnumDepthRange m_DepthRange = EnumDepthRange::STANDARD;
+
+        /**
+         * @brief 透视投影是否使用无穷远平面
+         *
+         */
+        bool m_InfiniteFar = false;
+
+        /**
+         * @brief 矩阵版本号
+         *
+         */
+        uint32_t m_Version = 0;
 
         union
         {
@@ -216,10 +494,10 @@ namespace Joy
             float fov;
 
             /**
-             * @brief 宽高比(正交相机专属)
+             * @brief 视口半高(正交相机专属)
              *
              */
             float size;
-        } m_UnionParam;
+        } m_UnionParam{60.f};
     };
 }   // namespace Joy
\ No newline at end of file
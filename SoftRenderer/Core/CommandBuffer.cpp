@@ -0,0 +1,160 @@
+#include "Core/CommandBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 按位比较相机状态，只有完全相同的相机才合并，避免回放时用了相近相机的矩阵
+         *
+         */
+        bool IsSameCamera(const CommandBuffer::CameraState& lhs, const CommandBuffer::CameraState& rhs)
+        {
+            return std::memcmp(&lhs.viewProj[0][0], &rhs.viewProj[0][0], sizeof(float) * 16) == 0 &&
+                   std::memcmp(&lhs.depthRow[0], &rhs.depthRow[0], sizeof(float) * 4) == 0;
+        }
+    }   // namespace
+
+    void CommandBuffer::Reset()
+    {
+        m_Cameras.clear();
+        m_Meshes.clear();
+        m_Shaders.clear();
+        m_Draws.clear();
+    }
+
+    void CommandBuffer::SetCamera(const Camera& camera)
+    {
+        const Mat4x4f& view = camera.GetViewMatrix();
+        const CameraState state{camera.GetViewProjMatrix(), Vec4f{-view[0][2], -view[1][2], -view[2][2], -view[3][2]}};
+        if (m_Cameras.empty() || !IsSameCamera(m_Cameras.back(), state))
+        {
+            m_Cameras.push_back(state);
+        }
+    }
+
+    void CommandBuffer::BindMesh(const Mesh& mesh)
+    {
+        if (m_Meshes.empty() || m_Meshes.back() != &mesh)
+        {
+            m_Meshes.push_back(&mesh);
+        }
+    }
+
+    void CommandBuffer::Draw(const Mat4x4f& model)
+    {
+        assert(!m_Cameras.empty() && !m_Meshes.empty() && !m_Shaders.empty());
+        const Vec4f& depthRow = m_Cameras.back().depthRow;
+        const float  depth    = depthRow[0] * model[3][0] + depthRow[1] * model[3][1] + depthRow[2] * model[3][2] + depthRow[3] * model[3][3];
+        m_Draws.push_back(DrawCommand{static_cast<uint32_t>(m_Cameras.size() - 1),
+                                      static_cast<uint32_t>(m_Meshes.size() - 1),
+                                      static_cast<uint32_t>(m_Shaders.size() - 1),
+                                      depth,
+                                      model});
+    }
+
+    void CommandQueue::Execute(Renderer& renderer)
+    {
+        // 将各命令缓冲的局部绑定编号映射为按首次出现顺序的全局编号
+        std::vector<CommandBuffer::CameraState>   cameras;
+        std::vector<const Mesh*>                  meshes;
+        std::vector<CommandBuffer::ShaderBinding> shaders;
+        std::unordered_map<const void*, uint32_t> meshIds;
+        std::unordered_map<const void*, uint32_t> shaderIds;
+        std::vector<uint32_t>                     cameraRemap;
+        std::vector<uint32_t>                     meshRemap;
+        std::vector<uint32_t>                     shaderRemap;
+        m_Items.clear();
+        for (uint32_t bufferIndex = 0; bufferIndex < m_Buffers.size(); ++bufferIndex)
+        {
+            const CommandBuffer& buffer = *m_Buffers[bufferIndex];
+            cameraRemap.clear();
+            for (const CommandBuffer::CameraState& camera : buffer.GetCameras())
+            {
+                const auto found = std::find_if(cameras.begin(), cameras.end(), [&](const CommandBuffer::CameraState& other) {
+                    return IsSameCamera(other, camera);
+                });
+                cameraRemap.push_back(static_cast<uint32_t>(found - cameras.begin()));
+                if (found == cameras.end())
+                {
+                    cameras.push_back(camera);
+                }
+            }
+            meshRemap.clear();
+            for (const Mesh* mesh : buffer.GetMeshes())
+            {
+                const auto inserted = meshIds.emplace(mesh, static_cast<uint32_t>(meshes.size()));
+                if (inserted.second)
+                {
+                    meshes.push_back(mesh);
+                }
+                meshRemap.push_back(inserted.first->second);
+            }
+            shaderRemap.clear();
+            for (const CommandBuffer::ShaderBinding& shader : buffer.GetShaders())
+            {
+                const auto inserted = shaderIds.emplace(shader.shader, static_cast<uint32_t>(shaders.size()));
+                if (inserted.second)
+                {
+                    shaders.push_back(shader);
+                }
+                assert(shaders[inserted.first->second].draw == shader.draw);
+                shaderRemap.push_back(inserted.first->second);
+            }
+
+            const std::vector<CommandBuffer::DrawCommand>& draws = buffer.GetDraws();
+            for (uint32_t command = 0; command < draws.size(); ++command)
+            {
+                const CommandBuffer::DrawCommand& draw = draws[command];
+                m_Items.push_back(SortItem{cameraRemap[draw.camera], shaderRemap[draw.shader], meshRemap[draw.mesh], draw.depth, bufferIndex, command});
+            }
+        }
+
+        std::sort(m_Items.begin(), m_Items.end(), [](const SortItem& lhs, const SortItem& rhs) {
+            if (lhs.camera != rhs.camera)
+            {
+                return lhs.camera < rhs.camera;
+            }
+            if (lhs.shader != rhs.shader)
+            {
+                return lhs.shader < rhs.shader;
+            }
+            if (lhs.mesh != rhs.mesh)
+            {
+                return lhs.mesh < rhs.mesh;
+            }
+            if (lhs.depth != rhs.depth)
+            {
+                return lhs.depth < rhs.depth;
+            }
+            if (lhs.buffer != rhs.buffer)
+            {
+                return lhs.buffer < rhs.buffer;
+            }
+            return lhs.command < rhs.command;
+        });
+
+        // 状态相同的相邻绘制合并为一个批次
+        m_Batches.clear();
+        m_Models.clear();
+        for (size_t i = 0; i < m_Items.size(); ++i)
+        {
+            const SortItem& item = m_Items[i];
+            if (i == 0 || item.camera != m_Items[i - 1].camera || item.shader != m_Items[i - 1].shader || item.mesh != m_Items[i - 1].mesh)
+            {
+                m_Batches.push_back(Batch{cameras[item.camera].viewProj, meshes[item.mesh], shaders[item.shader], static_cast<int>(m_Models.size()), 0});
+            }
+            m_Models.push_back(m_Buffers[item.buffer]->GetDraws()[item.command].model);
+            ++m_Batches.back().modelCount;
+        }
+
+        for (const Batch& batch : m_Batches)
+        {
+            batch.shader.draw(renderer, *batch.mesh, batch.shader.shader, batch.viewProj, &m_Models[batch.firstModel], batch.modelCount);
+        }
+        m_Buffers.clear();
+    }
+}   // namespace Joy
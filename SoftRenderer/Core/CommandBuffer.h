@@ -0,0 +1,230 @@
+/**
+ * @file CommandBuffer.h
+ * @author JoyatY
+ * @brief 绘制命令录制与按状态、深度排序的回放
+ * @version 0.1
+ * @date 2025-12-24
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/Camera.h"
+#include "Core/Mesh.h"
+#include "Core/Renderer.h"
+#include "Math/Mat.h"
+#include "Math/Vec.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 绘制命令缓冲: 录制相机、网格、着色器绑定与绘制命令，不访问渲染器
+     *
+     * 每个线程录制各自的命令缓冲即可并行，录制期间不共享任何状态。命令缓冲只保存网格与着色器的指针，
+     * 它们须在回放结束前保持有效；未调用Reset的命令缓冲可在多帧间重复提交，静态场景无需每帧重新录制。
+     *
+     * 着色器约定与Renderer::DrawInstanced相同: Vertex返回模型空间位置，由Draw给出的模型矩阵与相机的ViewProj变换到裁剪空间。
+     */
+    class CommandBuffer
+    {
+    public:
+        /**
+         * @brief 以类型擦除方式调用Renderer::DrawInstanced
+         *
+         */
+        using DrawFunc = void (*)(Renderer& renderer, const Mesh& mesh, const void* shader, const Mat4x4f& viewProj, const Mat4x4f* models, int count);
+
+        /**
+         * @brief 着色器绑定
+         *
+         */
+        struct ShaderBinding
+        {
+            const void* shader;
+            DrawFunc    draw;
+        };
+
+        /**
+         * @brief 相机状态
+         *
+         */
+        struct CameraState
+        {
+            Mat4x4f viewProj;
+
+            /**
+             * @brief 观察矩阵的第三行取负，与世界位置点乘得到沿视线方向的深度
+             *
+             */
+            Vec4f depthRow;
+        };
+
+        /**
+         * @brief 绘制命令，引用录制时的绑定状态
+         *
+         */
+        struct DrawCommand
+        {
+            uint32_t camera;
+            uint32_t mesh;
+            uint32_t shader;
+
+            /**
+             * @brief 模型原点沿视线方向的深度，用于排序
+             *
+             */
+            float   depth;
+            Mat4x4f model;
+        };
+
+    public:
+        CommandBuffer() = default;
+
+    public:
+        /**
+         * @brief 清空已录制的命令与绑定
+         *
+         */
+        void Reset();
+
+        /**
+         * @brief 设置后续绘制使用的相机，记录其当前的ViewProj与观察矩阵
+         *
+         * @param camera
+         */
+        void SetCamera(const Camera& camera);
+
+        /**
+         * @brief 绑定后续绘制使用的网格
+         *
+         * @param mesh 须在回放结束前保持有效
+         */
+        void BindMesh(const Mesh& mesh);
+
+        /**
+         * @brief 绑定后续绘制使用的着色器
+         *
+         * @tparam TShader 着色器类型
+         * @param shader 须在回放结束前保持有效
+         */
+        template<typename TShader> void BindShader(const TShader& shader)
+        {
+            const ShaderBinding binding{&shader, &DrawShader<TShader>};
+            if (m_Shaders.empty() || m_Shaders.back().shader != binding.shader || m_Shaders.back().draw != binding.draw)
+            {
+                m_Shaders.push_back(binding);
+            }
+        }
+
+        /**
+         * @brief 以当前绑定的相机、网格与着色器绘制一个实例
+         *
+         * @param model 模型矩阵
+         */
+        void Draw(const Mat4x4f& model);
+
+        size_t GetDrawCount() const { return m_Draws.size(); }
+
+        const std::vector<CameraState>&   GetCameras() const { return m_Cameras; }
+        const std::vector<const Mesh*>&   GetMeshes() const { return m_Meshes; }
+        const std::vector<ShaderBinding>& GetShaders() const { return m_Shaders; }
+        const std::vector<DrawCommand>&   GetDraws() const { return m_Draws; }
+
+    private:
+        template<typename TShader>
+        static void DrawShader(Renderer& renderer, const Mesh& mesh, const void* shader, const Mat4x4f& viewProj, const Mat4x4f* models, int count)
+        {
+            renderer.DrawInstanced(mesh, *static_cast<const TShader*>(shader), viewProj, models, count);
+        }
+
+    private:
+        /**
+         * @brief 录制过程中绑定过的状态，连续重复的绑定只保存一次
+         *
+         */
+        std::vector<CameraState>   m_Cameras;
+        std::vector<const Mesh*>   m_Meshes;
+        std::vector<ShaderBinding> m_Shaders;
+        std::vector<DrawCommand>   m_Draws;
+    };
+
+    /**
+     * @brief 命令队列: 合并多个命令缓冲，按状态与深度排序后回放
+     *
+     * 排序键依次为相机、着色器、网格、深度(由近及远)，最后以提交顺序与录制顺序保证全序，
+     * 回放结果与命令缓冲的划分方式和录制线程的调度无关。相机、着色器与网格按首次出现的顺序编号，
+     * 因此多个相机(如阴影与主视图)按提交顺序依次回放。状态相同的连续绘制合并为一次实例化绘制，顶点着色只执行一次。
+     */
+    class CommandQueue
+    {
+    public:
+        /**
+         * @brief 一次实例化绘制
+         *
+         */
+        struct Batch
+        {
+            Mat4x4f                      viewProj;
+            const Mesh*                  mesh;
+            CommandBuffer::ShaderBinding shader;
+            int                          firstModel;
+            int                          modelCount;
+        };
+
+    public:
+        CommandQueue() = default;
+
+    public:
+        /**
+         * @brief 提交命令缓冲，须在Execute前保持有效且不再录制
+         *
+         * @param buffer
+         */
+        void Submit(const CommandBuffer& buffer) { m_Buffers.push_back(&buffer); }
+
+        /**
+         * @brief 排序并回放所有已提交的命令缓冲，结束后清空提交列表
+         *
+         * @param renderer 渲染目标
+         */
+        void Execute(Renderer& renderer);
+
+        /**
+         * @brief 最近一次Execute回放的批次与按回放顺序排列的模型矩阵
+         *
+         */
+        const std::vector<Batch>&   GetBatches() const { return m_Batches; }
+        const std::vector<Mat4x4f>& GetBatchModels() const { return m_Models; }
+
+    private:
+        /**
+         * @brief 排序项
+         *
+         */
+        struct SortItem
+        {
+            uint32_t camera;
+            uint32_t shader;
+            uint32_t mesh;
+            float    depth;
+            uint32_t buffer;
+            uint32_t command;
+        };
+
+    private:
+        std::vector<const CommandBuffer*> m_Buffers;
+
+        /**
+         * @brief 排序与回放缓存，在多次执行间复用
+         *
+         */
+        std::vector<SortItem> m_Items;
+        std::vector<Batch>    m_Batches;
+        std::vector<Mat4x4f>  m_Models;
+    };
+}   // namespace Joy
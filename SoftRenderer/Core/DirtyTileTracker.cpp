@@ -0,0 +1,235 @@
+#include "Core/DirtyTileTracker.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 按位比较变换，任何微小移动都视为变化
+         *
+         */
+        bool IsSameTransform(const Mat4x4f& lhs, const Mat4x4f& rhs)
+        {
+            return std::memcmp(&lhs[0][0], &rhs[0][0], sizeof(float) * 16) == 0;
+        }
+
+        bool IsSameRect(const RasterRect& lhs, const RasterRect& rhs)
+        {
+            return lhs.minX == rhs.minX && lhs.minY == rhs.minY && lhs.maxX == rhs.maxX && lhs.maxY == rhs.maxY;
+        }
+    }   // namespace
+
+    DirtyTileTracker::DirtyTileTracker(int width, int height)
+        : m_Width(width)
+        , m_Height(height)
+        , m_TileCountX((width + FrameBuffer::TILE_SIZE - 1) / FrameBuffer::TILE_SIZE)
+        , m_TileCountY((height + FrameBuffer::TILE_SIZE - 1) / FrameBuffer::TILE_SIZE)
+        , m_DirtyTiles(static_cast<size_t>(m_TileCountX) * m_TileCountY, 0)
+        , m_DirtyTileCount(0)
+        , m_DirtyRects()
+        , m_Objects()
+        , m_ViewVersion(0)
+        , m_HasViewVersion(false)
+        , m_FrameIndex(0)
+    {
+        assert(width > 0 && height > 0);
+    }
+
+    void DirtyTileTracker::BeginFrame(uint32_t viewVersion)
+    {
+        ++m_FrameIndex;
+        std::fill(m_DirtyTiles.begin(), m_DirtyTiles.end(), static_cast<uint8_t>(0));
+        m_DirtyTileCount = 0;
+        m_DirtyRects.clear();
+        if (!m_HasViewVersion || viewVersion != m_ViewVersion)
+        {
+            InvalidateAll();
+        }
+        m_ViewVersion    = viewVersion;
+        m_HasViewVersion = true;
+    }
+
+    void DirtyTileTracker::SubmitObject(uint32_t objectId, const Mat4x4f& transform, uint32_t contentVersion, const RasterRect& screenBounds)
+    {
+        auto iter = m_Objects.find(objectId);
+        if (iter == m_Objects.end())
+        {
+            m_Objects.emplace(objectId, ObjectState{transform, contentVersion, screenBounds, m_FrameIndex});
+            MarkDirty(screenBounds);
+            return;
+        }
+        ObjectState& state = iter->second;
+        if (!IsSameTransform(state.transform, transform) || state.contentVersion != contentVersion || !IsSameRect(state.bounds, screenBounds))
+        {
+            MarkDirty(state.bounds);
+            MarkDirty(screenBounds);
+            state.transform      = transform;
+            state.contentVersion = contentVersion;
+            state.bounds         = screenBounds;
+        }
+        state.frameIndex = m_FrameIndex;
+    }
+
+    void DirtyTileTracker::EndFrame()
+    {
+        for (auto iter = m_Objects.begin(); iter != m_Objects.end();)
+        {
+            if (iter->second.frameIndex != m_FrameIndex)
+            {
+                MarkDirty(iter->second.bounds);
+                iter = m_Objects.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+        BuildDirtyRects();
+    }
+
+    void DirtyTileTracker::InvalidateAll()
+    {
+        std::fill(m_DirtyTiles.begin(), m_DirtyTiles.end(), static_cast<uint8_t>(1));
+        m_DirtyTileCount = m_TileCountX * m_TileCountY;
+    }
+
+    void DirtyTileTracker::MarkDirty(const RasterRect& rect)
+    {
+        const int minX = std::max(rect.minX, 0);
+        const int minY = std::max(rect.minY, 0);
+        const int maxX = std::min(rect.maxX, m_Width);
+        const int maxY = std::min(rect.maxY, m_Height);
+        if (minX >= maxX || minY >= maxY)
+        {
+            return;
+        }
+        for (int tileY = minY / FrameBuffer::TILE_SIZE; tileY <= (maxY - 1) / FrameBuffer::TILE_SIZE; ++tileY)
+        {
+            for (int tileX = minX / FrameBuffer::TILE_SIZE; tileX <= (maxX - 1) / FrameBuffer::TILE_SIZE; ++tileX)
+            {
+                MarkTile(tileY * m_TileCountX + tileX);
+            }
+        }
+    }
+
+    bool DirtyTileTracker::Intersects(const RasterRect& rect) const
+    {
+        const int minX = std::max(rect.minX, 0);
+        const int minY = std::max(rect.minY, 0);
+        const int maxX = std::min(rect.maxX, m_Width);
+        const int maxY = std::min(rect.maxY, m_Height);
+        if (minX >= maxX || minY >= maxY)
+        {
+            return false;
+        }
+        for (int tileY = minY / FrameBuffer::TILE_SIZE; tileY <= (maxY - 1) / FrameBuffer::TILE_SIZE; ++tileY)
+        {
+            for (int tileX = minX / FrameBuffer::TILE_SIZE; tileX <= (maxX - 1) / FrameBuffer::TILE_SIZE; ++tileX)
+            {
+                if (IsTileDirty(tileX, tileY))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void DirtyTileTracker::BuildDirtyRects()
+    {
+        // 每行分块先合并为水平连续段，再与上一行跨度相同的矩形纵向合并
+        m_DirtyRects.clear();
+        std::vector<size_t> openRects;
+        std::vector<size_t> nextOpenRects;
+        for (int tileY = 0; tileY < m_TileCountY; ++tileY)
+        {
+            const int minY = tileY * FrameBuffer::TILE_SIZE;
+            const int maxY = std::min(minY + FrameBuffer::TILE_SIZE, m_Height);
+            nextOpenRects.clear();
+            for (int tileX = 0; tileX < m_TileCountX;)
+            {
+                if (!IsTileDirty(tileX, tileY))
+                {
+                    ++tileX;
+                    continue;
+                }
+                const int runBegin = tileX;
+                while (tileX < m_TileCountX && IsTileDirty(tileX, tileY))
+                {
+                    ++tileX;
+                }
+                const int minX   = runBegin * FrameBuffer::TILE_SIZE;
+                const int maxX   = std::min(tileX * FrameBuffer::TILE_SIZE, m_Width);
+                size_t    target = m_DirtyRects.size();
+                for (size_t index : openRects)
+                {
+                    if (m_DirtyRects[index].minX == minX && m_DirtyRects[index].maxX == maxX)
+                    {
+                        target = index;
+                        break;
+                    }
+                }
+                if (target == m_DirtyRects.size())
+                {
+                    m_DirtyRects.push_back(RasterRect{minX, minY, maxX, maxY});
+                }
+                else
+                {
+                    m_DirtyRects[target].maxY = maxY;
+                }
+                nextOpenRects.push_back(target);
+            }
+            openRects.swap(nextOpenRects);
+        }
+    }
+
+    RasterRect DirtyTileTracker::ComputeScreenBounds(const Vec3f& boundsMin, const Vec3f& boundsMax, const Mat4x4f& modelViewProj, int width,
+                                                     int height)
+    {
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const Vec4f position{(corner & 1) ? boundsMax.X() : boundsMin.X(),
+                                 (corner & 2) ? boundsMax.Y() : boundsMin.Y(),
+                                 (corner & 4) ? boundsMax.Z() : boundsMin.Z(),
+                                 1.f};
+            const Vec4f clip = modelViewProj * position;
+            if (clip[3] <= 1e-6f)
+            {
+                return RasterRect{0, 0, width, height};
+            }
+            const float invW = 1.f / clip[3];
+            minX             = std::min(minX, clip[0] * invW);
+            minY             = std::min(minY, clip[1] * invW);
+            maxX             = std::max(maxX, clip[0] * invW);
+            maxY             = std::max(maxY, clip[1] * invW);
+        }
+        // 限制到略大于NDC的范围，避免接近相机的角点在转换为整数时溢出
+        minX = std::max(minX, -2.f);
+        minY = std::max(minY, -2.f);
+        maxX = std::min(maxX, 2.f);
+        maxY = std::min(maxY, 2.f);
+        // 视口变换(屏幕y轴向下)，各向外扩一个像素以覆盖子像素吸附与多重采样偏移
+        RasterRect ret{static_cast<int>(std::floor((minX * 0.5f + 0.5f) * static_cast<float>(width))) - 1,
+                       static_cast<int>(std::floor((0.5f - maxY * 0.5f) * static_cast<float>(height))) - 1,
+                       static_cast<int>(std::ceil((maxX * 0.5f + 0.5f) * static_cast<float>(width))) + 1,
+                       static_cast<int>(std::ceil((0.5f - minY * 0.5f) * static_cast<float>(height))) + 1};
+        ret.minX = std::max(ret.minX, 0);
+        ret.minY = std::max(ret.minY, 0);
+        ret.maxX = std::min(ret.maxX, width);
+        ret.maxY = std::min(ret.maxY, height);
+        if (ret.minX >= ret.maxX || ret.minY >= ret.maxY)
+        {
+            return RasterRect{0, 0, 0, 0};
+        }
+        return ret;
+    }
+}   // namespace Joy
@@ -0,0 +1,163 @@
+/**
+ * @file DirtyTileTracker.h
+ * @author JoyatY
+ * @brief 增量重绘的脏分块追踪
+ * @version 0.1
+ * @date 2025-12-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include "Core/Rasterizer.h"
+#include "Math/Mat.h"
+#include "Math/Vec.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 脏分块追踪器
+     *
+     * 以FrameBuffer::TILE_SIZE为粒度记录两帧之间发生变化的屏幕区域。每帧的使用流程:
+     * @code
+     * tracker.BeginFrame(camera.GetVersion());
+     * tracker.SubmitObject(id, model, contentVersion, bounds);   // 对每个物体
+     * tracker.EndFrame();
+     * renderer.RenderDirtyRegions(tracker, drawScene);
+     * @endcode
+     * 相机版本变化时整帧失效；物体变换、内容版本或屏幕包围盒变化时，其新旧包围盒覆盖的分块失效；
+     * 本帧未提交的物体视为已移除，其旧包围盒覆盖的分块失效。
+     */
+    class DirtyTileTracker
+    {
+    public:
+        /**
+         * @brief 构造追踪器
+         *
+         * @param width 渲染宽度(像素)
+         * @param height 渲染高度(像素)
+         */
+        DirtyTileTracker(int width, int height);
+
+    public:
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+        int GetTileCountX() const { return m_TileCountX; }
+        int GetTileCountY() const { return m_TileCountY; }
+
+        /**
+         * @brief 开始新的一帧，清空上一帧的脏标记
+         *
+         * @param viewVersion 视图版本号(通常为Camera::GetVersion)，与上一帧不同时整帧失效
+         */
+        void BeginFrame(uint32_t viewVersion);
+
+        /**
+         * @brief 提交本帧的一个物体
+         *
+         * @param objectId 物体的唯一标识
+         * @param transform 物体的模型变换，按位比较
+         * @param contentVersion 物体的内容版本号(网格、材质等)，变化时视为脏
+         * @param screenBounds 物体在屏幕上的保守包围盒
+         */
+        void SubmitObject(uint32_t objectId, const Mat4x4f& transform, uint32_t contentVersion, const RasterRect& screenBounds);
+
+        /**
+         * @brief 结束本帧的提交，处理已移除的物体并生成脏矩形
+         *
+         */
+        void EndFrame();
+
+        /**
+         * @brief 将整帧标记为脏，例如渲染目标尺寸或清除值发生变化时
+         *
+         */
+        void InvalidateAll();
+
+        /**
+         * @brief 将矩形覆盖的分块标记为脏
+         *
+         * @param rect
+         */
+        void MarkDirty(const RasterRect& rect);
+
+        bool IsTileDirty(int tileX, int tileY) const { return m_DirtyTiles[tileY * m_TileCountX + tileX] != 0; }
+        int  GetDirtyTileCount() const { return m_DirtyTileCount; }
+        bool IsFullFrameDirty() const { return m_DirtyTileCount == m_TileCountX * m_TileCountY; }
+
+        /**
+         * @brief 判断矩形是否与任一脏分块相交，用于跳过无需重绘的物体
+         *
+         * @param rect
+         * @return true
+         * @return false
+         */
+        bool Intersects(const RasterRect& rect) const;
+
+        /**
+         * @brief 获取EndFrame合并得到的脏矩形，已对齐到分块并裁剪到屏幕内，互不重叠
+         *
+         * @return const std::vector<RasterRect>&
+         */
+        const std::vector<RasterRect>& GetDirtyRects() const { return m_DirtyRects; }
+
+        /**
+         * @brief 计算包围盒在屏幕上的保守投影范围
+         *
+         * 任一角点位于相机后方(w <= 0)时返回整个屏幕。
+         *
+         * @param boundsMin 模型空间包围盒最小点
+         * @param boundsMax 模型空间包围盒最大点
+         * @param modelViewProj 模型到裁剪空间的变换
+         * @param width 渲染宽度(像素)
+         * @param height 渲染高度(像素)
+         * @return RasterRect 空矩形表示完全位于屏幕外
+         */
+        static RasterRect ComputeScreenBounds(const Vec3f& boundsMin, const Vec3f& boundsMax, const Mat4x4f& modelViewProj, int width, int height);
+
+    private:
+        /**
+         * @brief 物体上一次提交的状态
+         *
+         */
+        struct ObjectState
+        {
+            Mat4x4f    transform;
+            uint32_t   contentVersion;
+            RasterRect bounds;
+            uint32_t   frameIndex;
+        };
+
+        void MarkTile(int tileIndex)
+        {
+            m_DirtyTileCount += m_DirtyTiles[tileIndex] == 0 ? 1 : 0;
+            m_DirtyTiles[tileIndex] = 1;
+        }
+
+        void BuildDirtyRects();
+
+    private:
+        int                                       m_Width;
+        int                                       m_Height;
+        int                                       m_TileCountX;
+        int                                       m_TileCountY;
+        std::vector<uint8_t>                      m_DirtyTiles;
+        int                                       m_DirtyTileCount;
+        std::vector<RasterRect>                   m_DirtyRects;
+        std::unordered_map<uint32_t, ObjectState> m_Objects;
+
+        /**
+         * @brief 上一帧的视图版本号，首帧前无效
+         *
+         */
+        uint32_t m_ViewVersion;
+        bool     m_HasViewVersion;
+        uint32_t m_FrameIndex;
+    };
+}   // namespace Joy
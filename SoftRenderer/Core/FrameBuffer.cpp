@@ -0,0 +1,208 @@
+#include "Core/FrameBuffer.h"
+#include "Core/TileSchedule.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace Joy
+{
+    FrameBuffer::FrameBuffer(int width, int height, EnumColorFormat colorFormat, EnumDepthFormat depthFormat)
+        : m_Width(width)
+        , m_Height(height)
+        , m_TileCountX((width + TILE_SIZE - 1) / TILE_SIZE)
+        , m_TileCountY((height + TILE_SIZE - 1) / TILE_SIZE)
+        , m_ColorFormat(colorFormat)
+        , m_DepthFormat(depthFormat)
+        , m_ColorData(new uint8_t[static_cast<size_t>(width) * height * GetBytesPerPixel(colorFormat)])
+        , m_ExternalColorData(nullptr)
+        , m_DepthData(new uint8_t[static_cast<size_t>(width) * height * GetBytesPerPixel(depthFormat)])
+        , m_TileFlags(static_cast<size_t>(m_TileCountX) * m_TileCountY, 0)
+        , m_ClearColor()
+        , m_PackedClearColor()
+        , m_ClearDepth(1.f)
+        , m_PackedClearDepth(0)
+    {
+        assert(width > 0 && height > 0);
+        ClearColor(Vec4f{0.f, 0.f, 0.f, 1.f});
+        ClearDepth(1.f);
+    }
+
+    void FrameBuffer::ClearColor(const Vec4f& color)
+    {
+        m_ClearColor = color;
+        PackColor(m_ColorFormat, color, m_PackedClearColor);
+        for (uint8_t& flags : m_TileFlags)
+        {
+            flags |= TILE_FLAG_COLOR_CLEARED;
+        }
+    }
+
+    void FrameBuffer::BindColorStorage(uint8_t* colorData)
+    {
+        m_ExternalColorData = colorData;
+        if (colorData != nullptr)
+        {
+            m_ColorData.reset();
+        }
+        else
+        {
+            m_ColorData.reset(new uint8_t[static_cast<size_t>(m_Width) * m_Height * GetBytesPerPixel(m_ColorFormat)]);
+        }
+        // 新存储的内容未知，全部颜色分块回到清除状态
+        for (uint8_t& flags : m_TileFlags)
+        {
+            flags |= TILE_FLAG_COLOR_CLEARED;
+        }
+    }
+
+    void FrameBuffer::ClearDepth(float depth)
+    {
+        m_ClearDepth       = depth;
+        m_PackedClearDepth = PackDepth(m_DepthFormat, depth);
+        for (uint8_t& flags : m_TileFlags)
+        {
+            flags |= TILE_FLAG_DEPTH_CLEARED;
+        }
+    }
+
+    Vec4f FrameBuffer::GetColor(int x, int y) const
+    {
+        assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+        if (m_TileFlags[GetTileIndex(x, y)] & TILE_FLAG_COLOR_CLEARED)
+        {
+            return UnpackColor(m_ColorFormat, m_PackedClearColor);
+        }
+        const int bytesPerPixel = GetBytesPerPixel(m_ColorFormat);
+        return UnpackColor(m_ColorFormat, &GetColorStorage()[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel]);
+    }
+
+    void FrameBuffer::SetColor(int x, int y, const Vec4f& color)
+    {
+        assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+        TouchColorTile(GetTileIndex(x, y));
+        const int bytesPerPixel = GetBytesPerPixel(m_ColorFormat);
+        PackColor(m_ColorFormat, color, &GetColorStorage()[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel]);
+    }
+
+    void FrameBuffer::SetColorSpan(int x, int y, int count, const Vec4f* colors)
+    {
+        assert(x >= 0 && x + count <= m_Width && y >= 0 && y < m_Height);
+        if (count <= 0)
+        {
+            return;
+        }
+        for (int tileX = x / TILE_SIZE; tileX <= (x + count - 1) / TILE_SIZE; ++tileX)
+        {
+            TouchColorTile((y / TILE_SIZE) * m_TileCountX + tileX);
+        }
+        const int bytesPerPixel = GetBytesPerPixel(m_ColorFormat);
+        PackColors(m_ColorFormat, colors, count, &GetColorStorage()[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel]);
+    }
+
+    void FrameBuffer::GetColorSpan(int x, int y, int count, Vec4f* colors) const
+    {
+        assert(x >= 0 && x + count <= m_Width && y >= 0 && y < m_Height);
+        const int bytesPerPixel = GetBytesPerPixel(m_ColorFormat);
+        const int end           = x + count;
+        while (x < end)
+        {
+            // 按分块边界切分，每段整体解包或填充清除色
+            const int segmentEnd = std::min(end, (x / TILE_SIZE + 1) * TILE_SIZE);
+            if (m_TileFlags[GetTileIndex(x, y)] & TILE_FLAG_COLOR_CLEARED)
+            {
+                std::fill(colors, colors + (segmentEnd - x), UnpackColor(m_ColorFormat, m_PackedClearColor));
+            }
+            else
+            {
+                UnpackColors(m_ColorFormat, &GetColorStorage()[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel], segmentEnd - x, colors);
+            }
+            colors += segmentEnd - x;
+            x = segmentEnd;
+        }
+    }
+
+    float FrameBuffer::GetDepth(int x, int y) const
+    {
+        assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+        if (m_TileFlags[GetTileIndex(x, y)] & TILE_FLAG_DEPTH_CLEARED)
+        {
+            return UnpackDepth(m_DepthFormat, m_PackedClearDepth);
+        }
+        const int bytesPerPixel = GetBytesPerPixel(m_DepthFormat);
+        uint32_t  bits          = 0;
+        std::memcpy(&bits, &m_DepthData[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel], bytesPerPixel);
+        return UnpackDepth(m_DepthFormat, bits);
+    }
+
+    void FrameBuffer::SetDepth(int x, int y, float depth)
+    {
+        assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+        TouchDepthTile(GetTileIndex(x, y));
+        const int bytesPerPixel = GetBytesPerPixel(m_DepthFormat);
+        uint32_t  bits          = PackDepth(m_DepthFormat, depth);
+        std::memcpy(&m_DepthData[(static_cast<size_t>(y) * m_Width + x) * bytesPerPixel], &bits, bytesPerPixel);
+    }
+
+    void FrameBuffer::ResolveFastClear()
+    {
+        for (int tileIndex = 0; tileIndex < static_cast<int>(m_TileFlags.size()); ++tileIndex)
+        {
+            TouchColorTile(tileIndex);
+            TouchDepthTile(tileIndex);
+        }
+    }
+
+    void FrameBuffer::ResolveFastClear(const TileSchedule& schedule, ThreadPool* threadPool)
+    {
+        assert(schedule.GetTileCountX() == m_TileCountX && schedule.GetTileCountY() == m_TileCountY);
+        // 各分块的标记与像素互不重叠，可并行落地
+        schedule.ForEach(threadPool, [this](int tileIndex, int) {
+            TouchColorTile(tileIndex);
+            TouchDepthTile(tileIndex);
+        });
+    }
+
+    void FrameBuffer::ResolveColorFastClear()
+    {
+        for (int tileIndex = 0; tileIndex < static_cast<int>(m_TileFlags.size()); ++tileIndex)
+        {
+            TouchColorTile(tileIndex);
+        }
+    }
+
+    void FrameBuffer::FillColorTile(int tileIndex)
+    {
+        const int bytesPerPixel = GetBytesPerPixel(m_ColorFormat);
+        const int startX        = (tileIndex % m_TileCountX) * TILE_SIZE;
+        const int startY        = (tileIndex / m_TileCountX) * TILE_SIZE;
+        const int endX          = std::min(startX + TILE_SIZE, m_Width);
+        const int endY          = std::min(startY + TILE_SIZE, m_Height);
+        for (int y = startY; y < endY; ++y)
+        {
+            uint8_t* dst = &GetColorStorage()[(static_cast<size_t>(y) * m_Width + startX) * bytesPerPixel];
+            for (int x = startX; x < endX; ++x, dst += bytesPerPixel)
+            {
+                std::memcpy(dst, m_PackedClearColor, bytesPerPixel);
+            }
+        }
+        m_TileFlags[tileIndex] &= ~TILE_FLAG_COLOR_CLEARED;
+    }
+
+    void FrameBuffer::FillDepthTile(int tileIndex)
+    {
+        const int bytesPerPixel = GetBytesPerPixel(m_DepthFormat);
+        const int startX        = (tileIndex % m_TileCountX) * TILE_SIZE;
+        const int startY        = (tileIndex / m_TileCountX) * TILE_SIZE;
+        const int endX          = std::min(startX + TILE_SIZE, m_Width);
+        const int endY          = std::min(startY + TILE_SIZE, m_Height);
+        for (int y = startY; y < endY; ++y)
+        {
+            uint8_t* dst = &m_DepthData[(static_cast<size_t>(y) * m_Width + startX) * bytesPerPixel];
+            for (int x = startX; x < endX; ++x, dst += bytesPerPixel)
+            {
+                std::memcpy(dst, &m_PackedClearDepth, bytesPerPixel);
+            }
+        }
+        m_TileFlags[tileIndex] &= ~TILE_FLAG_DEPTH_CLEARED;
+    }
+}   // namespace Joy
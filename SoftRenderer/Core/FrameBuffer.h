@@ -0,0 +1,297 @@
+/**
+ * @file FrameBuffer.h
+ * @author JoyatY
+ * @brief 帧缓冲，支持多种压缩像素格式与分块快速清除
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/PixelFormat.h"
+#include "Math/Vec.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Joy
+{
+    class ThreadPool;
+    class TileSchedule;
+
+    /**
+     * @brief 帧缓冲类
+     *
+     * 颜色与深度按行优先连续存储，逻辑上划分为TILE_SIZE x TILE_SIZE的分块。
+     * 清除操作只记录清除值并标记分块，直到分块被第一次写入时才真正填充内存，
+     * 读取仍处于清除状态的分块直接返回清除值。
+     * 构造时不初始化像素内存，物理页在分块第一次落地时才分配，因此由哪个线程先写入分块，页就位于哪个线程所在的NUMA节点上。
+     */
+    class FrameBuffer
+    {
+    public:
+        /**
+         * @brief 分块边长(像素)
+         *
+         */
+        constexpr static int TILE_SIZE = 16;
+
+    public:
+        /**
+         * @brief 构造帧缓冲
+         *
+         * @param width 宽度(像素)
+         * @param height 高度(像素)
+         * @param colorFormat 颜色缓冲格式
+         * @param depthFormat 深度缓冲格式
+         */
+        FrameBuffer(int width, int height, EnumColorFormat colorFormat = EnumColorFormat::RGBA8, EnumDepthFormat depthFormat = EnumDepthFormat::D32F);
+
+    public:
+        int             GetWidth() const { return m_Width; }
+        int             GetHeight() const { return m_Height; }
+        EnumColorFormat GetColorFormat() const { return m_ColorFormat; }
+        EnumDepthFormat GetDepthFormat() const { return m_DepthFormat; }
+        int             GetTileCountX() const { return m_TileCountX; }
+        int             GetTileCountY() const { return m_TileCountY; }
+
+        /**
+         * @brief 快速清除颜色缓冲，不访问像素内存
+         *
+         * @param color
+         */
+        void ClearColor(const Vec4f& color);
+
+        /**
+         * @brief 让颜色缓冲改用外部存储(如共享内存中的帧)，传入nullptr恢复使用内部存储
+         *
+         * 外部存储至少为GetColorPitch() * GetHeight()字节，由调用者管理生命周期。
+         * 绑定后所有颜色分块回到快速清除状态，原有颜色内容不保留。
+         *
+         * @param colorData 外部颜色存储
+         */
+        void BindColorStorage(uint8_t* colorData);
+
+        /**
+         * @brief 快速清除深度缓冲，不访问像素内存
+         *
+         * @param depth
+         */
+        void ClearDepth(float depth);
+
+        /**
+         * @brief 将一个分块的颜色与深度重置为当前清除值，不访问像素内存
+         *
+         * @param tileX
+         * @param tileY
+         */
+        void ResetTile(int tileX, int tileY) { m_TileFlags[tileY * m_TileCountX + tileX] |= TILE_FLAG_COLOR_CLEARED | TILE_FLAG_DEPTH_CLEARED; }
+
+        /**
+         * @brief 读取像素颜色
+         *
+         * @param x
+         * @param y
+         * @return Vec4f
+         */
+        Vec4f GetColor(int x, int y) const;
+
+        /**
+         * @brief 写入像素颜色
+         *
+         * @param x
+         * @param y
+         * @param color
+         */
+        void SetColor(int x, int y, const Vec4f& color);
+
+        /**
+         * @brief 写入同一行上连续的像素颜色，使用SIMD批量打包
+         *
+         * @param x 起始列
+         * @param y 行
+         * @param count 像素数量
+         * @param colors 颜色数组
+         */
+        void SetColorSpan(int x, int y, int count, const Vec4f* colors);
+
+        /**
+         * @brief 读取同一行上连续的像素颜色，使用SIMD批量解包，快速清除的分块直接输出清除色
+         *
+         * @param x 起始列
+         * @param y 行
+         * @param count 像素数量
+         * @param colors 输出颜色数组
+         */
+        void GetColorSpan(int x, int y, int count, Vec4f* colors) const;
+
+        /**
+         * @brief 读取像素深度
+         *
+         * @param x
+         * @param y
+         * @return float
+         */
+        float GetDepth(int x, int y) const;
+
+        /**
+         * @brief 写入像素深度
+         *
+         * @param x
+         * @param y
+         * @param depth
+         */
+        void SetDepth(int x, int y, float depth);
+
+        /**
+         * @brief 颜色分块是否仍处于快速清除状态(尚未写入)
+         *
+         * @param tileX
+         * @param tileY
+         * @return true
+         * @return false
+         */
+        bool IsColorTileCleared(int tileX, int tileY) const { return (m_TileFlags[tileY * m_TileCountX + tileX] & TILE_FLAG_COLOR_CLEARED) != 0; }
+
+        /**
+         * @brief 深度分块是否仍处于快速清除状态(尚未写入)
+         *
+         * @param tileX
+         * @param tileY
+         * @return true
+         * @return false
+         */
+        bool IsDepthTileCleared(int tileX, int tileY) const { return (m_TileFlags[tileY * m_TileCountX + tileX] & TILE_FLAG_DEPTH_CLEARED) != 0; }
+
+        /**
+         * @brief 将所有未落地的快速清除写入内存，直接访问原始数据前需要调用
+         *
+         */
+        void ResolveFastClear();
+
+        /**
+         * @brief 按分块调度并行落地快速清除，每个分块由调度中负责它的线程写入
+         *
+         * 对新建的帧缓冲，这就是像素内存的首次触碰: 与之后各并行阶段使用同一调度(及绑定CPU的线程池)时，
+         * 物理页分配在处理该区域的线程所在的NUMA节点上。分块小于内存页时，跨越两个区域的页归先写入的一方。
+         *
+         * @param schedule 分块数须与帧缓冲一致
+         * @param threadPool 线程池，为空时串行
+         */
+        void ResolveFastClear(const TileSchedule& schedule, ThreadPool* threadPool);
+
+        /**
+         * @brief 只将颜色缓冲中未落地的快速清除写入内存，用于交出颜色数据而深度仍留在本地的场合
+         *
+         */
+        void ResolveColorFastClear();
+
+        /**
+         * @brief 获取颜色缓冲原始数据(调用前需ResolveFastClear)
+         *
+         * @return const uint8_t*
+         */
+        const uint8_t* GetColorData() const { return GetColorStorage(); }
+
+        /**
+         * @brief 获取颜色缓冲行跨度(字节)
+         *
+         * @return int
+         */
+        int GetColorPitch() const { return m_Width * GetBytesPerPixel(m_ColorFormat); }
+
+    private:
+        /**
+         * @brief 分块快速清除标记
+         *
+         */
+        enum : uint8_t
+        {
+            TILE_FLAG_COLOR_CLEARED = 1 << 0,
+            TILE_FLAG_DEPTH_CLEARED = 1 << 1,
+        };
+
+        uint8_t*       GetColorStorage() { return m_ExternalColorData != nullptr ? m_ExternalColorData : m_ColorData.get(); }
+        const uint8_t* GetColorStorage() const { return m_ExternalColorData != nullptr ? m_ExternalColorData : m_ColorData.get(); }
+
+        int GetTileIndex(int x, int y) const { return (y / TILE_SIZE) * m_TileCountX + (x / TILE_SIZE); }
+
+        /**
+         * @brief 写入前确保颜色分块已落地
+         *
+         * @param tileIndex
+         */
+        void TouchColorTile(int tileIndex)
+        {
+            if (m_TileFlags[tileIndex] & TILE_FLAG_COLOR_CLEARED)
+            {
+                FillColorTile(tileIndex);
+            }
+        }
+
+        /**
+         * @brief 写入前确保深度分块已落地
+         *
+         * @param tileIndex
+         */
+        void TouchDepthTile(int tileIndex)
+        {
+            if (m_TileFlags[tileIndex] & TILE_FLAG_DEPTH_CLEARED)
+            {
+                FillDepthTile(tileIndex);
+            }
+        }
+
+        void FillColorTile(int tileIndex);
+        void FillDepthTile(int tileIndex);
+
+    private:
+        int             m_Width;
+        int             m_Height;
+        int             m_TileCountX;
+        int             m_TileCountY;
+        EnumColorFormat m_ColorFormat;
+        EnumDepthFormat m_DepthFormat;
+
+        /**
+         * @brief 颜色缓冲(按格式打包)，分配时不初始化
+         *
+         */
+        std::unique_ptr<uint8_t[]> m_ColorData;
+
+        /**
+         * @brief 外部颜色存储，非空时代替m_ColorData
+         *
+         */
+        uint8_t* m_ExternalColorData;
+
+        /**
+         * @brief 深度缓冲(按格式打包)，分配时不初始化
+         *
+         */
+        std::unique_ptr<uint8_t[]> m_DepthData;
+
+        /**
+         * @brief 分块快速清除标记
+         *
+         */
+        std::vector<uint8_t> m_TileFlags;
+
+        /**
+         * @brief 颜色清除值及其打包后的位模式
+         *
+         */
+        Vec4f   m_ClearColor;
+        uint8_t m_PackedClearColor[8];
+
+        /**
+         * @brief 深度清除值及其打包后的位模式
+         *
+         */
+        float    m_ClearDepth;
+        uint32_t m_PackedClearDepth;
+    };
+}   // namespace Joy
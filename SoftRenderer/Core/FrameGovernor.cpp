@@ -0,0 +1,181 @@
+#include "Core/FrameGovernor.h"
+#include "Core/Renderer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 按对齐粒度取整的渲染尺寸，不超过输出尺寸
+         *
+         */
+        int GetAlignedRenderSize(int outputSize, float scale)
+        {
+            const int alignment = FrameGovernor::RENDER_SIZE_ALIGNMENT;
+            const int aligned   = static_cast<int>(std::lround(static_cast<float>(outputSize) * scale / alignment)) * alignment;
+            return std::min(std::max(aligned, alignment), outputSize);
+        }
+
+        /**
+         * @brief 多重采样数的上一档与下一档(支持1/4/8)
+         *
+         */
+        int LowerSampleCount(int sampleCount) { return sampleCount > 4 ? 4 : 1; }
+        int RaiseSampleCount(int sampleCount, int maxSampleCount) { return std::min(sampleCount < 4 ? 4 : 8, maxSampleCount); }
+    }   // namespace
+
+    FrameGovernor::FrameGovernor(int outputWidth, int outputHeight, const FrameGovernorSettings& settings)
+        : m_Settings(settings)
+        , m_OutputWidth(outputWidth)
+        , m_OutputHeight(outputHeight)
+        , m_ResolutionScale(1.f)
+        , m_RenderWidth(outputWidth)
+        , m_RenderHeight(outputHeight)
+        , m_SampleCount(settings.maxSampleCount)
+        , m_LodBias(0.f)
+        , m_StageTimes{}
+        , m_StageStarts{}
+        , m_LastFrameTime(0.f)
+        , m_LastStageTimes{}
+        , m_History()
+    {
+        assert(outputWidth > 0 && outputHeight > 0);
+        assert(settings.targetFrameMs > 0.f && settings.raiseRatio < settings.settleRatio && settings.settleRatio <= 1.f);
+        assert(settings.minResolutionScale > 0.f && settings.minResolutionScale <= settings.maxResolutionScale && settings.maxResolutionScale <= 1.f);
+        assert(settings.maxSampleCount == 1 || settings.maxSampleCount == 4 || settings.maxSampleCount == 8);
+        assert(settings.historySize >= 1 && settings.settleFrames >= 1 && settings.settleFrames <= settings.historySize);
+        m_History.reserve(settings.historySize);
+        SetResolutionScale(settings.maxResolutionScale);
+    }
+
+    float FrameGovernor::GetLodErrorScale() const { return std::exp2(m_LodBias); }
+
+    float FrameGovernor::GetEstimatedFrameTime() const
+    {
+        if (m_History.empty())
+        {
+            return 0.f;
+        }
+        std::vector<float> frameTimes(m_History.size());
+        std::transform(m_History.begin(), m_History.end(), frameTimes.begin(), [](const FrameSample& sample) { return sample.frameTime; });
+        std::sort(frameTimes.begin(), frameTimes.end());
+        const int last = static_cast<int>(frameTimes.size()) - 1;
+        return frameTimes[std::min(static_cast<int>(m_Settings.frameTimePercentile * last + 0.5f), last)];
+    }
+
+    void FrameGovernor::BeginFrame() { std::fill(std::begin(m_StageTimes), std::end(m_StageTimes), 0.f); }
+
+    void FrameGovernor::BeginStage(EnumFrameStage stage) { m_StageStarts[static_cast<int>(stage)] = std::chrono::steady_clock::now(); }
+
+    void FrameGovernor::EndStage(EnumFrameStage stage)
+    {
+        const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_StageStarts[static_cast<int>(stage)];
+        AddStageTime(stage, elapsed.count());
+    }
+
+    void FrameGovernor::AddStageTime(EnumFrameStage stage, float milliseconds)
+    {
+        assert(stage != EnumFrameStage::COUNT);
+        m_StageTimes[static_cast<int>(stage)] += milliseconds;
+    }
+
+    bool FrameGovernor::EndFrame()
+    {
+        FrameSample sample{0.f, 0.f};
+        for (int stage = 0; stage < FRAME_STAGE_COUNT; ++stage)
+        {
+            sample.frameTime += m_StageTimes[stage];
+            sample.scalableTime += IsResolutionDependent(static_cast<EnumFrameStage>(stage)) ? m_StageTimes[stage] : 0.f;
+            m_LastStageTimes[stage] = m_StageTimes[stage];
+        }
+        m_LastFrameTime = sample.frameTime;
+        if (static_cast<int>(m_History.size()) == m_Settings.historySize)
+        {
+            m_History.erase(m_History.begin());
+        }
+        m_History.push_back(sample);
+        return Decide();
+    }
+
+    void FrameGovernor::Apply(Renderer& renderer) const
+    {
+        if (renderer.GetWidth() != m_RenderWidth || renderer.GetHeight() != m_RenderHeight)
+        {
+            renderer.Resize(m_RenderWidth, m_RenderHeight);
+        }
+        renderer.SetSampleCount(m_SampleCount);
+    }
+
+    bool FrameGovernor::Decide()
+    {
+        if (static_cast<int>(m_History.size()) < m_Settings.settleFrames)
+        {
+            return false;
+        }
+        const float estimate = GetEstimatedFrameTime();
+        const float target   = m_Settings.targetFrameMs;
+        if (estimate > target * m_Settings.raiseRatio && estimate <= target)
+        {
+            return false;
+        }
+
+        // 取与估计值对应的那一帧拆分可缩放部分，缩放s后该部分耗时变为原来的(s' / s)^2
+        const auto sample = std::find_if(m_History.begin(), m_History.end(), [&](const FrameSample& frame) { return frame.frameTime == estimate; });
+        const float scalable  = sample->scalableTime;
+        const float fixed     = estimate - scalable;
+        const float goal      = target * m_Settings.settleRatio;
+        const float goalScale = scalable > 0.f ? m_ResolutionScale * std::sqrt(std::max(goal - fixed, 0.f) / scalable) : m_Settings.maxResolutionScale;
+        if (estimate > target)
+        {
+            // 超出预算: 先降分辨率，到下限或可缩放部分无耗时(降分辨率无效)后依次降低多重采样、增加LOD偏移
+            if (m_ResolutionScale > m_Settings.minResolutionScale && goalScale < m_ResolutionScale)
+            {
+                SetResolutionScale(goalScale);
+            }
+            else if (m_SampleCount > 1)
+            {
+                m_SampleCount = LowerSampleCount(m_SampleCount);
+            }
+            else if (m_LodBias < m_Settings.maxLodBias)
+            {
+                m_LodBias = std::min(m_LodBias + m_Settings.lodBiasStep, m_Settings.maxLodBias);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // 余量充足: 按相反顺序恢复，分辨率小步提升
+            if (m_LodBias > 0.f)
+            {
+                m_LodBias = std::max(m_LodBias - m_Settings.lodBiasStep, 0.f);
+            }
+            else if (m_SampleCount < m_Settings.maxSampleCount)
+            {
+                m_SampleCount = RaiseSampleCount(m_SampleCount, m_Settings.maxSampleCount);
+            }
+            else if (m_ResolutionScale < m_Settings.maxResolutionScale && goalScale > m_ResolutionScale)
+            {
+                SetResolutionScale(std::min(goalScale, m_ResolutionScale + m_Settings.maxRaiseStep));
+            }
+            else
+            {
+                return false;
+            }
+        }
+        ClearHistory();
+        return true;
+    }
+
+    void FrameGovernor::SetResolutionScale(float scale)
+    {
+        m_ResolutionScale = std::min(std::max(scale, m_Settings.minResolutionScale), m_Settings.maxResolutionScale);
+        m_RenderWidth     = GetAlignedRenderSize(m_OutputWidth, m_ResolutionScale);
+        m_RenderHeight    = GetAlignedRenderSize(m_OutputHeight, m_ResolutionScale);
+    }
+}   // namespace Joy
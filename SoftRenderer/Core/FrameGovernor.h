@@ -0,0 +1,300 @@
+/**
+ * @file FrameGovernor.h
+ * @author JoyatY
+ * @brief 帧时间预算调度: 按各阶段耗时动态调整渲染分辨率、MSAA与LOD偏移
+ * @version 0.1
+ * @date 2025-12-29
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace Joy
+{
+    class Renderer;
+
+    /**
+     * @brief 帧内阶段，按耗时是否与渲染分辨率成正比分为两类
+     *
+     */
+    enum class EnumFrameStage
+    {
+        /**
+         * @brief 顶点处理、剔除等与分辨率无关的工作
+         *
+         */
+        GEOMETRY = 0,
+
+        /**
+         * @brief 光栅化与片元着色，与渲染像素数成正比
+         *
+         */
+        RASTER = 1,
+
+        /**
+         * @brief 多重采样解析，与渲染像素数成正比
+         *
+         */
+        RESOLVE = 2,
+
+        /**
+         * @brief 渲染分辨率下的后处理，与渲染像素数成正比
+         *
+         */
+        POST_PROCESS = 3,
+
+        /**
+         * @brief 放大到输出分辨率，只与输出像素数有关
+         *
+         */
+        UPSCALE = 4,
+
+        /**
+         * @brief 交付输出
+         *
+         */
+        PRESENT = 5,
+
+        COUNT
+    };
+
+    constexpr int FRAME_STAGE_COUNT = static_cast<int>(EnumFrameStage::COUNT);
+
+    /**
+     * @brief 阶段耗时是否与渲染像素数成正比
+     *
+     * @param stage
+     * @return true
+     * @return false
+     */
+    constexpr bool IsResolutionDependent(EnumFrameStage stage)
+    {
+        return stage == EnumFrameStage::RASTER || stage == EnumFrameStage::RESOLVE || stage == EnumFrameStage::POST_PROCESS;
+    }
+
+    /**
+     * @brief 帧调度参数
+     *
+     */
+    struct FrameGovernorSettings
+    {
+        /**
+         * @brief 目标帧时间(毫秒)
+         *
+         */
+        float targetFrameMs = 16.6f;
+
+        /**
+         * @brief 调整后瞄准的帧时间占目标的比例，留出余量吸收抖动
+         *
+         */
+        float settleRatio = 0.85f;
+
+        /**
+         * @brief 帧时间低于目标的该比例时才提升画质；估计帧时间落在(raiseRatio * 目标, 目标]内时不做调整，避免来回振荡
+         *
+         */
+        float raiseRatio = 0.7f;
+
+        /**
+         * @brief 渲染分辨率相对输出分辨率的缩放范围
+         *
+         */
+        float minResolutionScale = 0.5f;
+        float maxResolutionScale = 1.f;
+
+        /**
+         * @brief 每次提升分辨率时缩放的最大增量，降低时不限制
+         *
+         */
+        float maxRaiseStep = 0.1f;
+
+        /**
+         * @brief 画质满档时的多重采样数(1/4/8)，分辨率降到最低后逐级降低
+         *
+         */
+        int maxSampleCount = 1;
+
+        /**
+         * @brief 多重采样降到1后仍超出预算时逐级增加的LOD偏移及其上限
+         *
+         */
+        float lodBiasStep = 0.5f;
+        float maxLodBias  = 2.f;
+
+        /**
+         * @brief 参与决策的最近帧数与所取的分位数，高分位数使决策针对偶发的慢帧而非平均情况
+         *
+         */
+        int   historySize        = 8;
+        float frameTimePercentile = 0.9f;
+
+        /**
+         * @brief 画质调整后至少观察的帧数，之前的测量来自旧的画质设置，不参与决策
+         *
+         */
+        int settleFrames = 4;
+    };
+
+    /**
+     * @brief 帧调度器
+     *
+     * 每帧记录各阶段耗时，帧结束时取最近若干帧帧时间的高分位数与目标比较。超出预算时，把耗时分为与渲染像素数成正比的部分和固定部分，
+     * 按比例直接算出使帧时间回到目标以内的分辨率缩放；分辨率已到下限时依次降低多重采样数、增加LOD偏移。
+     * 帧时间明显低于预算时按相反顺序恢复，分辨率每次只小步提升。每帧的使用流程:
+     * @code
+     * governor.BeginFrame();
+     * governor.Apply(renderer);                              // 按当前决策调整渲染尺寸与多重采样数
+     * governor.BeginStage(EnumFrameStage::RASTER);  renderer.Clear(...); renderer.Draw(...);  governor.EndStage(EnumFrameStage::RASTER);
+     * governor.BeginStage(EnumFrameStage::RESOLVE); renderer.Resolve();                       governor.EndStage(EnumFrameStage::RESOLVE);
+     * governor.BeginStage(EnumFrameStage::UPSCALE); upscaler.Process(renderer.GetFrameBuffer(), output); governor.EndStage(EnumFrameStage::UPSCALE);
+     * governor.EndFrame();
+     * @endcode
+     * LOD选择时以GetLodErrorScale()放大允许的屏幕误差。
+     */
+    class FrameGovernor
+    {
+    public:
+        /**
+         * @brief 渲染尺寸按该粒度取整，缩放的微小变化不会引起缓冲重新分配
+         *
+         */
+        constexpr static int RENDER_SIZE_ALIGNMENT = 8;
+
+    public:
+        /**
+         * @brief 构造帧调度器，初始为满档画质
+         *
+         * @param outputWidth 输出宽度(像素)
+         * @param outputHeight 输出高度(像素)
+         * @param settings 调度参数
+         */
+        FrameGovernor(int outputWidth, int outputHeight, const FrameGovernorSettings& settings = FrameGovernorSettings());
+
+    public:
+        const FrameGovernorSettings& GetSettings() const { return m_Settings; }
+        int                          GetOutputWidth() const { return m_OutputWidth; }
+        int                          GetOutputHeight() const { return m_OutputHeight; }
+
+        /**
+         * @brief 当前决策: 分辨率缩放、渲染尺寸、多重采样数与LOD偏移
+         *
+         */
+        float GetResolutionScale() const { return m_ResolutionScale; }
+        int   GetRenderWidth() const { return m_RenderWidth; }
+        int   GetRenderHeight() const { return m_RenderHeight; }
+        int   GetSampleCount() const { return m_SampleCount; }
+        float GetLodBias() const { return m_LodBias; }
+
+        /**
+         * @brief LOD允许的屏幕误差的放大系数，即2的LOD偏移次方
+         *
+         * @return float
+         */
+        float GetLodErrorScale() const;
+
+        /**
+         * @brief 上一帧的帧时间与各阶段耗时(毫秒)
+         *
+         */
+        float GetFrameTime() const { return m_LastFrameTime; }
+        float GetStageTime(EnumFrameStage stage) const { return m_LastStageTimes[static_cast<int>(stage)]; }
+
+        /**
+         * @brief 决策所用的帧时间估计: 最近帧帧时间的分位数，尚无测量时为0
+         *
+         * @return float
+         */
+        float GetEstimatedFrameTime() const;
+
+        /**
+         * @brief 开始一帧，清空本帧的阶段耗时
+         *
+         */
+        void BeginFrame();
+
+        /**
+         * @brief 开始计时一个阶段
+         *
+         * @param stage
+         */
+        void BeginStage(EnumFrameStage stage);
+
+        /**
+         * @brief 结束计时一个阶段，耗时累加到本帧该阶段
+         *
+         * @param stage
+         */
+        void EndStage(EnumFrameStage stage);
+
+        /**
+         * @brief 直接累加阶段耗时，用于外部测量的阶段
+         *
+         * @param stage
+         * @param milliseconds 耗时(毫秒)
+         */
+        void AddStageTime(EnumFrameStage stage, float milliseconds);
+
+        /**
+         * @brief 结束一帧: 帧时间为各阶段耗时之和，据此更新下一帧的画质决策
+         *
+         * @return true 画质决策发生变化
+         * @return false
+         */
+        bool EndFrame();
+
+        /**
+         * @brief 将当前决策应用到渲染器: 尺寸不同时调整尺寸，并设置多重采样数
+         *
+         * @param renderer
+         */
+        void Apply(Renderer& renderer) const;
+
+    private:
+        /**
+         * @brief 一帧的测量结果
+         *
+         */
+        struct FrameSample
+        {
+            float frameTime;
+            float scalableTime;
+        };
+
+        bool Decide();
+        void SetResolutionScale(float scale);
+        void ClearHistory() { m_History.clear(); }
+
+    private:
+        FrameGovernorSettings m_Settings;
+        int                   m_OutputWidth;
+        int                   m_OutputHeight;
+
+        float m_ResolutionScale;
+        int   m_RenderWidth;
+        int   m_RenderHeight;
+        int   m_SampleCount;
+        float m_LodBias;
+
+        /**
+         * @brief 本帧各阶段耗时与正在计时的阶段的开始时间
+         *
+         */
+        float                                 m_StageTimes[FRAME_STAGE_COUNT];
+        std::chrono::steady_clock::time_point m_StageStarts[FRAME_STAGE_COUNT];
+
+        float m_LastFrameTime;
+        float m_LastStageTimes[FRAME_STAGE_COUNT];
+
+        /**
+         * @brief 上次调整画质以来的帧测量，按时间顺序，最多historySize个
+         *
+         */
+        std::vector<FrameSample> m_History;
+    };
+}   // namespace Joy
@@ -0,0 +1,99 @@
+#include "Core/Instancing.h"
+#include "Core/SimdKernels.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Joy
+{
+    Mat4x4f MakeInstanceMatrix(const InstanceTransform& transform)
+    {
+        Mat4x4f ret = ToMat4x4f(transform.rotation);
+        for (int col = 0; col < 3; ++col)
+        {
+            const float scale = transform.scale[col];
+            ret[col]          = Vec4f{ret[col][0] * scale, ret[col][1] * scale, ret[col][2] * scale, 0.f};
+        }
+        ret[3] = Vec4f{transform.translation[0], transform.translation[1], transform.translation[2], 1.f};
+        return ret;
+    }
+
+    void MakeInstanceMatrices(const InstanceTransform* transforms, int count, Mat4x4f* models)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            models[i] = MakeInstanceMatrix(transforms[i]);
+        }
+    }
+
+    InstanceBounds ComputeBounds(const Vec4f* positions, size_t count)
+    {
+        assert(count > 0);
+        InstanceBounds ret{Vec3f{positions[0][0], positions[0][1], positions[0][2]}, Vec3f{positions[0][0], positions[0][1], positions[0][2]}};
+        for (size_t i = 1; i < count; ++i)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                ret.min[axis] = std::min(ret.min[axis], positions[i][axis]);
+                ret.max[axis] = std::max(ret.max[axis], positions[i][axis]);
+            }
+        }
+        return ret;
+    }
+
+    void ComposeInstanceMatrices(const Mat4x4f& viewProj, const Mat4x4f* models, int count, Mat4x4f* mvps)
+    {
+        // 输出的每一列只依赖模型矩阵的对应列，整批矩阵可视为count * 4个列向量一起变换
+        static_assert(sizeof(Mat4x4f) == sizeof(Vec4f) * 4, "Mat4x4f must be 4 packed columns");
+        GetSimdKernels().transformPositions(viewProj, reinterpret_cast<const Vec4f*>(models), static_cast<size_t>(count) * 4, reinterpret_cast<Vec4f*>(mvps));
+    }
+
+    int CullInstances(const Mat4x4f* mvps, int count, const InstanceBounds& bounds, uint32_t* visibleIndices)
+    {
+        using namespace Simd;
+        // 8个角点分两组放入SIMD通道: 第一组z取min，第二组z取max
+        const Float4 cornerX = Set(bounds.min[0], bounds.max[0], bounds.min[0], bounds.max[0]);
+        const Float4 cornerY = Set(bounds.min[1], bounds.min[1], bounds.max[1], bounds.max[1]);
+        const Float4 cornerZ[2] = {Splat(bounds.min[2]), Splat(bounds.max[2])};
+        const Float4 zero       = Splat(0.f);
+
+        int visibleCount = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            const Mat4x4f& mvp = mvps[i];
+            // 每个平面上两组角点的外侧掩码按位与，结果为0xF表示8个角点全部在该平面外
+            int outside[6] = {0xF, 0xF, 0xF, 0xF, 0xF, 0xF};
+            for (int group = 0; group < 2; ++group)
+            {
+                Float4 clip[4];
+                for (int row = 0; row < 4; ++row)
+                {
+                    clip[row] = MulAdd(Splat(mvp[0][row]), cornerX,
+                                       MulAdd(Splat(mvp[1][row]), cornerY, MulAdd(Splat(mvp[2][row]), cornerZ[group], Splat(mvp[3][row]))));
+                }
+                const Float4 negW = zero - clip[3];
+                outside[0] &= MoveMask(CmpLt(clip[0], negW));
+                outside[1] &= MoveMask(CmpGt(clip[0], clip[3]));
+                outside[2] &= MoveMask(CmpLt(clip[1], negW));
+                outside[3] &= MoveMask(CmpGt(clip[1], clip[3]));
+                outside[4] &= MoveMask(CmpLt(clip[2], zero));
+                outside[5] &= MoveMask(CmpGt(clip[2], clip[3]));
+            }
+            bool culled = false;
+            for (int plane = 0; plane < 6; ++plane)
+            {
+                culled |= outside[plane] == 0xF;
+            }
+            if (!culled)
+            {
+                visibleIndices[visibleCount++] = static_cast<uint32_t>(i);
+            }
+        }
+        return visibleCount;
+    }
+
+    void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out)
+    {
+        GetSimdKernels().transformPositions(mat, positions, count, out);
+    }
+}   // namespace Joy
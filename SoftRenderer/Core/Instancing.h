@@ -0,0 +1,103 @@
+/**
+ * @file Instancing.h
+ * @author JoyatY
+ * @brief 实例化绘制: 逐实例变换的批量组合、包围盒剔除与顶点变换
+ * @version 0.1
+ * @date 2025-12-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Mat.h"
+#include "Math/Quat.h"
+#include "Math/Vec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 紧凑的实例变换(平移、旋转、缩放)，展开为 M = T * R * S
+     *
+     */
+    struct InstanceTransform
+    {
+        Vec3f translation{0.f, 0.f, 0.f};
+        Quat  rotation{};
+        Vec3f scale{1.f, 1.f, 1.f};
+    };
+
+    /**
+     * @brief 由紧凑实例变换构造模型矩阵
+     *
+     * @param transform 旋转须为单位四元数
+     * @return Mat4x4f
+     */
+    Mat4x4f MakeInstanceMatrix(const InstanceTransform& transform);
+
+    /**
+     * @brief 批量展开紧凑实例变换
+     *
+     * @param transforms 实例变换数组
+     * @param count 实例数
+     * @param models 输出模型矩阵，长度为count
+     */
+    void MakeInstanceMatrices(const InstanceTransform* transforms, int count, Mat4x4f* models);
+
+    /**
+     * @brief 模型空间轴对齐包围盒
+     *
+     */
+    struct InstanceBounds
+    {
+        Vec3f min;
+        Vec3f max;
+    };
+
+    /**
+     * @brief 计算位置数组的包围盒
+     *
+     * @param positions 位置数组，w须为1
+     * @param count 位置数，至少为1
+     * @return InstanceBounds
+     */
+    InstanceBounds ComputeBounds(const Vec4f* positions, size_t count);
+
+    /**
+     * @brief 以SIMD批量组合实例矩阵 mvps[i] = viewProj * models[i]
+     *
+     * viewProj的4列常驻寄存器，每个输出列由模型矩阵对应列的4个分量各做一次乘加得到，以运行时选择的最宽SIMD路径执行。
+     *
+     * @param viewProj 相机的ViewProj矩阵
+     * @param models 实例模型矩阵数组
+     * @param count 实例数
+     * @param mvps 输出，长度为count，可与models指向同一数组
+     */
+    void ComposeInstanceMatrices(const Mat4x4f& viewProj, const Mat4x4f* models, int count, Mat4x4f* mvps);
+
+    /**
+     * @brief 逐实例视锥剔除: 包围盒8个角点全部位于某一裁剪平面外侧时剔除
+     *
+     * 裁剪平面与Renderer一致: x、y在[-w, w]，z在[0, w]。
+     *
+     * @param mvps 实例的ModelViewProj矩阵数组
+     * @param count 实例数
+     * @param bounds 模型空间包围盒
+     * @param visibleIndices 输出可见实例的索引(升序)，长度至少为count
+     * @return int 可见实例数
+     */
+    int CullInstances(const Mat4x4f* mvps, int count, const InstanceBounds& bounds, uint32_t* visibleIndices);
+
+    /**
+     * @brief 以SIMD批量变换位置 out[i] = mat * positions[i]
+     *
+     * @param mat 变换矩阵
+     * @param positions 输入位置数组
+     * @param count 位置数
+     * @param out 输出，长度为count，可与positions为同一数组(不可部分重叠)
+     */
+    void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out);
+}   // namespace Joy
@@ -0,0 +1,63 @@
+/**
+ * @file Mesh.h
+ * @author JoyatY
+ * @brief 网格数据定义
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Vec.h"
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 顶点数据
+     *
+     */
+    struct Vertex
+    {
+        /**
+         * @brief 模型空间位置
+         *
+         */
+        Vec3f position;
+
+        /**
+         * @brief 模型空间法线
+         *
+         */
+        Vec3f normal;
+
+        /**
+         * @brief 纹理坐标
+         *
+         */
+        Vec2f uv;
+    };
+
+    /**
+     * @brief 三角形网格
+     *
+     */
+    struct Mesh
+    {
+        /**
+         * @brief 顶点数组
+         *
+         */
+        std::vector<Vertex> vertices;
+
+        /**
+         * @brief 索引数组，每3个索引组成一个三角形
+         *
+         */
+        std::vector<uint32_t> indices;
+    };
+}   // namespace Joy
@@ -0,0 +1,444 @@
+#include "Core/MeshSimplifier.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 边界惩罚平面的权重
+         *
+         */
+        constexpr double BOUNDARY_WEIGHT = 100.0;
+
+        /**
+         * @brief 对称4x4误差二次型，存放上三角10个元素: aa ab ac ad bb bc bd cc cd dd
+         *
+         */
+        struct Quadric
+        {
+            double m[10] = {};
+
+            void AddPlane(const Vec3d& normal, double d, double weight)
+            {
+                const double a = normal[0];
+                const double b = normal[1];
+                const double c = normal[2];
+                m[0] += weight * a * a;
+                m[1] += weight * a * b;
+                m[2] += weight * a * c;
+                m[3] += weight * a * d;
+                m[4] += weight * b * b;
+                m[5] += weight * b * c;
+                m[6] += weight * b * d;
+                m[7] += weight * c * c;
+                m[8] += weight * c * d;
+                m[9] += weight * d * d;
+            }
+
+            Quadric& operator+=(const Quadric& rhs)
+            {
+                for (int i = 0; i < 10; ++i)
+                {
+                    m[i] += rhs.m[i];
+                }
+                return *this;
+            }
+
+            /**
+             * @brief 点到所有平面的加权距离平方和
+             *
+             */
+            double Evaluate(const Vec3d& p) const
+            {
+                const double x = p[0];
+                const double y = p[1];
+                const double z = p[2];
+                return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x + m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y +
+                       m[7] * z * z + 2.0 * m[8] * z + m[9];
+            }
+        };
+
+        /**
+         * @brief 候选折叠 from -> to，记录入队时两端顶点的版本，版本变化后该候选失效
+         *
+         */
+        struct Collapse
+        {
+            double   cost;
+            uint32_t from;
+            uint32_t to;
+            uint32_t fromStamp;
+            uint32_t toStamp;
+
+            bool operator>(const Collapse& rhs) const { return cost > rhs.cost; }
+        };
+
+        using Triangle = std::array<uint32_t, 3>;
+
+        /**
+         * @brief 原始三角形所在平面，法线为单位向量
+         *
+         */
+        struct Plane
+        {
+            Vec3d  normal;
+            double d;
+        };
+
+        bool Contains(const Triangle& tri, uint32_t vertex)
+        {
+            return tri[0] == vertex || tri[1] == vertex || tri[2] == vertex;
+        }
+
+        uint64_t EdgeKey(uint32_t a, uint32_t b)
+        {
+            return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+        }
+
+        /**
+         * @brief 简化过程中的网格拓扑与误差状态
+         *
+         */
+        class Simplifier
+        {
+        public:
+            explicit Simplifier(const Mesh& mesh)
+                : m_Positions(mesh.vertices.size())
+                , m_Quadrics(mesh.vertices.size())
+                , m_VertexTris(mesh.vertices.size())
+                , m_VertexPlanes(mesh.vertices.size())
+                , m_VertexAlive(mesh.vertices.size(), true)
+                , m_Stamps(mesh.vertices.size(), 0)
+            {
+                for (size_t i = 0; i < mesh.vertices.size(); ++i)
+                {
+                    m_Positions[i] = VecCast<double>(mesh.vertices[i].position);
+                }
+                for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+                {
+                    const Triangle tri{mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]};
+                    assert(tri[0] < mesh.vertices.size() && tri[1] < mesh.vertices.size() && tri[2] < mesh.vertices.size());
+                    if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+                    {
+                        continue;
+                    }
+                    for (uint32_t vertex : tri)
+                    {
+                        m_VertexTris[vertex].push_back(static_cast<uint32_t>(m_Tris.size()));
+                    }
+                    m_Tris.push_back(tri);
+                }
+                m_TriAlive.assign(m_Tris.size(), true);
+                m_AliveTriCount = m_Tris.size();
+                BuildQuadrics();
+            }
+
+            /**
+             * @brief 按代价从小到大折叠，直到达到目标三角形数或无可用折叠
+             *
+             */
+            void Run(size_t targetTriangleCount)
+            {
+                for (uint32_t t = 0; t < m_Tris.size(); ++t)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        PushCollapse(m_Tris[t][k], m_Tris[t][(k + 1) % 3]);
+                        PushCollapse(m_Tris[t][(k + 1) % 3], m_Tris[t][k]);
+                    }
+                }
+                while (m_AliveTriCount > targetTriangleCount && !m_Queue.empty())
+                {
+                    const Collapse collapse = m_Queue.top();
+                    m_Queue.pop();
+                    if (!m_VertexAlive[collapse.from] || !m_VertexAlive[collapse.to] || m_Stamps[collapse.from] != collapse.fromStamp ||
+                        m_Stamps[collapse.to] != collapse.toStamp || !IsCollapseValid(collapse.from, collapse.to))
+                    {
+                        continue;
+                    }
+                    ApplyCollapse(collapse.from, collapse.to);
+                }
+            }
+
+            /**
+             * @brief 输出简化网格，顶点按原顺序压缩
+             *
+             */
+            Mesh Build(const Mesh& source) const
+            {
+                Mesh                  ret;
+                std::vector<uint32_t> remap(source.vertices.size(), UINT32_MAX);
+                for (size_t t = 0; t < m_Tris.size(); ++t)
+                {
+                    if (m_TriAlive[t])
+                    {
+                        for (uint32_t vertex : m_Tris[t])
+                        {
+                            remap[vertex] = 0;
+                        }
+                    }
+                }
+                for (size_t i = 0; i < source.vertices.size(); ++i)
+                {
+                    if (remap[i] != UINT32_MAX)
+                    {
+                        remap[i] = static_cast<uint32_t>(ret.vertices.size());
+                        ret.vertices.push_back(source.vertices[i]);
+                    }
+                }
+                ret.indices.reserve(m_AliveTriCount * 3);
+                for (size_t t = 0; t < m_Tris.size(); ++t)
+                {
+                    if (m_TriAlive[t])
+                    {
+                        ret.indices.insert(ret.indices.end(), {remap[m_Tris[t][0]], remap[m_Tris[t][1]], remap[m_Tris[t][2]]});
+                    }
+                }
+                return ret;
+            }
+
+            float GetGeometricError() const { return static_cast<float>(m_MaxError); }
+
+        private:
+            Vec3d GetTriNormal(const Triangle& tri) const
+            {
+                return Cross(m_Positions[tri[1]] - m_Positions[tri[0]], m_Positions[tri[2]] - m_Positions[tri[0]]);
+            }
+
+            void BuildQuadrics()
+            {
+                std::unordered_map<uint64_t, int> edgeUseCount;
+                for (const Triangle& tri : m_Tris)
+                {
+                    const Vec3d  normal = GetTriNormal(tri);
+                    const double length = Norm(normal);
+                    if (length > 0.0)
+                    {
+                        const Vec3d unitNormal = normal / length;
+                        const double d         = -Dot(unitNormal, m_Positions[tri[0]]);
+                        for (uint32_t vertex : tri)
+                        {
+                            m_Quadrics[vertex].AddPlane(unitNormal, d, 1.0);
+                            m_VertexPlanes[vertex].push_back(static_cast<uint32_t>(m_Planes.size()));
+                        }
+                        m_Planes.push_back(Plane{unitNormal, d});
+                    }
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        ++edgeUseCount[EdgeKey(tri[k], tri[(k + 1) % 3])];
+                    }
+                }
+                // 只被一个三角形使用的边为开放边界，加入过边且垂直于三角形的平面约束其沿切向移动
+                for (const Triangle& tri : m_Tris)
+                {
+                    const Vec3d normal = GetTriNormal(tri);
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const uint32_t a = tri[k];
+                        const uint32_t b = tri[(k + 1) % 3];
+                        if (edgeUseCount[EdgeKey(a, b)] != 1)
+                        {
+                            continue;
+                        }
+                        const Vec3d  sideNormal = Cross(m_Positions[b] - m_Positions[a], normal);
+                        const double length     = Norm(sideNormal);
+                        if (length > 0.0)
+                        {
+                            const Vec3d unitNormal = sideNormal / length;
+                            const double d         = -Dot(unitNormal, m_Positions[a]);
+                            m_Quadrics[a].AddPlane(unitNormal, d, BOUNDARY_WEIGHT);
+                            m_Quadrics[b].AddPlane(unitNormal, d, BOUNDARY_WEIGHT);
+                        }
+                    }
+                }
+            }
+
+            void PushCollapse(uint32_t from, uint32_t to)
+            {
+                Quadric quadric = m_Quadrics[from];
+                quadric += m_Quadrics[to];
+                m_Queue.push(Collapse{std::max(quadric.Evaluate(m_Positions[to]), 0.0), from, to, m_Stamps[from], m_Stamps[to]});
+            }
+
+            /**
+             * @brief 收集顶点的相邻顶点
+             *
+             */
+            void GatherNeighbors(uint32_t vertex, std::vector<uint32_t>& neighbors) const
+            {
+                neighbors.clear();
+                for (uint32_t t : m_VertexTris[vertex])
+                {
+                    if (!m_TriAlive[t])
+                    {
+                        continue;
+                    }
+                    for (uint32_t other : m_Tris[t])
+                    {
+                        if (other != vertex)
+                        {
+                            neighbors.push_back(other);
+                        }
+                    }
+                }
+                std::sort(neighbors.begin(), neighbors.end());
+                neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+            }
+
+            bool IsCollapseValid(uint32_t from, uint32_t to)
+            {
+                // 连接条件: 两端的公共相邻顶点只能是共享该边的三角形的第三个顶点，否则折叠会产生非流形
+                int sharedTriCount = 0;
+                for (uint32_t t : m_VertexTris[from])
+                {
+                    sharedTriCount += m_TriAlive[t] && Contains(m_Tris[t], to) ? 1 : 0;
+                }
+                GatherNeighbors(from, m_FromNeighbors);
+                GatherNeighbors(to, m_ToNeighbors);
+                m_CommonNeighbors.clear();
+                std::set_intersection(m_FromNeighbors.begin(), m_FromNeighbors.end(), m_ToNeighbors.begin(), m_ToNeighbors.end(),
+                                      std::back_inserter(m_CommonNeighbors));
+                if (sharedTriCount == 0 || static_cast<int>(m_CommonNeighbors.size()) > sharedTriCount)
+                {
+                    return false;
+                }
+                // 保留下来的三角形不能翻转或退化
+                for (uint32_t t : m_VertexTris[from])
+                {
+                    if (!m_TriAlive[t] || Contains(m_Tris[t], to))
+                    {
+                        continue;
+                    }
+                    Triangle moved = m_Tris[t];
+                    std::replace(moved.begin(), moved.end(), from, to);
+                    const Vec3d before = GetTriNormal(m_Tris[t]);
+                    const Vec3d after  = GetTriNormal(moved);
+                    if (Dot(before, after) <= 0.0)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void ApplyCollapse(uint32_t from, uint32_t to)
+            {
+                for (uint32_t t : m_VertexTris[from])
+                {
+                    if (!m_TriAlive[t])
+                    {
+                        continue;
+                    }
+                    if (Contains(m_Tris[t], to))
+                    {
+                        m_TriAlive[t] = false;
+                        --m_AliveTriCount;
+                        continue;
+                    }
+                    std::replace(m_Tris[t].begin(), m_Tris[t].end(), from, to);
+                    m_VertexTris[to].push_back(t);
+                }
+                m_VertexAlive[from] = false;
+                m_VertexTris[from].clear();
+                m_Quadrics[to] += m_Quadrics[from];
+
+                // 折叠后to代表两端覆盖的原始三角形。几何误差取to到这些三角形平面的最大距离，不含边界惩罚平面与权重；
+                // to不移动，原属to的平面此前已计入，只需检查来自from的平面
+                for (uint32_t plane : m_VertexPlanes[from])
+                {
+                    m_MaxError = std::max(m_MaxError, std::abs(Dot(m_Planes[plane].normal, m_Positions[to]) + m_Planes[plane].d));
+                }
+                m_MergedPlanes.clear();
+                std::set_union(m_VertexPlanes[from].begin(), m_VertexPlanes[from].end(), m_VertexPlanes[to].begin(), m_VertexPlanes[to].end(),
+                               std::back_inserter(m_MergedPlanes));
+                m_VertexPlanes[to].swap(m_MergedPlanes);
+                m_VertexPlanes[from].clear();
+                ++m_Stamps[to];
+
+                std::vector<uint32_t>& tris = m_VertexTris[to];
+                tris.erase(std::remove_if(tris.begin(), tris.end(), [this](uint32_t t) { return !m_TriAlive[t]; }), tris.end());
+                GatherNeighbors(to, m_ToNeighbors);
+                for (uint32_t neighbor : m_ToNeighbors)
+                {
+                    PushCollapse(to, neighbor);
+                    PushCollapse(neighbor, to);
+                }
+            }
+
+        private:
+            std::vector<Vec3d>                                                   m_Positions;
+            std::vector<Quadric>                                                 m_Quadrics;
+            std::vector<std::vector<uint32_t>>                                   m_VertexTris;
+            std::vector<std::vector<uint32_t>>                                   m_VertexPlanes;
+            std::vector<Plane>                                                   m_Planes;
+            std::vector<bool>                                                    m_VertexAlive;
+            std::vector<uint32_t>                                                m_Stamps;
+            std::vector<Triangle>                                                m_Tris;
+            std::vector<bool>                                                    m_TriAlive;
+            size_t                                                               m_AliveTriCount = 0;
+            double                                                               m_MaxError      = 0.0;
+            std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> m_Queue;
+            std::vector<uint32_t>                                                m_FromNeighbors;
+            std::vector<uint32_t>                                                m_ToNeighbors;
+            std::vector<uint32_t>                                                m_CommonNeighbors;
+            std::vector<uint32_t>                                                m_MergedPlanes;
+        };
+    }   // namespace
+
+    Mesh SimplifyMesh(const Mesh& mesh, size_t targetTriangleCount, float* outGeometricError)
+    {
+        Simplifier simplifier(mesh);
+        simplifier.Run(targetTriangleCount);
+        if (outGeometricError != nullptr)
+        {
+            *outGeometricError = simplifier.GetGeometricError();
+        }
+        return simplifier.Build(mesh);
+    }
+
+    MeshLodChain::MeshLodChain(const Mesh& mesh, int maxLevelCount, float reduction, size_t minTriangleCount)
+    {
+        assert(maxLevelCount > 0 && reduction > 0.f && reduction < 1.f);
+        m_Levels.push_back(MeshLod{mesh, 0.f});
+        while (static_cast<int>(m_Levels.size()) < maxLevelCount)
+        {
+            const size_t previousCount = m_Levels.back().mesh.indices.size() / 3;
+            if (previousCount <= minTriangleCount)
+            {
+                break;
+            }
+            // 每级都从原始网格简化，避免逐级累积误差
+            const size_t target = std::max(minTriangleCount, static_cast<size_t>(static_cast<float>(previousCount) * reduction));
+            float        error  = 0.f;
+            Mesh         level  = SimplifyMesh(mesh, target, &error);
+            if (level.indices.size() / 3 >= previousCount)
+            {
+                break;
+            }
+            m_Levels.push_back(MeshLod{std::move(level), std::max(error, m_Levels.back().geometricError)});
+        }
+    }
+
+    int MeshLodChain::SelectLevel(const Camera& camera, const Vec3f& worldCenter, float worldScale, int viewportHeight, float maxPixelError) const
+    {
+        const float pixelsPerUnit = camera.GetPixelsPerUnit(Norm(worldCenter - camera.GetPosition()), viewportHeight) * worldScale;
+        for (int level = GetLevelCount() - 1; level > 0; --level)
+        {
+            if (m_Levels[level].geometricError * pixelsPerUnit <= maxPixelError)
+            {
+                return level;
+            }
+        }
+        return 0;
+    }
+}   // namespace Joy
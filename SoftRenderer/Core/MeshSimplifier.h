@@ -0,0 +1,106 @@
+/**
+ * @file MeshSimplifier.h
+ * @author JoyatY
+ * @brief 二次误差度量(QEM)网格简化与LOD选择
+ * @version 0.1
+ * @date 2025-12-21
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/Camera.h"
+#include "Core/Mesh.h"
+#include "Math/Vec.h"
+#include <cstddef>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 以二次误差度量简化网格
+     *
+     * 采用半边折叠: 顶点u折叠到相邻顶点v，代价为两者误差二次型之和在v处的取值，简化结果只引用原网格的顶点，法线与纹理坐标原样保留。
+     * 开放边界附加垂直于边界的惩罚平面以保持轮廓；纹理接缝处顶点不共享，按边界处理。拒绝使三角形翻转或破坏流形的折叠。
+     *
+     * @param mesh 输入网格
+     * @param targetTriangleCount 目标三角形数，无法继续折叠时提前结束
+     * @param outGeometricError 可选输出，简化引入的最大几何误差(模型空间距离): 保留顶点到其代表的原始三角形所在平面的最大距离
+     * @return Mesh 只包含被引用顶点的简化网格
+     */
+    Mesh SimplifyMesh(const Mesh& mesh, size_t targetTriangleCount, float* outGeometricError = nullptr);
+
+    /**
+     * @brief 一级LOD
+     *
+     */
+    struct MeshLod
+    {
+        /**
+         * @brief 该级网格
+         *
+         */
+        Mesh mesh;
+
+        /**
+         * @brief 相对原始网格的几何误差(模型空间距离)，随级别单调递增
+         *
+         */
+        float geometricError = 0.f;
+    };
+
+    /**
+     * @brief 离线生成的LOD链，运行时按屏幕空间误差选择级别
+     *
+     */
+    class MeshLodChain
+    {
+    public:
+        /**
+         * @brief 由原始网格生成LOD链，第0级为原始网格
+         *
+         * @param mesh 原始网格
+         * @param maxLevelCount 最大级数(含第0级)
+         * @param reduction 每级相对上一级保留的三角形比例
+         * @param minTriangleCount 三角形数低于该值后不再生成更粗的级别
+         */
+        MeshLodChain(const Mesh& mesh, int maxLevelCount = 5, float reduction = 0.5f, size_t minTriangleCount = 32);
+
+    public:
+        int            GetLevelCount() const { return static_cast<int>(m_Levels.size()); }
+        const MeshLod& GetLevel(int level) const { return m_Levels[level]; }
+
+        /**
+         * @brief 按投影屏幕空间误差选择LOD级别
+         *
+         * 屏幕误差 = 几何误差 * 缩放 * 相机在物体距离处每单位长度的像素数，返回误差不超过阈值的最粗级别。
+         *
+         * @param camera 相机，使用其FOV(正交相机为尺寸)与位置
+         * @param worldCenter 物体的世界空间中心
+         * @param worldScale 模型到世界的统一缩放
+         * @param viewportHeight 视口高度(像素)
+         * @param maxPixelError 允许的最大屏幕误差(像素)
+         * @return int 级别索引
+         */
+        int SelectLevel(const Camera& camera, const Vec3f& worldCenter, float worldScale, int viewportHeight, float maxPixelError = 1.f) const;
+
+        /**
+         * @brief 按投影屏幕空间误差选择LOD网格
+         *
+         * @see SelectLevel
+         */
+        const Mesh& Select(const Camera& camera, const Vec3f& worldCenter, float worldScale, int viewportHeight, float maxPixelError = 1.f) const
+        {
+            return m_Levels[SelectLevel(camera, worldCenter, worldScale, viewportHeight, maxPixelError)].mesh;
+        }
+
+    private:
+        /**
+         * @brief 各级LOD，由精到粗
+         *
+         */
+        std::vector<MeshLod> m_Levels;
+    };
+}   // namespace Joy
@@ -0,0 +1,179 @@
+#include "Core/MultiSampleBuffer.h"
+#include "Core/FrameBuffer.h"
+#include "Core/Rasterizer.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace Joy
+{
+    MultiSampleBuffer::MultiSampleBuffer(int width, int height, int sampleCount, EnumColorFormat colorFormat)
+        : m_Width(width)
+        , m_Height(height)
+        , m_SampleCount(sampleCount)
+        , m_BytesPerPixel(GetBytesPerPixel(colorFormat))
+        , m_ColorFormat(colorFormat)
+        , m_PixelStates(static_cast<size_t>(width) * height)
+        , m_Colors(static_cast<size_t>(width) * height * sampleCount * GetBytesPerPixel(colorFormat))
+        , m_Depths(static_cast<size_t>(width) * height * sampleCount)
+        , m_PackedClearColor()
+        , m_ClearDepth(1.f)
+    {
+        assert(sampleCount == 4 || sampleCount == 8);
+        Clear(Vec4f{0.f, 0.f, 0.f, 1.f}, 1.f);
+    }
+
+    void MultiSampleBuffer::Clear(const Vec4f& color, float depth)
+    {
+        PackColor(m_ColorFormat, color, m_PackedClearColor);
+        m_ClearDepth = depth;
+        std::fill(m_PixelStates.begin(), m_PixelStates.end(), static_cast<uint8_t>(PIXEL_COLOR_CLEARED | PIXEL_DEPTH_CLEARED));
+    }
+
+    void MultiSampleBuffer::ClearRect(const RasterRect& rect)
+    {
+        for (int y = rect.minY; y < rect.maxY; ++y)
+        {
+            std::fill_n(&m_PixelStates[PixelIndex(rect.minX, y)], rect.maxX - rect.minX, static_cast<uint8_t>(PIXEL_COLOR_CLEARED | PIXEL_DEPTH_CLEARED));
+        }
+    }
+
+    uint32_t MultiSampleBuffer::TestAndWriteDepth(int x, int y, uint32_t coverage, const float* sampleDepths, EnumDepthTest depthTest)
+    {
+        const uint32_t passMask = TestDepth(x, y, coverage, sampleDepths, depthTest);
+        WriteDepth(x, y, passMask, sampleDepths);
+        return passMask;
+    }
+
+    uint32_t MultiSampleBuffer::TestDepth(int x, int y, uint32_t coverage, const float* sampleDepths, EnumDepthTest depthTest) const
+    {
+        const size_t pixelIndex = PixelIndex(x, y);
+        if (m_PixelStates[pixelIndex] & PIXEL_DEPTH_CLEARED)
+        {
+            float clearDepths[MAX_SAMPLE_COUNT];
+            std::fill(clearDepths, clearDepths + m_SampleCount, m_ClearDepth);
+            return static_cast<uint32_t>(GetSimdKernels().depthTestSpan(depthTest, sampleDepths, clearDepths, m_SampleCount)) & coverage;
+        }
+        return static_cast<uint32_t>(GetSimdKernels().depthTestSpan(depthTest, sampleDepths, &m_Depths[pixelIndex * m_SampleCount], m_SampleCount)) & coverage;
+    }
+
+    void MultiSampleBuffer::WriteDepth(int x, int y, uint32_t mask, const float* sampleDepths)
+    {
+        if (mask == 0)
+        {
+            return;
+        }
+        const size_t pixelIndex = PixelIndex(x, y);
+        float*       depths     = &m_Depths[pixelIndex * m_SampleCount];
+        uint8_t&     state      = m_PixelStates[pixelIndex];
+        // 清除状态的像素第一次写入时才展开为逐采样深度
+        if (state & PIXEL_DEPTH_CLEARED)
+        {
+            std::fill(depths, depths + m_SampleCount, m_ClearDepth);
+            state &= ~PIXEL_DEPTH_CLEARED;
+        }
+        for (int sample = 0; sample < m_SampleCount; ++sample)
+        {
+            if (mask & (1u << sample))
+            {
+                depths[sample] = sampleDepths[sample];
+            }
+        }
+    }
+
+    void MultiSampleBuffer::WriteColor(int x, int y, uint32_t mask, const Vec4f& color)
+    {
+        const size_t   pixelIndex = PixelIndex(x, y);
+        const uint32_t fullMask   = (1u << m_SampleCount) - 1u;
+        uint8_t&       state      = m_PixelStates[pixelIndex];
+        if (mask == fullMask)
+        {
+            // 完全覆盖，只写入一个颜色
+            PackColor(m_ColorFormat, color, SampleColor(pixelIndex, 0));
+            state = static_cast<uint8_t>((state & ~PIXEL_COLOR_MASK) | PIXEL_COLOR_COMPRESSED);
+            return;
+        }
+
+        const uint8_t colorState = state & PIXEL_COLOR_MASK;
+        if (colorState != PIXEL_COLOR_EXPANDED)
+        {
+            // 部分覆盖，先将单一颜色展开到所有采样
+            const uint8_t* source = colorState == PIXEL_COLOR_CLEARED ? m_PackedClearColor : SampleColor(pixelIndex, 0);
+            uint8_t        value[8];
+            std::memcpy(value, source, m_BytesPerPixel);
+            for (int sample = 0; sample < m_SampleCount; ++sample)
+            {
+                std::memcpy(SampleColor(pixelIndex, sample), value, m_BytesPerPixel);
+            }
+            state = static_cast<uint8_t>((state & ~PIXEL_COLOR_MASK) | PIXEL_COLOR_EXPANDED);
+        }
+
+        uint8_t packed[8];
+        PackColor(m_ColorFormat, color, packed);
+        for (int sample = 0; sample < m_SampleCount; ++sample)
+        {
+            if (mask & (1u << sample))
+            {
+                std::memcpy(SampleColor(pixelIndex, sample), packed, m_BytesPerPixel);
+            }
+        }
+    }
+
+    Vec4f MultiSampleBuffer::GetSampleColor(int x, int y, int sample) const
+    {
+        const size_t  pixelIndex = PixelIndex(x, y);
+        const uint8_t colorState = m_PixelStates[pixelIndex] & PIXEL_COLOR_MASK;
+        if (colorState == PIXEL_COLOR_CLEARED)
+        {
+            return UnpackColor(m_ColorFormat, m_PackedClearColor);
+        }
+        return UnpackColor(m_ColorFormat, SampleColor(pixelIndex, colorState == PIXEL_COLOR_COMPRESSED ? 0 : sample));
+    }
+
+    float MultiSampleBuffer::GetSampleDepth(int x, int y, int sample) const
+    {
+        const size_t pixelIndex = PixelIndex(x, y);
+        return (m_PixelStates[pixelIndex] & PIXEL_DEPTH_CLEARED) ? m_ClearDepth : m_Depths[pixelIndex * m_SampleCount + sample];
+    }
+
+    void MultiSampleBuffer::Resolve(FrameBuffer& target) const
+    {
+        Resolve(target, RasterRect{0, 0, m_Width, m_Height});
+    }
+
+    void MultiSampleBuffer::Resolve(FrameBuffer& target, const RasterRect& rect) const
+    {
+        assert(target.GetWidth() == m_Width && target.GetHeight() == m_Height);
+        const Vec4f        clearColor = UnpackColor(m_ColorFormat, m_PackedClearColor);
+        const Simd::Float4 invCount   = Simd::Splat(1.f / static_cast<float>(m_SampleCount));
+        std::vector<Vec4f> row(m_Width);
+        Vec4f              samples[MAX_SAMPLE_COUNT];
+        for (int y = rect.minY; y < rect.maxY; ++y)
+        {
+            for (int x = rect.minX; x < rect.maxX; ++x)
+            {
+                const size_t  pixelIndex = PixelIndex(x, y);
+                const uint8_t state      = m_PixelStates[pixelIndex];
+                switch (state & PIXEL_COLOR_MASK)
+                {
+                    case PIXEL_COLOR_CLEARED: row[x] = clearColor; break;
+                    case PIXEL_COLOR_COMPRESSED: row[x] = UnpackColor(m_ColorFormat, SampleColor(pixelIndex, 0)); break;
+                    default:
+                    {
+                        UnpackColors(m_ColorFormat, SampleColor(pixelIndex, 0), m_SampleCount, samples);
+                        Simd::Float4 sum = Simd::Load(&samples[0][0]);
+                        for (int sample = 1; sample < m_SampleCount; ++sample)
+                        {
+                            sum = sum + Simd::Load(&samples[sample][0]);
+                        }
+                        Simd::Store(&row[x][0], sum * invCount);
+                        break;
+                    }
+                }
+                target.SetDepth(x, y, (state & PIXEL_DEPTH_CLEARED) ? m_ClearDepth : m_Depths[pixelIndex * m_SampleCount]);
+            }
+            target.SetColorSpan(rect.minX, y, rect.maxX - rect.minX, &row[rect.minX]);
+        }
+    }
+}   // namespace Joy
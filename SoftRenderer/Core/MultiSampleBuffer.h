@@ -0,0 +1,210 @@
+/**
+ * @file MultiSampleBuffer.h
+ * @author JoyatY
+ * @brief 多重采样缓冲，颜色采样按像素压缩存储
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/PixelFormat.h"
+#include "Core/Rasterizer.h"
+#include "Math/Vec.h"
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    class FrameBuffer;
+
+    /**
+     * @brief 多重采样缓冲
+     *
+     * 每个像素记录一个压缩状态:
+     * 清除状态下所有采样等于清除值，不访问采样内存；
+     * 压缩状态下所有采样颜色相同，只读写第0个采样槽；
+     * 只有被部分覆盖的像素才展开为逐采样存储。
+     * 颜色按帧缓冲格式打包存储，深度以32位浮点逐采样存储。
+     */
+    class MultiSampleBuffer
+    {
+    public:
+        /**
+         * @brief 构造多重采样缓冲
+         *
+         * @param width 宽度(像素)
+         * @param height 高度(像素)
+         * @param sampleCount 采样数(4或8)
+         * @param colorFormat 采样颜色格式
+         */
+        MultiSampleBuffer(int width, int height, int sampleCount, EnumColorFormat colorFormat);
+
+    public:
+        int             GetWidth() const { return m_Width; }
+        int             GetHeight() const { return m_Height; }
+        int             GetSampleCount() const { return m_SampleCount; }
+        EnumColorFormat GetColorFormat() const { return m_ColorFormat; }
+
+        /**
+         * @brief 清除颜色与深度，只重置像素状态
+         *
+         * @param color
+         * @param depth
+         */
+        void Clear(const Vec4f& color, float depth);
+
+        /**
+         * @brief 将矩形内的像素重置为当前清除值
+         *
+         * @param rect
+         */
+        void ClearRect(const RasterRect& rect);
+
+        /**
+         * @brief 对覆盖的采样进行深度测试，并写入通过测试的采样深度
+         *
+         * @param x
+         * @param y
+         * @param coverage 采样覆盖掩码
+         * @param sampleDepths 各采样深度
+         * @param depthTest 深度测试函数
+         * @return uint32_t 通过深度测试的采样掩码
+         */
+        uint32_t TestAndWriteDepth(int x, int y, uint32_t coverage, const float* sampleDepths, EnumDepthTest depthTest = EnumDepthTest::LESS);
+
+        /**
+         * @brief 对覆盖的采样进行深度测试，不写入深度(片元可能被丢弃时先测试，着色后再写入)
+         *
+         * @param x
+         * @param y
+         * @param coverage 采样覆盖掩码
+         * @param sampleDepths 各采样深度
+         * @param depthTest 深度测试函数
+         * @return uint32_t 通过深度测试的采样掩码
+         */
+        uint32_t TestDepth(int x, int y, uint32_t coverage, const float* sampleDepths, EnumDepthTest depthTest = EnumDepthTest::LESS) const;
+
+        /**
+         * @brief 写入掩码内采样的深度
+         *
+         * @param x
+         * @param y
+         * @param mask 写入的采样掩码
+         * @param sampleDepths 各采样深度
+         */
+        void WriteDepth(int x, int y, uint32_t mask, const float* sampleDepths);
+
+        /**
+         * @brief 写入掩码内采样的颜色
+         *
+         * @param x
+         * @param y
+         * @param mask 写入的采样掩码
+         * @param color 像素着色结果
+         */
+        void WriteColor(int x, int y, uint32_t mask, const Vec4f& color);
+
+        /**
+         * @brief 读取采样颜色
+         *
+         * @param x
+         * @param y
+         * @param sample
+         * @return Vec4f
+         */
+        Vec4f GetSampleColor(int x, int y, int sample) const;
+
+        /**
+         * @brief 读取采样深度
+         *
+         * @param x
+         * @param y
+         * @param sample
+         * @return float
+         */
+        float GetSampleDepth(int x, int y, int sample) const;
+
+        /**
+         * @brief 像素颜色是否为单一值存储(清除或压缩状态)
+         *
+         * @param x
+         * @param y
+         * @return true
+         * @return false
+         */
+        bool IsPixelCompressed(int x, int y) const { return (m_PixelStates[PixelIndex(x, y)] & PIXEL_COLOR_MASK) != PIXEL_COLOR_EXPANDED; }
+
+        /**
+         * @brief 将采样解析到单采样帧缓冲，展开的像素使用SIMD求平均
+         *
+         * @param target 目标帧缓冲，尺寸须与多重采样缓冲一致
+         */
+        void Resolve(FrameBuffer& target) const;
+
+        /**
+         * @brief 只解析矩形内的像素
+         *
+         * @param target 目标帧缓冲，尺寸须与多重采样缓冲一致
+         * @param rect 解析区域
+         */
+        void Resolve(FrameBuffer& target, const RasterRect& rect) const;
+
+    private:
+        /**
+         * @brief 像素状态位
+         *
+         */
+        enum : uint8_t
+        {
+            PIXEL_COLOR_CLEARED    = 0,
+            PIXEL_COLOR_COMPRESSED = 1,
+            PIXEL_COLOR_EXPANDED   = 2,
+            PIXEL_COLOR_MASK       = 3,
+            PIXEL_DEPTH_CLEARED    = 4,
+        };
+
+        size_t PixelIndex(int x, int y) const { return static_cast<size_t>(y) * m_Width + x; }
+
+        uint8_t* SampleColor(size_t pixelIndex, int sample)
+        {
+            return &m_Colors[(pixelIndex * m_SampleCount + sample) * m_BytesPerPixel];
+        }
+
+        const uint8_t* SampleColor(size_t pixelIndex, int sample) const
+        {
+            return &m_Colors[(pixelIndex * m_SampleCount + sample) * m_BytesPerPixel];
+        }
+
+    private:
+        int             m_Width;
+        int             m_Height;
+        int             m_SampleCount;
+        int             m_BytesPerPixel;
+        EnumColorFormat m_ColorFormat;
+
+        /**
+         * @brief 每像素压缩状态
+         *
+         */
+        std::vector<uint8_t> m_PixelStates;
+
+        /**
+         * @brief 采样颜色(像素内采样连续存储)
+         *
+         */
+        std::vector<uint8_t> m_Colors;
+
+        /**
+         * @brief 采样深度(像素内采样连续存储)
+         *
+         */
+        std::vector<float> m_Depths;
+
+        uint8_t m_PackedClearColor[8];
+        float   m_ClearDepth;
+    };
+}   // namespace Joy
@@ -0,0 +1,162 @@
+/**
+ * @file MultiView.h
+ * @author JoyatY
+ * @brief 多视图顶点变换，将同一顶点以SIMD同时变换到多个视图(立方体贴图、立体渲染、级联阴影)
+ * @version 0.1
+ * @date 2025-12-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Mat.h"
+#include "Math/Simd.h"
+#include "Math/Transform.h"
+#include "Math/Vec.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 单次提交支持的最大视图数
+     *
+     */
+    constexpr int MAX_VIEW_COUNT = 8;
+
+    /**
+     * @brief 裁剪空间外侧标记，三个顶点的标记按位与非零时三角形在该视图中完全不可见
+     *
+     */
+    constexpr uint8_t CLIP_OUTSIDE_LEFT   = 1 << 0;
+    constexpr uint8_t CLIP_OUTSIDE_RIGHT  = 1 << 1;
+    constexpr uint8_t CLIP_OUTSIDE_BOTTOM = 1 << 2;
+    constexpr uint8_t CLIP_OUTSIDE_TOP    = 1 << 3;
+    constexpr uint8_t CLIP_OUTSIDE_NEAR   = 1 << 4;
+    constexpr uint8_t CLIP_OUTSIDE_FAR    = 1 << 5;
+
+    /**
+     * @brief 立方体贴图的面数
+     *
+     */
+    constexpr int CUBEMAP_FACE_COUNT = 6;
+
+    /**
+     * @brief 立方体贴图某个面的观察投影矩阵，参数固定时可在编译期求出整套探针的矩阵
+     *
+     * 面依次为+X、-X、+Y、-Y、+Z、-Z，90度视角、宽高比1；上方向的选取与Camera一致，朝向竖直时以+Z为参考上方向。
+     *
+     * @param face 面索引
+     * @param center 探针位置
+     * @param near 近平面距离
+     * @param far 远平面距离
+     * @return Mat4x4f
+     */
+    constexpr Mat4x4f MakeCubemapViewProj(int face, const Vec3f& center, float near, float far)
+    {
+        const Vec3f directions[CUBEMAP_FACE_COUNT] = {Vec3f{1.f, 0.f, 0.f},  Vec3f{-1.f, 0.f, 0.f}, Vec3f{0.f, 1.f, 0.f},
+                                                      Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, 0.f, 1.f},  Vec3f{0.f, 0.f, -1.f}};
+        const Vec3f worldUp = face == 2 || face == 3 ? Vec3f{0.f, 0.f, 1.f} : Vec3f{0.f, 1.f, 0.f};
+        return Perspective(90.f, 1.f, near, far) * LookTo(center, directions[face], worldUp);
+    }
+
+    /**
+     * @brief 多视图变换，视图按4个一组放入SIMD通道，每个顶点只读取一次
+     *
+     */
+    class MultiViewTransform
+    {
+    public:
+        MultiViewTransform() = default;
+
+        /**
+         * @brief 设置各视图的变换矩阵
+         *
+         * @param matrices 视图矩阵数组(通常为ViewProj)
+         * @param viewCount 视图数[1, MAX_VIEW_COUNT]
+         */
+        void SetViews(const Mat4x4f* matrices, int viewCount)
+        {
+            assert(viewCount >= 1 && viewCount <= MAX_VIEW_COUNT);
+            m_ViewCount = viewCount;
+            for (int group = 0; group < GetGroupCount(); ++group)
+            {
+                // 不足4个视图的通道复制最后一个视图，保证结果有效
+                const Mat4x4f* mats[4];
+                for (int lane = 0; lane < 4; ++lane)
+                {
+                    mats[lane] = &matrices[std::min(group * 4 + lane, viewCount - 1)];
+                }
+                for (int col = 0; col < 4; ++col)
+                {
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        m_Columns[group][col][row] = Simd::Set((*mats[0])[col][row], (*mats[1])[col][row], (*mats[2])[col][row], (*mats[3])[col][row]);
+                    }
+                }
+            }
+        }
+
+        int GetViewCount() const { return m_ViewCount; }
+        int GetGroupCount() const { return (m_ViewCount + 3) / 4; }
+
+        /**
+         * @brief 将一个顶点变换到所有视图
+         *
+         * @param position 输入位置
+         * @param clipPositions 输出各视图的裁剪空间位置，长度为视图数
+         * @param outcodes 输出各视图的裁剪外侧标记，长度为视图数
+         */
+        void Transform(const Vec4f& position, Vec4f* clipPositions, uint8_t* outcodes) const
+        {
+            using namespace Simd;
+            const Float4 px = Splat(position[0]);
+            const Float4 py = Splat(position[1]);
+            const Float4 pz = Splat(position[2]);
+            const Float4 pw = Splat(position[3]);
+            for (int group = 0; group < GetGroupCount(); ++group)
+            {
+                const Float4(&columns)[4][4] = m_Columns[group];
+                // 每个输出分量的4个通道对应4个视图
+                Float4 clip[4];
+                for (int row = 0; row < 4; ++row)
+                {
+                    clip[row] = MulAdd(columns[0][row], px, MulAdd(columns[1][row], py, MulAdd(columns[2][row], pz, columns[3][row] * pw)));
+                }
+                const Float4 negW    = Splat(0.f) - clip[3];
+                const int    masks[6] = {MoveMask(CmpLt(clip[0], negW)),
+                                         MoveMask(CmpGt(clip[0], clip[3])),
+                                         MoveMask(CmpLt(clip[1], negW)),
+                                         MoveMask(CmpGt(clip[1], clip[3])),
+                                         MoveMask(CmpLt(clip[2], Splat(0.f))),
+                                         MoveMask(CmpGt(clip[2], clip[3]))};
+
+                Float4 transposed[4] = {clip[0], clip[1], clip[2], clip[3]};
+                Transpose4(transposed[0], transposed[1], transposed[2], transposed[3]);
+                const int laneCount = std::min(4, m_ViewCount - group * 4);
+                for (int lane = 0; lane < laneCount; ++lane)
+                {
+                    uint8_t outcode = 0;
+                    for (int plane = 0; plane < 6; ++plane)
+                    {
+                        outcode |= static_cast<uint8_t>(((masks[plane] >> lane) & 1) << plane);
+                    }
+                    Store(&clipPositions[group * 4 + lane][0], transposed[lane]);
+                    outcodes[group * 4 + lane] = outcode;
+                }
+            }
+        }
+
+    private:
+        int m_ViewCount = 0;
+
+        /**
+         * @brief [视图组][矩阵列][矩阵行]，通道为组内视图
+         *
+         */
+        Simd::Float4 m_Columns[MAX_VIEW_COUNT / 4][4][4];
+    };
+}   // namespace Joy
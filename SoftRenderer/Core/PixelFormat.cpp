@@ -0,0 +1,336 @@
+#include "Core/PixelFormat.h"
+#include "Math/LookupTable.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Joy
+{
+    namespace
+    {
+        inline uint32_t FloatBits(float value)
+        {
+            uint32_t ret = 0;
+            std::memcpy(&ret, &value, sizeof(ret));
+            return ret;
+        }
+
+        inline float BitsToFloat(uint32_t value)
+        {
+            float ret = 0.f;
+            std::memcpy(&ret, &value, sizeof(ret));
+            return ret;
+        }
+
+        /**
+         * @brief 4通道单精度浮点转半精度，结果在每个32位通道的低16位
+         *
+         * @param value
+         * @return Simd::Int4
+         */
+        inline Simd::Int4 FloatToHalf4(Simd::Float4 value)
+        {
+            using namespace Simd;
+            const Int4   signMask    = SplatInt(static_cast<int32_t>(0x80000000u));
+            const Int4   f32Infinity = SplatInt(255 << 23);
+            const Int4   f16Max      = SplatInt((127 + 16) << 23);
+            const Int4   minNormal   = SplatInt(113 << 23);
+            const Float4 denormMagic = AsFloat(SplatInt(((127 - 15) + (23 - 10) + 1) << 23));
+
+            Int4 bits = AsInt(value);
+            Int4 sign = bits & signMask;
+            bits      = bits ^ sign;
+
+            Int4 infNan   = Select(CmpGt(bits, f32Infinity), SplatInt(0x7e00), SplatInt(0x7c00));
+            Int4 overflow = CmpGt(bits, f16Max - SplatInt(1));
+            Int4 denormal = CmpGt(minNormal, bits);
+
+            Int4 denormalRet = AsInt(AsFloat(bits) + denormMagic) - AsInt(denormMagic);
+            Int4 mantOdd     = ShiftRightLogical<13>(bits) & SplatInt(1);
+            Int4 normalRet   = ShiftRightLogical<13>(bits + SplatInt(static_cast<int32_t>((15u - 127u) << 23) + 0xfff) + mantOdd);
+
+            Int4 ret = Select(overflow, infNan, Select(denormal, denormalRet, normalRet));
+            return ret | ShiftRightLogical<16>(sign);
+        }
+
+        /**
+         * @brief 4通道半精度转单精度，输入为每个32位通道的低16位
+         *
+         * @param value
+         * @return Simd::Float4
+         */
+        inline Simd::Float4 HalfToFloat4(Simd::Int4 value)
+        {
+            using namespace Simd;
+            const Int4   shiftedExp = SplatInt(0x7c00 << 13);
+            const Int4   expAdjust  = SplatInt((127 - 15) << 23);
+            const Float4 magic      = AsFloat(SplatInt(113 << 23));
+
+            Int4 bits    = ShiftLeft<13>(value & SplatInt(0x7fff));
+            Int4 exp     = bits & shiftedExp;
+            bits         = bits + expAdjust;
+            Int4 infNan  = bits + expAdjust;
+            Int4 denorm  = AsInt(AsFloat(bits + SplatInt(1 << 23)) - magic);
+            Int4 ret     = Select(CmpEq(exp, shiftedExp), infNan, Select(CmpEq(exp, SplatInt(0)), denorm, bits));
+            return AsFloat(ret | ShiftLeft<16>(value & SplatInt(0x8000)));
+        }
+
+        inline uint32_t HalfToUnsignedFloat(uint32_t half, int mantissaShift, uint32_t maxFinite, uint32_t infinity)
+        {
+            // 负数与NaN在输入阶段已被钳制为0
+            if (half >= 0x7c00u)
+            {
+                return infinity;
+            }
+            uint32_t ret = (half + (1u << (mantissaShift - 1))) >> mantissaShift;
+            return std::min(ret, maxFinite);
+        }
+
+        inline uint32_t PackR11G11B10F(Simd::Float4 color)
+        {
+            int32_t halves[4];
+            Simd::StoreInt(halves, FloatToHalf4(Simd::Max(color, Simd::Splat(0.f))));
+            uint32_t r = HalfToUnsignedFloat(static_cast<uint32_t>(halves[0]), 4, 0x7bfu, 0x7c0u);
+            uint32_t g = HalfToUnsignedFloat(static_cast<uint32_t>(halves[1]), 4, 0x7bfu, 0x7c0u);
+            uint32_t b = HalfToUnsignedFloat(static_cast<uint32_t>(halves[2]), 5, 0x3dfu, 0x3e0u);
+            return r | (g << 11) | (b << 22);
+        }
+
+        inline uint8_t ToUnorm8(float value)
+        {
+            value = std::min(std::max(value, 0.f), 1.f);
+            return static_cast<uint8_t>(value * 255.f + 0.5f);
+        }
+
+        inline Simd::Float4 LoadColor(const Vec4f& color) { return Simd::Set(color[0], color[1], color[2], color[3]); }
+
+        inline Vec4f StoreColor(Simd::Float4 value)
+        {
+            float data[4];
+            Simd::Store(data, value);
+            return Vec4f{data[0], data[1], data[2], data[3]};
+        }
+    }   // namespace
+
+    uint16_t FloatToHalf(float value)
+    {
+        const uint32_t f32Infinity = 255u << 23;
+        const uint32_t f16Max      = (127u + 16u) << 23;
+        const float    denormMagic = BitsToFloat(((127u - 15u) + (23u - 10u) + 1u) << 23);
+
+        uint32_t bits = FloatBits(value);
+        uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint32_t ret = 0;
+        if (bits >= f16Max)
+        {
+            // 溢出为无穷大，NaN保持为NaN
+            ret = bits > f32Infinity ? 0x7e00u : 0x7c00u;
+        }
+        else if (bits < (113u << 23))
+        {
+            // 非规格化数，借助浮点加法完成舍入
+            ret = FloatBits(BitsToFloat(bits) + denormMagic) - FloatBits(denormMagic);
+        }
+        else
+        {
+            uint32_t mantOdd = (bits >> 13) & 1u;
+            bits += ((15u - 127u) << 23) + 0xfffu;
+            bits += mantOdd;
+            ret = bits >> 13;
+        }
+        return static_cast<uint16_t>(ret | (sign >> 16));
+    }
+
+    float HalfToFloat(uint16_t value)
+    {
+        const uint32_t shiftedExp = 0x7c00u << 13;
+        const float    magic      = BitsToFloat(113u << 23);
+
+        uint32_t bits = (value & 0x7fffu) << 13;
+        uint32_t exp  = bits & shiftedExp;
+        bits += (127u - 15u) << 23;
+        if (exp == shiftedExp)
+        {
+            bits += (128u - 16u) << 23;
+        }
+        else if (exp == 0)
+        {
+            bits += 1u << 23;
+            bits = FloatBits(BitsToFloat(bits) - magic);
+        }
+        bits |= (value & 0x8000u) << 16;
+        return BitsToFloat(bits);
+    }
+
+    void PackColor(EnumColorFormat format, const Vec4f& color, uint8_t* dst)
+    {
+        switch (format)
+        {
+            case EnumColorFormat::RGBA8:
+            {
+                uint8_t rgba[4] = {ToUnorm8(color[0]), ToUnorm8(color[1]), ToUnorm8(color[2]), ToUnorm8(color[3])};
+                std::memcpy(dst, rgba, sizeof(rgba));
+                break;
+            }
+            case EnumColorFormat::SRGBA8:
+            {
+                uint8_t rgba[4] = {LinearToSrgb(color[0]), LinearToSrgb(color[1]), LinearToSrgb(color[2]), ToUnorm8(color[3])};
+                std::memcpy(dst, rgba, sizeof(rgba));
+                break;
+            }
+            case EnumColorFormat::R11G11B10F:
+            {
+                uint32_t packed = PackR11G11B10F(LoadColor(color));
+                std::memcpy(dst, &packed, sizeof(packed));
+                break;
+            }
+            case EnumColorFormat::RGBA16F:
+            {
+                int32_t  halves[4];
+                uint16_t packed[4];
+                Simd::StoreInt(halves, FloatToHalf4(LoadColor(color)));
+                for (int i = 0; i < 4; ++i)
+                {
+                    packed[i] = static_cast<uint16_t>(halves[i]);
+                }
+                std::memcpy(dst, packed, sizeof(packed));
+                break;
+            }
+        }
+    }
+
+    void PackColors(EnumColorFormat format, const Vec4f* colors, int count, uint8_t* dst)
+    {
+        static_assert(sizeof(Vec4f) == sizeof(float) * 4, "Vec4f must be tightly packed.");
+        int index = 0;
+#if JOY_SIMD_SSE2
+        if (format == EnumColorFormat::RGBA8)
+        {
+            // 一次处理4个像素: 钳制、缩放、舍入(与标量路径一致)后饱和打包到16字节
+            const __m128 zero  = _mm_setzero_ps();
+            const __m128 one   = _mm_set1_ps(1.f);
+            const __m128 scale = _mm_set1_ps(255.f);
+            const __m128 half  = _mm_set1_ps(0.5f);
+            for (; index + 4 <= count; index += 4)
+            {
+                const float* src = &colors[index][0];
+                __m128i      c0  = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 0), zero), one), scale), half));
+                __m128i      c1  = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4), zero), one), scale), half));
+                __m128i      c2  = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 8), zero), one), scale), half));
+                __m128i      c3  = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 12), zero), one), scale), half));
+                __m128i      ret = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + index * 4), ret);
+            }
+        }
+        else if (format == EnumColorFormat::RGBA16F)
+        {
+            // 一次处理2个像素: 半精度位模式符号扩展后用有符号饱和打包保持低16位不变
+            for (; index + 2 <= count; index += 2)
+            {
+                __m128i h0 = FloatToHalf4(Simd::Load(&colors[index][0])).m_Value;
+                __m128i h1 = FloatToHalf4(Simd::Load(&colors[index + 1][0])).m_Value;
+                h0         = _mm_srai_epi32(_mm_slli_epi32(h0, 16), 16);
+                h1         = _mm_srai_epi32(_mm_slli_epi32(h1, 16), 16);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + index * 8), _mm_packs_epi32(h0, h1));
+            }
+        }
+#endif
+        const int bytesPerPixel = GetBytesPerPixel(format);
+        for (; index < count; ++index)
+        {
+            PackColor(format, colors[index], dst + index * bytesPerPixel);
+        }
+    }
+
+    Vec4f UnpackColor(EnumColorFormat format, const uint8_t* src)
+    {
+        switch (format)
+        {
+            case EnumColorFormat::RGBA8:
+            {
+                constexpr float inv = 1.f / 255.f;
+                return Vec4f{src[0] * inv, src[1] * inv, src[2] * inv, src[3] * inv};
+            }
+            case EnumColorFormat::SRGBA8:
+            {
+                constexpr float inv = 1.f / 255.f;
+                return Vec4f{SrgbToLinear(src[0]), SrgbToLinear(src[1]), SrgbToLinear(src[2]), src[3] * inv};
+            }
+            case EnumColorFormat::R11G11B10F:
+            {
+                uint32_t packed = 0;
+                std::memcpy(&packed, src, sizeof(packed));
+                Simd::Int4 halves = Simd::SetInt(static_cast<int32_t>((packed & 0x7ffu) << 4),
+                                                 static_cast<int32_t>(((packed >> 11) & 0x7ffu) << 4),
+                                                 static_cast<int32_t>(((packed >> 22) & 0x3ffu) << 5),
+                                                 0x3c00);
+                return StoreColor(HalfToFloat4(halves));
+            }
+            case EnumColorFormat::RGBA16F:
+            {
+                uint16_t packed[4];
+                std::memcpy(packed, src, sizeof(packed));
+                return StoreColor(HalfToFloat4(Simd::SetInt(packed[0], packed[1], packed[2], packed[3])));
+            }
+        }
+        return Vec4f{};
+    }
+
+    void UnpackColors(EnumColorFormat format, const uint8_t* src, int count, Vec4f* colors)
+    {
+        int index = 0;
+#if JOY_SIMD_SSE2
+        if (format == EnumColorFormat::RGBA8)
+        {
+            const __m128  scale = _mm_set1_ps(1.f / 255.f);
+            const __m128i zero  = _mm_setzero_si128();
+            for (; index + 4 <= count; index += 4)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + index * 4));
+                __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+                __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+                float*  dst   = &colors[index][0];
+                _mm_storeu_ps(dst + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+                _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+                _mm_storeu_ps(dst + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+                _mm_storeu_ps(dst + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+            }
+        }
+#endif
+        const int bytesPerPixel = GetBytesPerPixel(format);
+        for (; index < count; ++index)
+        {
+            colors[index] = UnpackColor(format, src + index * bytesPerPixel);
+        }
+    }
+
+    uint32_t PackDepth(EnumDepthFormat format, float depth)
+    {
+        switch (format)
+        {
+            case EnumDepthFormat::D16:
+                return static_cast<uint32_t>(std::min(std::max(depth, 0.f), 1.f) * 65535.0 + 0.5);
+            case EnumDepthFormat::D24:
+                return static_cast<uint32_t>(std::min(std::max(depth, 0.f), 1.f) * 16777215.0 + 0.5);
+            case EnumDepthFormat::D32F:
+                return FloatBits(depth);
+        }
+        return 0;
+    }
+
+    float UnpackDepth(EnumDepthFormat format, uint32_t bits)
+    {
+        switch (format)
+        {
+            case EnumDepthFormat::D16:
+                return static_cast<float>((bits & 0xffffu) / 65535.0);
+            case EnumDepthFormat::D24:
+                return static_cast<float>((bits & 0xffffffu) / 16777215.0);
+            case EnumDepthFormat::D32F:
+                return BitsToFloat(bits);
+        }
+        return 0.f;
+    }
+}   // namespace Joy
@@ -0,0 +1,168 @@
+/**
+ * @file PixelFormat.h
+ * @author JoyatY
+ * @brief 帧缓冲像素格式及格式转换
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Vec.h"
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 颜色缓冲格式
+     *
+     */
+    enum class EnumColorFormat
+    {
+        /**
+         * @brief 每通道8位无符号归一化整数，4字节
+         *
+         */
+        RGBA8 = 0,
+
+        /**
+         * @brief 无符号小浮点数(R11/G11/B10)，无Alpha通道，4字节
+         *
+         */
+        R11G11B10F = 1,
+
+        /**
+         * @brief 每通道半精度浮点，8字节
+         *
+         */
+        RGBA16F = 2,
+
+        /**
+         * @brief RGB为8位sRGB编码、Alpha为8位线性值，4字节；着色与混合仍在线性空间，读写时查表编解码
+         *
+         */
+        SRGBA8 = 3,
+    };
+
+    /**
+     * @brief 深度缓冲格式
+     *
+     */
+    enum class EnumDepthFormat
+    {
+        /**
+         * @brief 16位无符号归一化整数深度，2字节
+         *
+         */
+        D16 = 0,
+
+        /**
+         * @brief 24位无符号归一化整数深度(高8位保留)，4字节
+         *
+         */
+        D24 = 1,
+
+        /**
+         * @brief 32位浮点深度，4字节
+         *
+         */
+        D32F = 2,
+    };
+
+    /**
+     * @brief 获取颜色格式每像素字节数
+     *
+     * @param format
+     * @return int
+     */
+    constexpr int GetBytesPerPixel(EnumColorFormat format)
+    {
+        return format == EnumColorFormat::RGBA16F ? 8 : 4;
+    }
+
+    /**
+     * @brief 获取深度格式每像素字节数
+     *
+     * @param format
+     * @return int
+     */
+    constexpr int GetBytesPerPixel(EnumDepthFormat format)
+    {
+        return format == EnumDepthFormat::D16 ? 2 : 4;
+    }
+
+    /**
+     * @brief 单精度浮点转半精度浮点(就近舍入到偶数)
+     *
+     * @param value
+     * @return uint16_t
+     */
+    uint16_t FloatToHalf(float value);
+
+    /**
+     * @brief 半精度浮点转单精度浮点
+     *
+     * @param value
+     * @return float
+     */
+    float HalfToFloat(uint16_t value);
+
+    /**
+     * @brief 将颜色打包为指定格式，写入dst(dst至少容纳GetBytesPerPixel(format)字节)
+     *
+     * @param format
+     * @param color
+     * @param dst
+     */
+    void PackColor(EnumColorFormat format, const Vec4f& color, uint8_t* dst);
+
+    /**
+     * @brief 批量打包连续的颜色，SIMD实现，每次处理4个像素
+     *
+     * @param format
+     * @param colors 输入颜色数组
+     * @param count 颜色数量
+     * @param dst 输出像素首地址
+     */
+    void PackColors(EnumColorFormat format, const Vec4f* colors, int count, uint8_t* dst);
+
+    /**
+     * @brief 从指定格式解包颜色
+     *
+     * @param format
+     * @param src
+     * @return Vec4f
+     */
+    Vec4f UnpackColor(EnumColorFormat format, const uint8_t* src);
+
+    /**
+     * @brief 批量解包连续的颜色
+     *
+     * @param format
+     * @param src 输入像素首地址
+     * @param count 像素数量
+     * @param colors 输出颜色数组
+     */
+    void UnpackColors(EnumColorFormat format, const uint8_t* src, int count, Vec4f* colors);
+
+    /**
+     * @brief 将[0, 1]深度打包为指定格式的位模式，返回值低GetBytesPerPixel(format)字节有效
+     *
+     * @param format
+     * @param depth
+     * @return uint32_t
+     */
+    uint32_t PackDepth(EnumDepthFormat format, float depth);
+
+    /**
+     * @brief 从位模式解包深度
+     *
+     * @param format
+     * @param bits
+     * @return float
+     */
+    float UnpackDepth(EnumDepthFormat format, uint32_t bits);
+}   // namespace Joy
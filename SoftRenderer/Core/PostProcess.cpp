@@ -0,0 +1,293 @@
+#include "Core/PostProcess.h"
+#include "Core/SimdKernels.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Joy
+{
+    namespace
+    {
+        static_assert(PostProcessor::TILE_SIZE % FrameBuffer::TILE_SIZE == 0, "post process tiles must cover whole frame buffer tiles");
+
+        /**
+         * @brief FXAA参数，与FXAA 3.11的默认值一致
+         *
+         */
+        constexpr float FXAA_EDGE_THRESHOLD     = 1.f / 8.f;
+        constexpr float FXAA_EDGE_THRESHOLD_MIN = 1.f / 16.f;
+        constexpr float FXAA_REDUCE_MUL         = 1.f / 8.f;
+        constexpr float FXAA_REDUCE_MIN         = 1.f / 128.f;
+
+        /**
+         * @brief 矩形区域[min, max)
+         *
+         */
+        struct Region
+        {
+            int minX;
+            int minY;
+            int maxX;
+            int maxY;
+
+            int GetWidth() const { return maxX - minX; }
+            int GetHeight() const { return maxY - minY; }
+        };
+
+        Region Expand(const Region& region, int border, int width, int height)
+        {
+            return Region{std::max(region.minX - border, 0), std::max(region.minY - border, 0), std::min(region.maxX + border, width), std::min(region.maxY + border, height)};
+        }
+
+        inline Simd::Float4 LoadPixel(const Vec4f& pixel) { return Simd::Load(&pixel[0]); }
+
+        /**
+         * @brief 只保留RGB通道的掩码
+         *
+         */
+        inline Simd::Float4 RgbMask() { return Simd::AsFloat(Simd::SetInt(-1, -1, -1, 0)); }
+
+        /**
+         * @brief ACES胶片曲线的有理函数近似(Narkowicz 2015)，结果截断到[0, 1]
+         *
+         */
+        inline Simd::Float4 ToneMapAces(Simd::Float4 color)
+        {
+            using namespace Simd;
+            const Float4 numerator   = color * MulAdd(color, Splat(2.51f), Splat(0.03f));
+            const Float4 denominator = MulAdd(color, MulAdd(color, Splat(2.43f), Splat(0.59f)), Splat(0.14f));
+            return Min(Max(numerator / denominator, Splat(0.f)), Splat(1.f));
+        }
+
+        /**
+         * @brief 线性值转sRGB编码，幂函数部分以三级平方根的线性组合近似，误差小于0.5/255
+         *
+         */
+        inline Simd::Float4 LinearToSrgb(Simd::Float4 color)
+        {
+            using namespace Simd;
+            const Float4 x      = Min(Max(color, Splat(0.f)), Splat(1.f));
+            const Float4 sqrt1  = Sqrt(x);
+            const Float4 sqrt2  = Sqrt(sqrt1);
+            const Float4 sqrt3  = Sqrt(sqrt2);
+            const Float4 curve  = MulAdd(sqrt1, Splat(0.585122381f), MulAdd(sqrt2, Splat(0.783140355f), sqrt3 * Splat(-0.368262736f)));
+            const Float4 linear = x * Splat(12.92f);
+            return Min(Select(CmpLe(x, Splat(0.0031308f)), linear, curve), Splat(1.f));
+        }
+
+        inline float Luma(const Vec4f& color) { return color[0] * 0.299f + color[1] * 0.587f + color[2] * 0.114f; }
+
+        /**
+         * @brief 在区域缓存中双线性采样，坐标以像素中心为整数，超出画面时取边缘像素
+         *
+         */
+        inline Simd::Float4 SampleBilinear(const Vec4f* pixels, const Region& region, int width, int height, float x, float y)
+        {
+            using namespace Simd;
+            const float floorX = std::floor(x);
+            const float floorY = std::floor(y);
+            const float fx     = x - floorX;
+            const float fy     = y - floorY;
+            const int   x0     = std::min(std::max(static_cast<int>(floorX), 0), width - 1) - region.minX;
+            const int   y0     = std::min(std::max(static_cast<int>(floorY), 0), height - 1) - region.minY;
+            const int   x1     = std::min(std::max(static_cast<int>(floorX) + 1, 0), width - 1) - region.minX;
+            const int   y1     = std::min(std::max(static_cast<int>(floorY) + 1, 0), height - 1) - region.minY;
+            const int   stride = region.GetWidth();
+            const Float4 top    = MulAdd(LoadPixel(pixels[y0 * stride + x1]) - LoadPixel(pixels[y0 * stride + x0]), Splat(fx), LoadPixel(pixels[y0 * stride + x0]));
+            const Float4 bottom = MulAdd(LoadPixel(pixels[y1 * stride + x1]) - LoadPixel(pixels[y1 * stride + x0]), Splat(fx), LoadPixel(pixels[y1 * stride + x0]));
+            return MulAdd(bottom - top, Splat(fy), top);
+        }
+    }   // namespace
+
+    PostProcessor::PostProcessor(ThreadPool* threadPool)
+        : m_ThreadPool(threadPool)
+        , m_Settings()
+        , m_TileSchedule()
+        , m_BloomWeights()
+        , m_Scratch(threadPool ? threadPool->GetThreadCount() : 1)
+    {
+        SetSettings(m_Settings);
+    }
+
+    void PostProcessor::SetSettings(const PostProcessSettings& settings)
+    {
+        m_Settings = settings;
+        // 高斯核截断到3倍标准差
+        const float sigma  = std::max(settings.bloomSigma, 0.1f);
+        const int   radius = std::min(static_cast<int>(std::ceil(sigma * 3.f)), MAX_BLOOM_RADIUS);
+        m_BloomWeights.resize(radius * 2 + 1);
+        float sum = 0.f;
+        for (int k = -radius; k <= radius; ++k)
+        {
+            m_BloomWeights[k + radius] = std::exp(-static_cast<float>(k * k) / (2.f * sigma * sigma));
+            sum += m_BloomWeights[k + radius];
+        }
+        for (float& weight : m_BloomWeights)
+        {
+            weight /= sum;
+        }
+    }
+
+    void PostProcessor::Process(const FrameBuffer& source, FrameBuffer& destination)
+    {
+        assert(&source != &destination);
+        assert(source.GetWidth() == destination.GetWidth() && source.GetHeight() == destination.GetHeight());
+        const int tileCountX = (source.GetWidth() + TILE_SIZE - 1) / TILE_SIZE;
+        const int tileCountY = (source.GetHeight() + TILE_SIZE - 1) / TILE_SIZE;
+        m_TileSchedule.Resize(tileCountX, tileCountY);
+        m_TileSchedule.ForEach(m_ThreadPool, [&](int tileIndex, int threadIndex) {
+            ProcessTile(source, destination, tileIndex % tileCountX, tileIndex / tileCountX, m_Scratch[threadIndex]);
+        });
+    }
+
+    void PostProcessor::ProcessTile(const FrameBuffer& source, FrameBuffer& destination, int tileX, int tileY, TileScratch& scratch) const
+    {
+        using namespace Simd;
+        const int    width      = source.GetWidth();
+        const int    height     = source.GetHeight();
+        const int    bloomRadius = m_Settings.bloom ? GetBloomRadius() : 0;
+        const Region tile{tileX * TILE_SIZE, tileY * TILE_SIZE, std::min((tileX + 1) * TILE_SIZE, width), std::min((tileY + 1) * TILE_SIZE, height)};
+        // FXAA的采样跨度加双线性的1像素；泛光模糊在此基础上再扩展半径
+        const Region ldrRegion    = Expand(tile, m_Settings.fxaa ? FXAA_SPAN_MAX + 1 : 0, width, height);
+        const Region sourceRegion = Expand(ldrRegion, bloomRadius, width, height);
+        const int    sourceWidth  = sourceRegion.GetWidth();
+        const int    ldrWidth     = ldrRegion.GetWidth();
+
+        // 读取源像素，快速清除的分块由GetColorSpan直接填充清除色
+        scratch.source.resize(static_cast<size_t>(sourceWidth) * sourceRegion.GetHeight());
+        for (int y = sourceRegion.minY; y < sourceRegion.maxY; ++y)
+        {
+            source.GetColorSpan(sourceRegion.minX, y, sourceWidth, &scratch.source[static_cast<size_t>(y - sourceRegion.minY) * sourceWidth]);
+        }
+
+        const SimdKernels& kernels  = GetSimdKernels();
+        const Float4       exposure = Splat(m_Settings.exposure);
+        const Float4       rgbMask  = RgbMask();
+        if (bloomRadius > 0)
+        {
+            // 亮部提取与水平模糊逐行融合，只输出LDR区域的列；亮部行两侧以边缘值填充半径宽度，卷积内核无需钳制下标
+            const Float4 threshold = Splat(m_Settings.bloomThreshold);
+            scratch.bright.resize(sourceWidth + bloomRadius * 2);
+            scratch.horizontal.resize(static_cast<size_t>(ldrWidth) * sourceRegion.GetHeight());
+            for (int row = 0; row < sourceRegion.GetHeight(); ++row)
+            {
+                const Vec4f* sourceRow = &scratch.source[static_cast<size_t>(row) * sourceWidth];
+                Vec4f*       bright    = &scratch.bright[bloomRadius];
+                for (int x = 0; x < sourceWidth; ++x)
+                {
+                    Store(&bright[x][0], And(Max(LoadPixel(sourceRow[x]) * exposure - threshold, Splat(0.f)), rgbMask));
+                }
+                std::fill(scratch.bright.begin(), scratch.bright.begin() + bloomRadius, bright[0]);
+                std::fill(scratch.bright.end() - bloomRadius, scratch.bright.end(), bright[sourceWidth - 1]);
+
+                kernels.convolveRow(&scratch.bright[ldrRegion.minX - sourceRegion.minX], m_BloomWeights.data(), bloomRadius * 2 + 1, ldrWidth,
+                                    &scratch.horizontal[static_cast<size_t>(row) * ldrWidth]);
+            }
+        }
+
+        // 垂直模糊、合成、色调映射与Gamma校正逐行融合
+        scratch.ldr.resize(static_cast<size_t>(ldrWidth) * ldrRegion.GetHeight());
+        scratch.luma.resize(scratch.ldr.size());
+        const Float4 bloomIntensity = Splat(m_Settings.bloomIntensity);
+        for (int y = ldrRegion.minY; y < ldrRegion.maxY; ++y)
+        {
+            const Vec4f* sourceRow = &scratch.source[static_cast<size_t>(y - sourceRegion.minY) * sourceWidth + (ldrRegion.minX - sourceRegion.minX)];
+            Vec4f*       ldrRow    = &scratch.ldr[static_cast<size_t>(y - ldrRegion.minY) * ldrWidth];
+            for (int x = 0; x < ldrWidth; ++x)
+            {
+                Store(&ldrRow[x][0], LoadPixel(sourceRow[x]) * exposure);
+            }
+            if (bloomRadius > 0)
+            {
+                // 按核的行累加，内层循环连续访问一行
+                std::fill(scratch.bright.begin(), scratch.bright.begin() + ldrWidth, Vec4f{});
+                for (int k = -bloomRadius; k <= bloomRadius; ++k)
+                {
+                    const int row = std::min(std::max(y + k - sourceRegion.minY, 0), sourceRegion.GetHeight() - 1);
+                    kernels.accumulateRow(&scratch.horizontal[static_cast<size_t>(row) * ldrWidth], m_BloomWeights[k + bloomRadius], ldrWidth,
+                                          scratch.bright.data());
+                }
+                for (int x = 0; x < ldrWidth; ++x)
+                {
+                    Store(&ldrRow[x][0], MulAdd(LoadPixel(scratch.bright[x]), bloomIntensity, LoadPixel(ldrRow[x])));
+                }
+            }
+            float* lumaRow = &scratch.luma[static_cast<size_t>(y - ldrRegion.minY) * ldrWidth];
+            for (int x = 0; x < ldrWidth; ++x)
+            {
+                Float4 color = LoadPixel(ldrRow[x]);
+                if (m_Settings.toneMapping)
+                {
+                    color = ToneMapAces(color);
+                }
+                if (m_Settings.gammaCorrection)
+                {
+                    color = LinearToSrgb(color);
+                }
+                // Alpha通道不参与曝光、泛光与色调映射
+                color = Select(rgbMask, color, LoadPixel(sourceRow[x]));
+                Store(&ldrRow[x][0], color);
+                lumaRow[x] = Luma(ldrRow[x]);
+            }
+        }
+
+        // FXAA并打包写入目标
+        scratch.output.resize(tile.GetWidth());
+        auto lumaAt = [&](int x, int y) {
+            x = std::min(std::max(x, 0), width - 1);
+            y = std::min(std::max(y, 0), height - 1);
+            return scratch.luma[static_cast<size_t>(y - ldrRegion.minY) * ldrWidth + (x - ldrRegion.minX)];
+        };
+        for (int y = tile.minY; y < tile.maxY; ++y)
+        {
+            const Vec4f* ldrRow = &scratch.ldr[static_cast<size_t>(y - ldrRegion.minY) * ldrWidth];
+            for (int x = tile.minX; x < tile.maxX; ++x)
+            {
+                const Vec4f& center = ldrRow[x - ldrRegion.minX];
+                Vec4f&       output = scratch.output[x - tile.minX];
+                output              = center;
+                if (!m_Settings.fxaa)
+                {
+                    continue;
+                }
+                const float lumaM   = lumaAt(x, y);
+                const float lumaNW  = lumaAt(x - 1, y - 1);
+                const float lumaNE  = lumaAt(x + 1, y - 1);
+                const float lumaSW  = lumaAt(x - 1, y + 1);
+                const float lumaSE  = lumaAt(x + 1, y + 1);
+                const float lumaMin = std::min(lumaM, std::min(std::min(lumaNW, lumaNE), std::min(lumaSW, lumaSE)));
+                const float lumaMax = std::max(lumaM, std::max(std::max(lumaNW, lumaNE), std::max(lumaSW, lumaSE)));
+                if (lumaMax - lumaMin < std::max(FXAA_EDGE_THRESHOLD_MIN, lumaMax * FXAA_EDGE_THRESHOLD))
+                {
+                    continue;
+                }
+
+                // 沿边缘切线方向采样
+                float       dirX      = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+                float       dirY      = (lumaNW + lumaSW) - (lumaNE + lumaSE);
+                const float dirReduce = std::max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25f * FXAA_REDUCE_MUL), FXAA_REDUCE_MIN);
+                const float rcpDirMin = 1.f / (std::min(std::abs(dirX), std::abs(dirY)) + dirReduce);
+                dirX = std::min(std::max(dirX * rcpDirMin, -static_cast<float>(FXAA_SPAN_MAX)), static_cast<float>(FXAA_SPAN_MAX));
+                dirY = std::min(std::max(dirY * rcpDirMin, -static_cast<float>(FXAA_SPAN_MAX)), static_cast<float>(FXAA_SPAN_MAX));
+
+                const Vec4f* ldr = scratch.ldr.data();
+                const float  fx  = static_cast<float>(x);
+                const float  fy  = static_cast<float>(y);
+                const Float4 rgbA =
+                    (SampleBilinear(ldr, ldrRegion, width, height, fx + dirX * (1.f / 3.f - 0.5f), fy + dirY * (1.f / 3.f - 0.5f)) +
+                     SampleBilinear(ldr, ldrRegion, width, height, fx + dirX * (2.f / 3.f - 0.5f), fy + dirY * (2.f / 3.f - 0.5f))) *
+                    Splat(0.5f);
+                const Float4 rgbB = MulAdd(SampleBilinear(ldr, ldrRegion, width, height, fx - dirX * 0.5f, fy - dirY * 0.5f) +
+                                               SampleBilinear(ldr, ldrRegion, width, height, fx + dirX * 0.5f, fy + dirY * 0.5f),
+                                           Splat(0.25f),
+                                           rgbA * Splat(0.5f));
+                Vec4f resultB;
+                Store(&resultB[0], rgbB);
+                const float lumaB = Luma(resultB);
+                Store(&output[0], Select(rgbMask, (lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, LoadPixel(center)));
+            }
+            destination.SetColorSpan(tile.minX, y, tile.GetWidth(), scratch.output.data());
+        }
+    }
+}   // namespace Joy
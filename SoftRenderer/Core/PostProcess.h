@@ -0,0 +1,156 @@
+/**
+ * @file PostProcess.h
+ * @author JoyatY
+ * @brief 多线程SIMD后处理链: 色调映射、Gamma校正、泛光与FXAA
+ * @version 0.1
+ * @date 2025-12-25
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include "Core/ThreadPool.h"
+#include "Core/TileSchedule.h"
+#include "Math/Vec.h"
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 后处理参数
+     *
+     */
+    struct PostProcessSettings
+    {
+        /**
+         * @brief 曝光，在所有效果之前乘到HDR颜色上
+         *
+         */
+        float exposure = 1.f;
+
+        /**
+         * @brief ACES近似曲线色调映射，关闭时颜色在打包时截断到[0, 1]
+         *
+         */
+        bool toneMapping = true;
+
+        /**
+         * @brief 线性空间转sRGB编码
+         *
+         */
+        bool gammaCorrection = true;
+
+        /**
+         * @brief 泛光: 超过阈值的亮度经可分离高斯模糊后叠加回原色
+         *
+         */
+        bool  bloom          = false;
+        float bloomThreshold = 1.f;
+        float bloomIntensity = 0.5f;
+        float bloomSigma     = 2.f;
+
+        /**
+         * @brief 快速近似抗锯齿，在色调映射与Gamma校正之后的结果上执行
+         *
+         */
+        bool fxaa = false;
+    };
+
+    /**
+     * @brief 后处理器
+     *
+     * 画面划分为TILE_SIZE x TILE_SIZE的块，各块在线程池中并行处理。每块把所需的源像素(含各效果需要的边缘)一次读入线程私有缓存，
+     * 依次执行泛光水平模糊、垂直模糊与合成、色调映射、Gamma校正、FXAA，最后打包写入目标，整条链只遍历帧缓冲一次，
+     * 中间结果留在缓存中。块边缘的重复计算换来块之间互不依赖，结果与线程数无关。
+     * 分块默认按Hilbert顺序以固定的线程归属调度(TileSchedule)，相邻块共用的边缘源像素多半已在同一核心的缓存中。
+     */
+    class PostProcessor
+    {
+    public:
+        /**
+         * @brief 分块尺寸，须为FrameBuffer::TILE_SIZE的整数倍，保证并行写入的目标分块互不重叠
+         *
+         */
+        constexpr static int TILE_SIZE = 128;
+
+        /**
+         * @brief 泛光模糊的最大半径(像素)
+         *
+         */
+        constexpr static int MAX_BLOOM_RADIUS = 16;
+
+        /**
+         * @brief FXAA沿边缘方向采样的最大跨度(像素)
+         *
+         */
+        constexpr static int FXAA_SPAN_MAX = 8;
+
+    public:
+        /**
+         * @brief 构造后处理器
+         *
+         * @param threadPool 线程池，为空时在调用线程中串行处理
+         */
+        explicit PostProcessor(ThreadPool* threadPool = nullptr);
+
+    public:
+        void                       SetSettings(const PostProcessSettings& settings);
+        const PostProcessSettings& GetSettings() const { return m_Settings; }
+
+        /**
+         * @brief 设置分块的遍历顺序与分配方式，不影响结果
+         *
+         * @param order
+         * @param scheduling
+         */
+        void                SetTileOrder(EnumTileOrder order, EnumTileScheduling scheduling = EnumTileScheduling::AFFINE) { m_TileSchedule.SetOrder(order, scheduling); }
+        const TileSchedule& GetTileSchedule() const { return m_TileSchedule; }
+
+        /**
+         * @brief 泛光模糊半径，由bloomSigma决定
+         *
+         */
+        int GetBloomRadius() const { return static_cast<int>(m_BloomWeights.size()) / 2; }
+
+        /**
+         * @brief 执行后处理链
+         *
+         * @param source 源帧缓冲(通常为HDR格式)
+         * @param destination 目标帧缓冲，尺寸与source一致且不能是同一个帧缓冲
+         */
+        void Process(const FrameBuffer& source, FrameBuffer& destination);
+
+    private:
+        /**
+         * @brief 线程私有的分块缓存
+         *
+         */
+        struct TileScratch
+        {
+            std::vector<Vec4f> source;
+            std::vector<Vec4f> bright;
+            std::vector<Vec4f> horizontal;
+            std::vector<Vec4f> ldr;
+            std::vector<float> luma;
+            std::vector<Vec4f> output;
+        };
+
+        void ProcessTile(const FrameBuffer& source, FrameBuffer& destination, int tileX, int tileY, TileScratch& scratch) const;
+
+    private:
+        ThreadPool*         m_ThreadPool;
+        PostProcessSettings m_Settings;
+        TileSchedule        m_TileSchedule;
+
+        /**
+         * @brief 归一化的高斯权重，长度为2 * 半径 + 1
+         *
+         */
+        std::vector<float> m_BloomWeights;
+
+        std::vector<TileScratch> m_Scratch;
+    };
+}   // namespace Joy
@@ -0,0 +1,660 @@
+/**
+ * @file Rasterizer.h
+ * @author JoyatY
+ * @brief 三角形光栅化(边函数 + SIMD覆盖计算)，支持1x/4x/8x采样
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/SimdKernels.h"
+#include "Math/Fixed.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 面剔除模式(逆时针为正面)
+     *
+     */
+    enum class EnumCullMode
+    {
+        NONE  = 0,
+        BACK  = 1,
+        FRONT = 2,
+    };
+
+    /**
+     * @brief 深度测试函数，LESS用于标准深度，GREATER用于反向Z(近处深度为1)
+     *
+     */
+    enum class EnumDepthTest
+    {
+        LESS    = 0,
+        GREATER = 1,
+    };
+
+    /**
+     * @brief 深度测试
+     *
+     * @param depthTest
+     * @param depth 片元深度
+     * @param stored 缓冲中的深度
+     * @return true 通过测试
+     */
+    inline bool DepthTestPass(EnumDepthTest depthTest, float depth, float stored)
+    {
+        return depthTest == EnumDepthTest::LESS ? depth < stored : depth > stored;
+    }
+
+    /**
+     * @brief 屏幕空间顶点(已完成透视除法和视口变换)
+     *
+     */
+    struct RasterVertex
+    {
+        float x;
+        float y;
+        float z;
+        float invW;
+    };
+
+    /**
+     * @brief 像素矩形区域，左闭右开[min, max)
+     *
+     */
+    struct RasterRect
+    {
+        int minX;
+        int minY;
+        int maxX;
+        int maxY;
+    };
+
+    /**
+     * @brief 最大采样数
+     *
+     */
+    constexpr int MAX_SAMPLE_COUNT = 8;
+
+    /**
+     * @brief 多重采样位置(相对像素左上角，D3D标准采样模式)
+     *
+     */
+    struct SamplePattern
+    {
+        int   count;
+        float x[MAX_SAMPLE_COUNT];
+        float y[MAX_SAMPLE_COUNT];
+    };
+
+    /**
+     * @brief 获取指定采样数的采样模式，支持1/4/8
+     *
+     * @param sampleCount
+     * @return const SamplePattern&
+     */
+    inline const SamplePattern& GetSamplePattern(int sampleCount)
+    {
+        static constexpr SamplePattern PATTERN_1X{1, {0.5f}, {0.5f}};
+        static constexpr SamplePattern PATTERN_4X{4, {0.375f, 0.875f, 0.125f, 0.625f}, {0.125f, 0.375f, 0.625f, 0.875f}};
+        static constexpr SamplePattern PATTERN_8X{8,
+                                                  {0.5625f, 0.4375f, 0.8125f, 0.3125f, 0.1875f, 0.0625f, 0.6875f, 0.9375f},
+                                                  {0.3125f, 0.6875f, 0.5625f, 0.1875f, 0.8125f, 0.4375f, 0.9375f, 0.0625f}};
+        return sampleCount == 8 ? PATTERN_8X : sampleCount == 4 ? PATTERN_4X : PATTERN_1X;
+    }
+
+    /**
+     * @brief 光栅化保护带(像素)，坐标超出±RASTER_GUARD_BAND的三角形被丢弃，保证24.8定点原始值之差不超出int32范围
+     *
+     */
+    constexpr float RASTER_GUARD_BAND = 2097152.f;
+
+    /**
+     * @brief 完成建立的三角形光栅化数据
+     *
+     * 边k为顶点k的对边，E_k(p) = edgeA[k] * x + edgeB[k] * y + edgeC[k]，三条边均 >= 0 时点在三角形内，
+     * E_k / area 即顶点k的屏幕空间重心坐标。
+     */
+    struct RasterTriangle
+    {
+        float      edgeA[3];
+        float      edgeB[3];
+        float      edgeC[3];
+        bool       edgeTopLeft[3];
+        float      invArea;
+        float      invW[3];
+        float      depthA;
+        float      depthB;
+        float      depthC;
+        RasterRect bounds;
+    };
+
+    /**
+     * @brief 三角形建立: 顶点吸附到1/256子像素网格，计算边函数、深度平面及包围盒，并进行面剔除
+     *
+     * 吸附后的坐标以24.8定点数表示，面积符号、剔除、左上规则与包围盒均由精确的整数运算得出，与浮点舍入无关；
+     * 边函数系数最后转换为浮点供SIMD遍历使用。坐标须在±2^21像素的保护带内，超出(或为NaN)的三角形被丢弃。
+     *
+     * @param v0
+     * @param v1
+     * @param v2
+     * @param cullMode 面剔除模式
+     * @param scissor 裁剪矩形
+     * @param tri 输出的光栅化数据
+     * @return true 三角形需要光栅化
+     * @return false 三角形被剔除、退化或在裁剪矩形外
+     */
+    inline bool SetupTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2, EnumCullMode cullMode, const RasterRect& scissor,
+                              RasterTriangle& tri)
+    {
+        const RasterVertex* v[3] = {&v0, &v1, &v2};
+        Fixed24_8           x[3];
+        Fixed24_8           y[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!(std::abs(v[i]->x) <= RASTER_GUARD_BAND && std::abs(v[i]->y) <= RASTER_GUARD_BAND))
+            {
+                return false;
+            }
+            x[i] = Fixed24_8{v[i]->x};
+            y[i] = Fixed24_8{v[i]->y};
+        }
+        // 原始值之积含16位小数，以64位整数精确计算
+        const int64_t area = static_cast<int64_t>(x[1].Raw() - x[0].Raw()) * (y[2].Raw() - y[0].Raw()) -
+                             static_cast<int64_t>(y[1].Raw() - y[0].Raw()) * (x[2].Raw() - x[0].Raw());
+        // 屏幕空间y轴向下，area < 0 对应NDC中的逆时针(正面)
+        if (area == 0 || (cullMode == EnumCullMode::BACK && area > 0) || (cullMode == EnumCullMode::FRONT && area < 0))
+        {
+            return false;
+        }
+
+        tri.bounds.minX = std::max(scissor.minX, std::min({x[0], x[1], x[2]}).Floor());
+        tri.bounds.minY = std::max(scissor.minY, std::min({y[0], y[1], y[2]}).Floor());
+        tri.bounds.maxX = std::min(scissor.maxX, std::max({x[0], x[1], x[2]}).Ceil());
+        tri.bounds.maxY = std::min(scissor.maxY, std::max({y[0], y[1], y[2]}).Ceil());
+        if (tri.bounds.minX >= tri.bounds.maxX || tri.bounds.minY >= tri.bounds.maxY)
+        {
+            return false;
+        }
+
+        // 统一为正向绕序，保证三角形内部的边函数均为正
+        const int32_t orientation = area > 0 ? 1 : -1;
+        for (int k = 0; k < 3; ++k)
+        {
+            const int     from  = (k + 1) % 3;
+            const int     to    = (k + 2) % 3;
+            const int32_t edgeA = (y[from].Raw() - y[to].Raw()) * orientation;
+            const int32_t edgeB = (x[to].Raw() - x[from].Raw()) * orientation;
+            const int64_t edgeC = -(static_cast<int64_t>(edgeA) * x[from].Raw() + static_cast<int64_t>(edgeB) * y[from].Raw());
+            tri.edgeA[k]        = static_cast<float>(edgeA) * (1.f / Fixed24_8::ONE);
+            tri.edgeB[k]        = static_cast<float>(edgeB) * (1.f / Fixed24_8::ONE);
+            tri.edgeC[k]        = static_cast<float>(edgeC) * (1.f / (Fixed24_8::ONE * Fixed24_8::ONE));
+            tri.edgeTopLeft[k]  = edgeA > 0 || (edgeA == 0 && edgeB > 0);
+            tri.invW[k]         = v[k]->invW;
+        }
+        tri.invArea = static_cast<float>(Fixed24_8::ONE * Fixed24_8::ONE) / static_cast<float>(area * orientation);
+        tri.depthA  = (tri.edgeA[0] * v0.z + tri.edgeA[1] * v1.z + tri.edgeA[2] * v2.z) * tri.invArea;
+        tri.depthB  = (tri.edgeB[0] * v0.z + tri.edgeB[1] * v1.z + tri.edgeB[2] * v2.z) * tri.invArea;
+        tri.depthC  = (tri.edgeC[0] * v0.z + tri.edgeC[1] * v1.z + tri.edgeC[2] * v2.z) * tri.invArea;
+        return true;
+    }
+
+    /**
+     * @brief 小三角形快速路径的包围盒尺寸上限(像素)
+     *
+     */
+    constexpr int MICRO_TRIANGLE_SIZE = 4;
+
+    /**
+     * @brief 一批待光栅化的小三角形，每个SIMD通道存放一个三角形
+     *
+     * 顶点坐标为相对包围盒左上像素的24.8定点原始值(以浮点存放)。足迹不超过MICRO_TRIANGLE_SIZE像素时原始值不超过1024，
+     * 面积与边函数的乘积、和均为绝对值小于2^24的整数，浮点运算没有舍入，覆盖结果与整数建立完全一致。
+     */
+    struct MicroTriangleBatch
+    {
+        constexpr static int CAPACITY = 4;
+
+        int   count  = 0;
+        int   width  = 0;
+        int   height = 0;
+        float originX[CAPACITY];
+        float originY[CAPACITY];
+        float x[3][CAPACITY];
+        float y[3][CAPACITY];
+        float z[3][CAPACITY];
+        float invW[3][CAPACITY];
+
+        bool IsFull() const { return count == CAPACITY; }
+
+        /**
+         * @brief 清空批次
+         *
+         */
+        void Reset()
+        {
+            count  = 0;
+            width  = 0;
+            height = 0;
+        }
+    };
+
+    /**
+     * @brief 尝试将三角形加入小三角形批次
+     *
+     * 只做吸附与包围盒判断，面积、剔除与边函数在批次光栅化时以SIMD对整批三角形同时计算。
+     *
+     * @param batch 未满的批次
+     * @param v0
+     * @param v1
+     * @param v2
+     * @return true 已加入批次
+     * @return false 包围盒超出MICRO_TRIANGLE_SIZE或坐标超出保护带，应走通用建立路径
+     */
+    inline bool AddMicroTriangle(MicroTriangleBatch& batch, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2)
+    {
+        assert(!batch.IsFull());
+        // 先以浮点包围盒快速排除大三角形，吸附最多移动半个子像素
+        constexpr float MAX_EXTENT = static_cast<float>(MICRO_TRIANGLE_SIZE) + 1.f;
+        if (!(std::max({v0.x, v1.x, v2.x}) - std::min({v0.x, v1.x, v2.x}) < MAX_EXTENT &&
+              std::max({v0.y, v1.y, v2.y}) - std::min({v0.y, v1.y, v2.y}) < MAX_EXTENT))
+        {
+            return false;
+        }
+        const RasterVertex* v[3] = {&v0, &v1, &v2};
+        Fixed24_8           x[3];
+        Fixed24_8           y[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!(std::abs(v[i]->x) <= RASTER_GUARD_BAND && std::abs(v[i]->y) <= RASTER_GUARD_BAND))
+            {
+                return false;
+            }
+            x[i] = Fixed24_8{v[i]->x};
+            y[i] = Fixed24_8{v[i]->y};
+        }
+        const int32_t originX = std::min({x[0], x[1], x[2]}).Floor();
+        const int32_t originY = std::min({y[0], y[1], y[2]}).Floor();
+        const int32_t width   = std::max({x[0], x[1], x[2]}).Ceil() - originX;
+        const int32_t height  = std::max({y[0], y[1], y[2]}).Ceil() - originY;
+        if (width > MICRO_TRIANGLE_SIZE || height > MICRO_TRIANGLE_SIZE)
+        {
+            return false;
+        }
+        // 批次只遍历所有三角形足迹的并集尺寸，常见的亚像素三角形只需遍历2x2
+        batch.width         = std::max(batch.width, width);
+        batch.height        = std::max(batch.height, height);
+        const int lane      = batch.count++;
+        batch.originX[lane] = static_cast<float>(originX);
+        batch.originY[lane] = static_cast<float>(originY);
+        for (int i = 0; i < 3; ++i)
+        {
+            batch.x[i][lane]    = static_cast<float>(x[i].Raw() - originX * Fixed24_8::ONE);
+            batch.y[i][lane]    = static_cast<float>(y[i].Raw() - originY * Fixed24_8::ONE);
+            batch.z[i][lane]    = v[i]->z;
+            batch.invW[i][lane] = v[i]->invW;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 计算像素中心处的透视校正重心坐标
+     *
+     * @param tri
+     * @param px
+     * @param py
+     * @param bary 输出的重心坐标(对应原始顶点顺序)
+     */
+    inline void ComputePerspectiveBarycentric(const RasterTriangle& tri, float px, float py, float* bary)
+    {
+        float sum = 0.f;
+        for (int k = 0; k < 3; ++k)
+        {
+            bary[k] = (tri.edgeA[k] * px + tri.edgeB[k] * py + tri.edgeC[k]) * tri.invW[k];
+            sum += bary[k];
+        }
+        const float invSum = 1.f / sum;
+        for (int k = 0; k < 3; ++k)
+        {
+            bary[k] *= invSum;
+        }
+    }
+
+    namespace Detail
+    {
+        /**
+         * @brief 边函数内部测试(遵循左上填充规则)
+         *
+         */
+        inline Simd::Float4 EdgeInside(Simd::Float4 edge, Simd::Float4 topLeftMask)
+        {
+            const Simd::Float4 zero = Simd::Splat(0.f);
+            return Simd::Select(topLeftMask, Simd::CmpGe(edge, zero), Simd::CmpGt(edge, zero));
+        }
+
+        inline Simd::Float4 TopLeftMask(bool topLeft) { return Simd::AsFloat(Simd::SplatInt(topLeft ? -1 : 0)); }
+
+        /**
+         * @brief 单采样光栅化，每行按SimdKernels::SPAN_SIZE个像素一段交给运行时选择的覆盖内核
+         *
+         */
+        template<typename TPixelFunc> void RasterizeSingleSample(const RasterTriangle& tri, TPixelFunc&& pixelFunc)
+        {
+            const SimdKernels& kernels = GetSimdKernels();
+            EdgeSpan           span;
+            for (int k = 0; k < 3; ++k)
+            {
+                span.edgeA[k]       = tri.edgeA[k];
+                span.edgeTopLeft[k] = tri.edgeTopLeft[k];
+            }
+            span.depthA = tri.depthA;
+
+            float depths[SimdKernels::SPAN_SIZE];
+            for (int y = tri.bounds.minY; y < tri.bounds.maxY; ++y)
+            {
+                const float py = static_cast<float>(y) + 0.5f;
+                for (int k = 0; k < 3; ++k)
+                {
+                    span.edgeRow[k] = tri.edgeB[k] * py + tri.edgeC[k];
+                }
+                span.depthRow = tri.depthB * py + tri.depthC;
+                for (int x = tri.bounds.minX; x < tri.bounds.maxX; x += SimdKernels::SPAN_SIZE)
+                {
+                    const int count = std::min(tri.bounds.maxX - x, SimdKernels::SPAN_SIZE);
+                    uint64_t  mask  = kernels.coverSpan(span, x, count, depths);
+                    for (int lane = 0; mask != 0; ++lane, mask >>= 1)
+                    {
+                        if (mask & 1u)
+                        {
+                            float bary[3];
+                            ComputePerspectiveBarycentric(tri, static_cast<float>(x + lane) + 0.5f, py, bary);
+                            pixelFunc(x + lane, y, 1u, &depths[lane], bary);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 多重采样光栅化，每个像素的采样点分布在SIMD通道中(每4个采样一组)
+         *
+         */
+        template<typename TPixelFunc> void RasterizeMultiSample(const RasterTriangle& tri, int sampleCount, TPixelFunc&& pixelFunc)
+        {
+            using namespace Simd;
+            const SamplePattern& pattern    = GetSamplePattern(sampleCount);
+            const int            groupCount = sampleCount / 4;
+            const Float4         zero       = Splat(0.f);
+            const Float4         one        = Splat(1.f);
+            const Float4         topLeft[3] = {TopLeftMask(tri.edgeTopLeft[0]), TopLeftMask(tri.edgeTopLeft[1]), TopLeftMask(tri.edgeTopLeft[2])};
+
+            // 采样点相对像素左上角的边函数与深度增量
+            Float4 edgeOffset[MAX_SAMPLE_COUNT / 4][3];
+            Float4 depthOffset[MAX_SAMPLE_COUNT / 4];
+            for (int group = 0; group < groupCount; ++group)
+            {
+                const Float4 sx = Load(&pattern.x[group * 4]);
+                const Float4 sy = Load(&pattern.y[group * 4]);
+                for (int k = 0; k < 3; ++k)
+                {
+                    edgeOffset[group][k] = Splat(tri.edgeA[k]) * sx + Splat(tri.edgeB[k]) * sy;
+                }
+                depthOffset[group] = Splat(tri.depthA) * sx + Splat(tri.depthB) * sy;
+            }
+
+            for (int y = tri.bounds.minY; y < tri.bounds.maxY; ++y)
+            {
+                const float py = static_cast<float>(y);
+                for (int x = tri.bounds.minX; x < tri.bounds.maxX; ++x)
+                {
+                    const float px       = static_cast<float>(x);
+                    uint32_t    coverage = 0;
+                    float       depths[MAX_SAMPLE_COUNT];
+                    for (int group = 0; group < groupCount; ++group)
+                    {
+                        Float4 inside = AsFloat(SplatInt(-1));
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const Float4 edge = Splat(tri.edgeA[k] * px + tri.edgeB[k] * py + tri.edgeC[k]) + edgeOffset[group][k];
+                            inside            = And(inside, EdgeInside(edge, topLeft[k]));
+                        }
+                        const Float4 depth = Splat(tri.depthA * px + tri.depthB * py + tri.depthC) + depthOffset[group];
+                        Store(&depths[group * 4], depth);
+                        coverage |= static_cast<uint32_t>(MoveMask(And(inside, And(CmpGe(depth, zero), CmpLe(depth, one))))) << (group * 4);
+                    }
+                    if (coverage != 0)
+                    {
+                        // 着色只在像素中心进行一次
+                        float bary[3];
+                        ComputePerspectiveBarycentric(tri, px + 0.5f, py + 0.5f, bary);
+                        pixelFunc(x, y, coverage, depths, bary);
+                    }
+                }
+            }
+        }
+    }   // namespace Detail
+
+    /**
+     * @brief 光栅化三角形
+     *
+     * 对每个至少有一个采样被覆盖的像素调用一次pixelFunc(x, y, coverage, sampleDepths, bary)，
+     * coverage为采样覆盖位掩码，sampleDepths为各采样点的深度，bary为像素中心的透视校正重心坐标。
+     *
+     * @tparam TPixelFunc
+     * @param tri 三角形建立结果
+     * @param sampleCount 采样数(1/4/8)
+     * @param pixelFunc 像素回调
+     */
+    template<typename TPixelFunc> void RasterizeTriangle(const RasterTriangle& tri, int sampleCount, TPixelFunc&& pixelFunc)
+    {
+        if (sampleCount == 1)
+        {
+            Detail::RasterizeSingleSample(tri, pixelFunc);
+        }
+        else
+        {
+            Detail::RasterizeMultiSample(tri, sampleCount, pixelFunc);
+        }
+    }
+
+    /**
+     * @brief 单采样光栅化一批小三角形
+     *
+     * 三角形建立(面积、剔除、边函数、左上规则)与足迹内各像素的覆盖、深度、重心坐标均以SIMD跨通道同时计算，
+     * 省去逐三角形的建立开销。结果按三角形在批次中的顺序依次回调pixelFunc(lane, x, y, depth, bary)，
+     * 与逐个三角形光栅化的写入顺序一致。
+     *
+     * @tparam TPixelFunc
+     * @param batch 小三角形批次
+     * @param cullMode 面剔除模式
+     * @param scissor 裁剪矩形
+     * @param pixelFunc 像素回调
+     */
+    template<typename TPixelFunc> void RasterizeMicroBatch(const MicroTriangleBatch& batch, EnumCullMode cullMode, const RasterRect& scissor, TPixelFunc&& pixelFunc)
+    {
+        using namespace Simd;
+        constexpr int   SIZE        = MICRO_TRIANGLE_SIZE;
+        constexpr int   PIXEL_COUNT = SIZE * SIZE;
+        constexpr int   CAPACITY    = MicroTriangleBatch::CAPACITY;
+        constexpr float SUBPIXEL    = static_cast<float>(Fixed24_8::ONE);
+        const Float4    zero        = Splat(0.f);
+        const Float4    one         = Splat(1.f);
+
+        Float4 x[3];
+        Float4 y[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            x[i] = Load(batch.x[i]);
+            y[i] = Load(batch.y[i]);
+        }
+        const Float4 area     = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        const Float4 positive = CmpGt(area, zero);
+        const Float4 negative = CmpLt(area, zero);
+        // 屏幕空间y轴向下，area < 0 为正面
+        Float4 valid = cullMode == EnumCullMode::BACK ? negative : cullMode == EnumCullMode::FRONT ? positive : Or(positive, negative);
+        valid        = And(valid, CmpLt(Set(0.f, 1.f, 2.f, 3.f), Splat(static_cast<float>(batch.count))));
+        if (MoveMask(valid) == 0)
+        {
+            return;
+        }
+
+        // 统一为正向绕序后的边函数 E_k = A_k * x + B_k * y + C_k，均为精确整数；
+        // 非左上边的C减去1(整数单位)，使左上规则统一为 E >= 0，内部测试只需取三条边的最小值
+        const Float4 orientation = Select(positive, one, Splat(-1.f));
+        const Float4 center      = Splat(0.5f * SUBPIXEL);
+        Float4       rowEdge[3];
+        Float4       stepX[3];
+        Float4       stepY[3];
+        Float4       bias[3];
+        Float4       z[3];
+        Float4       invW[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            const int    from    = (k + 1) % 3;
+            const int    to      = (k + 2) % 3;
+            const Float4 edgeA   = (y[from] - y[to]) * orientation;
+            const Float4 edgeB   = (x[to] - x[from]) * orientation;
+            const Float4 topLeft = Or(CmpGt(edgeA, zero), And(And(CmpGe(edgeA, zero), CmpLe(edgeA, zero)), CmpGt(edgeB, zero)));
+            bias[k]              = Select(topLeft, zero, one);
+            rowEdge[k]           = edgeA * center + edgeB * center - (edgeA * x[from] + edgeB * y[from]) - bias[k];
+            stepX[k]             = edgeA * Splat(SUBPIXEL);
+            stepY[k]             = edgeB * Splat(SUBPIXEL);
+            z[k]                 = Load(batch.z[k]);
+            invW[k]              = Load(batch.invW[k]);
+        }
+        const Float4 invArea = one / Select(valid, area * orientation, one);
+        const Float4 originX = Load(batch.originX);
+        const Float4 originY = Load(batch.originY);
+        Float4       columnMask[SIZE];
+        for (int dx = 0; dx < batch.width; ++dx)
+        {
+            const Float4 pixelX = originX + Splat(static_cast<float>(dx));
+            columnMask[dx]      = And(CmpGe(pixelX, Splat(static_cast<float>(scissor.minX))), CmpLt(pixelX, Splat(static_cast<float>(scissor.maxX))));
+        }
+
+        // 先以像素为外层循环计算整批覆盖，再按三角形顺序回调
+        uint32_t coverage[CAPACITY] = {};
+        float    depths[PIXEL_COUNT][CAPACITY];
+        float    barys[PIXEL_COUNT][3][CAPACITY];
+        for (int dy = 0; dy < batch.height; ++dy)
+        {
+            const Float4 pixelY  = originY + Splat(static_cast<float>(dy));
+            const Float4 rowMask = And(valid, And(CmpGe(pixelY, Splat(static_cast<float>(scissor.minY))), CmpLt(pixelY, Splat(static_cast<float>(scissor.maxY)))));
+            Float4       edge[3] = {rowEdge[0], rowEdge[1], rowEdge[2]};
+            for (int k = 0; k < 3; ++k)
+            {
+                rowEdge[k] = rowEdge[k] + stepY[k];
+            }
+            for (int dx = 0; dx < batch.width; ++dx, edge[0] = edge[0] + stepX[0], edge[1] = edge[1] + stepX[1], edge[2] = edge[2] + stepX[2])
+            {
+                const Float4 inside = And(And(rowMask, columnMask[dx]), CmpGe(Min(Min(edge[0], edge[1]), edge[2]), zero));
+                if (MoveMask(inside) == 0)
+                {
+                    continue;
+                }
+                // 还原左上规则偏移后即为重心坐标的分子；深度裁剪丢弃[0, 1]之外的片元
+                const Float4 e0    = edge[0] + bias[0];
+                const Float4 e1    = edge[1] + bias[1];
+                const Float4 e2    = edge[2] + bias[2];
+                const Float4 depth = (e0 * z[0] + e1 * z[1] + e2 * z[2]) * invArea;
+                const int    mask  = MoveMask(And(inside, And(CmpGe(depth, zero), CmpLe(depth, one))));
+                if (mask == 0)
+                {
+                    continue;
+                }
+                const int    pixel  = dy * SIZE + dx;
+                const Float4 bary0  = e0 * invW[0];
+                const Float4 bary1  = e1 * invW[1];
+                const Float4 bary2  = e2 * invW[2];
+                const Float4 invSum = one / Select(inside, bary0 + bary1 + bary2, one);
+                Store(depths[pixel], depth);
+                Store(barys[pixel][0], bary0 * invSum);
+                Store(barys[pixel][1], bary1 * invSum);
+                Store(barys[pixel][2], bary2 * invSum);
+                for (int lane = 0; lane < CAPACITY; ++lane)
+                {
+                    coverage[lane] |= static_cast<uint32_t>((mask >> lane) & 1) << pixel;
+                }
+            }
+        }
+
+        for (int lane = 0; lane < batch.count; ++lane)
+        {
+            const int baseX = static_cast<int>(batch.originX[lane]);
+            const int baseY = static_cast<int>(batch.originY[lane]);
+            for (uint32_t bits = coverage[lane]; bits != 0; bits &= bits - 1)
+            {
+                int pixel = 0;
+                while (((bits >> pixel) & 1u) == 0)
+                {
+                    ++pixel;
+                }
+                const float bary[3] = {barys[pixel][0][lane], barys[pixel][1][lane], barys[pixel][2][lane]};
+                pixelFunc(lane, baseX + pixel % SIZE, baseY + pixel / SIZE, depths[pixel][lane], bary);
+            }
+        }
+    }
+
+    /**
+     * @brief 仅深度光栅化(阴影图等深度预渲染)，无插值变量与颜色输出，深度测试为LESS
+     *
+     * 每次以SIMD读写相邻4个像素的深度，行内起点按4对齐，因此depthBuffer的行距须为4的倍数。
+     *
+     * @param tri 三角形建立结果
+     * @param depthBuffer 深度缓冲首地址
+     * @param pitch 深度缓冲行距(元素数)
+     */
+    inline void RasterizeDepthOnly(const RasterTriangle& tri, float* depthBuffer, int pitch)
+    {
+        using namespace Simd;
+        assert(pitch % 4 == 0);
+        const Float4 laneOffset = Set(0.5f, 1.5f, 2.5f, 3.5f);
+        const Float4 zero       = Splat(0.f);
+        const Float4 one        = Splat(1.f);
+        const Float4 minX       = Splat(static_cast<float>(tri.bounds.minX));
+        const Float4 maxX       = Splat(static_cast<float>(tri.bounds.maxX));
+        const Float4 topLeft[3] = {Detail::TopLeftMask(tri.edgeTopLeft[0]), Detail::TopLeftMask(tri.edgeTopLeft[1]), Detail::TopLeftMask(tri.edgeTopLeft[2])};
+        const Float4 edgeA[3]   = {Splat(tri.edgeA[0]), Splat(tri.edgeA[1]), Splat(tri.edgeA[2])};
+        const Float4 depthA     = Splat(tri.depthA);
+        const int    startX     = tri.bounds.minX & ~3;
+
+        for (int y = tri.bounds.minY; y < tri.bounds.maxY; ++y)
+        {
+            const float  py         = static_cast<float>(y) + 0.5f;
+            const Float4 edgeRow[3] = {Splat(tri.edgeB[0] * py + tri.edgeC[0]),
+                                       Splat(tri.edgeB[1] * py + tri.edgeC[1]),
+                                       Splat(tri.edgeB[2] * py + tri.edgeC[2])};
+            const Float4 depthRow   = Splat(tri.depthB * py + tri.depthC);
+            float*       row        = depthBuffer + static_cast<size_t>(y) * pitch;
+            for (int x = startX; x < tri.bounds.maxX; x += 4)
+            {
+                const Float4 px     = Splat(static_cast<float>(x)) + laneOffset;
+                Float4       inside = And(CmpGe(px, minX), CmpLt(px, maxX));
+                for (int k = 0; k < 3; ++k)
+                {
+                    inside = And(inside, Detail::EdgeInside(MulAdd(edgeA[k], px, edgeRow[k]), topLeft[k]));
+                }
+                if (MoveMask(inside) == 0)
+                {
+                    continue;
+                }
+                const Float4 depth  = MulAdd(depthA, px, depthRow);
+                const Float4 stored = Load(row + x);
+                const Float4 pass   = And(inside, And(CmpLt(depth, stored), And(CmpGe(depth, zero), CmpLe(depth, one))));
+                if (MoveMask(pass) != 0)
+                {
+                    Store(row + x, Select(pass, depth, stored));
+                }
+            }
+        }
+    }
+}   // namespace Joy
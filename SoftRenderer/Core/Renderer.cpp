@@ -0,0 +1,97 @@
+#include "Core/Renderer.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Joy
+{
+    Renderer::Renderer(int width, int height, EnumColorFormat colorFormat, EnumDepthFormat depthFormat)
+        : m_FrameBuffer(width, height, colorFormat, depthFormat)
+        , m_MultiSampleBuffer()
+        , m_CullMode(EnumCullMode::BACK)
+        , m_DepthTest(EnumDepthTest::LESS)
+        , m_Scissor{0, 0, width, height}
+        , m_SmallTriangleFastPath(true)
+        , m_TransparencyTarget(nullptr)
+    {}
+
+    void Renderer::Resize(int width, int height)
+    {
+        assert(width > 0 && height > 0);
+        m_FrameBuffer = FrameBuffer(width, height, m_FrameBuffer.GetColorFormat(), m_FrameBuffer.GetDepthFormat());
+        if (m_MultiSampleBuffer)
+        {
+            m_MultiSampleBuffer = std::make_unique<MultiSampleBuffer>(width, height, m_MultiSampleBuffer->GetSampleCount(), m_FrameBuffer.GetColorFormat());
+        }
+        m_TransparencyTarget = nullptr;
+        ResetScissor();
+    }
+
+    void Renderer::SetSampleCount(int sampleCount)
+    {
+        assert(sampleCount == 1 || sampleCount == 4 || sampleCount == 8);
+        if (sampleCount == GetSampleCount())
+        {
+            return;
+        }
+        if (sampleCount == 1)
+        {
+            m_MultiSampleBuffer.reset();
+        }
+        else
+        {
+            m_MultiSampleBuffer = std::make_unique<MultiSampleBuffer>(GetWidth(), GetHeight(), sampleCount, m_FrameBuffer.GetColorFormat());
+        }
+    }
+
+    void Renderer::SetScissor(const RasterRect& scissor)
+    {
+        m_Scissor.minX = std::max(scissor.minX, 0);
+        m_Scissor.minY = std::max(scissor.minY, 0);
+        m_Scissor.maxX = std::min(scissor.maxX, GetWidth());
+        m_Scissor.maxY = std::min(scissor.maxY, GetHeight());
+    }
+
+    void Renderer::Clear(const Vec4f& color, float depth)
+    {
+        m_FrameBuffer.ClearColor(color);
+        m_FrameBuffer.ClearDepth(depth);
+        if (m_MultiSampleBuffer)
+        {
+            m_MultiSampleBuffer->Clear(color, depth);
+        }
+    }
+
+    void Renderer::Resolve()
+    {
+        if (m_MultiSampleBuffer)
+        {
+            m_MultiSampleBuffer->Resolve(m_FrameBuffer);
+        }
+    }
+
+    void Renderer::ClearRegion(const RasterRect& rect)
+    {
+        assert(rect.minX % FrameBuffer::TILE_SIZE == 0 && rect.minY % FrameBuffer::TILE_SIZE == 0);
+        for (int tileY = rect.minY / FrameBuffer::TILE_SIZE; tileY * FrameBuffer::TILE_SIZE < rect.maxY; ++tileY)
+        {
+            for (int tileX = rect.minX / FrameBuffer::TILE_SIZE; tileX * FrameBuffer::TILE_SIZE < rect.maxX; ++tileX)
+            {
+                m_FrameBuffer.ResetTile(tileX, tileY);
+            }
+        }
+        if (m_MultiSampleBuffer)
+        {
+            m_MultiSampleBuffer->ClearRect(rect);
+        }
+    }
+
+    RasterVertex Renderer::ToRasterVertex(const Vec4f& clipPosition) const
+    {
+        // 透视除法与视口变换，屏幕空间y轴向下
+        const float invW = 1.f / clipPosition[3];
+        return RasterVertex{(clipPosition[0] * invW * 0.5f + 0.5f) * static_cast<float>(GetWidth()),
+                            (0.5f - clipPosition[1] * invW * 0.5f) * static_cast<float>(GetHeight()),
+                            clipPosition[2] * invW,
+                            invW};
+    }
+}   // namespace Joy
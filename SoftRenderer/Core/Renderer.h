@@ -0,0 +1,812 @@
+/**
+ * @file Renderer.h
+ * @author JoyatY
+ * @brief 渲染器，负责顶点处理、裁剪、光栅化与片元输出
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/DirtyTileTracker.h"
+#include "Core/FrameBuffer.h"
+#include "Core/Instancing.h"
+#include "Core/Mesh.h"
+#include "Core/MultiSampleBuffer.h"
+#include "Core/MultiView.h"
+#include "Core/Rasterizer.h"
+#include "Core/TransparencyBuffer.h"
+#include "Math/Mat.h"
+#include "Math/Vec.h"
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Joy
+{
+    class Renderer;
+
+    /**
+     * @brief 多视图绘制中的单个视图
+     *
+     */
+    struct RenderView
+    {
+        /**
+         * @brief 着色器输出位置到该视图裁剪空间的变换
+         *
+         */
+        Mat4x4f viewProj;
+
+        /**
+         * @brief 该视图的渲染目标
+         *
+         */
+        Renderer* target;
+    };
+
+    /**
+     * @brief 渲染器
+     *
+     * 着色器为任意满足以下约定的类型:
+     * @code
+     * struct Shader
+     * {
+     *     constexpr static int VARYING_COUNT = N;                 // 顶点到片元插值的浮点数量
+     *     Vec4f Vertex(const Vertex& vertex, float* varyings) const; // 返回裁剪空间坐标
+     *     Vec4f Fragment(const float* varyings) const;             // 返回片元颜色
+     * };
+     * @endcode
+     * 片元默认在深度测试通过后才着色(early-Z)。需要丢弃片元或改写深度的着色器须在类型中静态声明，并改用带输出参数的Fragment:
+     * @code
+     * struct LateDepthShader
+     * {
+     *     constexpr static bool DISCARDS     = true;   // Fragment可能丢弃片元
+     *     constexpr static bool WRITES_DEPTH = false;  // Fragment改写深度
+     *     bool Fragment(const float* varyings, Vec4f& color, float& depth) const; // depth传入插值深度，返回false丢弃
+     * };
+     * @endcode
+     * 只丢弃片元的着色器仍先做深度测试，着色后才写入深度；改写深度的着色器先着色再测试(late-Z)。着色路径在编译期确定。
+     * 裁剪空间约定: x、y在[-w, w]内，z在[0, w]内，NDC中逆时针为正面。
+     */
+    class Renderer
+    {
+    public:
+        /**
+         * @brief 构造渲染器
+         *
+         * @param width 渲染宽度(像素)
+         * @param height 渲染高度(像素)
+         * @param colorFormat 颜色缓冲格式
+         * @param depthFormat 深度缓冲格式
+         */
+        Renderer(int width, int height, EnumColorFormat colorFormat = EnumColorFormat::RGBA8, EnumDepthFormat depthFormat = EnumDepthFormat::D32F);
+
+    public:
+        int                GetWidth() const { return m_FrameBuffer.GetWidth(); }
+        int                GetHeight() const { return m_FrameBuffer.GetHeight(); }
+        FrameBuffer&       GetFrameBuffer() { return m_FrameBuffer; }
+        const FrameBuffer& GetFrameBuffer() const { return m_FrameBuffer; }
+
+        /**
+         * @brief 获取多重采样缓冲，未开启MSAA时为空
+         *
+         * @return const MultiSampleBuffer*
+         */
+        const MultiSampleBuffer* GetMultiSampleBuffer() const { return m_MultiSampleBuffer.get(); }
+
+        /**
+         * @brief 调整渲染尺寸: 颜色与深度缓冲按新尺寸重新分配，内容须重新清除，外部绑定的颜色存储随之解除；
+         * 多重采样数与其余状态保持不变，裁剪矩形重置为整个渲染区域，透明绘制目标解除
+         *
+         * @param width 渲染宽度(像素)
+         * @param height 渲染高度(像素)
+         */
+        void Resize(int width, int height);
+
+        /**
+         * @brief 设置面剔除模式
+         *
+         * @param cullMode
+         */
+        void         SetCullMode(EnumCullMode cullMode) { m_CullMode = cullMode; }
+        EnumCullMode GetCullMode() const { return m_CullMode; }
+
+        /**
+         * @brief 设置深度测试函数，反向Z投影须使用GREATER并以0清除深度
+         *
+         * @param depthTest
+         */
+        void          SetDepthTest(EnumDepthTest depthTest) { m_DepthTest = depthTest; }
+        EnumDepthTest GetDepthTest() const { return m_DepthTest; }
+
+        /**
+         * @brief 设置多重采样数，1表示关闭MSAA，支持1/4/8
+         *
+         * @param sampleCount
+         */
+        void SetSampleCount(int sampleCount);
+        int  GetSampleCount() const { return m_MultiSampleBuffer ? m_MultiSampleBuffer->GetSampleCount() : 1; }
+
+        /**
+         * @brief 设置是否启用小三角形快速路径
+         *
+         * 启用后单采样绘制中包围盒不超过MICRO_TRIANGLE_SIZE像素的三角形跳过通用建立，攒满一批后以SIMD跨三角形同时建立与光栅化，
+         * 写入顺序与逐个绘制一致。被近平面裁剪的三角形与MSAA绘制始终走通用路径。
+         *
+         * @param enabled
+         */
+        void SetSmallTriangleFastPath(bool enabled) { m_SmallTriangleFastPath = enabled; }
+        bool IsSmallTriangleFastPathEnabled() const { return m_SmallTriangleFastPath; }
+
+        /**
+         * @brief 设置透明绘制目标: 非空时之后的绘制照常做深度测试但不写入深度，片元颜色记录到透明缓冲而不写入渲染目标
+         *
+         * 透明物体无需排序，不透明物体绘制(及Resolve)完成后调用TransparencyBuffer::Resolve合成。
+         * 多重采样时每像素记录一个片元，Alpha乘以通过深度测试的采样比例。反向Z时记录的深度为1 - depth，透明缓冲中总是越小越近。
+         *
+         * @param target 尺寸须与渲染器一致，为空时恢复不透明绘制
+         */
+        void SetTransparencyTarget(TransparencyBuffer* target)
+        {
+            assert(target == nullptr || (target->GetWidth() == GetWidth() && target->GetHeight() == GetHeight()));
+            m_TransparencyTarget = target;
+        }
+        TransparencyBuffer* GetTransparencyTarget() const { return m_TransparencyTarget; }
+
+        /**
+         * @brief 设置裁剪矩形，光栅化只输出矩形内的像素
+         *
+         * @param scissor
+         */
+        void SetScissor(const RasterRect& scissor);
+
+        /**
+         * @brief 重置裁剪矩形为整个渲染区域
+         *
+         */
+        void ResetScissor() { m_Scissor = RasterRect{0, 0, GetWidth(), GetHeight()}; }
+
+        /**
+         * @brief 清除渲染目标
+         *
+         * @param color 清除颜色
+         * @param depth 清除深度
+         */
+        void Clear(const Vec4f& color, float depth = 1.f);
+
+        /**
+         * @brief 绘制网格
+         *
+         * @tparam TShader 着色器类型
+         * @param mesh 网格
+         * @param shader 着色器
+         */
+        template<typename TShader> void Draw(const Mesh& mesh, const TShader& shader);
+
+        /**
+         * @brief 多视图绘制: 顶点只读取、着色一次，再以SIMD同时变换到所有视图，三角形按视图可见性统一剔除
+         *
+         * 着色器Vertex返回的是各视图共享空间(通常为世界空间)中的位置，由view.viewProj变换到各视图的裁剪空间。
+         * 顶点缓存复用views[0].target的内部缓冲。
+         *
+         * @tparam TShader 着色器类型
+         * @param mesh 网格
+         * @param shader 着色器
+         * @param views 视图数组
+         * @param viewCount 视图数[1, MAX_VIEW_COUNT]
+         */
+        template<typename TShader> static void DrawMultiView(const Mesh& mesh, const TShader& shader, const RenderView* views, int viewCount);
+
+        /**
+         * @brief 实例化绘制: 一个网格按逐实例模型矩阵绘制多次
+         *
+         * 着色器Vertex返回模型空间位置(w为1)，顶点着色只执行一次，插值变量在所有实例间共享。
+         * 实例矩阵与viewProj以SIMD批量组合，按网格包围盒逐实例剔除，可见实例的顶点再批量变换到裁剪空间。
+         * 结果与逐实例调用Draw(着色器返回viewProj * model * position)逐像素一致。
+         *
+         * @tparam TShader 着色器类型
+         * @param mesh 网格
+         * @param shader 着色器
+         * @param viewProj 相机的ViewProj矩阵
+         * @param instanceModels 实例模型矩阵数组
+         * @param instanceCount 实例数
+         * @return int 通过剔除的实例数
+         */
+        template<typename TShader>
+        int DrawInstanced(const Mesh& mesh, const TShader& shader, const Mat4x4f& viewProj, const Mat4x4f* instanceModels, int instanceCount);
+
+        /**
+         * @brief 将多重采样结果解析到帧缓冲，未开启MSAA时无操作
+         *
+         */
+        void Resolve();
+
+        /**
+         * @brief 将矩形区域重置为上一次Clear的清除值，帧缓冲以分块快速清除标记完成
+         *
+         * @param rect 须对齐到FrameBuffer::TILE_SIZE(右、下边界可为屏幕边界)
+         */
+        void ClearRegion(const RasterRect& rect);
+
+        /**
+         * @brief 增量重绘: 仅重置并重绘追踪器给出的脏矩形，其余像素沿用上一帧的颜色与深度
+         *
+         * 对每个脏矩形依次清除、设置裁剪矩形、调用draw(rect)并在开启MSAA时解析该矩形，结束后重置裁剪矩形。
+         * draw应绘制所有可能覆盖该矩形的物体(可用DirtyTileTracker::Intersects跳过其余物体)，
+         * 光栅化结果与整帧重绘逐像素一致。
+         *
+         * @tparam TDrawFunc void(const RasterRect&)
+         * @param tracker 已调用EndFrame的追踪器，尺寸须与渲染器一致
+         * @param draw 绘制回调
+         */
+        template<typename TDrawFunc> void RenderDirtyRegions(const DirtyTileTracker& tracker, TDrawFunc&& draw);
+
+    private:
+        /**
+         * @brief 顶点着色后的裁剪空间顶点
+         *
+         */
+        struct ClipVertex
+        {
+            Vec4f        position;
+            const float* varyings;
+        };
+
+        template<typename TShader> void DrawTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const TShader& shader);
+
+        /**
+         * @brief 光栅化已完成近平面裁剪的三角形
+         *
+         * @param batchable 顶点插值变量在本次绘制结束前保持有效，可延迟到小三角形批次中光栅化
+         */
+        template<typename TShader>
+        void RasterizeClipped(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const TShader& shader, bool batchable = false);
+
+        /**
+         * @brief 光栅化积攒的小三角形批次
+         *
+         */
+        template<typename TShader> void FlushMicroTriangles(const TShader& shader);
+
+        /**
+         * @brief 单采样像素的深度测试、着色与输出，按着色器声明的深度行为选择early-Z或late-Z
+         *
+         * @param depth 像素中心的插值深度
+         * @param bary 像素中心的透视校正重心坐标，与顶点插值变量一起只在需要着色时插值
+         */
+        template<typename TShader>
+        void ShadePixel(int x, int y, float depth, const float* v0, const float* v1, const float* v2, const float* bary, const TShader& shader);
+
+        /**
+         * @brief 多重采样像素的深度测试、着色与输出，着色每像素只执行一次
+         *
+         * @param centerDepth 像素中心的插值深度，作为改写深度的着色器的输入
+         */
+        template<typename TShader>
+        void ShadeSamples(int x, int y, uint32_t coverage, const float* sampleDepths, float centerDepth, const float* v0, const float* v1, const float* v2,
+                          const float* bary, const TShader& shader);
+
+        /**
+         * @brief 多重采样下的透明片元: 深度测试不写入，每像素记录一个片元
+         *
+         */
+        template<typename TShader>
+        void ShadeTransparentSamples(int x, int y, uint32_t coverage, const float* sampleDepths, float centerDepth, const float* v0, const float* v1,
+                                     const float* v2, const float* bary, const TShader& shader);
+
+        /**
+         * @brief 透明缓冲按深度越小越近排序与加权，反向Z(GREATER)时翻转深度
+         *
+         */
+        float GetTransparencyDepth(float depth) const { return m_DepthTest == EnumDepthTest::GREATER ? 1.f - depth : depth; }
+
+        /**
+         * @brief 裁剪空间位置到近平面的有向距离，不小于0时位于近平面内侧。近平面在标准深度下为z = 0，反向Z(GREATER)下为z = w
+         *
+         */
+        float GetNearPlaneDistance(const Vec4f& clipPosition) const
+        {
+            return m_DepthTest == EnumDepthTest::GREATER ? clipPosition[3] - clipPosition[2] : clipPosition[2];
+        }
+
+        RasterVertex ToRasterVertex(const Vec4f& clipPosition) const;
+
+    private:
+        FrameBuffer                        m_FrameBuffer;
+        std::unique_ptr<MultiSampleBuffer> m_MultiSampleBuffer;
+        EnumCullMode                       m_CullMode;
+        EnumDepthTest                      m_DepthTest;
+        RasterRect                         m_Scissor;
+        bool                               m_SmallTriangleFastPath;
+        TransparencyBuffer*                m_TransparencyTarget;
+
+        /**
+         * @brief 待光栅化的小三角形批次及各三角形顶点的插值变量
+         *
+         */
+        MicroTriangleBatch m_MicroBatch;
+        const float*       m_MicroVaryings[MicroTriangleBatch::CAPACITY][3];
+
+        /**
+         * @brief 顶点着色输出缓存，在多次绘制间复用
+         *
+         */
+        std::vector<Vec4f>   m_ClipPositions;
+        std::vector<float>   m_Varyings;
+        std::vector<Vec4f>   m_ViewClipPositions;
+        std::vector<uint8_t> m_ViewOutcodes;
+
+        /**
+         * @brief 实例化绘制缓存: 模型空间位置、组合后的实例矩阵与可见实例索引
+         *
+         */
+        std::vector<Vec4f>    m_ObjectPositions;
+        std::vector<Mat4x4f>  m_InstanceMatrices;
+        std::vector<uint32_t> m_VisibleInstances;
+    };
+
+    namespace Detail
+    {
+        /**
+         * @brief 着色器插值变量容量(至少为1，避免零长度数组)
+         *
+         */
+        template<typename TShader> constexpr int VaryingCapacity()
+        {
+            return TShader::VARYING_COUNT > 0 ? TShader::VARYING_COUNT : 1;
+        }
+
+        /**
+         * @brief 着色器声明的深度行为，未声明时为false
+         *
+         */
+        template<typename TShader, typename = void> struct ShaderDiscards : std::false_type
+        {};
+        template<typename TShader> struct ShaderDiscards<TShader, std::void_t<decltype(TShader::DISCARDS)>> : std::bool_constant<TShader::DISCARDS>
+        {};
+        template<typename TShader, typename = void> struct ShaderWritesDepth : std::false_type
+        {};
+        template<typename TShader> struct ShaderWritesDepth<TShader, std::void_t<decltype(TShader::WRITES_DEPTH)>> : std::bool_constant<TShader::WRITES_DEPTH>
+        {};
+
+        /**
+         * @brief 着色器是否使用带输出参数的Fragment(可丢弃片元或改写深度)
+         *
+         */
+        template<typename TShader> constexpr bool HasFragmentOutputs()
+        {
+            return ShaderDiscards<TShader>::value || ShaderWritesDepth<TShader>::value;
+        }
+
+        template<int N> inline void InterpolateVaryings(const float* v0, const float* v1, const float* v2, const float* bary, float* out)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                out[i] = v0[i] * bary[0] + v1[i] * bary[1] + v2[i] * bary[2];
+            }
+        }
+    }   // namespace Detail
+
+    template<typename TDrawFunc> void Renderer::RenderDirtyRegions(const DirtyTileTracker& tracker, TDrawFunc&& draw)
+    {
+        assert(tracker.GetWidth() == GetWidth() && tracker.GetHeight() == GetHeight());
+        for (const RasterRect& rect : tracker.GetDirtyRects())
+        {
+            ClearRegion(rect);
+            SetScissor(rect);
+            draw(rect);
+            if (m_MultiSampleBuffer)
+            {
+                m_MultiSampleBuffer->Resolve(m_FrameBuffer, rect);
+            }
+        }
+        ResetScissor();
+    }
+
+    template<typename TShader> void Renderer::Draw(const Mesh& mesh, const TShader& shader)
+    {
+        constexpr int varyingCapacity = Detail::VaryingCapacity<TShader>();
+        const size_t  vertexCount     = mesh.vertices.size();
+        m_ClipPositions.resize(vertexCount);
+        m_Varyings.resize(vertexCount * varyingCapacity);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            m_ClipPositions[i] = shader.Vertex(mesh.vertices[i], &m_Varyings[i * varyingCapacity]);
+        }
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            const uint32_t i0 = mesh.indices[i];
+            const uint32_t i1 = mesh.indices[i + 1];
+            const uint32_t i2 = mesh.indices[i + 2];
+            DrawTriangle(ClipVertex{m_ClipPositions[i0], &m_Varyings[i0 * varyingCapacity]},
+                         ClipVertex{m_ClipPositions[i1], &m_Varyings[i1 * varyingCapacity]},
+                         ClipVertex{m_ClipPositions[i2], &m_Varyings[i2 * varyingCapacity]},
+                         shader);
+        }
+        FlushMicroTriangles(shader);
+    }
+
+    template<typename TShader>
+    int Renderer::DrawInstanced(const Mesh& mesh, const TShader& shader, const Mat4x4f& viewProj, const Mat4x4f* instanceModels, int instanceCount)
+    {
+        constexpr int varyingCapacity = Detail::VaryingCapacity<TShader>();
+        const size_t  vertexCount     = mesh.vertices.size();
+        if (vertexCount == 0 || instanceCount <= 0)
+        {
+            return 0;
+        }
+
+        // 顶点着色只执行一次，包围盒取自着色后的位置，着色器可在模型空间内偏移顶点
+        m_ObjectPositions.resize(vertexCount);
+        m_ClipPositions.resize(vertexCount);
+        m_Varyings.resize(vertexCount * varyingCapacity);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            m_ObjectPositions[i] = shader.Vertex(mesh.vertices[i], &m_Varyings[i * varyingCapacity]);
+        }
+        const InstanceBounds bounds = ComputeBounds(m_ObjectPositions.data(), vertexCount);
+
+        m_InstanceMatrices.resize(instanceCount);
+        m_VisibleInstances.resize(instanceCount);
+        ComposeInstanceMatrices(viewProj, instanceModels, instanceCount, m_InstanceMatrices.data());
+        const int visibleCount = CullInstances(m_InstanceMatrices.data(), instanceCount, bounds, m_VisibleInstances.data());
+
+        for (int visible = 0; visible < visibleCount; ++visible)
+        {
+            TransformPositions(m_InstanceMatrices[m_VisibleInstances[visible]], m_ObjectPositions.data(), vertexCount, m_ClipPositions.data());
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+            {
+                const uint32_t i0 = mesh.indices[i];
+                const uint32_t i1 = mesh.indices[i + 1];
+                const uint32_t i2 = mesh.indices[i + 2];
+                DrawTriangle(ClipVertex{m_ClipPositions[i0], &m_Varyings[i0 * varyingCapacity]},
+                             ClipVertex{m_ClipPositions[i1], &m_Varyings[i1 * varyingCapacity]},
+                             ClipVertex{m_ClipPositions[i2], &m_Varyings[i2 * varyingCapacity]},
+                             shader);
+            }
+        }
+        FlushMicroTriangles(shader);
+        return visibleCount;
+    }
+
+    template<typename TShader> void Renderer::DrawMultiView(const Mesh& mesh, const TShader& shader, const RenderView* views, int viewCount)
+    {
+        assert(viewCount >= 1 && viewCount <= MAX_VIEW_COUNT);
+        constexpr int varyingCapacity = Detail::VaryingCapacity<TShader>();
+        Renderer&     scratch         = *views[0].target;
+        const size_t  vertexCount     = mesh.vertices.size();
+
+        Mat4x4f viewProjs[MAX_VIEW_COUNT];
+        for (int view = 0; view < viewCount; ++view)
+        {
+            viewProjs[view] = views[view].viewProj;
+        }
+        MultiViewTransform transform;
+        transform.SetViews(viewProjs, viewCount);
+
+        // 顶点读取与着色只执行一次，随后一次性变换到所有视图
+        scratch.m_Varyings.resize(vertexCount * varyingCapacity);
+        scratch.m_ViewClipPositions.resize(vertexCount * viewCount);
+        scratch.m_ViewOutcodes.resize(vertexCount * viewCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const Vec4f position = shader.Vertex(mesh.vertices[i], &scratch.m_Varyings[i * varyingCapacity]);
+            transform.Transform(position, &scratch.m_ViewClipPositions[i * viewCount], &scratch.m_ViewOutcodes[i * viewCount]);
+        }
+
+        const Vec4f*   clipPositions = scratch.m_ViewClipPositions.data();
+        const uint8_t* outcodes      = scratch.m_ViewOutcodes.data();
+        const float*   varyings      = scratch.m_Varyings.data();
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            const size_t i0 = mesh.indices[i];
+            const size_t i1 = mesh.indices[i + 1];
+            const size_t i2 = mesh.indices[i + 2];
+            for (int view = 0; view < viewCount; ++view)
+            {
+                // 三个顶点位于同一裁剪平面外侧时在该视图中剔除
+                if ((outcodes[i0 * viewCount + view] & outcodes[i1 * viewCount + view] & outcodes[i2 * viewCount + view]) != 0)
+                {
+                    continue;
+                }
+                views[view].target->DrawTriangle(ClipVertex{clipPositions[i0 * viewCount + view], &varyings[i0 * varyingCapacity]},
+                                                 ClipVertex{clipPositions[i1 * viewCount + view], &varyings[i1 * varyingCapacity]},
+                                                 ClipVertex{clipPositions[i2 * viewCount + view], &varyings[i2 * varyingCapacity]},
+                                                 shader);
+            }
+        }
+        for (int view = 0; view < viewCount; ++view)
+        {
+            views[view].target->FlushMicroTriangles(shader);
+        }
+    }
+
+    template<typename TShader> void Renderer::DrawTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const TShader& shader)
+    {
+        constexpr int varyingCount    = TShader::VARYING_COUNT;
+        constexpr int varyingCapacity = Detail::VaryingCapacity<TShader>();
+        const Vec4f&  p0              = v0.position;
+        const Vec4f&  p1              = v1.position;
+        const Vec4f&  p2              = v2.position;
+
+        // 三个顶点位于同一裁剪平面外侧时直接剔除
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if ((p0[axis] > p0[3] && p1[axis] > p1[3] && p2[axis] > p2[3]) || (p0[axis] < -p0[3] && p1[axis] < -p1[3] && p2[axis] < -p2[3]))
+            {
+                return;
+            }
+        }
+        const bool inside0 = GetNearPlaneDistance(p0) >= 0.f;
+        const bool inside1 = GetNearPlaneDistance(p1) >= 0.f;
+        const bool inside2 = GetNearPlaneDistance(p2) >= 0.f;
+        if (inside0 && inside1 && inside2)
+        {
+            RasterizeClipped(v0, v1, v2, shader, true);
+            return;
+        }
+        if (!inside0 && !inside1 && !inside2)
+        {
+            return;
+        }
+
+        // 近平面裁剪(标准深度z = 0，反向Z为z = w)，三角形最多被裁为四边形
+        const ClipVertex* input[3] = {&v0, &v1, &v2};
+        Vec4f             clippedPositions[4];
+        float             clippedVaryings[4][varyingCapacity];
+        int               clippedCount = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            const ClipVertex& current = *input[i];
+            const ClipVertex& next    = *input[(i + 1) % 3];
+            const float       dCur    = GetNearPlaneDistance(current.position);
+            const float       dNext   = GetNearPlaneDistance(next.position);
+            if (dCur >= 0.f)
+            {
+                clippedPositions[clippedCount] = current.position;
+                for (int j = 0; j < varyingCount; ++j)
+                {
+                    clippedVaryings[clippedCount][j] = current.varyings[j];
+                }
+                ++clippedCount;
+            }
+            if ((dCur >= 0.f) != (dNext >= 0.f))
+            {
+                const float t                  = dCur / (dCur - dNext);
+                clippedPositions[clippedCount] = current.position + (next.position - current.position) * t;
+                for (int j = 0; j < varyingCount; ++j)
+                {
+                    clippedVaryings[clippedCount][j] = current.varyings[j] + (next.varyings[j] - current.varyings[j]) * t;
+                }
+                ++clippedCount;
+            }
+        }
+        for (int i = 1; i + 1 < clippedCount; ++i)
+        {
+            RasterizeClipped(ClipVertex{clippedPositions[0], clippedVaryings[0]},
+                             ClipVertex{clippedPositions[i], clippedVaryings[i]},
+                             ClipVertex{clippedPositions[i + 1], clippedVaryings[i + 1]},
+                             shader);
+        }
+    }
+
+    template<typename TShader> void Renderer::FlushMicroTriangles(const TShader& shader)
+    {
+        if (m_MicroBatch.count == 0)
+        {
+            return;
+        }
+        RasterizeMicroBatch(m_MicroBatch, m_CullMode, m_Scissor, [&](int lane, int x, int y, float depth, const float* bary) {
+            const float* const* laneVaryings = m_MicroVaryings[lane];
+            ShadePixel(x, y, depth, laneVaryings[0], laneVaryings[1], laneVaryings[2], bary, shader);
+        });
+        m_MicroBatch.Reset();
+    }
+
+    template<typename TShader>
+    void Renderer::RasterizeClipped(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const TShader& shader, bool batchable)
+    {
+        const RasterVertex r0 = ToRasterVertex(v0.position);
+        const RasterVertex r1 = ToRasterVertex(v1.position);
+        const RasterVertex r2 = ToRasterVertex(v2.position);
+        if (batchable && m_SmallTriangleFastPath && !m_MultiSampleBuffer && AddMicroTriangle(m_MicroBatch, r0, r1, r2))
+        {
+            const int lane           = m_MicroBatch.count - 1;
+            m_MicroVaryings[lane][0] = v0.varyings;
+            m_MicroVaryings[lane][1] = v1.varyings;
+            m_MicroVaryings[lane][2] = v2.varyings;
+            if (m_MicroBatch.IsFull())
+            {
+                FlushMicroTriangles(shader);
+            }
+            return;
+        }
+        // 先输出批次中更早提交的三角形，保持写入顺序
+        FlushMicroTriangles(shader);
+
+        RasterTriangle tri;
+        if (!SetupTriangle(r0, r1, r2, m_CullMode, m_Scissor, tri))
+        {
+            return;
+        }
+
+        if (!m_MultiSampleBuffer)
+        {
+            RasterizeTriangle(tri, 1, [&](int x, int y, uint32_t, const float* sampleDepths, const float* bary) {
+                ShadePixel(x, y, sampleDepths[0], v0.varyings, v1.varyings, v2.varyings, bary, shader);
+            });
+            return;
+        }
+
+        RasterizeTriangle(tri, m_MultiSampleBuffer->GetSampleCount(), [&](int x, int y, uint32_t coverage, const float* sampleDepths, const float* bary) {
+            // 带输出参数的着色器与透明片元使用像素中心的深度
+            const float centerDepth = tri.depthA * (x + 0.5f) + tri.depthB * (y + 0.5f) + tri.depthC;
+            ShadeSamples(x, y, coverage, sampleDepths, centerDepth, v0.varyings, v1.varyings, v2.varyings, bary, shader);
+        });
+    }
+
+    template<typename TShader>
+    void Renderer::ShadePixel(int x, int y, float depth, const float* v0, const float* v1, const float* v2, const float* bary, const TShader& shader)
+    {
+        constexpr int  varyingCapacity = Detail::VaryingCapacity<TShader>();
+        constexpr bool writesDepth     = Detail::ShaderWritesDepth<TShader>::value;
+        // early-Z: 深度不由着色器决定时先测试，未通过的像素既不插值也不着色
+        if constexpr (!writesDepth)
+        {
+            if (!DepthTestPass(m_DepthTest, depth, m_FrameBuffer.GetDepth(x, y)))
+            {
+                return;
+            }
+        }
+        float varyings[varyingCapacity];
+        Detail::InterpolateVaryings<TShader::VARYING_COUNT>(v0, v1, v2, bary, varyings);
+        Vec4f color;
+        if constexpr (Detail::HasFragmentOutputs<TShader>())
+        {
+            float outputDepth = depth;
+            if (!shader.Fragment(varyings, color, outputDepth))
+            {
+                return;
+            }
+            // late-Z: 以着色器输出的深度测试
+            if constexpr (writesDepth)
+            {
+                if (!DepthTestPass(m_DepthTest, outputDepth, m_FrameBuffer.GetDepth(x, y)))
+                {
+                    return;
+                }
+                depth = outputDepth;
+            }
+        }
+        else
+        {
+            color = shader.Fragment(varyings);
+        }
+        if (m_TransparencyTarget != nullptr)
+        {
+            m_TransparencyTarget->AddFragment(x, y, GetTransparencyDepth(depth), color);
+            return;
+        }
+        m_FrameBuffer.SetDepth(x, y, depth);
+        m_FrameBuffer.SetColor(x, y, color);
+    }
+
+    template<typename TShader>
+    void Renderer::ShadeSamples(int x, int y, uint32_t coverage, const float* sampleDepths, float centerDepth, const float* v0, const float* v1, const float* v2,
+                                const float* bary, const TShader& shader)
+    {
+        if (m_TransparencyTarget != nullptr)
+        {
+            ShadeTransparentSamples(x, y, coverage, sampleDepths, centerDepth, v0, v1, v2, bary, shader);
+            return;
+        }
+        constexpr int      varyingCapacity = Detail::VaryingCapacity<TShader>();
+        MultiSampleBuffer& msBuffer        = *m_MultiSampleBuffer;
+        float              varyings[varyingCapacity];
+        Vec4f              color;
+        if constexpr (Detail::ShaderWritesDepth<TShader>::value)
+        {
+            // late-Z: 着色器输出的深度替换所有覆盖采样的深度
+            Detail::InterpolateVaryings<TShader::VARYING_COUNT>(v0, v1, v2, bary, varyings);
+            if (!shader.Fragment(varyings, color, centerDepth))
+            {
+                return;
+            }
+            float outputDepths[MAX_SAMPLE_COUNT];
+            std::fill(outputDepths, outputDepths + msBuffer.GetSampleCount(), centerDepth);
+            const uint32_t passMask = msBuffer.TestAndWriteDepth(x, y, coverage, outputDepths, m_DepthTest);
+            if (passMask != 0)
+            {
+                msBuffer.WriteColor(x, y, passMask, color);
+            }
+        }
+        else if constexpr (Detail::ShaderDiscards<TShader>::value)
+        {
+            // 先测试，片元未被丢弃时才写入通过测试的采样深度
+            const uint32_t passMask = msBuffer.TestDepth(x, y, coverage, sampleDepths, m_DepthTest);
+            if (passMask == 0)
+            {
+                return;
+            }
+            Detail::InterpolateVaryings<TShader::VARYING_COUNT>(v0, v1, v2, bary, varyings);
+            float outputDepth = centerDepth;
+            if (!shader.Fragment(varyings, color, outputDepth))
+            {
+                return;
+            }
+            msBuffer.WriteDepth(x, y, passMask, sampleDepths);
+            msBuffer.WriteColor(x, y, passMask, color);
+        }
+        else
+        {
+            // 覆盖与深度逐采样计算，通过测试后才着色
+            const uint32_t passMask = msBuffer.TestAndWriteDepth(x, y, coverage, sampleDepths, m_DepthTest);
+            if (passMask == 0)
+            {
+                return;
+            }
+            Detail::InterpolateVaryings<TShader::VARYING_COUNT>(v0, v1, v2, bary, varyings);
+            msBuffer.WriteColor(x, y, passMask, shader.Fragment(varyings));
+        }
+    }
+
+    template<typename TShader>
+    void Renderer::ShadeTransparentSamples(int x, int y, uint32_t coverage, const float* sampleDepths, float centerDepth, const float* v0, const float* v1,
+                                           const float* v2, const float* bary, const TShader& shader)
+    {
+        constexpr int      varyingCapacity = Detail::VaryingCapacity<TShader>();
+        constexpr bool     writesDepth     = Detail::ShaderWritesDepth<TShader>::value;
+        MultiSampleBuffer& msBuffer        = *m_MultiSampleBuffer;
+        uint32_t           passMask        = coverage;
+        if constexpr (!writesDepth)
+        {
+            passMask = msBuffer.TestDepth(x, y, coverage, sampleDepths, m_DepthTest);
+            if (passMask == 0)
+            {
+                return;
+            }
+        }
+        float varyings[varyingCapacity];
+        Detail::InterpolateVaryings<TShader::VARYING_COUNT>(v0, v1, v2, bary, varyings);
+        Vec4f color;
+        if constexpr (Detail::HasFragmentOutputs<TShader>())
+        {
+            float outputDepth = centerDepth;
+            if (!shader.Fragment(varyings, color, outputDepth))
+            {
+                return;
+            }
+            if constexpr (writesDepth)
+            {
+                float outputDepths[MAX_SAMPLE_COUNT];
+                std::fill(outputDepths, outputDepths + msBuffer.GetSampleCount(), outputDepth);
+                passMask = msBuffer.TestDepth(x, y, coverage, outputDepths, m_DepthTest);
+                if (passMask == 0)
+                {
+                    return;
+                }
+                centerDepth = outputDepth;
+            }
+        }
+        else
+        {
+            color = shader.Fragment(varyings);
+        }
+        // 部分覆盖的像素按通过测试的采样比例降低不透明度
+        int passCount = 0;
+        for (uint32_t mask = passMask; mask != 0; mask &= mask - 1)
+        {
+            ++passCount;
+        }
+        color[3] *= static_cast<float>(passCount) / static_cast<float>(msBuffer.GetSampleCount());
+        m_TransparencyTarget->AddFragment(x, y, GetTransparencyDepth(centerDepth), color);
+    }
+}   // namespace Joy
@@ -0,0 +1,257 @@
+#include "Core/ShadowMap.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Joy
+{
+    ShadowMap::ShadowMap(int resolution)
+        : m_Resolution(resolution)
+        , m_Pitch((resolution + 3) & ~3)
+        , m_Depths(static_cast<size_t>((resolution + 3) & ~3) * resolution, 1.f)
+        , m_RasterVertices()
+    {
+        assert(resolution >= 4);
+    }
+
+    void ShadowMap::Clear(float depth)
+    {
+        std::fill(m_Depths.begin(), m_Depths.end(), depth);
+    }
+
+    void ShadowMap::RenderDepth(const Mesh& mesh, const Mat4x4f& modelLightViewProj, EnumCullMode cullMode)
+    {
+        using namespace Simd;
+        const Float4 col0       = Load(&modelLightViewProj[0][0]);
+        const Float4 col1       = Load(&modelLightViewProj[1][0]);
+        const Float4 col2       = Load(&modelLightViewProj[2][0]);
+        const Float4 col3       = Load(&modelLightViewProj[3][0]);
+
+        // 顶点只需位置变换
+        m_RasterVertices.resize(mesh.vertices.size());
+        for (size_t i = 0; i < mesh.vertices.size(); ++i)
+        {
+            const Vec3f& position = mesh.vertices[i].position;
+            Vec4f        clip;
+            Store(&clip[0], MulAdd(col0, Splat(position.X()), MulAdd(col1, Splat(position.Y()), MulAdd(col2, Splat(position.Z()), col3))));
+            m_RasterVertices[i] = ToRasterVertex(clip);
+        }
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            RenderDepthTriangle(m_RasterVertices[mesh.indices[i]], m_RasterVertices[mesh.indices[i + 1]], m_RasterVertices[mesh.indices[i + 2]], cullMode);
+        }
+    }
+
+    RasterVertex ShadowMap::ToRasterVertex(const Vec4f& clipPosition) const
+    {
+        const float resolution = static_cast<float>(m_Resolution);
+        const float invW       = clipPosition[3] > 0.f ? 1.f / clipPosition[3] : -1.f;
+        return RasterVertex{(clipPosition[0] * invW * 0.5f + 0.5f) * resolution,
+                            (0.5f - clipPosition[1] * invW * 0.5f) * resolution,
+                            std::max(clipPosition[2] * invW, 0.f),
+                            invW};
+    }
+
+    void ShadowMap::RenderDepthTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2, EnumCullMode cullMode)
+    {
+        if (v0.invW < 0.f || v1.invW < 0.f || v2.invW < 0.f)
+        {
+            return;
+        }
+        RasterTriangle tri;
+        if (SetupTriangle(v0, v1, v2, cullMode, RasterRect{0, 0, m_Resolution, m_Resolution}, tri))
+        {
+            RasterizeDepthOnly(tri, m_Depths.data(), m_Pitch);
+        }
+    }
+
+    float ShadowMap::SampleCompare(float u, float v, float depth) const
+    {
+        using namespace Simd;
+        // 以采样点左上方的texel为原点取4x4窗口，行列权重为(1 - f, 1, 1, f)，等价于3x3次双线性PCF
+        const float tx = u * static_cast<float>(m_Resolution) - 0.5f;
+        const float ty = v * static_cast<float>(m_Resolution) - 0.5f;
+        const float fx = std::floor(tx);
+        const float fy = std::floor(ty);
+        const int   x0 = static_cast<int>(fx) - 1;
+        const int   y0 = static_cast<int>(fy) - 1;
+        const float wx = tx - fx;
+        const float wy = ty - fy;
+
+        const Float4 columnWeights = Set(1.f - wx, 1.f, 1.f, wx);
+        const float  rowWeights[4] = {1.f - wy, 1.f, 1.f, wy};
+        const Float4 reference     = Splat(depth);
+        const int    maxIndex      = m_Resolution - 1;
+        const bool   columnsInside = x0 >= 0 && x0 + 3 <= maxIndex;
+        Float4       sum           = Splat(0.f);
+        for (int row = 0; row < 4; ++row)
+        {
+            const int    y      = std::clamp(y0 + row, 0, maxIndex);
+            const float* depths = &m_Depths[static_cast<size_t>(y) * m_Pitch];
+            Float4       texels;
+            if (columnsInside)
+            {
+                texels = Load(depths + x0);
+            }
+            else
+            {
+                // 边缘处按clamp寻址
+                texels = Set(depths[std::clamp(x0, 0, maxIndex)],
+                             depths[std::clamp(x0 + 1, 0, maxIndex)],
+                             depths[std::clamp(x0 + 2, 0, maxIndex)],
+                             depths[std::clamp(x0 + 3, 0, maxIndex)]);
+            }
+            const Float4 lit = And(CmpLe(reference, texels), columnWeights);
+            sum              = MulAdd(lit, Splat(rowWeights[row]), sum);
+        }
+        return HorizontalSum(sum) * (1.f / 9.f);
+    }
+
+    CascadedShadowMap::CascadedShadowMap(int resolution, int cascadeCount)
+        : m_CascadeCount(cascadeCount)
+        , m_SplitLambda(0.75f)
+        , m_DepthBias(0.002f)
+        , m_SplitDistances()
+        , m_MainViewMatrix(MAT4X4F_IDENTITY)
+        , m_LightCameras()
+        , m_LightViewProjs()
+        , m_ShadowMaps(cascadeCount, ShadowMap(resolution))
+        , m_CascadeVertices()
+        , m_CascadeOutcodes()
+    {
+        assert(cascadeCount >= 1 && cascadeCount <= MAX_CASCADE_COUNT);
+    }
+
+    void CascadedShadowMap::ComputeSplitDistances(float near, float far, int cascadeCount, float lambda, float* splits)
+    {
+        splits[0] = near;
+        for (int i = 1; i < cascadeCount; ++i)
+        {
+            const float ratio       = static_cast<float>(i) / static_cast<float>(cascadeCount);
+            const float logSplit    = near * std::pow(far / near, ratio);
+            const float linearSplit = near + (far - near) * ratio;
+            splits[i]               = lambda * logSplit + (1.f - lambda) * linearSplit;
+        }
+        splits[cascadeCount] = far;
+    }
+
+    void CascadedShadowMap::Update(const Camera& camera, const Vec3f& lightDirection)
+    {
+        const float near = camera.GetNearPlane();
+        const float far  = camera.GetFarPlane();
+        ComputeSplitDistances(near, far, m_CascadeCount, m_SplitLambda, m_SplitDistances);
+        m_MainViewMatrix = camera.GetViewMatrix();
+
+        // 视锥切片直接由相机参数求出，与投影的深度映射约定(反向Z、无穷远平面)无关
+        const Vec3f direction = Normalized(lightDirection);
+        for (int cascade = 0; cascade < m_CascadeCount; ++cascade)
+        {
+            Vec3f corners[8];
+            camera.GetFrustumCorners(m_SplitDistances[cascade], corners);
+            camera.GetFrustumCorners(m_SplitDistances[cascade + 1], corners + 4);
+            Vec3f center{};
+            for (const Vec3f& corner : corners)
+            {
+                center = center + corner;
+            }
+            center = center * (1.f / 8.f);
+
+            // 包围球拟合，半径与相机朝向无关，旋转相机时阴影图尺寸保持稳定
+            float radius = 0.f;
+            for (const Vec3f& corner : corners)
+            {
+                radius = std::max(radius, Norm(corner - center));
+            }
+            radius = std::ceil(radius * 16.f) / 16.f;
+
+            // 中心在光源平面内吸附到texel网格，避免相机平移时阴影边缘闪烁
+            const Camera   basis(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{}, direction, 0.f, 1.f, radius);
+            const Mat4x4f& basisView = basis.GetViewMatrix();
+            const Vec3f    right{basisView[0][0], basisView[1][0], basisView[2][0]};
+            const Vec3f    up{basisView[0][1], basisView[1][1], basisView[2][1]};
+            const float    texelSize = 2.f * radius / static_cast<float>(m_ShadowMaps[cascade].GetResolution());
+            const float    offsetX   = Dot(center, right);
+            const float    offsetY   = Dot(center, up);
+            center = center + right * (std::floor(offsetX / texelSize) * texelSize - offsetX) + up * (std::floor(offsetY / texelSize) * texelSize - offsetY);
+
+            m_LightCameras[cascade]   = Camera(Camera::EnumCameraType::ORTHOGRAPHIC, center - direction * radius, center, 0.f, 2.f * radius, radius);
+            m_LightViewProjs[cascade] = m_LightCameras[cascade].GetViewProjMatrix();
+            m_ShadowMaps[cascade].Clear();
+        }
+    }
+
+    void CascadedShadowMap::Render(const Mesh& mesh, const Mat4x4f& modelMatrix)
+    {
+        Mat4x4f matrices[MAX_CASCADE_COUNT];
+        for (int cascade = 0; cascade < m_CascadeCount; ++cascade)
+        {
+            matrices[cascade] = m_LightViewProjs[cascade] * modelMatrix;
+        }
+        MultiViewTransform transform;
+        transform.SetViews(matrices, m_CascadeCount);
+
+        // 每个顶点只读取一次，以SIMD同时变换到所有级联
+        const size_t vertexCount = mesh.vertices.size();
+        m_CascadeVertices.resize(vertexCount * m_CascadeCount);
+        m_CascadeOutcodes.resize(vertexCount * m_CascadeCount);
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const Vec3f& position = mesh.vertices[i].position;
+            Vec4f        clipPositions[MAX_CASCADE_COUNT];
+            transform.Transform(Vec4f{position.X(), position.Y(), position.Z(), 1.f}, clipPositions, &m_CascadeOutcodes[i * m_CascadeCount]);
+            for (int cascade = 0; cascade < m_CascadeCount; ++cascade)
+            {
+                m_CascadeVertices[i * m_CascadeCount + cascade] = m_ShadowMaps[cascade].ToRasterVertex(clipPositions[cascade]);
+            }
+        }
+
+        // 近平面外侧的遮挡体会被压平，不参与剔除
+        constexpr uint8_t cullMask = static_cast<uint8_t>(~CLIP_OUTSIDE_NEAR);
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            const size_t i0 = mesh.indices[i] * static_cast<size_t>(m_CascadeCount);
+            const size_t i1 = mesh.indices[i + 1] * static_cast<size_t>(m_CascadeCount);
+            const size_t i2 = mesh.indices[i + 2] * static_cast<size_t>(m_CascadeCount);
+            for (int cascade = 0; cascade < m_CascadeCount; ++cascade)
+            {
+                if ((m_CascadeOutcodes[i0 + cascade] & m_CascadeOutcodes[i1 + cascade] & m_CascadeOutcodes[i2 + cascade] & cullMask) != 0)
+                {
+                    continue;
+                }
+                m_ShadowMaps[cascade].RenderDepthTriangle(m_CascadeVertices[i0 + cascade], m_CascadeVertices[i1 + cascade], m_CascadeVertices[i2 + cascade], EnumCullMode::NONE);
+            }
+        }
+    }
+
+    int CascadedShadowMap::SelectCascade(float viewDepth) const
+    {
+        for (int cascade = 0; cascade < m_CascadeCount; ++cascade)
+        {
+            if (viewDepth <= m_SplitDistances[cascade + 1])
+            {
+                return viewDepth >= m_SplitDistances[0] ? cascade : -1;
+            }
+        }
+        return -1;
+    }
+
+    float CascadedShadowMap::Sample(const Vec3f& worldPosition) const
+    {
+        const Vec4f world{worldPosition.X(), worldPosition.Y(), worldPosition.Z(), 1.f};
+        const int   cascade = SelectCascade(-(m_MainViewMatrix * world)[2]);
+        if (cascade < 0)
+        {
+            return 1.f;
+        }
+        const Vec4f clip = m_LightViewProjs[cascade] * world;
+        const float u    = clip[0] * 0.5f + 0.5f;
+        const float v    = 0.5f - clip[1] * 0.5f;
+        if (u < 0.f || u > 1.f || v < 0.f || v > 1.f || clip[2] > 1.f)
+        {
+            return 1.f;
+        }
+        return m_ShadowMaps[cascade].SampleCompare(u, v, clip[2] - m_DepthBias);
+    }
+}   // namespace Joy
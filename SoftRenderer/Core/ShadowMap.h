@@ -0,0 +1,211 @@
+/**
+ * @file ShadowMap.h
+ * @author JoyatY
+ * @brief 阴影图与级联阴影图(CSM)
+ * @version 0.1
+ * @date 2025-12-15
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/Camera.h"
+#include "Core/Mesh.h"
+#include "Core/MultiView.h"
+#include "Core/Rasterizer.h"
+#include "Math/Mat.h"
+#include "Math/Vec.h"
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 阴影图，仅保存光源空间深度
+     *
+     * 纹理坐标与Renderer视口约定一致: u = ndcX * 0.5 + 0.5，v = 0.5 - ndcY * 0.5。
+     */
+    class ShadowMap
+    {
+    public:
+        /**
+         * @brief 构造阴影图
+         *
+         * @param resolution 边长(像素)
+         */
+        explicit ShadowMap(int resolution);
+
+    public:
+        int GetResolution() const { return m_Resolution; }
+
+        /**
+         * @brief 清除深度
+         *
+         * @param depth
+         */
+        void Clear(float depth = 1.f);
+
+        /**
+         * @brief 获取指定像素的深度
+         *
+         * @param x
+         * @param y
+         * @return float
+         */
+        float GetDepth(int x, int y) const { return m_Depths[static_cast<size_t>(y) * m_Pitch + x]; }
+
+        /**
+         * @brief 以仅深度路径渲染网格，只使用顶点位置，不执行着色与颜色写入
+         *
+         * 深度小于0的顶点被压平到近平面(pancaking)，使光源视锥外的遮挡体仍能投射阴影；
+         * w <= 0的三角形被丢弃，因此适用于正交光源或完全位于透视光源前方的几何体。
+         *
+         * @param mesh 网格
+         * @param modelLightViewProj 模型到光源裁剪空间的变换
+         * @param cullMode 面剔除模式
+         */
+        void RenderDepth(const Mesh& mesh, const Mat4x4f& modelLightViewProj, EnumCullMode cullMode = EnumCullMode::NONE);
+
+        /**
+         * @brief 裁剪空间位置转换为阴影图屏幕空间顶点(含近平面压平)，invW < 0 表示顶点位于光源后方
+         *
+         * @param clipPosition
+         * @return RasterVertex
+         */
+        RasterVertex ToRasterVertex(const Vec4f& clipPosition) const;
+
+        /**
+         * @brief 光栅化一个已变换的三角形到阴影图，供多视图路径复用
+         *
+         * @param v0
+         * @param v1
+         * @param v2
+         * @param cullMode 面剔除模式
+         */
+        void RenderDepthTriangle(const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2, EnumCullMode cullMode);
+
+        /**
+         * @brief 百分比渐近过滤(PCF)，3x3双线性加权，SIMD一次比较一行4个深度
+         *
+         * @param u 纹理坐标
+         * @param v 纹理坐标
+         * @param depth 接收点在光源空间的深度(已包含偏移)
+         * @return float 受光比例[0, 1]
+         */
+        float SampleCompare(float u, float v, float depth) const;
+
+    private:
+        int                       m_Resolution;
+        int                       m_Pitch;
+        std::vector<float>        m_Depths;
+        std::vector<RasterVertex> m_RasterVertices;
+    };
+
+    /**
+     * @brief 级联阴影图，将主相机视锥按深度切分，每段使用独立的正交光源相机
+     *
+     * 渲染时各级联作为多视图一次完成顶点变换与剔除。
+     */
+    class CascadedShadowMap
+    {
+    public:
+        /**
+         * @brief 最大级联数
+         *
+         */
+        constexpr static int MAX_CASCADE_COUNT = 4;
+
+        /**
+         * @brief 构造级联阴影图
+         *
+         * @param resolution 每级阴影图边长
+         * @param cascadeCount 级联数[1, MAX_CASCADE_COUNT]
+         */
+        CascadedShadowMap(int resolution, int cascadeCount);
+
+    public:
+        int GetCascadeCount() const { return m_CascadeCount; }
+
+        /**
+         * @brief 设置切分系数，0为均匀切分，1为对数切分
+         *
+         * @param lambda
+         */
+        void  SetSplitLambda(float lambda) { m_SplitLambda = lambda; }
+        float GetSplitLambda() const { return m_SplitLambda; }
+
+        /**
+         * @brief 设置阴影深度偏移，用于消除自阴影失真
+         *
+         * @param bias
+         */
+        void  SetDepthBias(float bias) { m_DepthBias = bias; }
+        float GetDepthBias() const { return m_DepthBias; }
+
+        /**
+         * @brief 按主相机视锥与光照方向更新各级切分及光源相机，并清除阴影图
+         *
+         * @param camera 主相机
+         * @param lightDirection 光线传播方向
+         */
+        void Update(const Camera& camera, const Vec3f& lightDirection);
+
+        /**
+         * @brief 将投射阴影的网格渲染到所有级联
+         *
+         * @param mesh 网格
+         * @param modelMatrix 模型矩阵
+         */
+        void Render(const Mesh& mesh, const Mat4x4f& modelMatrix);
+
+        /**
+         * @brief 查询世界空间点的受光比例，超出最后一级的点视为受光
+         *
+         * @param worldPosition
+         * @return float 受光比例[0, 1]
+         */
+        float Sample(const Vec3f& worldPosition) const;
+
+        /**
+         * @brief 按观察空间深度选择级联
+         *
+         * @param viewDepth 点到主相机的观察空间深度(沿朝向)
+         * @return int 级联索引，超出范围返回-1
+         */
+        int SelectCascade(float viewDepth) const;
+
+        float            GetSplitDistance(int cascade) const { return m_SplitDistances[cascade + 1]; }
+        const Camera&    GetLightCamera(int cascade) const { return m_LightCameras[cascade]; }
+        const Mat4x4f&   GetLightViewProj(int cascade) const { return m_LightViewProjs[cascade]; }
+        const ShadowMap& GetShadowMap(int cascade) const { return m_ShadowMaps[cascade]; }
+
+        /**
+         * @brief 计算视锥切分距离(均匀切分与对数切分的混合)
+         *
+         * @param near 近平面
+         * @param far 远平面
+         * @param cascadeCount 级联数
+         * @param lambda 混合系数
+         * @param splits 输出cascadeCount + 1个距离，首尾为near与far
+         */
+        static void ComputeSplitDistances(float near, float far, int cascadeCount, float lambda, float* splits);
+
+    private:
+        int                    m_CascadeCount;
+        float                  m_SplitLambda;
+        float                  m_DepthBias;
+        float                  m_SplitDistances[MAX_CASCADE_COUNT + 1];
+        Mat4x4f                m_MainViewMatrix;
+        Camera                 m_LightCameras[MAX_CASCADE_COUNT];
+        Mat4x4f                m_LightViewProjs[MAX_CASCADE_COUNT];
+        std::vector<ShadowMap> m_ShadowMaps;
+
+        /**
+         * @brief 多视图渲染缓存，按[顶点][级联]排列
+         *
+         */
+        std::vector<RasterVertex> m_CascadeVertices;
+        std::vector<uint8_t>      m_CascadeOutcodes;
+    };
+}   // namespace Joy
@@ -0,0 +1,269 @@
+#include "Core/SharedFrameRing.h"
+#include <atomic>
+#include <cassert>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Joy
+{
+    /**
+     * @brief 共享内存头部，生产者与消费者按相同布局访问
+     *
+     */
+    struct SharedFrameRing::Header
+    {
+        /**
+         * @brief 初始化完成后最后写入，消费者据此判断头部是否可用
+         *
+         */
+        std::atomic<uint32_t> magic;
+        uint32_t              version;
+        int32_t               width;
+        int32_t               height;
+        int32_t               colorFormat;
+        int32_t               colorPitch;
+        int32_t               slotCount;
+        int32_t               reserved;
+        uint64_t              slotStride;
+        uint64_t              dataOffset;
+
+        /**
+         * @brief 最新帧: (序号 << 8) | 帧索引，0表示尚未发布
+         *
+         */
+        alignas(64) std::atomic<uint64_t> latestFrame;
+
+        /**
+         * @brief 消费者正在读取的帧索引，NO_SLOT表示没有
+         *
+         */
+        alignas(64) std::atomic<uint32_t> readerSlot;
+    };
+
+    namespace
+    {
+        constexpr uint32_t SHARED_FRAME_MAGIC   = 0x4A4F5946;   // "JOYF"
+        constexpr uint32_t SHARED_FRAME_VERSION = 1;
+        constexpr uint32_t NO_SLOT              = 0xFFFFFFFFu;
+        constexpr uint64_t SLOT_MASK            = 0xFF;
+        constexpr int      SEQUENCE_SHIFT       = 8;
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                      "cross-process atomics must be lock-free");
+
+        size_t AlignToPage(size_t size)
+        {
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return (size + pageSize - 1) / pageSize * pageSize;
+        }
+    }   // namespace
+
+    SharedFrameRing::SharedFrameRing()
+        : m_Name()
+        , m_Mapping(nullptr)
+        , m_MappingSize(0)
+        , m_Producer(false)
+        , m_WritingSlot(-1)
+        , m_Sequence(0)
+    {
+    }
+
+    SharedFrameRing::~SharedFrameRing() { Close(); }
+
+    bool SharedFrameRing::Create(const std::string& name, int width, int height, EnumColorFormat colorFormat, int slotCount)
+    {
+        assert(width > 0 && height > 0);
+        assert(slotCount >= MIN_SLOT_COUNT && slotCount <= MAX_SLOT_COUNT);
+        Close();
+        shm_unlink(name.c_str());
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return false;
+        }
+        // 每帧按页对齐，消费者可以单独映射或锁定某一帧
+        const int    colorPitch = width * GetBytesPerPixel(colorFormat);
+        const size_t dataOffset = AlignToPage(sizeof(Header));
+        const size_t slotStride = AlignToPage(static_cast<size_t>(colorPitch) * height);
+        const size_t size       = dataOffset + slotStride * slotCount;
+        void*        mapping    = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+        {
+            mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            shm_unlink(name.c_str());
+            return false;
+        }
+
+        Header* header      = new (mapping) Header();
+        header->version     = SHARED_FRAME_VERSION;
+        header->width       = width;
+        header->height      = height;
+        header->colorFormat = static_cast<int32_t>(colorFormat);
+        header->colorPitch  = colorPitch;
+        header->slotCount   = slotCount;
+        header->reserved    = 0;
+        header->slotStride  = slotStride;
+        header->dataOffset  = dataOffset;
+        header->latestFrame.store(0, std::memory_order_relaxed);
+        header->readerSlot.store(NO_SLOT, std::memory_order_relaxed);
+        header->magic.store(SHARED_FRAME_MAGIC, std::memory_order_release);
+
+        m_Name        = name;
+        m_Mapping     = mapping;
+        m_MappingSize = size;
+        m_Producer    = true;
+        m_WritingSlot = -1;
+        m_Sequence    = 0;
+        return true;
+    }
+
+    bool SharedFrameRing::Open(const std::string& name)
+    {
+        Close();
+        const int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat status;
+        void*       mapping = MAP_FAILED;
+        size_t      size    = 0;
+        if (fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(Header))
+        {
+            size    = static_cast<size_t>(status.st_size);
+            mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        const Header* header = reinterpret_cast<const Header*>(mapping);
+        const bool    valid  = header->magic.load(std::memory_order_acquire) == SHARED_FRAME_MAGIC && header->version == SHARED_FRAME_VERSION &&
+                           header->slotCount >= MIN_SLOT_COUNT && header->slotCount <= MAX_SLOT_COUNT &&
+                           header->dataOffset + header->slotStride * header->slotCount <= size;
+        if (!valid)
+        {
+            munmap(mapping, size);
+            return false;
+        }
+        m_Name        = name;
+        m_Mapping     = mapping;
+        m_MappingSize = size;
+        m_Producer    = false;
+        return true;
+    }
+
+    void SharedFrameRing::Close()
+    {
+        if (m_Mapping == nullptr)
+        {
+            return;
+        }
+        if (!m_Producer)
+        {
+            ReleaseFrame();
+        }
+        munmap(m_Mapping, m_MappingSize);
+        if (m_Producer)
+        {
+            shm_unlink(m_Name.c_str());
+        }
+        m_Name.clear();
+        m_Mapping     = nullptr;
+        m_MappingSize = 0;
+        m_Producer    = false;
+        m_WritingSlot = -1;
+        m_Sequence    = 0;
+    }
+
+    int             SharedFrameRing::GetWidth() const { return GetHeader()->width; }
+    int             SharedFrameRing::GetHeight() const { return GetHeader()->height; }
+    EnumColorFormat SharedFrameRing::GetColorFormat() const { return static_cast<EnumColorFormat>(GetHeader()->colorFormat); }
+    int             SharedFrameRing::GetColorPitch() const { return GetHeader()->colorPitch; }
+    int             SharedFrameRing::GetSlotCount() const { return GetHeader()->slotCount; }
+
+    uint64_t SharedFrameRing::GetLatestSequence() const { return GetHeader()->latestFrame.load(std::memory_order_acquire) >> SEQUENCE_SHIFT; }
+
+    void SharedFrameRing::BeginFrame(FrameBuffer& frameBuffer)
+    {
+        assert(IsOpen() && m_Producer);
+        assert(frameBuffer.GetWidth() == GetWidth() && frameBuffer.GetHeight() == GetHeight() && frameBuffer.GetColorFormat() == GetColorFormat());
+        Header*        header = GetHeader();
+        const uint64_t latest = header->latestFrame.load(std::memory_order_seq_cst);
+        // 与消费者登记readerSlot后复查latestFrame配对: 两边都是顺序一致的先写后读，
+        // 生产者读到旧的readerSlot时，消费者的复查必然看到更新的latestFrame并重新登记
+        const uint32_t reader     = header->readerSlot.load(std::memory_order_seq_cst);
+        const int      latestSlot = latest == 0 ? -1 : static_cast<int>(latest & SLOT_MASK);
+        const int      slotCount  = header->slotCount;
+        int            slot       = m_WritingSlot;
+        for (int i = 1; i <= slotCount; ++i)
+        {
+            const int candidate = (m_WritingSlot + i + slotCount) % slotCount;
+            if (candidate != latestSlot && static_cast<uint32_t>(candidate) != reader)
+            {
+                slot = candidate;
+                break;
+            }
+        }
+        assert(slot >= 0);
+        m_WritingSlot = slot;
+        frameBuffer.BindColorStorage(GetSlotData(slot));
+    }
+
+    uint64_t SharedFrameRing::PublishFrame(FrameBuffer& frameBuffer)
+    {
+        assert(IsOpen() && m_Producer && m_WritingSlot >= 0);
+        frameBuffer.ResolveColorFastClear();
+        ++m_Sequence;
+        GetHeader()->latestFrame.store((m_Sequence << SEQUENCE_SHIFT) | static_cast<uint64_t>(m_WritingSlot), std::memory_order_seq_cst);
+        return m_Sequence;
+    }
+
+    const uint8_t* SharedFrameRing::AcquireLatestFrame(uint64_t* sequence)
+    {
+        assert(IsOpen() && !m_Producer);
+        Header*  header = GetHeader();
+        uint64_t latest = header->latestFrame.load(std::memory_order_seq_cst);
+        if (latest == 0)
+        {
+            return nullptr;
+        }
+        // 登记后复查: 登记期间若有新帧发布，登记的帧可能已被生产者选中，改为登记新帧
+        for (;;)
+        {
+            header->readerSlot.store(static_cast<uint32_t>(latest & SLOT_MASK), std::memory_order_seq_cst);
+            const uint64_t check = header->latestFrame.load(std::memory_order_seq_cst);
+            if (check == latest)
+            {
+                break;
+            }
+            latest = check;
+        }
+        if (sequence != nullptr)
+        {
+            *sequence = latest >> SEQUENCE_SHIFT;
+        }
+        return GetSlotData(static_cast<int>(latest & SLOT_MASK));
+    }
+
+    void SharedFrameRing::ReleaseFrame()
+    {
+        assert(IsOpen() && !m_Producer);
+        GetHeader()->readerSlot.store(NO_SLOT, std::memory_order_release);
+    }
+
+    uint8_t* SharedFrameRing::GetSlotData(int slot) const
+    {
+        const Header* header = GetHeader();
+        return static_cast<uint8_t*>(m_Mapping) + header->dataOffset + header->slotStride * static_cast<size_t>(slot);
+    }
+}   // namespace Joy
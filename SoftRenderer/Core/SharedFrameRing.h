@@ -0,0 +1,144 @@
+/**
+ * @file SharedFrameRing.h
+ * @author JoyatY
+ * @brief POSIX共享内存中的帧环，渲染结果零拷贝地交给其他进程
+ * @version 0.1
+ * @date 2025-12-27
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Joy
+{
+    /**
+     * @brief 共享内存帧环
+     *
+     * 生产者(渲染进程)用Create创建名为name的POSIX共享内存对象，其中是一个头部与slotCount个按页对齐的颜色帧。
+     * BeginFrame把下一个空闲帧绑定为FrameBuffer的颜色存储，渲染直接写入共享内存；PublishFrame落地快速清除后发布该帧。
+     * 消费者(如合成器)用Open映射同一对象，AcquireLatestFrame返回最新一帧在映射中的指针，不发生任何拷贝。
+     *
+     * 同步不使用锁: 头部只有两个原子量，最新帧(序号与帧索引)由生产者发布，正在读取的帧索引由消费者登记。
+     * 生产者从不写入最新帧与被登记的帧，slotCount不小于3时总有空闲帧，两端都不会等待对方，消费者崩溃也不会阻塞渲染。
+     * 每个帧环只支持一个生产者与一个消费者，跨进程的原子量要求平台上对应宽度的原子操作免锁。
+     */
+    class SharedFrameRing
+    {
+    public:
+        /**
+         * @brief 帧数上下限，至少3帧才能保证生产者总有空闲帧
+         *
+         */
+        constexpr static int MIN_SLOT_COUNT = 3;
+        constexpr static int MAX_SLOT_COUNT = 16;
+
+    public:
+        SharedFrameRing();
+        ~SharedFrameRing();
+
+        SharedFrameRing(const SharedFrameRing&)            = delete;
+        SharedFrameRing& operator=(const SharedFrameRing&) = delete;
+
+    public:
+        /**
+         * @brief 作为生产者创建帧环，已存在的同名对象(如上次崩溃遗留)会被替换，Close时删除共享内存对象
+         *
+         * @param name 共享内存对象名，以'/'开头
+         * @param width 帧宽度(像素)
+         * @param height 帧高度(像素)
+         * @param colorFormat 颜色格式
+         * @param slotCount 帧数，在[MIN_SLOT_COUNT, MAX_SLOT_COUNT]内
+         * @return true 成功
+         * @return false 系统调用失败
+         */
+        bool Create(const std::string& name, int width, int height, EnumColorFormat colorFormat, int slotCount = MIN_SLOT_COUNT);
+
+        /**
+         * @brief 作为消费者映射已有的帧环
+         *
+         * @param name 共享内存对象名
+         * @return true 成功
+         * @return false 对象不存在，或生产者尚未完成初始化，可稍后重试
+         */
+        bool Open(const std::string& name);
+
+        /**
+         * @brief 解除映射，生产者同时删除共享内存对象(已映射的消费者不受影响)
+         *
+         */
+        void Close();
+
+        bool            IsOpen() const { return m_Mapping != nullptr; }
+        bool            IsProducer() const { return m_Producer; }
+        int             GetWidth() const;
+        int             GetHeight() const;
+        EnumColorFormat GetColorFormat() const;
+        int             GetColorPitch() const;
+        int             GetSlotCount() const;
+
+        /**
+         * @brief 最近发布的帧序号(从1开始)，尚未发布时为0；消费者可轮询它判断是否有新帧
+         *
+         * @return uint64_t
+         */
+        uint64_t GetLatestSequence() const;
+
+        /**
+         * @brief 生产者: 选择一个空闲帧并绑定为frameBuffer的颜色存储
+         *
+         * 绑定后颜色分块处于快速清除状态，frameBuffer的尺寸与颜色格式必须与帧环一致。
+         * 发布之后到下一次BeginFrame之前不应再写入frameBuffer的颜色，否则会改动已发布的帧。
+         *
+         * @param frameBuffer
+         */
+        void BeginFrame(FrameBuffer& frameBuffer);
+
+        /**
+         * @brief 生产者: 落地颜色快速清除并发布当前帧
+         *
+         * @param frameBuffer 与BeginFrame相同的帧缓冲
+         * @return uint64_t 发布的帧序号
+         */
+        uint64_t PublishFrame(FrameBuffer& frameBuffer);
+
+        /**
+         * @brief 消费者: 取得最新一帧，在ReleaseFrame或下一次AcquireLatestFrame之前生产者不会写入它
+         *
+         * @param sequence 输出帧序号，可为nullptr
+         * @return const uint8_t* 帧的颜色数据(行跨度为GetColorPitch)，尚未发布任何帧时为nullptr
+         */
+        const uint8_t* AcquireLatestFrame(uint64_t* sequence = nullptr);
+
+        /**
+         * @brief 消费者: 归还AcquireLatestFrame取得的帧
+         *
+         */
+        void ReleaseFrame();
+
+    private:
+        struct Header;
+
+        Header*  GetHeader() const { return reinterpret_cast<Header*>(m_Mapping); }
+        uint8_t* GetSlotData(int slot) const;
+
+    private:
+        std::string m_Name;
+        void*       m_Mapping;
+        size_t      m_MappingSize;
+        bool        m_Producer;
+
+        /**
+         * @brief 生产者正在写入的帧与上一次发布的序号
+         *
+         */
+        int      m_WritingSlot;
+        uint64_t m_Sequence;
+    };
+}   // namespace Joy
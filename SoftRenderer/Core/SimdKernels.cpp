@@ -0,0 +1,181 @@
+#include "Core/SimdKernels.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    define JOY_SIMD_X86 1
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#else
+#    define JOY_SIMD_X86 0
+#endif
+
+namespace Joy
+{
+    namespace
+    {
+#if JOY_SIMD_X86
+        void CpuId(uint32_t leaf, uint32_t subLeaf, uint32_t* regs)
+        {
+#    if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+            for (int i = 0; i < 4; ++i)
+            {
+                regs[i] = static_cast<uint32_t>(info[i]);
+            }
+#    else
+            __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#    endif
+        }
+
+        /**
+         * @brief 读取XCR0，得到操作系统在上下文切换时保存的寄存器状态
+         *
+         */
+        uint64_t ReadXcr0()
+        {
+#    if defined(_MSC_VER)
+            return _xgetbv(0);
+#    else
+            uint32_t eax = 0;
+            uint32_t edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<uint64_t>(edx) << 32) | eax;
+#    endif
+        }
+#endif
+
+        /**
+         * @brief CPU与操作系统支持的最高等级，不考虑本库是否编译了该路径
+         *
+         */
+        EnumSimdLevel DetectCpuSimdLevel()
+        {
+#if JOY_SIMD_X86
+            uint32_t regs[4];
+            CpuId(0, 0, regs);
+            const uint32_t maxLeaf = regs[0];
+            CpuId(1, 0, regs);
+            const bool sse2    = (regs[3] & (1u << 26)) != 0;
+            const bool osxsave = (regs[2] & (1u << 27)) != 0;
+            if (!sse2)
+            {
+                return EnumSimdLevel::SCALAR;
+            }
+            if (!osxsave || maxLeaf < 7)
+            {
+                return EnumSimdLevel::SSE2;
+            }
+            // YMM需要XCR0的SSE与AVX状态位，ZMM另外需要opmask与高位ZMM状态位
+            const uint64_t xcr0  = ReadXcr0();
+            const bool     ymmOs = (xcr0 & 0x6) == 0x6;
+            const bool     zmmOs = (xcr0 & 0xE6) == 0xE6;
+            CpuId(7, 0, regs);
+            const bool avx2    = (regs[1] & (1u << 5)) != 0;
+            const bool avx512f = (regs[1] & (1u << 16)) != 0;
+            if (avx512f && avx2 && zmmOs)
+            {
+                return EnumSimdLevel::AVX512;
+            }
+            if (avx2 && ymmOs)
+            {
+                return EnumSimdLevel::AVX2;
+            }
+            return EnumSimdLevel::SSE2;
+#else
+            return EnumSimdLevel::SCALAR;
+#endif
+        }
+
+        /**
+         * @brief 本库编译了的某等级内核，不检查CPU
+         *
+         */
+        const SimdKernels* GetCompiledSimdKernels(EnumSimdLevel level)
+        {
+            switch (level)
+            {
+#if JOY_SIMD_DISPATCH_AVX512
+                case EnumSimdLevel::AVX512: return &Detail::GetAvx512SimdKernels();
+#endif
+#if JOY_SIMD_DISPATCH_AVX2
+                case EnumSimdLevel::AVX2: return &Detail::GetAvx2SimdKernels();
+#endif
+                // 标量路径总是单独编译，基准实现在x86上是SSE2
+                case EnumSimdLevel::SCALAR: return &Detail::GetScalarSimdKernels();
+                default: return Detail::GetBaselineSimdKernels().level == level ? &Detail::GetBaselineSimdKernels() : nullptr;
+            }
+        }
+
+        std::atomic<const SimdKernels*> g_SimdKernels{nullptr};
+    }   // namespace
+
+    EnumSimdLevel DetectSimdLevel()
+    {
+        const EnumSimdLevel cpuLevel = DetectCpuSimdLevel();
+        for (int level = static_cast<int>(cpuLevel); level > static_cast<int>(EnumSimdLevel::SCALAR); --level)
+        {
+            if (GetCompiledSimdKernels(static_cast<EnumSimdLevel>(level)) != nullptr)
+            {
+                return static_cast<EnumSimdLevel>(level);
+            }
+        }
+        return Detail::GetBaselineSimdKernels().level;
+    }
+
+    EnumSimdLevel GetDefaultSimdLevel()
+    {
+#ifdef JOY_FORCE_SIMD_LEVEL
+        if (FindSimdKernels(static_cast<EnumSimdLevel>(JOY_FORCE_SIMD_LEVEL)) != nullptr)
+        {
+            return static_cast<EnumSimdLevel>(JOY_FORCE_SIMD_LEVEL);
+        }
+#endif
+        return DetectSimdLevel();
+    }
+
+    const SimdKernels& GetSimdKernels()
+    {
+        const SimdKernels* kernels = g_SimdKernels.load(std::memory_order_acquire);
+        if (kernels == nullptr)
+        {
+            // 并发的首次调用选择结果相同，重复写入无害
+            kernels = FindSimdKernels(GetDefaultSimdLevel());
+            g_SimdKernels.store(kernels, std::memory_order_release);
+        }
+        return *kernels;
+    }
+
+    bool SetSimdLevel(EnumSimdLevel level)
+    {
+        const SimdKernels* kernels = FindSimdKernels(level);
+        if (kernels == nullptr)
+        {
+            return false;
+        }
+        g_SimdKernels.store(kernels, std::memory_order_release);
+        return true;
+    }
+
+    const SimdKernels* FindSimdKernels(EnumSimdLevel level)
+    {
+        return static_cast<int>(level) <= static_cast<int>(DetectCpuSimdLevel()) || level == Detail::GetBaselineSimdKernels().level
+                   ? GetCompiledSimdKernels(level)
+                   : nullptr;
+    }
+
+    const char* GetSimdLevelName(EnumSimdLevel level)
+    {
+        switch (level)
+        {
+            case EnumSimdLevel::SCALAR: return "Scalar";
+            case EnumSimdLevel::SSE2: return "SSE2";
+            case EnumSimdLevel::AVX2: return "AVX2";
+            case EnumSimdLevel::AVX512: return "AVX-512";
+        }
+        return "Unknown";
+    }
+}   // namespace Joy
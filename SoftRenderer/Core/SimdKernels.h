@@ -0,0 +1,145 @@
+/**
+ * @file SimdKernels.h
+ * @author JoyatY
+ * @brief 热点SIMD内核的运行时分派(SSE2/AVX2/AVX-512)
+ * @version 0.1
+ * @date 2025-12-26
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Mat.h"
+#include "Math/Vec.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Joy
+{
+    enum class EnumDepthTest;
+
+    /**
+     * @brief SIMD指令集等级，数值越大向量越宽
+     *
+     */
+    enum class EnumSimdLevel
+    {
+        SCALAR = 0,
+        SSE2   = 1,
+        AVX2   = 2,
+        AVX512 = 3,
+    };
+
+    /**
+     * @brief 一行像素的边函数与深度平面: 像素中心px处的边函数为edgeA * px + edgeRow，深度为depthA * px + depthRow
+     *
+     */
+    struct EdgeSpan
+    {
+        float edgeA[3];
+        float edgeRow[3];
+        bool  edgeTopLeft[3];
+        float depthA;
+        float depthRow;
+    };
+
+    /**
+     * @brief 内核函数表
+     *
+     * 各指令集的实现与基准实现逐位一致: 运算顺序相同且不使用融合乘加，切换路径不会改变渲染结果。
+     */
+    struct SimdKernels
+    {
+        /**
+         * @brief 内核一次处理的最大像素/采样数
+         *
+         */
+        constexpr static int SPAN_SIZE = 64;
+
+        EnumSimdLevel level;
+
+        /**
+         * @brief 批量变换 out[i] = mat * positions[i]，out可与positions为同一数组(不可部分重叠)
+         *
+         */
+        void (*transformPositions)(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out);
+
+        /**
+         * @brief 计算从x开始的count(不超过SPAN_SIZE)个像素的覆盖
+         *
+         * @return uint64_t 第i位表示像素x + i在三角形内(左上填充规则)且深度在[0, 1]内；depths输出各像素深度，长度至少为SPAN_SIZE
+         */
+        uint64_t (*coverSpan)(const EdgeSpan& span, int x, int count, float* depths);
+
+        /**
+         * @brief 深度测试count(不超过SPAN_SIZE)个值
+         *
+         * @return uint64_t 第i位表示depths[i]相对stored[i]通过测试
+         */
+        uint64_t (*depthTestSpan)(EnumDepthTest depthTest, const float* depths, const float* stored, int count);
+
+        /**
+         * @brief 一维卷积 out[x] = sum(taps[x + k] * weights[k])，k从0到tapCount - 1依次累加
+         *
+         */
+        void (*convolveRow)(const Vec4f* taps, const float* weights, int tapCount, int count, Vec4f* out);
+
+        /**
+         * @brief 加权累加 accumulator[x] = source[x] * weight + accumulator[x]
+         *
+         */
+        void (*accumulateRow)(const Vec4f* source, float weight, int count, Vec4f* accumulator);
+    };
+
+    /**
+     * @brief 检测CPU与操作系统共同支持的最高指令集等级(只考虑本库编译了的路径)
+     *
+     */
+    EnumSimdLevel DetectSimdLevel();
+
+    /**
+     * @brief 默认路径: CMake选项JOY_SIMD_LEVEL指定且CPU支持时为该等级，否则为DetectSimdLevel()
+     *
+     */
+    EnumSimdLevel GetDefaultSimdLevel();
+
+    /**
+     * @brief 当前使用的内核
+     *
+     * 首次调用时选择GetDefaultSimdLevel()的路径。
+     */
+    const SimdKernels& GetSimdKernels();
+
+    inline EnumSimdLevel GetSimdLevel() { return GetSimdKernels().level; }
+
+    /**
+     * @brief 切换内核路径，用于测试与基准对比。不能与渲染并发调用
+     *
+     * @param level 目标等级
+     * @return true 切换成功
+     * @return false 本库未编译该路径或CPU不支持，保持原路径
+     */
+    bool SetSimdLevel(EnumSimdLevel level);
+
+    /**
+     * @brief 某等级的内核，未编译或CPU不支持时返回nullptr
+     *
+     */
+    const SimdKernels* FindSimdKernels(EnumSimdLevel level);
+
+    const char* GetSimdLevelName(EnumSimdLevel level);
+
+    namespace Detail
+    {
+        /**
+         * @brief 各指令集的内核表，定义在对应编译选项的源文件中
+         *
+         */
+        const SimdKernels& GetScalarSimdKernels();
+        const SimdKernels& GetBaselineSimdKernels();
+        const SimdKernels& GetAvx2SimdKernels();
+        const SimdKernels& GetAvx512SimdKernels();
+    }   // namespace Detail
+}   // namespace Joy
@@ -0,0 +1,147 @@
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+#include <immintrin.h>
+
+// 本文件以AVX2编译(见CMakeLists.txt)，只在运行时检测到AVX2后才会被调用。乘加保持先乘后加，不使用FMA，结果与基准实现逐位一致。
+// 不得调用头文件中的inline函数或模板(包括Vec/Mat的成员函数)：它们在本文件中生成的AVX2版本可能被链接器选为全局唯一定义
+namespace Joy
+{
+    namespace
+    {
+        inline const float* Floats(const Vec4f* vec) { return reinterpret_cast<const float*>(vec); }
+        inline float*       Floats(Vec4f* vec) { return reinterpret_cast<float*>(vec); }
+
+        inline __m256 MulColumns(const __m256* columns, __m256 position)
+        {
+            const __m256 x  = _mm256_permute_ps(position, 0x00);
+            const __m256 y  = _mm256_permute_ps(position, 0x55);
+            const __m256 z  = _mm256_permute_ps(position, 0xAA);
+            const __m256 w  = _mm256_permute_ps(position, 0xFF);
+            const __m256 xy = _mm256_add_ps(_mm256_mul_ps(columns[1], y), _mm256_mul_ps(columns[0], x));
+            return _mm256_add_ps(_mm256_mul_ps(columns[3], w), _mm256_add_ps(_mm256_mul_ps(columns[2], z), xy));
+        }
+
+        void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out)
+        {
+            // 每个寄存器的高低128位各放一个位置
+            const __m128* matColumns = reinterpret_cast<const __m128*>(&mat);
+            const __m256  columns[4] = {_mm256_broadcast_ps(&matColumns[0]), _mm256_broadcast_ps(&matColumns[1]), _mm256_broadcast_ps(&matColumns[2]),
+                                        _mm256_broadcast_ps(&matColumns[3])};
+            const float*  src        = Floats(positions);
+            float*        dst        = Floats(out);
+            size_t        i          = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                _mm256_storeu_ps(&dst[i * 4], MulColumns(columns, _mm256_loadu_ps(&src[i * 4])));
+            }
+            if (i < count)
+            {
+                const __m256 position = _mm256_castps128_ps256(_mm_loadu_ps(&src[i * 4]));
+                _mm_storeu_ps(&dst[i * 4], _mm256_castps256_ps128(MulColumns(columns, position)));
+            }
+        }
+
+        uint64_t CoverSpan(const EdgeSpan& span, int x, int count, float* depths)
+        {
+            const __m256 laneOffset = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+            const __m256 zero       = _mm256_setzero_ps();
+            const __m256 one        = _mm256_set1_ps(1.f);
+            const __m256 endX       = _mm256_set1_ps(static_cast<float>(x + count));
+            const __m256 depthA     = _mm256_set1_ps(span.depthA);
+            const __m256 depthRow   = _mm256_set1_ps(span.depthRow);
+            __m256       edgeA[3];
+            __m256       edgeRow[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                edgeA[k]   = _mm256_set1_ps(span.edgeA[k]);
+                edgeRow[k] = _mm256_set1_ps(span.edgeRow[k]);
+            }
+            uint64_t mask = 0;
+            for (int i = 0; i < count; i += 8)
+            {
+                const __m256 px     = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x + i)), laneOffset);
+                __m256       inside = _mm256_cmp_ps(px, endX, _CMP_LT_OS);
+                for (int k = 0; k < 3; ++k)
+                {
+                    const __m256 edge = _mm256_add_ps(_mm256_mul_ps(edgeA[k], px), edgeRow[k]);
+                    inside = _mm256_and_ps(inside, span.edgeTopLeft[k] ? _mm256_cmp_ps(edge, zero, _CMP_GE_OS) : _mm256_cmp_ps(edge, zero, _CMP_GT_OS));
+                }
+                const __m256 depth = _mm256_add_ps(_mm256_mul_ps(depthA, px), depthRow);
+                _mm256_storeu_ps(&depths[i], depth);
+                inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(depth, zero, _CMP_GE_OS), _mm256_cmp_ps(depth, one, _CMP_LE_OS)));
+                mask |= static_cast<uint64_t>(_mm256_movemask_ps(inside)) << i;
+            }
+            return mask;
+        }
+
+        uint64_t DepthTestSpan(EnumDepthTest depthTest, const float* depths, const float* stored, int count)
+        {
+            uint64_t mask  = 0;
+            int      index = 0;
+            for (; index + 8 <= count; index += 8)
+            {
+                const __m256 depth  = _mm256_loadu_ps(&depths[index]);
+                const __m256 old    = _mm256_loadu_ps(&stored[index]);
+                const __m256 passed = depthTest == EnumDepthTest::LESS ? _mm256_cmp_ps(depth, old, _CMP_LT_OS) : _mm256_cmp_ps(depth, old, _CMP_GT_OS);
+                mask |= static_cast<uint64_t>(_mm256_movemask_ps(passed)) << index;
+            }
+            for (; index < count; ++index)
+            {
+                const bool passed = depthTest == EnumDepthTest::LESS ? depths[index] < stored[index] : depths[index] > stored[index];
+                mask |= static_cast<uint64_t>(passed) << index;
+            }
+            return mask;
+        }
+
+        void ConvolveRow(const Vec4f* tapPixels, const float* weights, int tapCount, int count, Vec4f* outPixels)
+        {
+            const float* taps = Floats(tapPixels);
+            float*       out  = Floats(outPixels);
+            // 每个寄存器处理相邻的两个像素
+            for (int x = 0; x < count; ++x)
+            {
+                _mm_storeu_ps(&out[x * 4], _mm_setzero_ps());
+            }
+            for (int k = 0; k < tapCount; ++k)
+            {
+                const __m256 weight = _mm256_set1_ps(weights[k]);
+                int          x      = 0;
+                for (; x + 2 <= count; x += 2)
+                {
+                    _mm256_storeu_ps(&out[x * 4], _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&taps[(x + k) * 4]), weight), _mm256_loadu_ps(&out[x * 4])));
+                }
+                if (x < count)
+                {
+                    const __m128 product = _mm_mul_ps(_mm_loadu_ps(&taps[(x + k) * 4]), _mm256_castps256_ps128(weight));
+                    _mm_storeu_ps(&out[x * 4], _mm_add_ps(product, _mm_loadu_ps(&out[x * 4])));
+                }
+            }
+        }
+
+        void AccumulateRow(const Vec4f* sourcePixels, float weight, int count, Vec4f* accumulatorPixels)
+        {
+            const float* source      = Floats(sourcePixels);
+            float*       accumulator = Floats(accumulatorPixels);
+            const __m256 weightVec   = _mm256_set1_ps(weight);
+            int          x           = 0;
+            for (; x + 2 <= count; x += 2)
+            {
+                _mm256_storeu_ps(&accumulator[x * 4], _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&source[x * 4]), weightVec), _mm256_loadu_ps(&accumulator[x * 4])));
+            }
+            if (x < count)
+            {
+                const __m128 product = _mm_mul_ps(_mm_loadu_ps(&source[x * 4]), _mm256_castps256_ps128(weightVec));
+                _mm_storeu_ps(&accumulator[x * 4], _mm_add_ps(product, _mm_loadu_ps(&accumulator[x * 4])));
+            }
+        }
+    }   // namespace
+
+    namespace Detail
+    {
+        const SimdKernels& GetAvx2SimdKernels()
+        {
+            static const SimdKernels kernels{EnumSimdLevel::AVX2, &TransformPositions, &CoverSpan, &DepthTestSpan, &ConvolveRow, &AccumulateRow};
+            return kernels;
+        }
+    }   // namespace Detail
+}   // namespace Joy
@@ -0,0 +1,151 @@
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+#include <immintrin.h>
+
+// 本文件以AVX-512F编译(见CMakeLists.txt)，只在运行时检测到AVX-512F后才会被调用。乘加保持先乘后加，不使用FMA，结果与基准实现逐位一致。
+// 不得调用头文件中的inline函数或模板(包括Vec/Mat的成员函数)：它们在本文件中生成的AVX-512版本可能被链接器选为全局唯一定义
+namespace Joy
+{
+    namespace
+    {
+        inline const float* Floats(const Vec4f* vec) { return reinterpret_cast<const float*>(vec); }
+        inline float*       Floats(Vec4f* vec) { return reinterpret_cast<float*>(vec); }
+
+        /**
+         * @brief 前count个通道为1的掩码
+         *
+         */
+        inline __mmask16 TailMask(int count) { return static_cast<__mmask16>((1u << count) - 1u); }
+
+        /**
+         * @brief 从first开始、不超过16个通道的有效掩码，每个元素占elementSize个通道
+         *
+         */
+        inline __mmask16 ValidMask(int first, int count, int elementSize)
+        {
+            const int remaining = count - first;
+            return remaining * elementSize >= 16 ? static_cast<__mmask16>(0xFFFF) : TailMask(remaining * elementSize);
+        }
+
+        inline __m512 MulColumns(const __m512* columns, __m512 position)
+        {
+            const __m512 x  = _mm512_permute_ps(position, 0x00);
+            const __m512 y  = _mm512_permute_ps(position, 0x55);
+            const __m512 z  = _mm512_permute_ps(position, 0xAA);
+            const __m512 w  = _mm512_permute_ps(position, 0xFF);
+            const __m512 xy = _mm512_add_ps(_mm512_mul_ps(columns[1], y), _mm512_mul_ps(columns[0], x));
+            return _mm512_add_ps(_mm512_mul_ps(columns[3], w), _mm512_add_ps(_mm512_mul_ps(columns[2], z), xy));
+        }
+
+        void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out)
+        {
+            // 每个寄存器的4个128位通道各放一个位置，不足4个的尾部使用掩码读写
+            const float*  matData    = reinterpret_cast<const float*>(&mat);
+            const __m512  columns[4] = {_mm512_broadcast_f32x4(_mm_loadu_ps(&matData[0])), _mm512_broadcast_f32x4(_mm_loadu_ps(&matData[4])),
+                                        _mm512_broadcast_f32x4(_mm_loadu_ps(&matData[8])), _mm512_broadcast_f32x4(_mm_loadu_ps(&matData[12]))};
+            const float*  src        = Floats(positions);
+            float*        dst        = Floats(out);
+            size_t        i          = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm512_storeu_ps(&dst[i * 4], MulColumns(columns, _mm512_loadu_ps(&src[i * 4])));
+            }
+            if (i < count)
+            {
+                const __mmask16 mask = TailMask(static_cast<int>(count - i) * 4);
+                _mm512_mask_storeu_ps(&dst[i * 4], mask, MulColumns(columns, _mm512_maskz_loadu_ps(mask, &src[i * 4])));
+            }
+        }
+
+        uint64_t CoverSpan(const EdgeSpan& span, int x, int count, float* depths)
+        {
+            const __m512 laneOffset = _mm512_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f, 8.5f, 9.5f, 10.5f, 11.5f, 12.5f, 13.5f, 14.5f, 15.5f);
+            const __m512 zero       = _mm512_setzero_ps();
+            const __m512 one        = _mm512_set1_ps(1.f);
+            const __m512 endX       = _mm512_set1_ps(static_cast<float>(x + count));
+            const __m512 depthA     = _mm512_set1_ps(span.depthA);
+            const __m512 depthRow   = _mm512_set1_ps(span.depthRow);
+            __m512       edgeA[3];
+            __m512       edgeRow[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                edgeA[k]   = _mm512_set1_ps(span.edgeA[k]);
+                edgeRow[k] = _mm512_set1_ps(span.edgeRow[k]);
+            }
+            uint64_t mask = 0;
+            for (int i = 0; i < count; i += 16)
+            {
+                const __m512 px     = _mm512_add_ps(_mm512_set1_ps(static_cast<float>(x + i)), laneOffset);
+                __mmask16    inside = _mm512_cmp_ps_mask(px, endX, _CMP_LT_OS);
+                for (int k = 0; k < 3; ++k)
+                {
+                    const __m512 edge = _mm512_add_ps(_mm512_mul_ps(edgeA[k], px), edgeRow[k]);
+                    inside &= span.edgeTopLeft[k] ? _mm512_cmp_ps_mask(edge, zero, _CMP_GE_OS) : _mm512_cmp_ps_mask(edge, zero, _CMP_GT_OS);
+                }
+                const __m512 depth = _mm512_add_ps(_mm512_mul_ps(depthA, px), depthRow);
+                _mm512_storeu_ps(&depths[i], depth);
+                inside &= _mm512_cmp_ps_mask(depth, zero, _CMP_GE_OS) & _mm512_cmp_ps_mask(depth, one, _CMP_LE_OS);
+                mask |= static_cast<uint64_t>(inside) << i;
+            }
+            return mask;
+        }
+
+        uint64_t DepthTestSpan(EnumDepthTest depthTest, const float* depths, const float* stored, int count)
+        {
+            uint64_t mask = 0;
+            for (int index = 0; index < count; index += 16)
+            {
+                const __mmask16 valid  = ValidMask(index, count, 1);
+                const __m512    depth  = _mm512_maskz_loadu_ps(valid, &depths[index]);
+                const __m512    old    = _mm512_maskz_loadu_ps(valid, &stored[index]);
+                const __mmask16 passed = depthTest == EnumDepthTest::LESS ? _mm512_mask_cmp_ps_mask(valid, depth, old, _CMP_LT_OS)
+                                                                          : _mm512_mask_cmp_ps_mask(valid, depth, old, _CMP_GT_OS);
+                mask |= static_cast<uint64_t>(passed) << index;
+            }
+            return mask;
+        }
+
+        void ConvolveRow(const Vec4f* tapPixels, const float* weights, int tapCount, int count, Vec4f* outPixels)
+        {
+            // 每个寄存器处理相邻的4个像素
+            const float* taps = Floats(tapPixels);
+            float*       out  = Floats(outPixels);
+            for (int x = 0; x < count; x += 4)
+            {
+                _mm512_mask_storeu_ps(&out[x * 4], ValidMask(x, count, 4), _mm512_setzero_ps());
+            }
+            for (int k = 0; k < tapCount; ++k)
+            {
+                const __m512 weight = _mm512_set1_ps(weights[k]);
+                for (int x = 0; x < count; x += 4)
+                {
+                    const __mmask16 valid   = ValidMask(x, count, 4);
+                    const __m512    product = _mm512_mul_ps(_mm512_maskz_loadu_ps(valid, &taps[(x + k) * 4]), weight);
+                    _mm512_mask_storeu_ps(&out[x * 4], valid, _mm512_add_ps(product, _mm512_maskz_loadu_ps(valid, &out[x * 4])));
+                }
+            }
+        }
+
+        void AccumulateRow(const Vec4f* sourcePixels, float weight, int count, Vec4f* accumulatorPixels)
+        {
+            const float* source      = Floats(sourcePixels);
+            float*       accumulator = Floats(accumulatorPixels);
+            const __m512 weightVec   = _mm512_set1_ps(weight);
+            for (int x = 0; x < count; x += 4)
+            {
+                const __mmask16 valid   = ValidMask(x, count, 4);
+                const __m512    product = _mm512_mul_ps(_mm512_maskz_loadu_ps(valid, &source[x * 4]), weightVec);
+                _mm512_mask_storeu_ps(&accumulator[x * 4], valid, _mm512_add_ps(product, _mm512_maskz_loadu_ps(valid, &accumulator[x * 4])));
+            }
+        }
+    }   // namespace
+
+    namespace Detail
+    {
+        const SimdKernels& GetAvx512SimdKernels()
+        {
+            static const SimdKernels kernels{EnumSimdLevel::AVX512, &TransformPositions, &CoverSpan, &DepthTestSpan, &ConvolveRow, &AccumulateRow};
+            return kernels;
+        }
+    }   // namespace Detail
+}   // namespace Joy
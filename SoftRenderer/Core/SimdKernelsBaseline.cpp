@@ -0,0 +1,107 @@
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+#include "Math/Simd.h"
+
+namespace Joy
+{
+    namespace
+    {
+        using namespace Simd;
+
+        /**
+         * @brief columns * (x, y, z, w)，累加顺序与标量的矩阵乘法一致，结果逐位相同
+         *
+         */
+        inline Float4 MulColumns(const Float4* columns, float x, float y, float z, float w)
+        {
+            return MulAdd(columns[3], Splat(w), MulAdd(columns[2], Splat(z), MulAdd(columns[1], Splat(y), columns[0] * Splat(x))));
+        }
+
+        void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out)
+        {
+            const Float4 columns[4] = {Load(&mat[0][0]), Load(&mat[1][0]), Load(&mat[2][0]), Load(&mat[3][0])};
+            for (size_t i = 0; i < count; ++i)
+            {
+                const Vec4f position = positions[i];
+                Store(&out[i][0], MulColumns(columns, position[0], position[1], position[2], position[3]));
+            }
+        }
+
+        uint64_t CoverSpan(const EdgeSpan& span, int x, int count, float* depths)
+        {
+            const Float4 laneOffset = Set(0.5f, 1.5f, 2.5f, 3.5f);
+            const Float4 zero       = Splat(0.f);
+            const Float4 one        = Splat(1.f);
+            const Float4 endX       = Splat(static_cast<float>(x + count));
+            uint64_t     mask       = 0;
+            for (int i = 0; i < count; i += 4)
+            {
+                const Float4 px     = Splat(static_cast<float>(x + i)) + laneOffset;
+                Float4       inside = CmpLt(px, endX);
+                for (int k = 0; k < 3; ++k)
+                {
+                    const Float4 edge = MulAdd(Splat(span.edgeA[k]), px, Splat(span.edgeRow[k]));
+                    inside            = And(inside, span.edgeTopLeft[k] ? CmpGe(edge, zero) : CmpGt(edge, zero));
+                }
+                // 深度裁剪，丢弃[0, 1]之外的片元
+                const Float4 depth = MulAdd(Splat(span.depthA), px, Splat(span.depthRow));
+                Store(&depths[i], depth);
+                mask |= static_cast<uint64_t>(MoveMask(And(inside, And(CmpGe(depth, zero), CmpLe(depth, one))))) << i;
+            }
+            return mask;
+        }
+
+        uint64_t DepthTestSpan(EnumDepthTest depthTest, const float* depths, const float* stored, int count)
+        {
+            uint64_t mask  = 0;
+            int      index = 0;
+            for (; index + 4 <= count; index += 4)
+            {
+                const Float4 depth = Load(&depths[index]);
+                const Float4 old   = Load(&stored[index]);
+                mask |= static_cast<uint64_t>(MoveMask(depthTest == EnumDepthTest::LESS ? CmpLt(depth, old) : CmpGt(depth, old))) << index;
+            }
+            for (; index < count; ++index)
+            {
+                mask |= static_cast<uint64_t>(DepthTestPass(depthTest, depths[index], stored[index])) << index;
+            }
+            return mask;
+        }
+
+        void ConvolveRow(const Vec4f* taps, const float* weights, int tapCount, int count, Vec4f* out)
+        {
+            // 按核的每一项遍历整行，每个输出的累加顺序仍是k从小到大
+            for (int x = 0; x < count; ++x)
+            {
+                Store(&out[x][0], Splat(0.f));
+            }
+            for (int k = 0; k < tapCount; ++k)
+            {
+                const Float4 weight = Splat(weights[k]);
+                for (int x = 0; x < count; ++x)
+                {
+                    Store(&out[x][0], MulAdd(Load(&taps[x + k][0]), weight, Load(&out[x][0])));
+                }
+            }
+        }
+
+        void AccumulateRow(const Vec4f* source, float weight, int count, Vec4f* accumulator)
+        {
+            const Float4 weightVec = Splat(weight);
+            for (int x = 0; x < count; ++x)
+            {
+                Store(&accumulator[x][0], MulAdd(Load(&source[x][0]), weightVec, Load(&accumulator[x][0])));
+            }
+        }
+    }   // namespace
+
+    namespace Detail
+    {
+        const SimdKernels& GetBaselineSimdKernels()
+        {
+            static const SimdKernels kernels{JOY_SIMD_SSE2 ? EnumSimdLevel::SSE2 : EnumSimdLevel::SCALAR, &TransformPositions, &CoverSpan, &DepthTestSpan,
+                                             &ConvolveRow, &AccumulateRow};
+            return kernels;
+        }
+    }   // namespace Detail
+}   // namespace Joy
@@ -0,0 +1,94 @@
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+
+// 纯标量实现，不依赖Simd.h，供JOY_SIMD_LEVEL=SCALAR与对比测试使用。运算顺序与基准实现相同，结果逐位一致
+namespace Joy
+{
+    namespace
+    {
+        void TransformPositions(const Mat4x4f& mat, const Vec4f* positions, size_t count, Vec4f* out)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const Vec4f position = positions[i];
+                Vec4f       result;
+                for (int row = 0; row < 4; ++row)
+                {
+                    const float xy = mat[1][row] * position[1] + mat[0][row] * position[0];
+                    result[row]    = mat[3][row] * position[3] + (mat[2][row] * position[2] + xy);
+                }
+                out[i] = result;
+            }
+        }
+
+        uint64_t CoverSpan(const EdgeSpan& span, int x, int count, float* depths)
+        {
+            // 与4宽实现一致: 像素中心为分组起点加上组内偏移，深度输出补齐到4的倍数
+            uint64_t  mask        = 0;
+            const int paddedCount = (count + 3) & ~3;
+            for (int i = 0; i < paddedCount; ++i)
+            {
+                const float px     = static_cast<float>(x + (i & ~3)) + (static_cast<float>(i & 3) + 0.5f);
+                bool        inside = i < count;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const float edge = span.edgeA[k] * px + span.edgeRow[k];
+                    inside           = inside && (span.edgeTopLeft[k] ? edge >= 0.f : edge > 0.f);
+                }
+                const float depth = span.depthA * px + span.depthRow;
+                depths[i]         = depth;
+                if (inside && depth >= 0.f && depth <= 1.f)
+                {
+                    mask |= uint64_t(1) << i;
+                }
+            }
+            return mask;
+        }
+
+        uint64_t DepthTestSpan(EnumDepthTest depthTest, const float* depths, const float* stored, int count)
+        {
+            uint64_t mask = 0;
+            for (int index = 0; index < count; ++index)
+            {
+                mask |= static_cast<uint64_t>(DepthTestPass(depthTest, depths[index], stored[index])) << index;
+            }
+            return mask;
+        }
+
+        void ConvolveRow(const Vec4f* taps, const float* weights, int tapCount, int count, Vec4f* out)
+        {
+            for (int x = 0; x < count; ++x)
+            {
+                Vec4f sum{0.f, 0.f, 0.f, 0.f};
+                for (int k = 0; k < tapCount; ++k)
+                {
+                    for (int channel = 0; channel < 4; ++channel)
+                    {
+                        sum[channel] = taps[x + k][channel] * weights[k] + sum[channel];
+                    }
+                }
+                out[x] = sum;
+            }
+        }
+
+        void AccumulateRow(const Vec4f* source, float weight, int count, Vec4f* accumulator)
+        {
+            for (int x = 0; x < count; ++x)
+            {
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    accumulator[x][channel] = source[x][channel] * weight + accumulator[x][channel];
+                }
+            }
+        }
+    }   // namespace
+
+    namespace Detail
+    {
+        const SimdKernels& GetScalarSimdKernels()
+        {
+            static const SimdKernels kernels{EnumSimdLevel::SCALAR, &TransformPositions, &CoverSpan, &DepthTestSpan, &ConvolveRow, &AccumulateRow};
+            return kernels;
+        }
+    }   // namespace Detail
+}   // namespace Joy
@@ -0,0 +1,182 @@
+#include "Core/Skinning.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 一组4个顶点，以SIMD通道存放
+         *
+         */
+        constexpr int GROUP_SIZE = 4;
+
+        /**
+         * @brief 读取一组顶点数据，不足4个时以padding补齐
+         *
+         */
+        template<typename T> inline void LoadGroup(const T* source, int base, int count, T padding, T* dest)
+        {
+            for (int lane = 0; lane < GROUP_SIZE; ++lane)
+            {
+                dest[lane] = lane < count ? source[base + lane] : padding;
+            }
+        }
+
+        inline Simd::Float4 LoadStream(const float* source, int base, int count)
+        {
+            if (count == GROUP_SIZE)
+            {
+                return Simd::Load(source + base);
+            }
+            float data[GROUP_SIZE];
+            LoadGroup(source, base, count, 0.f, data);
+            return Simd::Load(data);
+        }
+
+        inline void StoreStream(float* dest, int base, int count, Simd::Float4 value)
+        {
+            if (count == GROUP_SIZE)
+            {
+                Simd::Store(dest + base, value);
+                return;
+            }
+            float data[GROUP_SIZE];
+            Simd::Store(data, value);
+            std::copy(data, data + count, dest + base);
+        }
+    }   // namespace
+
+    SkinningMatrix MakeSkinningMatrix(const Mat4x4f& mat)
+    {
+        SkinningMatrix ret;
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                ret.rows[row][col] = mat[col][row];
+            }
+        }
+        return ret;
+    }
+
+    SkinningMatrix MakeSkinningMatrix(const Quat& rotation, const Vec3f& translation, float scale)
+    {
+        const Mat3x3f  rotationMat = ToMat3x3f(rotation);
+        SkinningMatrix ret;
+        for (int row = 0; row < 3; ++row)
+        {
+            for (int col = 0; col < 3; ++col)
+            {
+                ret.rows[row][col] = rotationMat[col][row] * scale;
+            }
+            ret.rows[row][3] = translation[row];
+        }
+        return ret;
+    }
+
+    SkinningMatrix operator*(const SkinningMatrix& lhs, const SkinningMatrix& rhs)
+    {
+        // 逐行计算: 结果第r行 = sum(lhs[r][k] * rhs第k行) + (0, 0, 0, lhs[r][3])
+        const Simd::Float4 rhsRow0 = Simd::Load(rhs.rows[0]);
+        const Simd::Float4 rhsRow1 = Simd::Load(rhs.rows[1]);
+        const Simd::Float4 rhsRow2 = Simd::Load(rhs.rows[2]);
+        SkinningMatrix     ret;
+        for (int row = 0; row < 3; ++row)
+        {
+            const float* l   = lhs.rows[row];
+            Simd::Float4 sum = Simd::Set(0.f, 0.f, 0.f, l[3]);
+            sum              = Simd::MulAdd(Simd::Splat(l[0]), rhsRow0, sum);
+            sum              = Simd::MulAdd(Simd::Splat(l[1]), rhsRow1, sum);
+            sum              = Simd::MulAdd(Simd::Splat(l[2]), rhsRow2, sum);
+            Simd::Store(ret.rows[row], sum);
+        }
+        return ret;
+    }
+
+    void BuildSkinningPalette(const SkinningMatrix* boneTransforms, const SkinningMatrix* inverseBindPoses, int boneCount, SkinningMatrix* palette)
+    {
+        for (int bone = 0; bone < boneCount; ++bone)
+        {
+            palette[bone] = boneTransforms[bone] * inverseBindPoses[bone];
+        }
+    }
+
+    void SkinVertices(const SkinningMatrix* palette, const SkinningInput& input, const SkinningOutput& output)
+    {
+        using namespace Simd;
+        assert(input.positionX != nullptr && input.positionY != nullptr && input.positionZ != nullptr);
+        int influenceCount = 0;
+        while (influenceCount < MAX_BONE_INFLUENCES && input.boneWeights[influenceCount] != nullptr)
+        {
+            assert(input.boneIndices[influenceCount] != nullptr);
+            ++influenceCount;
+        }
+        const bool hasNormal = input.normalX != nullptr && output.normalX != nullptr;
+
+        for (int base = 0; base < input.vertexCount; base += GROUP_SIZE)
+        {
+            const int count = std::min(GROUP_SIZE, input.vertexCount - base);
+
+            // 混合后的蒙皮矩阵，blended[r * 4 + c]的各通道为对应顶点的第r行第c列
+            Float4 blended[12];
+            for (Float4& value : blended)
+            {
+                value = Splat(0.f);
+            }
+            for (int influence = 0; influence < influenceCount; ++influence)
+            {
+                uint16_t indices[GROUP_SIZE];
+                LoadGroup(input.boneIndices[influence], base, count, static_cast<uint16_t>(0), indices);
+                const Float4 weight = LoadStream(input.boneWeights[influence], base, count);
+                for (int row = 0; row < 3; ++row)
+                {
+                    // 每个顶点取出骨骼矩阵的一行，转置后每个寄存器保存同一列的4个顶点
+                    Float4 col0 = Load(palette[indices[0]].rows[row]);
+                    Float4 col1 = Load(palette[indices[1]].rows[row]);
+                    Float4 col2 = Load(palette[indices[2]].rows[row]);
+                    Float4 col3 = Load(palette[indices[3]].rows[row]);
+                    Transpose4(col0, col1, col2, col3);
+                    blended[row * 4 + 0] = MulAdd(weight, col0, blended[row * 4 + 0]);
+                    blended[row * 4 + 1] = MulAdd(weight, col1, blended[row * 4 + 1]);
+                    blended[row * 4 + 2] = MulAdd(weight, col2, blended[row * 4 + 2]);
+                    blended[row * 4 + 3] = MulAdd(weight, col3, blended[row * 4 + 3]);
+                }
+            }
+
+            const Float4 px = LoadStream(input.positionX, base, count);
+            const Float4 py = LoadStream(input.positionY, base, count);
+            const Float4 pz = LoadStream(input.positionZ, base, count);
+            Float4       position[3];
+            for (int row = 0; row < 3; ++row)
+            {
+                position[row] = MulAdd(blended[row * 4 + 0], px, MulAdd(blended[row * 4 + 1], py, MulAdd(blended[row * 4 + 2], pz, blended[row * 4 + 3])));
+            }
+            StoreStream(output.positionX, base, count, position[0]);
+            StoreStream(output.positionY, base, count, position[1]);
+            StoreStream(output.positionZ, base, count, position[2]);
+
+            if (!hasNormal)
+            {
+                continue;
+            }
+            // 法线只做线性部分变换后重新归一化(统一缩放下与逆转置矩阵等价)
+            const Float4 nx = LoadStream(input.normalX, base, count);
+            const Float4 ny = LoadStream(input.normalY, base, count);
+            const Float4 nz = LoadStream(input.normalZ, base, count);
+            Float4       normal[3];
+            for (int row = 0; row < 3; ++row)
+            {
+                normal[row] = MulAdd(blended[row * 4 + 0], nx, MulAdd(blended[row * 4 + 1], ny, blended[row * 4 + 2] * nz));
+            }
+            const Float4 sqrLength = MulAdd(normal[0], normal[0], MulAdd(normal[1], normal[1], normal[2] * normal[2]));
+            // 补齐通道长度为0，取较大值避免除零
+            const Float4 invLength = Splat(1.f) / Sqrt(Max(sqrLength, Splat(1e-20f)));
+            StoreStream(output.normalX, base, count, normal[0] * invLength);
+            StoreStream(output.normalY, base, count, normal[1] * invLength);
+            StoreStream(output.normalZ, base, count, normal[2] * invLength);
+        }
+    }
+}   // namespace Joy
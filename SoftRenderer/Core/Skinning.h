@@ -0,0 +1,113 @@
+/**
+ * @file Skinning.h
+ * @author JoyatY
+ * @brief 线性混合蒙皮(LBS)，按SoA布局批量处理顶点
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Math/Mat.h"
+#include "Math/Quat.h"
+#include "Math/Vec.h"
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 每个顶点最多受影响的骨骼数
+     *
+     */
+    constexpr int MAX_BONE_INFLUENCES = 4;
+
+    /**
+     * @brief 蒙皮矩阵，仿射变换的前三行(行优先3x4)，省去恒为(0, 0, 0, 1)的最后一行
+     *
+     */
+    struct SkinningMatrix
+    {
+        float rows[3][4];
+    };
+
+    /**
+     * @brief 由四阶仿射矩阵构造蒙皮矩阵
+     *
+     * @param mat 最后一行须为(0, 0, 0, 1)
+     * @return SkinningMatrix
+     */
+    SkinningMatrix MakeSkinningMatrix(const Mat4x4f& mat);
+
+    /**
+     * @brief 由旋转、平移和统一缩放构造蒙皮矩阵 M = T * R * S
+     *
+     * @param rotation 单位四元数
+     * @param translation 平移
+     * @param scale 统一缩放
+     * @return SkinningMatrix
+     */
+    SkinningMatrix MakeSkinningMatrix(const Quat& rotation, const Vec3f& translation, float scale = 1.f);
+
+    /**
+     * @brief 蒙皮矩阵乘法(仿射矩阵相乘，先应用rhs再应用lhs)
+     *
+     * @param lhs
+     * @param rhs
+     * @return SkinningMatrix
+     */
+    SkinningMatrix operator*(const SkinningMatrix& lhs, const SkinningMatrix& rhs);
+
+    /**
+     * @brief 构建蒙皮调色板 palette[i] = boneTransforms[i] * inverseBindPoses[i]
+     *
+     * @param boneTransforms 骨骼当前帧的模型空间变换
+     * @param inverseBindPoses 骨骼绑定姿态的逆变换
+     * @param boneCount 骨骼数量
+     * @param palette 输出蒙皮矩阵
+     */
+    void BuildSkinningPalette(const SkinningMatrix* boneTransforms, const SkinningMatrix* inverseBindPoses, int boneCount, SkinningMatrix* palette);
+
+    /**
+     * @brief 蒙皮输入顶点流(SoA布局)
+     *
+     * 未使用的影响槽将boneIndices与boneWeights置空；法线流为空时只处理位置。
+     */
+    struct SkinningInput
+    {
+        int             vertexCount                       = 0;
+        const float*    positionX                         = nullptr;
+        const float*    positionY                         = nullptr;
+        const float*    positionZ                         = nullptr;
+        const float*    normalX                           = nullptr;
+        const float*    normalY                           = nullptr;
+        const float*    normalZ                           = nullptr;
+        const uint16_t* boneIndices[MAX_BONE_INFLUENCES] = {};
+        const float*    boneWeights[MAX_BONE_INFLUENCES] = {};
+    };
+
+    /**
+     * @brief 蒙皮输出顶点流(SoA布局)，法线流仅在输入含法线时写入
+     *
+     */
+    struct SkinningOutput
+    {
+        float* positionX = nullptr;
+        float* positionY = nullptr;
+        float* positionZ = nullptr;
+        float* normalX   = nullptr;
+        float* normalY   = nullptr;
+        float* normalZ   = nullptr;
+    };
+
+    /**
+     * @brief 批量线性混合蒙皮，每次以SIMD处理4个顶点: 先按权重混合蒙皮矩阵，再变换位置与法线
+     *
+     * @param palette 蒙皮调色板
+     * @param input 输入顶点流
+     * @param output 输出顶点流
+     */
+    void SkinVertices(const SkinningMatrix* palette, const SkinningInput& input, const SkinningOutput& output);
+}   // namespace Joy
@@ -0,0 +1,109 @@
+#include "Core/TemporalAccumulator.h"
+#include "Math/Simd.h"
+#include <cassert>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 以base为基数的radical inverse
+         *
+         */
+        float RadicalInverse(int index, int base)
+        {
+            float result   = 0.f;
+            float fraction = 1.f / static_cast<float>(base);
+            while (index > 0)
+            {
+                result += static_cast<float>(index % base) * fraction;
+                index /= base;
+                fraction /= static_cast<float>(base);
+            }
+            return result;
+        }
+    }   // namespace
+
+    TemporalAccumulator::TemporalAccumulator(int width, int height, int maxSampleCount)
+        : m_Width(width)
+        , m_Height(height)
+        , m_MaxSampleCount(maxSampleCount)
+        , m_SampleCount(0)
+        , m_ViewVersion(0)
+        , m_HasViewVersion(false)
+        , m_History(static_cast<size_t>(width) * height * 4, 0.f)
+        , m_Row(width)
+    {
+        assert(width > 0 && height > 0 && maxSampleCount > 0);
+    }
+
+    bool TemporalAccumulator::Update(uint32_t viewVersion)
+    {
+        const bool changed = !m_HasViewVersion || viewVersion != m_ViewVersion;
+        m_ViewVersion      = viewVersion;
+        m_HasViewVersion   = true;
+        if (changed)
+        {
+            Reset();
+        }
+        return changed;
+    }
+
+    Vec2f TemporalAccumulator::GetNdcJitter() const
+    {
+        // 屏幕y轴向下，NDC y轴向上
+        const Vec2f jitter = GetPixelJitter();
+        return Vec2f{jitter.X() * 2.f / static_cast<float>(m_Width), -jitter.Y() * 2.f / static_cast<float>(m_Height)};
+    }
+
+    void TemporalAccumulator::Accumulate(const FrameBuffer& frame)
+    {
+        assert(frame.GetWidth() == m_Width && frame.GetHeight() == m_Height);
+        if (IsConverged())
+        {
+            return;
+        }
+        using namespace Simd;
+        // 首帧权重为1，直接覆盖历史
+        const Float4 weight = Splat(1.f / static_cast<float>(m_SampleCount + 1));
+        for (int y = 0; y < m_Height; ++y)
+        {
+            frame.GetColorSpan(0, y, m_Width, m_Row.data());
+            float* history = &m_History[static_cast<size_t>(y) * m_Width * 4];
+            for (int x = 0; x < m_Width; ++x)
+            {
+                const Float4 previous = Load(history + x * 4);
+                Store(history + x * 4, MulAdd(Load(&m_Row[x][0]) - previous, weight, previous));
+            }
+        }
+        ++m_SampleCount;
+    }
+
+    void TemporalAccumulator::Resolve(FrameBuffer& target) const
+    {
+        assert(target.GetWidth() == m_Width && target.GetHeight() == m_Height);
+        std::vector<Vec4f> row(m_Width);
+        for (int y = 0; y < m_Height; ++y)
+        {
+            const float* history = &m_History[static_cast<size_t>(y) * m_Width * 4];
+            for (int x = 0; x < m_Width; ++x)
+            {
+                Simd::Store(&row[x][0], Simd::Load(history + x * 4));
+            }
+            target.SetColorSpan(0, y, m_Width, row.data());
+        }
+    }
+
+    Vec4f TemporalAccumulator::GetColor(int x, int y) const
+    {
+        assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+        const float* history = &m_History[(static_cast<size_t>(y) * m_Width + x) * 4];
+        return Vec4f{history[0], history[1], history[2], history[3]};
+    }
+
+    Vec2f TemporalAccumulator::GetHaltonJitter(int index)
+    {
+        // 跳过序号0(恒为原点)，使前几帧即均匀分布
+        return Vec2f{RadicalInverse(index + 1, 2) - 0.5f, RadicalInverse(index + 1, 3) - 0.5f};
+    }
+}   // namespace Joy
@@ -0,0 +1,133 @@
+/**
+ * @file TemporalAccumulator.h
+ * @author JoyatY
+ * @brief 时间累积与渐进式细化
+ * @version 0.1
+ * @date 2025-12-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include "Math/Vec.h"
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 时间累积器: 每帧以不同的子像素抖动渲染，并将结果累积到浮点历史缓冲，相机静止时逐帧收敛为超采样结果
+     *
+     * 每帧的使用流程:
+     * @code
+     * accumulator.Update(camera.GetVersion());             // 相机变化时丢弃历史
+     * if (!accumulator.IsConverged())
+     * {
+     *     camera.SetJitter(accumulator.GetNdcJitter());    // 抖动不改变相机版本号
+     *     renderer.Clear(...); renderer.Draw(...); renderer.Resolve();
+     *     accumulator.Accumulate(renderer.GetFrameBuffer());
+     * }
+     * accumulator.Resolve(output);
+     * @endcode
+     * 第1帧即可输出单采样预览，此后N帧的结果为N个抖动采样的均值。
+     */
+    class TemporalAccumulator
+    {
+    public:
+        /**
+         * @brief 构造累积器
+         *
+         * @param width 宽度(像素)
+         * @param height 高度(像素)
+         * @param maxSampleCount 收敛所需的累积帧数，达到后停止累积
+         */
+        TemporalAccumulator(int width, int height, int maxSampleCount = 64);
+
+    public:
+        int  GetWidth() const { return m_Width; }
+        int  GetHeight() const { return m_Height; }
+        int  GetSampleCount() const { return m_SampleCount; }
+        int  GetMaxSampleCount() const { return m_MaxSampleCount; }
+        bool IsConverged() const { return m_SampleCount >= m_MaxSampleCount; }
+
+        /**
+         * @brief 丢弃累积历史，从单采样预览重新开始
+         *
+         */
+        void Reset() { m_SampleCount = 0; }
+
+        /**
+         * @brief 以视图版本号判断历史是否仍然有效，版本变化时丢弃历史
+         *
+         * @param viewVersion 视图版本号(通常为Camera::GetVersion)
+         * @return true 历史被丢弃
+         * @return false
+         */
+        bool Update(uint32_t viewVersion);
+
+        /**
+         * @brief 获取下一帧的子像素抖动(像素单位，范围[-0.5, 0.5))
+         *
+         * @return Vec2f
+         */
+        Vec2f GetPixelJitter() const { return GetHaltonJitter(m_SampleCount); }
+
+        /**
+         * @brief 获取下一帧的抖动(NDC单位)，可直接传给Camera::SetJitter
+         *
+         * @return Vec2f
+         */
+        Vec2f GetNdcJitter() const;
+
+        /**
+         * @brief 将一帧渲染结果累积到历史中: history += (frame - history) / (n + 1)
+         *
+         * 已收敛时不做任何操作。
+         *
+         * @param frame 以GetNdcJitter抖动渲染的帧，尺寸须与累积器一致
+         */
+        void Accumulate(const FrameBuffer& frame);
+
+        /**
+         * @brief 将累积结果写入帧缓冲的颜色
+         *
+         * @param target 尺寸须与累积器一致
+         */
+        void Resolve(FrameBuffer& target) const;
+
+        /**
+         * @brief 读取累积后的像素颜色
+         *
+         * @param x
+         * @param y
+         * @return Vec4f
+         */
+        Vec4f GetColor(int x, int y) const;
+
+        /**
+         * @brief Halton(2, 3)低差异序列的子像素偏移
+         *
+         * @param index 序号
+         * @return Vec2f 像素单位，范围[-0.5, 0.5)
+         */
+        static Vec2f GetHaltonJitter(int index);
+
+    private:
+        int                m_Width;
+        int                m_Height;
+        int                m_MaxSampleCount;
+        int                m_SampleCount;
+        uint32_t           m_ViewVersion;
+        bool               m_HasViewVersion;
+
+        /**
+         * @brief 浮点历史缓冲，每像素RGBA
+         *
+         */
+        std::vector<float> m_History;
+        std::vector<Vec4f> m_Row;
+    };
+}   // namespace Joy
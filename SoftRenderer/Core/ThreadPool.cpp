@@ -0,0 +1,340 @@
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#if defined(__linux__)
+    #include <dirent.h>
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace Joy
+{
+    namespace
+    {
+#if defined(__linux__)
+        std::vector<int> GetThreadCpus(pthread_t thread)
+        {
+            std::vector<int> cpus;
+            cpu_set_t        set;
+            CPU_ZERO(&set);
+            if (pthread_getaffinity_np(thread, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &set))
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+            }
+            return cpus;
+        }
+
+        bool SetThreadCpus(pthread_t thread, const std::vector<int>& cpus)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (const int cpu : cpus)
+            {
+                CPU_SET(cpu, &set);
+            }
+            return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+        }
+
+        std::string ReadTextFile(const std::string& path)
+        {
+            std::ifstream file(path);
+            std::string   text;
+            std::getline(file, text);
+            return text;
+        }
+
+        /**
+         * @brief 按sysfs读取的拓扑排列可用CPU，读取失败的部分视为未知(单节点、无超线程)
+         *
+         */
+        std::vector<int> GetTopologyOrderedCpus(const std::vector<int>& allowedCpus, std::vector<int>& nodes)
+        {
+            std::vector<std::vector<int>> nodeCpus;
+            if (DIR* directory = opendir("/sys/devices/system/node"))
+            {
+                std::vector<int> nodeIds;
+                while (const dirent* entry = readdir(directory))
+                {
+                    const std::string name = entry->d_name;
+                    if (name.size() > 4 && name.compare(0, 4, "node") == 0 && name.find_first_not_of("0123456789", 4) == std::string::npos)
+                    {
+                        nodeIds.push_back(std::atoi(name.c_str() + 4));
+                    }
+                }
+                closedir(directory);
+                std::sort(nodeIds.begin(), nodeIds.end());
+                for (const int nodeId : nodeIds)
+                {
+                    nodeCpus.push_back(Detail::ParseCpuList(ReadTextFile("/sys/devices/system/node/node" + std::to_string(nodeId) + "/cpulist")));
+                }
+            }
+            std::vector<int> primaryCpus;
+            for (const int cpu : allowedCpus)
+            {
+                const std::vector<int> siblings =
+                    Detail::ParseCpuList(ReadTextFile("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list"));
+                if (siblings.empty() || *std::min_element(siblings.begin(), siblings.end()) == cpu)
+                {
+                    primaryCpus.push_back(cpu);
+                }
+            }
+            return Detail::OrderCpusByTopology(allowedCpus, nodeCpus, primaryCpus, nodes);
+        }
+#endif
+    }   // namespace
+
+    namespace Detail
+    {
+        std::vector<int> ParseCpuList(const std::string& text)
+        {
+            std::vector<int> cpus;
+            size_t           position = 0;
+            while (position < text.size())
+            {
+                size_t            end   = text.find(',', position);
+                const std::string range = text.substr(position, end == std::string::npos ? std::string::npos : end - position);
+                const size_t      dash  = range.find('-');
+                if (range.find_first_of("0123456789") != std::string::npos)
+                {
+                    const int first = std::atoi(range.c_str());
+                    const int last  = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+                    for (int cpu = first; cpu <= last; ++cpu)
+                    {
+                        cpus.push_back(cpu);
+                    }
+                }
+                position = end == std::string::npos ? text.size() : end + 1;
+            }
+            return cpus;
+        }
+
+        std::vector<int> OrderCpusByTopology(const std::vector<int>& allowedCpus, const std::vector<std::vector<int>>& nodeCpus,
+                                             const std::vector<int>& primaryCpus, std::vector<int>& nodes)
+        {
+            auto contains = [](const std::vector<int>& cpus, int cpu) { return std::find(cpus.begin(), cpus.end(), cpu) != cpus.end(); };
+            auto isPrimary = [&](int cpu) { return primaryCpus.empty() || contains(primaryCpus, cpu); };
+            std::vector<int> ordered;
+            nodes.clear();
+            // 节点内先排物理核心，再排超线程；节点为-1时收集不属于任何节点的CPU
+            for (int node = 0; node <= static_cast<int>(nodeCpus.size()); ++node)
+            {
+                const bool unknownNode = node == static_cast<int>(nodeCpus.size());
+                for (const bool primaryPass : {true, false})
+                {
+                    for (const int cpu : allowedCpus)
+                    {
+                        const bool inNode = unknownNode ? std::none_of(nodeCpus.begin(), nodeCpus.end(), [&](const std::vector<int>& cpus) { return contains(cpus, cpu); })
+                                                        : contains(nodeCpus[node], cpu);
+                        if (inNode && isPrimary(cpu) == primaryPass)
+                        {
+                            ordered.push_back(cpu);
+                            nodes.push_back(unknownNode ? -1 : node);
+                        }
+                    }
+                }
+            }
+            return ordered;
+        }
+    }   // namespace Detail
+
+    ThreadPool::ThreadPool(int threadCount, bool pinThreads)
+        : m_Workers()
+        , m_Generation(0)
+        , m_Stop(false)
+        , m_PendingWorkers(0)
+        , m_Func(nullptr)
+        , m_Context(nullptr)
+        , m_TaskCount(0)
+        , m_NextTask(0)
+        , m_Affine(false)
+        , m_Ranges()
+        , m_PinnedCpus()
+        , m_PinnedNodes()
+        , m_CallerCpus()
+    {
+        if (threadCount <= 0)
+        {
+            threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        m_Ranges = std::vector<TaskRange>(threadCount);
+        for (int threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+        {
+            m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, threadIndex);
+        }
+        if (pinThreads)
+        {
+            PinThreads();
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_WakeCondition.notify_all();
+        for (std::thread& worker : m_Workers)
+        {
+            worker.join();
+        }
+        UnpinCaller();
+    }
+
+    void ThreadPool::PinThreads()
+    {
+#if defined(__linux__)
+        // 在构造线程当前允许的CPU范围内按拓扑顺序分配，相邻线程落在同一NUMA节点上
+        std::vector<int> cpus = GetThreadCpus(pthread_self());
+        if (cpus.empty())
+        {
+            return;
+        }
+        std::vector<int>       cpuNodes;
+        const std::vector<int> orderedCpus = GetTopologyOrderedCpus(cpus, cpuNodes);
+        std::vector<int>       pinnedCpus(GetThreadCount());
+        std::vector<int>       pinnedNodes(GetThreadCount());
+        for (int threadIndex = 0; threadIndex < GetThreadCount(); ++threadIndex)
+        {
+            pinnedCpus[threadIndex]  = orderedCpus[threadIndex % orderedCpus.size()];
+            pinnedNodes[threadIndex] = cpuNodes[threadIndex % cpuNodes.size()];
+            pthread_t thread        = threadIndex == 0 ? pthread_self() : m_Workers[threadIndex - 1].native_handle();
+            if (!SetThreadCpus(thread, {pinnedCpus[threadIndex]}))
+            {
+                // 部分线程绑定失败时全部恢复，保持未绑定状态
+                SetThreadCpus(pthread_self(), cpus);
+                for (int restoreIndex = 1; restoreIndex < threadIndex; ++restoreIndex)
+                {
+                    SetThreadCpus(m_Workers[restoreIndex - 1].native_handle(), cpus);
+                }
+                return;
+            }
+        }
+        m_PinnedCpus  = std::move(pinnedCpus);
+        m_PinnedNodes = std::move(pinnedNodes);
+        m_CallerCpus  = std::move(cpus);
+#endif
+    }
+
+    void ThreadPool::UnpinCaller()
+    {
+#if defined(__linux__)
+        if (IsPinned())
+        {
+            SetThreadCpus(pthread_self(), m_CallerCpus);
+        }
+#endif
+    }
+
+    void ThreadPool::RunTasks(int taskCount, TaskFunc func, void* context, bool affine)
+    {
+        if (m_Workers.empty() || taskCount <= 1)
+        {
+            for (int taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+            {
+                func(context, taskIndex, 0);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Func           = func;
+            m_Context        = context;
+            m_TaskCount      = taskCount;
+            m_Affine         = affine;
+            m_PendingWorkers = static_cast<int>(m_Workers.size());
+            m_NextTask.store(0, std::memory_order_relaxed);
+            if (affine)
+            {
+                const int threadCount = GetThreadCount();
+                for (int threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+                {
+                    const uint64_t begin = static_cast<uint64_t>(taskCount) * threadIndex / threadCount;
+                    const uint64_t end   = static_cast<uint64_t>(taskCount) * (threadIndex + 1) / threadCount;
+                    m_Ranges[threadIndex].bounds.store(begin | (end << 32), std::memory_order_relaxed);
+                }
+            }
+            ++m_Generation;
+        }
+        m_WakeCondition.notify_all();
+        Work(0);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this] { return m_PendingWorkers == 0; });
+    }
+
+    void ThreadPool::WorkerLoop(int threadIndex)
+    {
+        uint64_t generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_WakeCondition.wait(lock, [&] { return m_Stop || m_Generation != generation; });
+                if (m_Stop)
+                {
+                    return;
+                }
+                generation = m_Generation;
+            }
+            Work(threadIndex);
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if (--m_PendingWorkers == 0)
+                {
+                    m_DoneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    int ThreadPool::PopTask(TaskRange& range, bool fromFront)
+    {
+        uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const uint32_t begin = static_cast<uint32_t>(bounds);
+            const uint32_t end   = static_cast<uint32_t>(bounds >> 32);
+            if (begin >= end)
+            {
+                return -1;
+            }
+            const uint64_t next = fromFront ? bounds + 1 : bounds - (uint64_t(1) << 32);
+            if (range.bounds.compare_exchange_weak(bounds, next, std::memory_order_relaxed))
+            {
+                return static_cast<int>(fromFront ? begin : end - 1);
+            }
+        }
+    }
+
+    void ThreadPool::Work(int threadIndex)
+    {
+        int taskIndex = 0;
+        if (m_Affine)
+        {
+            // 先从头部执行自己的区间，再依次从后续线程区间的尾部领取剩余任务，各线程保留自己区间的连续前缀
+            const int threadCount = GetThreadCount();
+            for (int offset = 0; offset < threadCount; ++offset)
+            {
+                TaskRange& range = m_Ranges[(threadIndex + offset) % threadCount];
+                while ((taskIndex = PopTask(range, offset == 0)) >= 0)
+                {
+                    m_Func(m_Context, taskIndex, threadIndex);
+                }
+            }
+            return;
+        }
+        while ((taskIndex = m_NextTask.fetch_add(1, std::memory_order_relaxed)) < m_TaskCount)
+        {
+            m_Func(m_Context, taskIndex, threadIndex);
+        }
+    }
+}   // namespace Joy
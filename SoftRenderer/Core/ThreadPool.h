@@ -0,0 +1,194 @@
+/**
+ * @file ThreadPool.h
+ * @author JoyatY
+ * @brief 常驻线程池，按任务索引并行执行，可将线程绑定到CPU
+ * @version 0.1
+ * @date 2025-12-25
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 常驻线程池
+     *
+     * 工作线程在两次并行之间休眠，调用ParallelFor的线程同时作为第0号线程参与执行。任务以原子计数器动态领取，
+     * 任务之间须互不依赖。同一时刻只允许一个线程调用ParallelFor。
+     *
+     * 绑定CPU时，可用CPU按NUMA节点分组排列(Linux读取/sys/devices/system/node，节点内先各物理核心再超线程)，
+     * 第i号线程固定在第i个CPU上，因此编号相邻的线程位于同一节点，与CPU编号是否交错无关。
+     * 配合ParallelForAffine，每个线程每次并行都执行自己区间的同一段前缀，其访问的内存与缓存留在该线程所在的核心与NUMA节点上。
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief 构造线程池
+         *
+         * @param threadCount 参与执行的线程总数(含调用线程)，不大于0时取硬件线程数
+         * @param pinThreads 是否将线程绑定到CPU。构造线程作为第0号线程一并绑定，析构时恢复其原有的亲和性，
+         *                   因此构造、调用ParallelFor与析构须在同一线程中进行。平台不支持时忽略
+         */
+        explicit ThreadPool(int threadCount = 0, bool pinThreads = false);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+    public:
+        int GetThreadCount() const { return static_cast<int>(m_Workers.size()) + 1; }
+
+        /**
+         * @brief 线程是否已绑定到CPU
+         *
+         */
+        bool IsPinned() const { return !m_PinnedCpus.empty(); }
+
+        /**
+         * @brief 线程绑定的CPU编号，未绑定时为-1
+         *
+         * @param threadIndex
+         * @return int
+         */
+        int GetPinnedCpu(int threadIndex) const { return IsPinned() ? m_PinnedCpus[threadIndex] : -1; }
+
+        /**
+         * @brief 线程绑定的CPU所在的NUMA节点，未绑定或无法得知时为-1
+         *
+         * @param threadIndex
+         * @return int
+         */
+        int GetPinnedNode(int threadIndex) const { return IsPinned() ? m_PinnedNodes[threadIndex] : -1; }
+
+        /**
+         * @brief 并行执行taskCount个任务，全部完成后返回
+         *
+         * @tparam TFunc void(int taskIndex, int threadIndex)，threadIndex在[0, GetThreadCount())内，可用于索引线程私有的缓存
+         * @param taskCount 任务数
+         * @param func 任务函数
+         */
+        template<typename TFunc> void ParallelFor(int taskCount, TFunc&& func)
+        {
+            using TFuncType = typename std::remove_reference<TFunc>::type;
+            RunTasks(
+                taskCount, [](void* context, int taskIndex, int threadIndex) { (*static_cast<TFuncType*>(context))(taskIndex, threadIndex); }, &func,
+                false);
+        }
+
+        /**
+         * @brief 按亲和性并行执行taskCount个任务，全部完成后返回
+         *
+         * 任务按索引均分为GetThreadCount()段连续区间，第t号线程从第t段的头部依次执行，完成后再从其他线程区间的尾部领取剩余任务。
+         * 因此每个线程总是执行自己区间的一段连续前缀，被帮忙的只有区间末尾；任务数不变且负载均衡时每个任务每次都由同一线程执行。
+         *
+         * @tparam TFunc void(int taskIndex, int threadIndex)
+         * @param taskCount 任务数
+         * @param func 任务函数
+         */
+        template<typename TFunc> void ParallelForAffine(int taskCount, TFunc&& func)
+        {
+            using TFuncType = typename std::remove_reference<TFunc>::type;
+            RunTasks(
+                taskCount, [](void* context, int taskIndex, int threadIndex) { (*static_cast<TFuncType*>(context))(taskIndex, threadIndex); }, &func,
+                true);
+        }
+
+    private:
+        using TaskFunc = void (*)(void* context, int taskIndex, int threadIndex);
+
+        /**
+         * @brief 一个线程的任务区间[begin, end)，两端打包在一个原子量中(低32位begin，高32位end)：
+         * 所属线程从头部领取，其他线程从尾部领取。独占缓存行避免线程间伪共享
+         *
+         */
+        struct alignas(64) TaskRange
+        {
+            std::atomic<uint64_t> bounds;
+        };
+
+        /**
+         * @brief 从区间头部(所属线程)或尾部(其他线程)领取一个任务
+         *
+         * @return int 任务索引，区间已空时为-1
+         */
+        static int PopTask(TaskRange& range, bool fromFront);
+
+        void RunTasks(int taskCount, TaskFunc func, void* context, bool affine);
+        void WorkerLoop(int threadIndex);
+        void Work(int threadIndex);
+        void PinThreads();
+        void UnpinCaller();
+
+    private:
+        std::vector<std::thread> m_Workers;
+        std::mutex               m_Mutex;
+        std::condition_variable  m_WakeCondition;
+        std::condition_variable  m_DoneCondition;
+
+        /**
+         * @brief 每次并行递增，唤醒的工作线程据此判断是否有新任务
+         *
+         */
+        uint64_t m_Generation;
+        bool     m_Stop;
+        int      m_PendingWorkers;
+
+        /**
+         * @brief 当前并行的任务
+         *
+         */
+        TaskFunc         m_Func;
+        void*            m_Context;
+        int              m_TaskCount;
+        std::atomic<int> m_NextTask;
+        bool             m_Affine;
+
+        /**
+         * @brief 亲和性并行时各线程的任务区间
+         *
+         */
+        std::vector<TaskRange> m_Ranges;
+
+        /**
+         * @brief 各线程绑定的CPU(未绑定时为空)与构造线程原有的可用CPU
+         *
+         */
+        std::vector<int> m_PinnedCpus;
+        std::vector<int> m_PinnedNodes;
+        std::vector<int> m_CallerCpus;
+    };
+
+    namespace Detail
+    {
+        /**
+         * @brief 解析sysfs的CPU列表(如"0-3,8-11")
+         *
+         */
+        std::vector<int> ParseCpuList(const std::string& text);
+
+        /**
+         * @brief 按拓扑排列可用CPU: 节点按编号先后，节点内先排各物理核心的第一个逻辑CPU，再排其余超线程，不属于任何节点的CPU排在最后
+         *
+         * @param allowedCpus 可用CPU(升序)
+         * @param nodeCpus 各NUMA节点的CPU
+         * @param primaryCpus 各物理核心编号最小的逻辑CPU，为空时不区分超线程
+         * @param nodes 输出每个排好的CPU所在的节点，不属于任何节点时为-1
+         * @return std::vector<int> 排好的CPU
+         */
+        std::vector<int> OrderCpusByTopology(const std::vector<int>& allowedCpus, const std::vector<std::vector<int>>& nodeCpus,
+                                             const std::vector<int>& primaryCpus, std::vector<int>& nodes);
+    }   // namespace Detail
+}   // namespace Joy
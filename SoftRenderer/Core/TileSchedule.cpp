@@ -0,0 +1,108 @@
+#include "Core/TileSchedule.h"
+#include "Math/LookupTable.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 点(x, y)在边长为size(2的幂)的Hilbert曲线上的序号
+         *
+         */
+        uint32_t HilbertEncode2D(uint32_t size, uint32_t x, uint32_t y)
+        {
+            uint32_t code = 0;
+            for (uint32_t half = size / 2; half > 0; half /= 2)
+            {
+                const uint32_t rx = (x & half) != 0 ? 1 : 0;
+                const uint32_t ry = (y & half) != 0 ? 1 : 0;
+                code += half * half * ((3 * rx) ^ ry);
+                // 旋转象限，使子曲线的起点与终点和上一级衔接
+                if (ry == 0)
+                {
+                    if (rx == 1)
+                    {
+                        x = size - 1 - x;
+                        y = size - 1 - y;
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return code;
+        }
+    }   // namespace
+
+    TileSchedule::TileSchedule(EnumTileOrder order, EnumTileScheduling scheduling)
+        : TileSchedule(0, 0, order, scheduling)
+    {}
+
+    TileSchedule::TileSchedule(int tileCountX, int tileCountY, EnumTileOrder order, EnumTileScheduling scheduling)
+        : m_TileCountX(tileCountX)
+        , m_TileCountY(tileCountY)
+        , m_Order(order)
+        , m_Scheduling(scheduling)
+        , m_Tiles()
+    {
+        BuildOrder();
+    }
+
+    void TileSchedule::Resize(int tileCountX, int tileCountY)
+    {
+        if (tileCountX != m_TileCountX || tileCountY != m_TileCountY)
+        {
+            m_TileCountX = tileCountX;
+            m_TileCountY = tileCountY;
+            BuildOrder();
+        }
+    }
+
+    void TileSchedule::SetOrder(EnumTileOrder order, EnumTileScheduling scheduling)
+    {
+        m_Scheduling = scheduling;
+        if (order != m_Order)
+        {
+            m_Order = order;
+            BuildOrder();
+        }
+    }
+
+    void TileSchedule::BuildOrder()
+    {
+        assert(m_TileCountX >= 0 && m_TileCountX <= 0xFFFF && m_TileCountY >= 0 && m_TileCountY <= 0xFFFF);
+        const int tileCount = m_TileCountX * m_TileCountY;
+        m_Tiles.resize(tileCount);
+        for (int tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+        {
+            m_Tiles[tileIndex] = tileIndex;
+        }
+        if (m_Order == EnumTileOrder::ROW_MAJOR)
+        {
+            return;
+        }
+
+        // 曲线覆盖包含全部分块的2的幂边长的正方形，按曲线序号排序后跳过画面外的部分
+        uint32_t size = 1;
+        while (size < static_cast<uint32_t>(std::max(m_TileCountX, m_TileCountY)))
+        {
+            size *= 2;
+        }
+        std::vector<std::pair<uint32_t, int>> keys(tileCount);
+        for (int tileIndex = 0; tileIndex < tileCount; ++tileIndex)
+        {
+            const uint32_t tileX = static_cast<uint32_t>(tileIndex % m_TileCountX);
+            const uint32_t tileY = static_cast<uint32_t>(tileIndex / m_TileCountX);
+            const uint32_t code  = m_Order == EnumTileOrder::MORTON ? MortonEncode2D(static_cast<uint16_t>(tileX), static_cast<uint16_t>(tileY))
+                                                                     : HilbertEncode2D(size, tileX, tileY);
+            keys[tileIndex]      = {code, tileIndex};
+        }
+        std::sort(keys.begin(), keys.end());
+        for (int position = 0; position < tileCount; ++position)
+        {
+            m_Tiles[position] = keys[position].second;
+        }
+    }
+}   // namespace Joy
@@ -0,0 +1,166 @@
+/**
+ * @file TileSchedule.h
+ * @author JoyatY
+ * @brief 分块调度: 按空间填充曲线排列分块，并以稳定的线程归属并行处理
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/ThreadPool.h"
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 分块遍历顺序
+     *
+     */
+    enum class EnumTileOrder
+    {
+        /**
+         * @brief 按行优先
+         *
+         */
+        ROW_MAJOR = 0,
+
+        /**
+         * @brief Morton(Z序)曲线
+         *
+         */
+        MORTON = 1,
+
+        /**
+         * @brief Hilbert曲线: 顺序上相邻的分块在画面上也相邻，连续的一段总是连通的区域
+         *
+         */
+        HILBERT = 2,
+    };
+
+    /**
+     * @brief 分块分配到线程的方式
+     *
+     */
+    enum class EnumTileScheduling
+    {
+        /**
+         * @brief 各线程以原子计数器轮流领取下一个分块，同一分块每帧可能由不同线程处理
+         *
+         */
+        DYNAMIC = 0,
+
+        /**
+         * @brief 按遍历顺序均分为连续的段，每个线程固定负责一段，做完后再从其他线程的段尾帮忙(ThreadPool::ParallelForAffine)
+         *
+         */
+        AFFINE = 1,
+    };
+
+    /**
+     * @brief 分块调度
+     *
+     * 按空间填充曲线排列分块后交给ThreadPool::ParallelForAffine，每个线程每帧都处理画面上同一块紧凑的区域:
+     * 区域内相邻分块共用的源像素留在该线程所在核心的缓存中，区域边界(跨线程的相邻分块对)也比按行均分时少。
+     * 线程绑定CPU(ThreadPool的pinThreads)后，帧缓冲内存再由FrameBuffer::ResolveFastClear(schedule, threadPool)
+     * 按同一调度首次触碰，物理页分配在负责该区域的线程所在的NUMA节点上。
+     */
+    class TileSchedule
+    {
+    public:
+        /**
+         * @brief 构造分块调度，分块数为0，须先调用Resize
+         *
+         * @param order 遍历顺序
+         * @param scheduling 分配方式
+         */
+        explicit TileSchedule(EnumTileOrder order = EnumTileOrder::HILBERT, EnumTileScheduling scheduling = EnumTileScheduling::AFFINE);
+
+        /**
+         * @brief 构造分块调度
+         *
+         * @param tileCountX 水平分块数
+         * @param tileCountY 垂直分块数
+         * @param order 遍历顺序
+         * @param scheduling 分配方式
+         */
+        TileSchedule(int tileCountX, int tileCountY, EnumTileOrder order = EnumTileOrder::HILBERT,
+                     EnumTileScheduling scheduling = EnumTileScheduling::AFFINE);
+
+    public:
+        int                GetTileCountX() const { return m_TileCountX; }
+        int                GetTileCountY() const { return m_TileCountY; }
+        int                GetTileCount() const { return static_cast<int>(m_Tiles.size()); }
+        EnumTileOrder      GetOrder() const { return m_Order; }
+        EnumTileScheduling GetScheduling() const { return m_Scheduling; }
+
+        /**
+         * @brief 遍历顺序中第position个分块的行优先索引(tileY * tileCountX + tileX)
+         *
+         * @param position
+         * @return int
+         */
+        int GetTile(int position) const { return m_Tiles[position]; }
+
+        /**
+         * @brief 设置分块数，与当前一致时不重新生成遍历顺序
+         *
+         * @param tileCountX
+         * @param tileCountY
+         */
+        void Resize(int tileCountX, int tileCountY);
+
+        /**
+         * @brief 设置遍历顺序与分配方式
+         *
+         * @param order
+         * @param scheduling
+         */
+        void SetOrder(EnumTileOrder order, EnumTileScheduling scheduling = EnumTileScheduling::AFFINE);
+
+        /**
+         * @brief 并行处理所有分块
+         *
+         * @tparam TFunc void(int tileIndex, int threadIndex)，tileIndex为行优先索引
+         * @param threadPool 线程池，为空时在调用线程中按遍历顺序串行处理
+         * @param func 分块函数
+         */
+        template<typename TFunc> void ForEach(ThreadPool* threadPool, TFunc&& func) const
+        {
+            auto task = [&](int position, int threadIndex) { func(m_Tiles[position], threadIndex); };
+            if (threadPool == nullptr)
+            {
+                for (int position = 0; position < GetTileCount(); ++position)
+                {
+                    task(position, 0);
+                }
+            }
+            else if (m_Scheduling == EnumTileScheduling::AFFINE)
+            {
+                threadPool->ParallelForAffine(GetTileCount(), task);
+            }
+            else
+            {
+                threadPool->ParallelFor(GetTileCount(), task);
+            }
+        }
+
+    private:
+        void BuildOrder();
+
+    private:
+        int                m_TileCountX;
+        int                m_TileCountY;
+        EnumTileOrder      m_Order;
+        EnumTileScheduling m_Scheduling;
+
+        /**
+         * @brief 按遍历顺序排列的分块行优先索引
+         *
+         */
+        std::vector<int> m_Tiles;
+    };
+}   // namespace Joy
@@ -0,0 +1,165 @@
+#include "Core/TransparencyBuffer.h"
+#include "Math/Simd.h"
+#include <algorithm>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 加权混合的深度权重(McGuire & Bavoil 2013，式(10)的[0, 1]深度版本)，近处的片元权重更大
+         *
+         */
+        inline float GetBlendWeight(float depth, float alpha)
+        {
+            const float distance = 1.f - std::min(std::max(depth, 0.f), 1.f);
+            return alpha * std::max(1e-2f, 3e3f * distance * distance * distance);
+        }
+
+        inline Simd::Float4 LoadPixel(const Vec4f& pixel) { return Simd::Load(&pixel[0]); }
+    }   // namespace
+
+    TransparencyBuffer::TransparencyBuffer(int width, int height, EnumTransparencyMode mode, ThreadPool* threadPool)
+        : m_Width(width)
+        , m_Height(height)
+        , m_TileCountX((width + TILE_SIZE - 1) / TILE_SIZE)
+        , m_TileCountY((height + TILE_SIZE - 1) / TILE_SIZE)
+        , m_Mode(mode)
+        , m_ThreadPool(threadPool)
+        , m_TileSchedule(m_TileCountX, m_TileCountY)
+        , m_TileFragmentCounts(static_cast<size_t>(m_TileCountX) * m_TileCountY, 0)
+        , m_TouchedTiles()
+        , m_FragmentCount(0)
+        , m_Accumulation()
+        , m_Revealage()
+        , m_Heads()
+        , m_TileFragments()
+        , m_Scratch(threadPool ? threadPool->GetThreadCount() : 1)
+    {
+        assert(width > 0 && height > 0);
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        if (mode == EnumTransparencyMode::WEIGHTED_BLENDED)
+        {
+            m_Accumulation.assign(pixelCount, Vec4f{0.f, 0.f, 0.f, 0.f});
+            m_Revealage.assign(pixelCount, 1.f);
+        }
+        else
+        {
+            m_Heads.assign(pixelCount, NO_FRAGMENT);
+            m_TileFragments.resize(m_TileFragmentCounts.size());
+        }
+    }
+
+    void TransparencyBuffer::Clear()
+    {
+        for (const int tileIndex : m_TouchedTiles)
+        {
+            const int minX = (tileIndex % m_TileCountX) * TILE_SIZE;
+            const int minY = (tileIndex / m_TileCountX) * TILE_SIZE;
+            const int maxX = std::min(minX + TILE_SIZE, m_Width);
+            const int maxY = std::min(minY + TILE_SIZE, m_Height);
+            for (int y = minY; y < maxY; ++y)
+            {
+                const size_t rowBegin = static_cast<size_t>(y) * m_Width;
+                if (m_Mode == EnumTransparencyMode::WEIGHTED_BLENDED)
+                {
+                    std::fill(m_Accumulation.begin() + rowBegin + minX, m_Accumulation.begin() + rowBegin + maxX, Vec4f{0.f, 0.f, 0.f, 0.f});
+                    std::fill(m_Revealage.begin() + rowBegin + minX, m_Revealage.begin() + rowBegin + maxX, 1.f);
+                }
+                else
+                {
+                    std::fill(m_Heads.begin() + rowBegin + minX, m_Heads.begin() + rowBegin + maxX, NO_FRAGMENT);
+                }
+            }
+            if (m_Mode == EnumTransparencyMode::FRAGMENT_LIST)
+            {
+                m_TileFragments[tileIndex].clear();
+            }
+            m_TileFragmentCounts[tileIndex] = 0;
+        }
+        m_TouchedTiles.clear();
+        m_FragmentCount = 0;
+    }
+
+    void TransparencyBuffer::AccumulateWeighted(size_t pixelIndex, float depth, const Vec4f& color)
+    {
+        const float alpha  = color[3];
+        const float weight = GetBlendWeight(depth, alpha);
+        Vec4f&      accum  = m_Accumulation[pixelIndex];
+        accum[0] += color[0] * weight;
+        accum[1] += color[1] * weight;
+        accum[2] += color[2] * weight;
+        accum[3] += weight;
+        m_Revealage[pixelIndex] *= 1.f - alpha;
+    }
+
+    void TransparencyBuffer::Resolve(FrameBuffer& target)
+    {
+        assert(target.GetWidth() == m_Width && target.GetHeight() == m_Height);
+        // 遍历全部分块而非本帧收到片元的列表，同一分块每帧都由同一线程解析
+        m_TileSchedule.ForEach(m_ThreadPool, [&](int tileIndex, int threadIndex) {
+            if (m_TileFragmentCounts[tileIndex] != 0)
+            {
+                ResolveTile(target, tileIndex, m_Scratch[threadIndex]);
+            }
+        });
+    }
+
+    void TransparencyBuffer::ResolveTile(FrameBuffer& target, int tileIndex, ResolveScratch& scratch) const
+    {
+        using namespace Simd;
+        const int minX  = (tileIndex % m_TileCountX) * TILE_SIZE;
+        const int minY  = (tileIndex / m_TileCountX) * TILE_SIZE;
+        const int width = std::min(minX + TILE_SIZE, m_Width) - minX;
+        const int maxY  = std::min(minY + TILE_SIZE, m_Height);
+        scratch.row.resize(width);
+        for (int y = minY; y < maxY; ++y)
+        {
+            target.GetColorSpan(minX, y, width, scratch.row.data());
+            for (int i = 0; i < width; ++i)
+            {
+                const size_t pixelIndex = static_cast<size_t>(y) * m_Width + minX + i;
+                Float4       dst        = LoadPixel(scratch.row[i]);
+                if (m_Mode == EnumTransparencyMode::WEIGHTED_BLENDED)
+                {
+                    // 加权平均颜色按总不透明度(1 - 透射率)覆盖在目标上
+                    const Vec4f& accum     = m_Accumulation[pixelIndex];
+                    const float  coverage  = 1.f - m_Revealage[pixelIndex];
+                    const float  invWeight = 1.f / std::max(accum[3], 1e-5f);
+                    const Float4 average   = Set(accum[0] * invWeight, accum[1] * invWeight, accum[2] * invWeight, 1.f);
+                    dst                    = MulAdd(average - dst, Splat(coverage), dst);
+                }
+                else
+                {
+                    // 链表为逆提交顺序，反转后稳定排序，深度相同的片元保持提交顺序
+                    scratch.fragments.clear();
+                    const std::vector<FragmentNode>& nodes = m_TileFragments[tileIndex];
+                    for (uint32_t node = m_Heads[pixelIndex]; node != NO_FRAGMENT; node = nodes[node].next)
+                    {
+                        scratch.fragments.push_back(nodes[node]);
+                    }
+                    std::reverse(scratch.fragments.begin(), scratch.fragments.end());
+                    // 由远及近插入排序，每像素的片元通常很少
+                    for (size_t k = 1; k < scratch.fragments.size(); ++k)
+                    {
+                        const FragmentNode fragment = scratch.fragments[k];
+                        size_t             j        = k;
+                        for (; j > 0 && scratch.fragments[j - 1].depth < fragment.depth; --j)
+                        {
+                            scratch.fragments[j] = scratch.fragments[j - 1];
+                        }
+                        scratch.fragments[j] = fragment;
+                    }
+                    // 由远及近逐层覆盖: rgb = c * a + dst * (1 - a)，a = a + dst.a * (1 - a)
+                    for (const FragmentNode& fragment : scratch.fragments)
+                    {
+                        const Float4 source = Set(fragment.color[0], fragment.color[1], fragment.color[2], 1.f);
+                        dst                 = MulAdd(source - dst, Splat(fragment.color[3]), dst);
+                    }
+                }
+                Store(&scratch.row[i][0], dst);
+            }
+            target.SetColorSpan(minX, y, width, scratch.row.data());
+        }
+    }
+}   // namespace Joy
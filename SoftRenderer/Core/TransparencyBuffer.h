@@ -0,0 +1,184 @@
+/**
+ * @file TransparencyBuffer.h
+ * @author JoyatY
+ * @brief 顺序无关透明(OIT): 加权混合近似与逐分块片元链表精确合成
+ * @version 0.1
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include "Core/ThreadPool.h"
+#include "Core/TileSchedule.h"
+#include "Math/Vec.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 透明合成方式
+     *
+     */
+    enum class EnumTransparencyMode
+    {
+        /**
+         * @brief 加权混合(McGuire & Bavoil 2013): 每像素固定存储，按深度加权累积，结果为近似值
+         *
+         */
+        WEIGHTED_BLENDED = 0,
+
+        /**
+         * @brief 片元链表: 保存所有透明片元，解析时逐像素按深度排序后精确合成
+         *
+         */
+        FRAGMENT_LIST = 1,
+    };
+
+    /**
+     * @brief 透明缓冲
+     *
+     * 透明物体无需按远近排序，可按任意顺序提交(包括相互穿插的网格)。通过Renderer::SetTransparencyTarget设置后，
+     * 绘制的片元照常与不透明深度比较，但不写入深度，颜色(非预乘Alpha)与深度记录到透明缓冲；不透明绘制完成后调用Resolve合成到帧缓冲。
+     *
+     * 片元链表按FrameBuffer::TILE_SIZE分块组织: 每个分块有自己的片元池，链表节点索引在分块内有效，池在帧间复用容量，
+     * 每帧的分配只是在池尾追加。解析时只处理收到片元的分块，各分块按TileSchedule的Hilbert顺序以固定的线程归属并行，
+     * 写入的目标分块互不重叠，结果与线程数无关。
+     */
+    class TransparencyBuffer
+    {
+    public:
+        constexpr static int TILE_SIZE = FrameBuffer::TILE_SIZE;
+
+    public:
+        /**
+         * @brief 构造透明缓冲
+         *
+         * @param width 宽度(像素)
+         * @param height 高度(像素)
+         * @param mode 合成方式
+         * @param threadPool 解析用的线程池，为空时在调用线程中串行解析
+         */
+        TransparencyBuffer(int width, int height, EnumTransparencyMode mode = EnumTransparencyMode::FRAGMENT_LIST, ThreadPool* threadPool = nullptr);
+
+    public:
+        int                  GetWidth() const { return m_Width; }
+        int                  GetHeight() const { return m_Height; }
+        EnumTransparencyMode GetMode() const { return m_Mode; }
+
+        /**
+         * @brief 本帧收到的片元数
+         *
+         */
+        size_t GetFragmentCount() const { return m_FragmentCount; }
+
+        /**
+         * @brief 开始新的一帧: 只重置收到过片元的分块，片元池保留容量
+         *
+         */
+        void Clear();
+
+        /**
+         * @brief 记录一个透明片元
+         *
+         * @param x
+         * @param y
+         * @param depth 深度[0, 1]，越小越近(反向Z的深度须先转换为1 - depth，Renderer已处理)
+         * @param color 非预乘Alpha的颜色
+         */
+        void AddFragment(int x, int y, float depth, const Vec4f& color)
+        {
+            assert(x >= 0 && x < m_Width && y >= 0 && y < m_Height);
+            const int tileIndex = (y / TILE_SIZE) * m_TileCountX + (x / TILE_SIZE);
+            if (m_Mode == EnumTransparencyMode::WEIGHTED_BLENDED)
+            {
+                AccumulateWeighted(static_cast<size_t>(y) * m_Width + x, depth, color);
+            }
+            else
+            {
+                // 头插法: 新节点指向原链表头
+                std::vector<FragmentNode>& nodes = m_TileFragments[tileIndex];
+                uint32_t&                  head  = m_Heads[static_cast<size_t>(y) * m_Width + x];
+                nodes.push_back(FragmentNode{color, depth, head});
+                head = static_cast<uint32_t>(nodes.size() - 1);
+            }
+            if (m_TileFragmentCounts[tileIndex]++ == 0)
+            {
+                m_TouchedTiles.push_back(tileIndex);
+            }
+            ++m_FragmentCount;
+        }
+
+        /**
+         * @brief 将透明片元合成到帧缓冲已有的(不透明)颜色上
+         *
+         * @param target 尺寸须与透明缓冲一致
+         */
+        void Resolve(FrameBuffer& target);
+
+    private:
+        constexpr static uint32_t NO_FRAGMENT = 0xFFFFFFFFu;
+
+        /**
+         * @brief 片元链表节点，next为同一分块池内的索引
+         *
+         */
+        struct FragmentNode
+        {
+            Vec4f    color;
+            float    depth;
+            uint32_t next;
+        };
+
+        /**
+         * @brief 线程私有的解析缓存
+         *
+         */
+        struct ResolveScratch
+        {
+            std::vector<FragmentNode> fragments;
+            std::vector<Vec4f>        row;
+        };
+
+        void AccumulateWeighted(size_t pixelIndex, float depth, const Vec4f& color);
+        void ResolveTile(FrameBuffer& target, int tileIndex, ResolveScratch& scratch) const;
+
+    private:
+        int                  m_Width;
+        int                  m_Height;
+        int                  m_TileCountX;
+        int                  m_TileCountY;
+        EnumTransparencyMode m_Mode;
+        ThreadPool*          m_ThreadPool;
+        TileSchedule         m_TileSchedule;
+
+        /**
+         * @brief 各分块本帧收到的片元数，以及收到过片元的分块(按首次收到的顺序)
+         *
+         */
+        std::vector<uint32_t> m_TileFragmentCounts;
+        std::vector<int>      m_TouchedTiles;
+        size_t                m_FragmentCount;
+
+        /**
+         * @brief 加权混合: 每像素的加权颜色与权重之和(RGB: sum(c * a * w)，A: sum(a * w))，以及透射率prod(1 - a)
+         *
+         */
+        std::vector<Vec4f> m_Accumulation;
+        std::vector<float> m_Revealage;
+
+        /**
+         * @brief 片元链表: 每像素的链表头(分块池内索引，NO_FRAGMENT表示空)与各分块的片元池
+         *
+         */
+        std::vector<uint32_t>                  m_Heads;
+        std::vector<std::vector<FragmentNode>> m_TileFragments;
+
+        std::vector<ResolveScratch> m_Scratch;
+    };
+}   // namespace Joy
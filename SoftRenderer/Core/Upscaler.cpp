@@ -0,0 +1,129 @@
+#include "Core/Upscaler.h"
+#include "Math/Simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Joy
+{
+    namespace
+    {
+        /**
+         * @brief 目标像素中心在源中的采样位置: 左(上)侧像素索引与右(下)侧像素的权重，超出画面时取边缘像素
+         *
+         */
+        void MapSampleCoordinate(int index, int sourceSize, int destinationSize, int& sourceIndex, float& weight)
+        {
+            const float position = std::min(std::max((index + 0.5f) * sourceSize / destinationSize - 0.5f, 0.f), static_cast<float>(sourceSize - 1));
+            sourceIndex          = std::min(static_cast<int>(position), sourceSize - 1);
+            weight               = position - static_cast<float>(sourceIndex);
+        }
+
+        inline Simd::Float4 LoadPixel(const Vec4f& pixel) { return Simd::Load(&pixel[0]); }
+    }   // namespace
+
+    BilinearUpscaler::BilinearUpscaler(ThreadPool* threadPool)
+        : m_ThreadPool(threadPool)
+        , m_SourceWidth(0)
+        , m_DestinationWidth(0)
+        , m_ColumnIndices()
+        , m_ColumnWeights()
+        , m_Scratch(threadPool ? threadPool->GetThreadCount() : 1)
+    {}
+
+    void BilinearUpscaler::Process(const FrameBuffer& source, FrameBuffer& destination)
+    {
+        assert(&source != &destination);
+        const int sourceWidth      = source.GetWidth();
+        const int destinationWidth = destination.GetWidth();
+        if (sourceWidth != m_SourceWidth || destinationWidth != m_DestinationWidth)
+        {
+            m_SourceWidth      = sourceWidth;
+            m_DestinationWidth = destinationWidth;
+            m_ColumnIndices.resize(destinationWidth);
+            m_ColumnWeights.resize(destinationWidth);
+            for (int x = 0; x < destinationWidth; ++x)
+            {
+                MapSampleCoordinate(x, sourceWidth, destinationWidth, m_ColumnIndices[x], m_ColumnWeights[x]);
+            }
+        }
+
+        // 每组行覆盖整行分块，各组写入的目标分块互不重叠
+        const int bandHeight = FrameBuffer::TILE_SIZE;
+        const int bandCount  = (destination.GetHeight() + bandHeight - 1) / bandHeight;
+        auto      task       = [&](int taskIndex, int threadIndex) {
+            const int beginY = taskIndex * bandHeight;
+            ProcessRows(source, destination, beginY, std::min(beginY + bandHeight, destination.GetHeight()), m_Scratch[threadIndex]);
+        };
+        if (m_ThreadPool)
+        {
+            m_ThreadPool->ParallelFor(bandCount, task);
+        }
+        else
+        {
+            for (int taskIndex = 0; taskIndex < bandCount; ++taskIndex)
+            {
+                task(taskIndex, 0);
+            }
+        }
+    }
+
+    void BilinearUpscaler::ProcessRows(const FrameBuffer& source, FrameBuffer& destination, int beginY, int endY, RowScratch& scratch) const
+    {
+        using namespace Simd;
+        const int sourceWidth      = source.GetWidth();
+        const int destinationWidth = destination.GetWidth();
+        for (std::vector<Vec4f>& row : scratch.rows)
+        {
+            row.resize(sourceWidth);
+        }
+        scratch.rowIndices[0] = -1;
+        scratch.rowIndices[1] = -1;
+        scratch.blended.resize(sourceWidth);
+        scratch.output.resize(destinationWidth);
+
+        for (int y = beginY; y < endY; ++y)
+        {
+            int   sourceY = 0;
+            float weightY = 0.f;
+            MapSampleCoordinate(y, source.GetHeight(), destination.GetHeight(), sourceY, weightY);
+            const int sourceRows[2] = {sourceY, std::min(sourceY + 1, source.GetHeight() - 1)};
+
+            // 放大时相邻目标行多半共用源行，已解包的行直接复用
+            if (scratch.rowIndices[1] == sourceRows[0])
+            {
+                std::swap(scratch.rows[0], scratch.rows[1]);
+                std::swap(scratch.rowIndices[0], scratch.rowIndices[1]);
+            }
+            for (int i = 0; i < 2; ++i)
+            {
+                if (scratch.rowIndices[i] != sourceRows[i])
+                {
+                    source.GetColorSpan(0, sourceRows[i], sourceWidth, scratch.rows[i].data());
+                    scratch.rowIndices[i] = sourceRows[i];
+                }
+            }
+
+            // 垂直插值: 整行视为连续的浮点数组，每次处理一个像素的4个通道
+            const Vec4f* top    = scratch.rows[0].data();
+            const Vec4f* bottom = scratch.rows[1].data();
+            const Float4 fy     = Splat(weightY);
+            for (int x = 0; x < sourceWidth; ++x)
+            {
+                const Float4 topPixel = LoadPixel(top[x]);
+                Store(&scratch.blended[x][0], MulAdd(LoadPixel(bottom[x]) - topPixel, fy, topPixel));
+            }
+
+            // 水平插值: 列索引与权重已预先算好
+            const Vec4f* blended = scratch.blended.data();
+            for (int x = 0; x < destinationWidth; ++x)
+            {
+                const int    left      = m_ColumnIndices[x];
+                const int    right     = std::min(left + 1, sourceWidth - 1);
+                const Float4 leftPixel = LoadPixel(blended[left]);
+                Store(&scratch.output[x][0], MulAdd(LoadPixel(blended[right]) - leftPixel, Splat(m_ColumnWeights[x]), leftPixel));
+            }
+            destination.SetColorSpan(0, y, destinationWidth, scratch.output.data());
+        }
+    }
+}   // namespace Joy
@@ -0,0 +1,76 @@
+/**
+ * @file Upscaler.h
+ * @author JoyatY
+ * @brief 多线程SIMD双线性放大，将动态分辨率的渲染结果缩放到输出尺寸
+ * @version 0.1
+ * @date 2025-12-29
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Core/FrameBuffer.h"
+#include "Core/ThreadPool.h"
+#include "Math/Vec.h"
+#include <vector>
+
+namespace Joy
+{
+    /**
+     * @brief 双线性缩放器
+     *
+     * 像素中心对齐: 目标像素x采样源坐标(x + 0.5) * 源宽 / 目标宽 - 0.5，超出画面时取边缘像素，尺寸相同时结果与源一致。
+     * 目标按FrameBuffer::TILE_SIZE行一组在线程池中并行处理。每个目标行先以SIMD对两条源行做垂直插值(连续的浮点数组)，
+     * 再按预先算好的列索引与权重做水平插值，每个源行只解包一次。
+     */
+    class BilinearUpscaler
+    {
+    public:
+        /**
+         * @brief 构造缩放器
+         *
+         * @param threadPool 线程池，为空时在调用线程中串行处理
+         */
+        explicit BilinearUpscaler(ThreadPool* threadPool = nullptr);
+
+    public:
+        /**
+         * @brief 将source的颜色缩放到destination的尺寸
+         *
+         * @param source 源帧缓冲
+         * @param destination 目标帧缓冲，不能与source是同一个帧缓冲
+         */
+        void Process(const FrameBuffer& source, FrameBuffer& destination);
+
+    private:
+        /**
+         * @brief 线程私有的行缓存: 最近解包的两条源行及其行号、垂直插值结果与输出行
+         *
+         */
+        struct RowScratch
+        {
+            std::vector<Vec4f> rows[2];
+            int                rowIndices[2];
+            std::vector<Vec4f> blended;
+            std::vector<Vec4f> output;
+        };
+
+        void ProcessRows(const FrameBuffer& source, FrameBuffer& destination, int beginY, int endY, RowScratch& scratch) const;
+
+    private:
+        ThreadPool* m_ThreadPool;
+
+        /**
+         * @brief 目标各列的左侧源列索引与右侧源列的权重，源宽或目标宽变化时重新计算
+         *
+         */
+        int                m_SourceWidth;
+        int                m_DestinationWidth;
+        std::vector<int>   m_ColumnIndices;
+        std::vector<float> m_ColumnWeights;
+
+        std::vector<RowScratch> m_Scratch;
+    };
+}   // namespace Joy
@@ -0,0 +1,187 @@
+/**
+ * @file Expr.h
+ * @author JoyatY
+ * @brief 向量/矩阵的惰性表达式模板(按需引入)
+ * @version 0.1
+ * @date 2025-12-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Mat.h"
+#include "Vec.h"
+
+namespace Joy
+{
+    /**
+     * 用法:
+     * @code
+     * Vec4f ret = Lazy(a) * s + Lazy(b) * t - Lazy(c);   // 单次循环求值，无中间向量
+     * @endcode
+     * 表达式节点按值保存子节点，叶子节点引用原始向量/矩阵，求值前须保证其有效。
+     * 默认的Vec/Mat运算符保持立即求值语义不变。
+     */
+    namespace Detail
+    {
+        /**
+         * @brief 表达式可求值类型的元素访问，矩阵按列优先展开为一维
+         *
+         * @tparam TValue Vec或Mat
+         */
+        template<typename TValue> struct ExprTraits;
+
+        template<int N, typename T> struct ExprTraits<Vec<N, T>>
+        {
+            using Scalar              = T;
+            constexpr static int SIZE = N;
+            constexpr static T   Get(const Vec<N, T>& value, int index) { return value[index]; }
+            constexpr static T&  At(Vec<N, T>& value, int index) { return value[index]; }
+        };
+
+        template<int NRows, int NCols, typename T> struct ExprTraits<Mat<NRows, NCols, T>>
+        {
+            using Scalar              = T;
+            constexpr static int SIZE = NRows * NCols;
+            constexpr static T   Get(const Mat<NRows, NCols, T>& value, int index) { return value[index / NRows][index % NRows]; }
+            constexpr static T&  At(Mat<NRows, NCols, T>& value, int index) { return value[index / NRows][index % NRows]; }
+        };
+
+        struct ExprAdd
+        {
+            template<typename T> constexpr static T Apply(const T& lhs, const T& rhs) { return lhs + rhs; }
+        };
+
+        struct ExprSub
+        {
+            template<typename T> constexpr static T Apply(const T& lhs, const T& rhs) { return lhs - rhs; }
+        };
+    }   // namespace Detail
+
+    /**
+     * @brief 表达式基类(CRTP)，可隐式转换为结果类型
+     *
+     * @tparam TResult 表达式结果类型(Vec或Mat)
+     * @tparam TDerived 具体表达式节点类型
+     */
+    template<typename TResult, typename TDerived> struct Expr
+    {
+        using Scalar = typename Detail::ExprTraits<TResult>::Scalar;
+
+        constexpr const TDerived& Derived() const { return static_cast<const TDerived&>(*this); }
+
+        /**
+         * @brief 单次循环对整个表达式树求值
+         *
+         * @return TResult
+         */
+        constexpr TResult Eval() const
+        {
+            TResult ret{};
+            for (int i = 0; i < Detail::ExprTraits<TResult>::SIZE; ++i)
+            {
+                Detail::ExprTraits<TResult>::At(ret, i) = Derived().Get(i);
+            }
+            return ret;
+        }
+
+        constexpr operator TResult() const { return Eval(); }
+    };
+
+    /**
+     * @brief 叶子节点，引用一个向量或矩阵
+     *
+     */
+    template<typename TResult> struct ExprLeaf : public Expr<TResult, ExprLeaf<TResult>>
+    {
+        constexpr explicit ExprLeaf(const TResult& value)
+            : m_Value(value)
+        {}
+
+        constexpr auto Get(int index) const { return Detail::ExprTraits<TResult>::Get(m_Value, index); }
+
+    private:
+        const TResult& m_Value;
+    };
+
+    /**
+     * @brief 逐元素二元运算节点
+     *
+     */
+    template<typename TResult, typename TOp, typename TLhs, typename TRhs> struct ExprBinary : public Expr<TResult, ExprBinary<TResult, TOp, TLhs, TRhs>>
+    {
+        constexpr ExprBinary(const TLhs& lhs, const TRhs& rhs)
+            : m_Lhs(lhs)
+            , m_Rhs(rhs)
+        {}
+
+        constexpr auto Get(int index) const { return TOp::Apply(m_Lhs.Get(index), m_Rhs.Get(index)); }
+
+    private:
+        TLhs m_Lhs;
+        TRhs m_Rhs;
+    };
+
+    /**
+     * @brief 标量缩放节点
+     *
+     */
+    template<typename TResult, typename TExpr> struct ExprScale : public Expr<TResult, ExprScale<TResult, TExpr>>
+    {
+        using Scalar = typename Detail::ExprTraits<TResult>::Scalar;
+
+        constexpr ExprScale(const TExpr& expr, const Scalar& scale)
+            : m_Expr(expr)
+            , m_Scale(scale)
+        {}
+
+        constexpr auto Get(int index) const { return m_Expr.Get(index) * m_Scale; }
+
+    private:
+        TExpr  m_Expr;
+        Scalar m_Scale;
+    };
+
+    /**
+     * @brief 将向量或矩阵包装为惰性表达式
+     *
+     * @tparam TResult Vec或Mat
+     * @param value
+     * @return ExprLeaf<TResult>
+     */
+    template<typename TResult> constexpr ExprLeaf<TResult> Lazy(const TResult& value)
+    {
+        return ExprLeaf<TResult>{value};
+    }
+
+    template<typename TResult, typename TLhs, typename TRhs>
+    constexpr ExprBinary<TResult, Detail::ExprAdd, TLhs, TRhs> operator+(const Expr<TResult, TLhs>& lhs, const Expr<TResult, TRhs>& rhs)
+    {
+        return ExprBinary<TResult, Detail::ExprAdd, TLhs, TRhs>{lhs.Derived(), rhs.Derived()};
+    }
+
+    template<typename TResult, typename TLhs, typename TRhs>
+    constexpr ExprBinary<TResult, Detail::ExprSub, TLhs, TRhs> operator-(const Expr<TResult, TLhs>& lhs, const Expr<TResult, TRhs>& rhs)
+    {
+        return ExprBinary<TResult, Detail::ExprSub, TLhs, TRhs>{lhs.Derived(), rhs.Derived()};
+    }
+
+    template<typename TResult, typename TExpr>
+    constexpr ExprScale<TResult, TExpr> operator*(const Expr<TResult, TExpr>& expr, const typename Expr<TResult, TExpr>::Scalar& scale)
+    {
+        return ExprScale<TResult, TExpr>{expr.Derived(), scale};
+    }
+
+    template<typename TResult, typename TExpr>
+    constexpr ExprScale<TResult, TExpr> operator*(const typename Expr<TResult, TExpr>::Scalar& scale, const Expr<TResult, TExpr>& expr)
+    {
+        return ExprScale<TResult, TExpr>{expr.Derived(), scale};
+    }
+
+    template<typename TResult, typename TExpr> constexpr ExprScale<TResult, TExpr> operator-(const Expr<TResult, TExpr>& expr)
+    {
+        return ExprScale<TResult, TExpr>{expr.Derived(), -typename Expr<TResult, TExpr>::Scalar(1)};
+    }
+}   // namespace Joy
@@ -0,0 +1,211 @@
+/**
+ * @file Fixed.h
+ * @author JoyatY
+ * @brief 定点数标量类型
+ * @version 0.1
+ * @date 2025-12-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Scalar.h"
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+
+namespace Joy
+{
+    /**
+     * @brief 32位有符号定点数，低FracBits位为小数部分
+     *
+     * 加减为精确整数运算；乘除以64位中间结果计算后向负无穷截断。与浮点数的转换四舍五入(远离零)。
+     * 可作为Vec/Mat的元素类型，比较为精确比较。
+     *
+     * @tparam FracBits 小数位数
+     */
+    template<int FracBits> struct Fixed
+    {
+        static_assert(FracBits > 0 && FracBits < 31, "Fixed fraction bits must be in [1, 30].");
+
+    public:
+        constexpr Fixed() = default;
+
+        constexpr explicit Fixed(int value)
+            : m_Raw(value * ONE)
+        {}
+
+        constexpr explicit Fixed(float value)
+            : m_Raw(static_cast<int32_t>(value >= 0.f ? value * ONE + 0.5f : value * ONE - 0.5f))
+        {}
+
+        constexpr explicit Fixed(double value)
+            : m_Raw(static_cast<int32_t>(value >= 0.0 ? value * ONE + 0.5 : value * ONE - 0.5))
+        {}
+
+    public:
+        /**
+         * @brief 由原始整数表示构造
+         *
+         * @param raw
+         * @return Fixed
+         */
+        constexpr static Fixed FromRaw(int32_t raw)
+        {
+            Fixed ret;
+            ret.m_Raw = raw;
+            return ret;
+        }
+
+        constexpr int32_t Raw() const { return m_Raw; }
+        constexpr float   ToFloat() const { return static_cast<float>(m_Raw) * (1.f / ONE); }
+        constexpr double  ToDouble() const { return static_cast<double>(m_Raw) * (1.0 / ONE); }
+
+        constexpr explicit operator float() const { return ToFloat(); }
+        constexpr explicit operator double() const { return ToDouble(); }
+
+        /**
+         * @brief 向下取整到整数(算术右移)
+         *
+         * @return int32_t
+         */
+        constexpr int32_t Floor() const { return m_Raw >> FracBits; }
+
+        /**
+         * @brief 向上取整到整数
+         *
+         * @return int32_t
+         */
+        constexpr int32_t Ceil() const { return (m_Raw + ONE - 1) >> FracBits; }
+
+    public:
+        constexpr Fixed operator-() const { return FromRaw(-m_Raw); }
+
+        constexpr Fixed& operator+=(const Fixed& rhs)
+        {
+            m_Raw += rhs.m_Raw;
+            return *this;
+        }
+        constexpr Fixed& operator-=(const Fixed& rhs)
+        {
+            m_Raw -= rhs.m_Raw;
+            return *this;
+        }
+        constexpr Fixed& operator*=(const Fixed& rhs)
+        {
+            m_Raw = static_cast<int32_t>((static_cast<int64_t>(m_Raw) * rhs.m_Raw) >> FracBits);
+            return *this;
+        }
+        constexpr Fixed& operator/=(const Fixed& rhs)
+        {
+            // 整数除法向零截断，余数非零且商为负时减1，与乘法的算术右移同为向负无穷截断
+            const int64_t numerator = static_cast<int64_t>(m_Raw) * ONE;
+            int64_t       quotient  = numerator / rhs.m_Raw;
+            if (numerator % rhs.m_Raw != 0 && (numerator < 0) != (rhs.m_Raw < 0))
+            {
+                --quotient;
+            }
+            m_Raw = static_cast<int32_t>(quotient);
+            return *this;
+        }
+
+    public:
+        /**
+         * @brief 小数位数
+         *
+         */
+        constexpr static int FRACTION_BITS = FracBits;
+
+        /**
+         * @brief 数值1的原始表示
+         *
+         */
+        constexpr static int32_t ONE = 1 << FracBits;
+
+    private:
+        int32_t m_Raw = 0;
+    };
+
+    template<int FracBits> constexpr Fixed<FracBits> operator+(Fixed<FracBits> lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template<int FracBits> constexpr Fixed<FracBits> operator-(Fixed<FracBits> lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template<int FracBits> constexpr Fixed<FracBits> operator*(Fixed<FracBits> lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template<int FracBits> constexpr Fixed<FracBits> operator/(Fixed<FracBits> lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template<int FracBits> constexpr bool operator==(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() == rhs.Raw();
+    }
+
+    template<int FracBits> constexpr bool operator!=(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() != rhs.Raw();
+    }
+
+    template<int FracBits> constexpr bool operator<(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() < rhs.Raw();
+    }
+
+    template<int FracBits> constexpr bool operator<=(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() <= rhs.Raw();
+    }
+
+    template<int FracBits> constexpr bool operator>(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() > rhs.Raw();
+    }
+
+    template<int FracBits> constexpr bool operator>=(const Fixed<FracBits>& lhs, const Fixed<FracBits>& rhs)
+    {
+        return lhs.Raw() >= rhs.Raw();
+    }
+
+    /**
+     * @brief 打印定点数(以浮点形式)
+     *
+     * @param out
+     * @param value
+     * @return std::ostream&
+     */
+    template<int FracBits> std::ostream& operator<<(std::ostream& out, const Fixed<FracBits>& value)
+    {
+        return out << value.ToDouble();
+    }
+
+    template<int FracBits> struct ScalarTraits<Fixed<FracBits>>
+    {
+        constexpr static Fixed<FracBits> Epsilon() { return Fixed<FracBits>{}; }
+
+        static Fixed<FracBits> Sqrt(const Fixed<FracBits>& value) { return Fixed<FracBits>{std::sqrt(value.ToDouble())}; }
+    };
+
+    /**
+     * @brief 16.16定点数，适合取值范围在±32768内的通用计算
+     *
+     */
+    using Fixed16_16 = Fixed<16>;
+
+    /**
+     * @brief 24.8定点数，光栅化建立使用的1/256子像素精度
+     *
+     */
+    using Fixed24_8 = Fixed<8>;
+}   // namespace Joy
@@ -0,0 +1,169 @@
+/**
+ * @file LookupTable.h
+ * @author JoyatY
+ * @brief 编译期生成的查找表: sRGB编解码与Morton编码
+ * @version 0.1
+ * @date 2025-12-28
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Scalar.h"
+#include <cstdint>
+
+namespace Joy
+{
+    /**
+     * @brief 定长查找表，可在编译期生成并放入只读数据段
+     *
+     * @tparam T 元素类型
+     * @tparam N 元素个数
+     */
+    template<typename T, int N> struct LookupTable
+    {
+    public:
+        constexpr static int SIZE = N;
+
+        constexpr const T& operator[](const int index) const { return m_Data[index]; }
+        constexpr T&       operator[](const int index) { return m_Data[index]; }
+
+    public:
+        T m_Data[N];
+    };
+
+    /**
+     * @brief 以生成函数逐项填充查找表，在constexpr上下文中调用即为编译期生成
+     *
+     * @tparam T 元素类型
+     * @tparam N 元素个数
+     * @tparam TFunc T(int index)
+     * @param func 生成函数
+     * @return LookupTable<T, N>
+     */
+    template<typename T, int N, typename TFunc> constexpr LookupTable<T, N> MakeLookupTable(TFunc func)
+    {
+        LookupTable<T, N> ret{};
+        for (int i = 0; i < N; ++i)
+        {
+            ret[i] = func(i);
+        }
+        return ret;
+    }
+
+    namespace Detail
+    {
+        /**
+         * @brief sRGB解码(编码值与线性值均在[0, 1]内)，只用于生成查找表
+         *
+         */
+        constexpr double DecodeSrgb(double encoded)
+        {
+            return encoded <= 0.04045 ? encoded / 12.92 : ConstexprPow((encoded + 0.055) / 1.055, 2.4);
+        }
+
+        /**
+         * @brief 将低8位的每一位间隔一位展开，得到16位
+         *
+         */
+        constexpr uint16_t SpreadBits(int value)
+        {
+            uint32_t ret = 0;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                ret |= ((static_cast<uint32_t>(value) >> bit) & 1u) << (2 * bit);
+            }
+            return static_cast<uint16_t>(ret);
+        }
+
+        /**
+         * @brief 取出奇数或偶数位上的位并压缩到低16位
+         *
+         */
+        constexpr uint16_t CompactBits(uint32_t value)
+        {
+            value &= 0x55555555u;
+            value = (value | (value >> 1)) & 0x33333333u;
+            value = (value | (value >> 2)) & 0x0F0F0F0Fu;
+            value = (value | (value >> 4)) & 0x00FF00FFu;
+            value = (value | (value >> 8)) & 0x0000FFFFu;
+            return static_cast<uint16_t>(value);
+        }
+    }   // namespace Detail
+
+    /**
+     * @brief 8位sRGB编码值到线性值
+     *
+     */
+    constexpr LookupTable<float, 256> SRGB_TO_LINEAR_TABLE =
+        MakeLookupTable<float, 256>([](int index) { return static_cast<float>(Detail::DecodeSrgb(index / 255.0)); });
+
+    /**
+     * @brief 线性值到8位sRGB编码的分界: 线性值不小于第k项时编码值不小于k + 1，即编码值k + 0.5处的线性值
+     *
+     */
+    constexpr LookupTable<float, 255> LINEAR_TO_SRGB_THRESHOLDS =
+        MakeLookupTable<float, 255>([](int index) { return static_cast<float>(Detail::DecodeSrgb((index + 0.5) / 255.0)); });
+
+    /**
+     * @brief 字节的Morton展开表，第i项为i的各位间隔一位排列的结果
+     *
+     */
+    constexpr LookupTable<uint16_t, 256> MORTON_SPREAD_TABLE = MakeLookupTable<uint16_t, 256>([](int index) { return Detail::SpreadBits(index); });
+
+    /**
+     * @brief 8位sRGB编码值转线性值，查表
+     *
+     * @param encoded
+     * @return float
+     */
+    constexpr float SrgbToLinear(uint8_t encoded)
+    {
+        return SRGB_TO_LINEAR_TABLE[encoded];
+    }
+
+    /**
+     * @brief 线性值转8位sRGB编码(就近舍入)，在分界表上做8步无分支二分查找，NaN与负数得0
+     *
+     * @param linear
+     * @return uint8_t
+     */
+    constexpr uint8_t LinearToSrgb(float linear)
+    {
+        int code = 0;
+        for (int step = 128; step > 0; step >>= 1)
+        {
+            code += linear >= LINEAR_TO_SRGB_THRESHOLDS[code + step - 1] ? step : 0;
+        }
+        return static_cast<uint8_t>(code);
+    }
+
+    /**
+     * @brief 二维Morton编码(Z序)，x占偶数位、y占奇数位，查表完成位展开
+     *
+     * @param x
+     * @param y
+     * @return uint32_t
+     */
+    constexpr uint32_t MortonEncode2D(uint16_t x, uint16_t y)
+    {
+        const uint32_t spreadX = MORTON_SPREAD_TABLE[x & 0xFF] | (static_cast<uint32_t>(MORTON_SPREAD_TABLE[x >> 8]) << 16);
+        const uint32_t spreadY = MORTON_SPREAD_TABLE[y & 0xFF] | (static_cast<uint32_t>(MORTON_SPREAD_TABLE[y >> 8]) << 16);
+        return spreadX | (spreadY << 1);
+    }
+
+    /**
+     * @brief 二维Morton解码
+     *
+     * @param code
+     * @param x
+     * @param y
+     */
+    constexpr void MortonDecode2D(uint32_t code, uint16_t& x, uint16_t& y)
+    {
+        x = Detail::CompactBits(code);
+        y = Detail::CompactBits(code >> 1);
+    }
+}   // namespace Joy
@@ -92,7 +92,7 @@ namespace Joy
             {
                 for (int row = 0; row < NRows; ++row)
                 {
-                    ret[col][row] = col == row ? 1 : 0;
+                    ret[col][row] = col == row ? T(1) : T(0);
                 }
             }
             return ret;
@@ -209,18 +209,21 @@ namespace Joy
      * @brief 矩阵右乘向量
      *
      * @tparam NRows 矩阵行数
-     * @tparam N 矩阵列数 | 向量维度
+     * @tparam NCols 矩阵列数 | 向量维度
      * @tparam T 矩阵/向量的元素类型
      * @param mat 左侧矩阵
      * @param vec 右侧向量
-     * @return Vec<N, T>
+     * @return Vec<NRows, T>
      */
-    template<int NRows, int N, typename T> constexpr Vec<N, T> operator*(const Mat<NRows, N, T>& mat, const Vec<N, T>& vec)
+    template<int NRows, int NCols, typename T> constexpr Vec<NRows, T> operator*(const Mat<NRows, NCols, T>& mat, const Vec<NCols, T>& vec)
     {
-        Vec<N, T> ret{};
-        for (int col = 0; col < N; ++col)
+        Vec<NRows, T> ret{};
+        for (int col = 0; col < NCols; ++col)
         {
-            ret += mat[col] * vec[col];
+            for (int row = 0; row < NRows; ++row)
+            {
+                ret[row] += mat[col][row] * vec[col];
+            }
         }
         return ret;
     }
@@ -280,6 +283,150 @@ namespace Joy
         return ret;
     }
 
+    /**
+     * @brief 融合乘加 a * scale + b，逐元素单次循环完成，常用于矩阵加权混合
+     *
+     * @tparam NRows 矩阵行数
+     * @tparam NCols 矩阵列数
+     * @tparam T 矩阵元素类型
+     * @param a 被缩放矩阵
+     * @param scale 缩放系数
+     * @param b 累加矩阵
+     * @return Mat<NRows, NCols, T>
+     */
+    template<int NRows, int NCols, typename T>
+    constexpr Mat<NRows, NCols, T> MulAdd(const Mat<NRows, NCols, T>& a, const T& scale, const Mat<NRows, NCols, T>& b)
+    {
+        Mat<NRows, NCols, T> ret{b};
+        for (int col = 0; col < NCols; ++col)
+        {
+            for (int row = 0; row < NRows; ++row)
+            {
+                ret[col][row] += a[col][row] * scale;
+            }
+        }
+        return ret;
+    }
+
+    namespace Detail
+    {
+        /**
+         * @brief constexpr版本的绝对值
+         *
+         */
+        template<typename T> constexpr T Abs(const T& value) { return value < T(0) ? -value : value; }
+
+        /**
+         * @brief 交换矩阵的两行
+         *
+         */
+        template<int NRows, int NCols, typename T> constexpr void SwapRows(Mat<NRows, NCols, T>& mat, int row1, int row2)
+        {
+            for (int col = 0; col < NCols; ++col)
+            {
+                T temp         = mat[col][row1];
+                mat[col][row1] = mat[col][row2];
+                mat[col][row2] = temp;
+            }
+        }
+    }   // namespace Detail
+
+    /**
+     * @brief 方阵行列式(通用版本，部分主元高斯消元)
+     *
+     * @tparam N 矩阵阶数
+     * @tparam T 矩阵元素类型
+     * @param mat 输入方阵
+     * @return T
+     */
+    template<int N, typename T> constexpr T Determinant(const Mat<N, N, T>& mat)
+    {
+        Mat<N, N, T> m   = mat;
+        T            det = T(1);
+        for (int col = 0; col < N; ++col)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < N; ++row)
+            {
+                if (Detail::Abs(m[col][row]) > Detail::Abs(m[col][pivot]))
+                {
+                    pivot = row;
+                }
+            }
+            if (m[col][pivot] == T(0))
+            {
+                return T(0);
+            }
+            if (pivot != col)
+            {
+                Detail::SwapRows(m, col, pivot);
+                det = -det;
+            }
+            det *= m[col][col];
+            for (int row = col + 1; row < N; ++row)
+            {
+                const T factor = m[col][row] / m[col][col];
+                for (int c = col; c < N; ++c)
+                {
+                    m[c][row] -= factor * m[c][col];
+                }
+            }
+        }
+        return det;
+    }
+
+    /**
+     * @brief 逆矩阵(通用版本，部分主元高斯-约当消元)，奇异矩阵返回零矩阵
+     *
+     * @tparam N 矩阵阶数
+     * @tparam T 矩阵元素类型
+     * @param mat 输入方阵
+     * @return Mat<N, N, T>
+     */
+    template<int N, typename T> constexpr Mat<N, N, T> Inverse(const Mat<N, N, T>& mat)
+    {
+        Mat<N, N, T> m   = mat;
+        Mat<N, N, T> ret = Mat<N, N, T>::Identity();
+        for (int col = 0; col < N; ++col)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < N; ++row)
+            {
+                if (Detail::Abs(m[col][row]) > Detail::Abs(m[col][pivot]))
+                {
+                    pivot = row;
+                }
+            }
+            if (m[col][pivot] == T(0))
+            {
+                assert(false && "Inverse of a singular matrix.");
+                return Mat<N, N, T>::Zero();
+            }
+            Detail::SwapRows(m, col, pivot);
+            Detail::SwapRows(ret, col, pivot);
+            const T invPivot = T(1) / m[col][col];
+            for (int c = 0; c < N; ++c)
+            {
+                m[c][col] *= invPivot;
+                ret[c][col] *= invPivot;
+            }
+            for (int row = 0; row < N; ++row)
+            {
+                const T factor = m[col][row];
+                if (row == col || factor == T(0))
+                {
+                    continue;
+                }
+                for (int c = 0; c < N; ++c)
+                {
+                    m[c][row] -= factor * m[c][col];
+                    ret[c][row] -= factor * ret[c][col];
+                }
+            }
+        }
+        return ret;
+    }
+
     /**
      * @brief 流输出矩阵
      *
@@ -355,4 +502,211 @@ namespace Joy
      *
      */
     constexpr Mat4x4f MAT4X4F_IDENTITY = Mat4x4f::Identity();
+
+    /**
+     * @brief 双精度矩阵别名，用于大世界坐标下的相机与物体变换
+     *
+     */
+    using Mat3x3d = Mat<3, 3, double>;
+    using Mat4x4d = Mat<4, 4, double>;
+
+    /**
+     * @brief 逐元素转换矩阵元素类型
+     *
+     * @tparam TTo 目标元素类型
+     * @tparam NRows 矩阵行数
+     * @tparam NCols 矩阵列数
+     * @tparam TFrom 源元素类型
+     * @param mat
+     * @return Mat<NRows, NCols, TTo>
+     */
+    template<typename TTo, int NRows, int NCols, typename TFrom> constexpr Mat<NRows, NCols, TTo> MatCast(const Mat<NRows, NCols, TFrom>& mat)
+    {
+        Mat<NRows, NCols, TTo> ret{};
+        for (int col = 0; col < NCols; ++col)
+        {
+            ret[col] = VecCast<TTo>(mat[col]);
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 二阶浮点矩阵行列式 - 展开版本
+     *
+     * @param m
+     * @return float
+     */
+    constexpr float Determinant(const Mat2x2f& m)
+    {
+        return m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    }
+
+    /**
+     * @brief 三阶浮点矩阵行列式 - 展开版本
+     *
+     * @param m
+     * @return float
+     */
+    constexpr float Determinant(const Mat3x3f& m)
+    {
+        // m[col][row]
+        return m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2]) - m[1][0] * (m[0][1] * m[2][2] - m[2][1] * m[0][2]) +
+               m[2][0] * (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+    }
+
+    /**
+     * @brief 三阶浮点矩阵求逆 - 展开版本(伴随矩阵)，奇异矩阵返回零矩阵
+     *
+     * @param m
+     * @return Mat3x3f
+     */
+    constexpr Mat3x3f Inverse(const Mat3x3f& m)
+    {
+        const float det = Determinant(m);
+        if (det == 0.f)
+        {
+            assert(false && "Inverse of a singular matrix.");
+            return MAT3X3F_ZERO;
+        }
+        const float invDet = 1.f / det;
+        Mat3x3f     ret{};
+        ret[0][0] = (m[1][1] * m[2][2] - m[2][1] * m[1][2]) * invDet;
+        ret[0][1] = (m[2][1] * m[0][2] - m[0][1] * m[2][2]) * invDet;
+        ret[0][2] = (m[0][1] * m[1][2] - m[1][1] * m[0][2]) * invDet;
+        ret[1][0] = (m[2][0] * m[1][2] - m[1][0] * m[2][2]) * invDet;
+        ret[1][1] = (m[0][0] * m[2][2] - m[2][0] * m[0][2]) * invDet;
+        ret[1][2] = (m[1][0] * m[0][2] - m[0][0] * m[1][2]) * invDet;
+        ret[2][0] = (m[1][0] * m[2][1] - m[2][0] * m[1][1]) * invDet;
+        ret[2][1] = (m[2][0] * m[0][1] - m[0][0] * m[2][1]) * invDet;
+        ret[2][2] = (m[0][0] * m[1][1] - m[1][0] * m[0][1]) * invDet;
+        return ret;
+    }
+
+    /**
+     * @brief 四阶浮点矩阵行列式 - 展开版本(拉普拉斯展开，复用2x2子式)
+     *
+     * @param m
+     * @return float
+     */
+    constexpr float Determinant(const Mat4x4f& m)
+    {
+        const float s0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        const float s1 = m[0][0] * m[2][1] - m[0][1] * m[2][0];
+        const float s2 = m[0][0] * m[3][1] - m[0][1] * m[3][0];
+        const float s3 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const float s4 = m[1][0] * m[3][1] - m[1][1] * m[3][0];
+        const float s5 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+        const float c5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+        const float c4 = m[1][2] * m[3][3] - m[1][3] * m[3][2];
+        const float c3 = m[1][2] * m[2][3] - m[1][3] * m[2][2];
+        const float c2 = m[0][2] * m[3][3] - m[0][3] * m[3][2];
+        const float c1 = m[0][2] * m[2][3] - m[0][3] * m[2][2];
+        const float c0 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+
+    /**
+     * @brief 四阶浮点矩阵求逆 - 展开版本(拉普拉斯展开，复用2x2子式)，奇异矩阵返回零矩阵
+     *
+     * @param m
+     * @return Mat4x4f
+     */
+    constexpr Mat4x4f Inverse(const Mat4x4f& m)
+    {
+        // 下标为m[col][row]，s为上两行的2x2子式，c为下两行的2x2子式
+        const float s0  = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+        const float s1  = m[0][0] * m[2][1] - m[0][1] * m[2][0];
+        const float s2  = m[0][0] * m[3][1] - m[0][1] * m[3][0];
+        const float s3  = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const float s4  = m[1][0] * m[3][1] - m[1][1] * m[3][0];
+        const float s5  = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+        const float c5  = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+        const float c4  = m[1][2] * m[3][3] - m[1][3] * m[3][2];
+        const float c3  = m[1][2] * m[2][3] - m[1][3] * m[2][2];
+        const float c2  = m[0][2] * m[3][3] - m[0][3] * m[3][2];
+        const float c1  = m[0][2] * m[2][3] - m[0][3] * m[2][2];
+        const float c0  = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+        const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (det == 0.f)
+        {
+            assert(false && "Inverse of a singular matrix.");
+            return MAT4X4F_ZERO;
+        }
+        const float invDet = 1.f / det;
+        Mat4x4f     ret{};
+        ret[0][0] = (m[1][1] * c5 - m[2][1] * c4 + m[3][1] * c3) * invDet;
+        ret[1][0] = (-m[1][0] * c5 + m[2][0] * c4 - m[3][0] * c3) * invDet;
+        ret[2][0] = (m[1][3] * s5 - m[2][3] * s4 + m[3][3] * s3) * invDet;
+        ret[3][0] = (-m[1][2] * s5 + m[2][2] * s4 - m[3][2] * s3) * invDet;
+        ret[0][1] = (-m[0][1] * c5 + m[2][1] * c2 - m[3][1] * c1) * invDet;
+        ret[1][1] = (m[0][0] * c5 - m[2][0] * c2 + m[3][0] * c1) * invDet;
+        ret[2][1] = (-m[0][3] * s5 + m[2][3] * s2 - m[3][3] * s1) * invDet;
+        ret[3][1] = (m[0][2] * s5 - m[2][2] * s2 + m[3][2] * s1) * invDet;
+        ret[0][2] = (m[0][1] * c4 - m[1][1] * c2 + m[3][1] * c0) * invDet;
+        ret[1][2] = (-m[0][0] * c4 + m[1][0] * c2 - m[3][0] * c0) * invDet;
+        ret[2][2] = (m[0][3] * s4 - m[1][3] * s2 + m[3][3] * s0) * invDet;
+        ret[3][2] = (-m[0][2] * s4 + m[1][2] * s2 - m[3][2] * s0) * invDet;
+        ret[0][3] = (-m[0][1] * c3 + m[1][1] * c1 - m[2][1] * c0) * invDet;
+        ret[1][3] = (m[0][0] * c3 - m[1][0] * c1 + m[2][0] * c0) * invDet;
+        ret[2][3] = (-m[0][3] * s3 + m[1][3] * s1 - m[2][3] * s0) * invDet;
+        ret[3][3] = (m[0][2] * s3 - m[1][2] * s1 + m[2][2] * s0) * invDet;
+        return ret;
+    }
+
+    /**
+     * @brief 仿射变换矩阵求逆(最后一行为[0, 0, 0, 1])，只对左上3x3求逆: [A^-1, -A^-1 * t]
+     *
+     * @param m
+     * @return Mat4x4f
+     */
+    constexpr Mat4x4f InverseAffine(const Mat4x4f& m)
+    {
+        Mat3x3f linear{};
+        for (int col = 0; col < 3; ++col)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                linear[col][row] = m[col][row];
+            }
+        }
+        const Mat3x3f invLinear = Inverse(linear);
+        Mat4x4f       ret{};
+        for (int col = 0; col < 3; ++col)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                ret[col][row] = invLinear[col][row];
+            }
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            ret[3][row] = -(invLinear[0][row] * m[3][0] + invLinear[1][row] * m[3][1] + invLinear[2][row] * m[3][2]);
+        }
+        ret[3][3] = 1.f;
+        return ret;
+    }
+
+    /**
+     * @brief 刚体变换矩阵求逆(旋转 + 平移，旋转部分正交)，旋转部分直接转置: [R^T, -R^T * t]
+     *
+     * @param m
+     * @return Mat4x4f
+     */
+    constexpr Mat4x4f InverseRigid(const Mat4x4f& m)
+    {
+        Mat4x4f ret{};
+        for (int col = 0; col < 3; ++col)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                ret[col][row] = m[row][col];
+            }
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            ret[3][row] = -(m[row][0] * m[3][0] + m[row][1] * m[3][1] + m[row][2] * m[3][2]);
+        }
+        ret[3][3] = 1.f;
+        return ret;
+    }
 }   // namespace Joy
\ No newline at end of file
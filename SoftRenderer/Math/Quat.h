@@ -0,0 +1,284 @@
+/**
+ * @file Quat.h
+ * @author JoyatY
+ * @brief 四元数定义
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Mat.h"
+#include "Simd.h"
+#include "Vec.h"
+#include <cassert>
+#include <cmath>
+#include <ostream>
+
+namespace Joy
+{
+    /**
+     * @brief 单精度四元数 q = w + xi + yj + zk，用于表示旋转
+     *
+     */
+    struct Quat
+    {
+    public:
+        constexpr Quat(float x = 0.f, float y = 0.f, float z = 0.f, float w = 1.f)
+            : m_X(x)
+            , m_Y(y)
+            , m_Z(z)
+            , m_W(w)
+        {}
+
+    public:
+        constexpr const float& operator[](const int index) const
+        {
+            assert(index >= 0 && index < 4);
+            return index == 0 ? m_X : index == 1 ? m_Y : index == 2 ? m_Z : m_W;
+        }
+        constexpr float& operator[](const int index)
+        {
+            assert(index >= 0 && index < 4);
+            return index == 0 ? m_X : index == 1 ? m_Y : index == 2 ? m_Z : m_W;
+        }
+
+    public:
+        constexpr float X() const { return m_X; }
+        constexpr float Y() const { return m_Y; }
+        constexpr float Z() const { return m_Z; }
+        constexpr float W() const { return m_W; }
+
+        /**
+         * @brief 转换为四维向量(x, y, z, w)
+         *
+         * @return Vec4f
+         */
+        constexpr Vec4f ToVec4f() const { return Vec4f{m_X, m_Y, m_Z, m_W}; }
+
+    private:
+        float m_X = 0.f;
+        float m_Y = 0.f;
+        float m_Z = 0.f;
+        float m_W = 1.f;
+
+    public:
+        /**
+         * @brief 单位四元数(无旋转)
+         *
+         * @return Quat
+         */
+        constexpr static Quat Identity() { return Quat{}; }
+
+        /**
+         * @brief 由旋转轴和旋转角构造四元数
+         *
+         * @param axis 旋转轴(须为单位向量)
+         * @param radians 旋转角(弧度)
+         * @return Quat
+         */
+        static Quat FromAxisAngle(const Vec3f& axis, float radians)
+        {
+            const float halfAngle = radians * 0.5f;
+            const float s         = std::sin(halfAngle);
+            return Quat{axis.X() * s, axis.Y() * s, axis.Z() * s, std::cos(halfAngle)};
+        }
+    };
+
+    namespace Detail
+    {
+        inline Simd::Float4 LoadQuat(const Quat& quat) { return Simd::Set(quat.X(), quat.Y(), quat.Z(), quat.W()); }
+
+        inline Quat StoreQuat(Simd::Float4 value)
+        {
+            float data[4];
+            Simd::Store(data, value);
+            return Quat{data[0], data[1], data[2], data[3]};
+        }
+    }   // namespace Detail
+
+    /**
+     * @brief 四元数乘法(先应用rhs旋转，再应用lhs旋转)
+     *
+     * @param lhs
+     * @param rhs
+     * @return Quat
+     */
+    constexpr Quat operator*(const Quat& lhs, const Quat& rhs)
+    {
+        return Quat{lhs.W() * rhs.X() + lhs.X() * rhs.W() + lhs.Y() * rhs.Z() - lhs.Z() * rhs.Y(),
+                    lhs.W() * rhs.Y() - lhs.X() * rhs.Z() + lhs.Y() * rhs.W() + lhs.Z() * rhs.X(),
+                    lhs.W() * rhs.Z() + lhs.X() * rhs.Y() - lhs.Y() * rhs.X() + lhs.Z() * rhs.W(),
+                    lhs.W() * rhs.W() - lhs.X() * rhs.X() - lhs.Y() * rhs.Y() - lhs.Z() * rhs.Z()};
+    }
+
+    /**
+     * @brief 判断两个四元数是否相等
+     *
+     * @param lhs
+     * @param rhs
+     * @return true
+     * @return false
+     */
+    inline bool operator==(const Quat& lhs, const Quat& rhs)
+    {
+        return lhs.ToVec4f() == rhs.ToVec4f();
+    }
+
+    inline bool operator!=(const Quat& lhs, const Quat& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief 四元数点积
+     *
+     * @param lhs
+     * @param rhs
+     * @return float
+     */
+    constexpr float Dot(const Quat& lhs, const Quat& rhs)
+    {
+        return lhs.X() * rhs.X() + lhs.Y() * rhs.Y() + lhs.Z() * rhs.Z() + lhs.W() * rhs.W();
+    }
+
+    /**
+     * @brief 共轭四元数，对单位四元数即为逆旋转
+     *
+     * @param quat
+     * @return Quat
+     */
+    constexpr Quat Conjugate(const Quat& quat)
+    {
+        return Quat{-quat.X(), -quat.Y(), -quat.Z(), quat.W()};
+    }
+
+    /**
+     * @brief 归一化四元数
+     *
+     * @param quat
+     * @return Quat
+     */
+    inline Quat Normalized(const Quat& quat)
+    {
+        const float sqrNorm = Dot(quat, quat);
+        if (sqrNorm == 0.f)
+        {
+            return Quat::Identity();
+        }
+        return Detail::StoreQuat(Detail::LoadQuat(quat) * Simd::Splat(1.f / std::sqrt(sqrNorm)));
+    }
+
+    /**
+     * @brief 使用四元数旋转向量
+     *
+     * @param quat 单位四元数
+     * @param vec
+     * @return Vec3f
+     */
+    inline Vec3f Rotate(const Quat& quat, const Vec3f& vec)
+    {
+        // v' = v + 2w(u x v) + 2u x (u x v)
+        const Vec3f u{quat.X(), quat.Y(), quat.Z()};
+        const Vec3f t = Cross(u, vec) * 2.f;
+        return vec + t * quat.W() + Cross(u, t);
+    }
+
+    /**
+     * @brief 归一化线性插值，沿最短路径插值，速度不均匀但开销远低于Slerp
+     *
+     * @param from
+     * @param to
+     * @param t 插值系数[0, 1]
+     * @return Quat
+     */
+    inline Quat Nlerp(const Quat& from, const Quat& to, float t)
+    {
+        using namespace Simd;
+        const Float4 a    = Detail::LoadQuat(from);
+        const Float4 b    = Detail::LoadQuat(to);
+        const float  sign = Dot(from, to) < 0.f ? -1.f : 1.f;
+        const Float4 ret  = a * Splat(1.f - t) + b * Splat(t * sign);
+        const float  norm = std::sqrt(HorizontalSum(ret * ret));
+        return Detail::StoreQuat(ret * Splat(1.f / norm));
+    }
+
+    /**
+     * @brief 球面线性插值，沿最短路径匀速插值，夹角很小时退化为Nlerp
+     *
+     * @param from
+     * @param to
+     * @param t 插值系数[0, 1]
+     * @return Quat
+     */
+    inline Quat Slerp(const Quat& from, const Quat& to, float t)
+    {
+        float cosTheta = Dot(from, to);
+        float sign     = 1.f;
+        if (cosTheta < 0.f)
+        {
+            cosTheta = -cosTheta;
+            sign     = -1.f;
+        }
+        if (cosTheta > 0.9995f)
+        {
+            return Nlerp(from, to, t);
+        }
+        const float theta     = std::acos(cosTheta);
+        const float invSin    = 1.f / std::sin(theta);
+        const float fromScale = std::sin((1.f - t) * theta) * invSin;
+        const float toScale   = std::sin(t * theta) * invSin * sign;
+        return Detail::StoreQuat(Detail::LoadQuat(from) * Simd::Splat(fromScale) + Detail::LoadQuat(to) * Simd::Splat(toScale));
+    }
+
+    /**
+     * @brief 单位四元数转三阶旋转矩阵
+     *
+     * @param quat
+     * @return Mat3x3f
+     */
+    constexpr Mat3x3f ToMat3x3f(const Quat& quat)
+    {
+        const float x = quat.X();
+        const float y = quat.Y();
+        const float z = quat.Z();
+        const float w = quat.W();
+        Mat3x3f     ret{};
+        ret[0] = Vec3f{1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y)};
+        ret[1] = Vec3f{2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x)};
+        ret[2] = Vec3f{2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y)};
+        return ret;
+    }
+
+    /**
+     * @brief 单位四元数转四阶旋转矩阵
+     *
+     * @param quat
+     * @return Mat4x4f
+     */
+    constexpr Mat4x4f ToMat4x4f(const Quat& quat)
+    {
+        const Mat3x3f rotation = ToMat3x3f(quat);
+        Mat4x4f       ret      = MAT4X4F_IDENTITY;
+        for (int col = 0; col < 3; ++col)
+        {
+            ret[col] = Vec4f{rotation[col][0], rotation[col][1], rotation[col][2], 0.f};
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 打印四元数
+     *
+     * @param out
+     * @param quat
+     * @return std::ostream&
+     */
+    inline std::ostream& operator<<(std::ostream& out, const Quat& quat)
+    {
+        return out << "(" << quat.X() << ", " << quat.Y() << ", " << quat.Z() << ", " << quat.W() << ")";
+    }
+}   // namespace Joy
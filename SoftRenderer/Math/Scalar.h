@@ -0,0 +1,259 @@
+/**
+ * @file Scalar.h
+ * @author JoyatY
+ * @brief 向量/矩阵元素类型的标量特性
+ * @version 0.1
+ * @date 2025-12-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace Joy
+{
+    namespace Detail
+    {
+        /**
+         * @brief 当前是否处于常量求值(编译期)，用于让同一个constexpr函数在运行期走标准库实现
+         *
+         */
+        constexpr bool IsConstantEvaluated()
+        {
+#if defined(__cpp_lib_is_constant_evaluated)
+            return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+            return __builtin_is_constant_evaluated();
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief 编译期开方，从不小于结果的初值开始牛顿迭代，单调递减直到不再变化
+         *
+         */
+        constexpr double ConstexprSqrt(double value)
+        {
+            if (!(value > 0.0) || value == std::numeric_limits<double>::infinity())
+            {
+                return value == 0.0 || value == std::numeric_limits<double>::infinity() ? value : std::numeric_limits<double>::quiet_NaN();
+            }
+            double guess = value > 1.0 ? value : 1.0;
+            for (;;)
+            {
+                const double next = 0.5 * (guess + value / guess);
+                if (next >= guess)
+                {
+                    return guess;
+                }
+                guess = next;
+            }
+        }
+
+        /**
+         * @brief 编译期正弦/余弦: 以pi/2分段约化到[-pi/4, pi/4]后展开泰勒级数
+         *
+         */
+        constexpr double ConstexprSinCos(double value, bool cosine)
+        {
+            // pi/2拆成高低两部分，约化时保留更多有效位
+            constexpr double HALF_PI_HI = 1.57079632673412561417e+00;
+            constexpr double HALF_PI_LO = 6.07710050650619224932e-11;
+            const double     quotient   = value / (HALF_PI_HI + HALF_PI_LO);
+            const int64_t    quadrant   = static_cast<int64_t>(quotient < 0.0 ? quotient - 0.5 : quotient + 0.5);
+            const double     reduced    = (value - static_cast<double>(quadrant) * HALF_PI_HI) - static_cast<double>(quadrant) * HALF_PI_LO;
+            const double     square     = reduced * reduced;
+            double           sinSum     = reduced;
+            double           cosSum     = 1.0;
+            double           sinTerm    = reduced;
+            double           cosTerm    = 1.0;
+            for (int n = 1; n <= 12; ++n)
+            {
+                sinTerm *= -square / static_cast<double>((2 * n) * (2 * n + 1));
+                cosTerm *= -square / static_cast<double>((2 * n - 1) * (2 * n));
+                sinSum += sinTerm;
+                cosSum += cosTerm;
+            }
+            switch (((quadrant % 4) + 4 + (cosine ? 1 : 0)) % 4)
+            {
+                case 0: return sinSum;
+                case 1: return cosSum;
+                case 2: return -sinSum;
+                default: return -cosSum;
+            }
+        }
+
+        constexpr double ConstexprSin(double value) { return ConstexprSinCos(value, false); }
+        constexpr double ConstexprCos(double value) { return ConstexprSinCos(value, true); }
+
+        /**
+         * @brief 编译期指数: 以ln2约化后展开泰勒级数，再乘以2的整数次幂
+         *
+         */
+        constexpr double ConstexprExp(double value)
+        {
+            constexpr double LN2_HI   = 6.93147180369123816490e-01;
+            constexpr double LN2_LO   = 1.90821492927058770002e-10;
+            const double     quotient = value / (LN2_HI + LN2_LO);
+            const int64_t    exponent = static_cast<int64_t>(quotient < 0.0 ? quotient - 0.5 : quotient + 0.5);
+            const double     reduced  = (value - static_cast<double>(exponent) * LN2_HI) - static_cast<double>(exponent) * LN2_LO;
+            double           sum      = 1.0;
+            double           term     = 1.0;
+            for (int n = 1; n <= 20; ++n)
+            {
+                term *= reduced / static_cast<double>(n);
+                sum += term;
+            }
+            for (int64_t i = 0; i < exponent; ++i)
+            {
+                sum *= 2.0;
+            }
+            for (int64_t i = 0; i > exponent; --i)
+            {
+                sum *= 0.5;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief 编译期自然对数: 约化到[sqrt(1/2), sqrt(2))后用atanh级数 ln(m) = 2 * atanh((m - 1) / (m + 1))
+         *
+         */
+        constexpr double ConstexprLog(double value)
+        {
+            if (!(value > 0.0))
+            {
+                return value == 0.0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+            }
+            constexpr double SQRT2    = 1.41421356237309504880;
+            constexpr double LN2      = 6.93147180559945309417e-01;
+            int              exponent = 0;
+            while (value >= SQRT2)
+            {
+                value *= 0.5;
+                ++exponent;
+            }
+            while (value < SQRT2 * 0.5)
+            {
+                value *= 2.0;
+                --exponent;
+            }
+            const double ratio  = (value - 1.0) / (value + 1.0);
+            const double square = ratio * ratio;
+            double       sum    = 0.0;
+            double       power  = ratio;
+            for (int n = 0; n < 24; ++n)
+            {
+                sum += power / static_cast<double>(2 * n + 1);
+                power *= square;
+            }
+            return 2.0 * sum + static_cast<double>(exponent) * LN2;
+        }
+
+        /**
+         * @brief 编译期幂函数，底数须非负
+         *
+         */
+        constexpr double ConstexprPow(double base, double exponent) { return base == 0.0 ? 0.0 : ConstexprExp(exponent * ConstexprLog(base)); }
+    }   // namespace Detail
+
+    /**
+     * @brief 标量特性，描述Vec/Mat元素类型的比较容差与开方
+     *
+     * 元素类型须支持T(0)、T(1)构造与四则运算。默认按精确值比较，浮点类型按绝对容差比较。
+     * 开方与三角函数为constexpr，矩阵构建函数因此可以在编译期求值。
+     *
+     * @tparam T 元素类型
+     */
+    template<typename T> struct ScalarTraits
+    {
+        /**
+         * @brief 相等比较的绝对容差，0表示精确比较
+         *
+         * @return T
+         */
+        constexpr static T Epsilon() { return T(0); }
+
+        /**
+         * @brief 开方与三角函数: 编译期走constexpr实现，运行期直接调用标准库，运行期结果不受影响
+         *
+         */
+        constexpr static T Sqrt(const T& value)
+        {
+            return T(Detail::IsConstantEvaluated() ? Detail::ConstexprSqrt(ToDouble(value)) : std::sqrt(ToDouble(value)));
+        }
+        constexpr static T Sin(const T& value)
+        {
+            return T(Detail::IsConstantEvaluated() ? Detail::ConstexprSin(ToDouble(value)) : std::sin(ToDouble(value)));
+        }
+        constexpr static T Cos(const T& value)
+        {
+            return T(Detail::IsConstantEvaluated() ? Detail::ConstexprCos(ToDouble(value)) : std::cos(ToDouble(value)));
+        }
+        constexpr static T Tan(const T& value) { return Sin(value) / Cos(value); }
+
+    private:
+        constexpr static double ToDouble(const T& value) { return static_cast<double>(value); }
+    };
+
+    template<> struct ScalarTraits<float>
+    {
+        constexpr static float Epsilon() { return 1e-5f; }
+
+        constexpr static float Sqrt(float value)
+        {
+            return Detail::IsConstantEvaluated() ? static_cast<float>(Detail::ConstexprSqrt(value)) : std::sqrt(value);
+        }
+        constexpr static float Sin(float value)
+        {
+            return Detail::IsConstantEvaluated() ? static_cast<float>(Detail::ConstexprSin(value)) : std::sin(value);
+        }
+        constexpr static float Cos(float value)
+        {
+            return Detail::IsConstantEvaluated() ? static_cast<float>(Detail::ConstexprCos(value)) : std::cos(value);
+        }
+        constexpr static float Tan(float value)
+        {
+            return Detail::IsConstantEvaluated() ? static_cast<float>(Detail::ConstexprSin(value) / Detail::ConstexprCos(value)) : std::tan(value);
+        }
+    };
+
+    template<> struct ScalarTraits<double>
+    {
+        constexpr static double Epsilon() { return 1e-9; }
+
+        constexpr static double Sqrt(double value) { return Detail::IsConstantEvaluated() ? Detail::ConstexprSqrt(value) : std::sqrt(value); }
+        constexpr static double Sin(double value) { return Detail::IsConstantEvaluated() ? Detail::ConstexprSin(value) : std::sin(value); }
+        constexpr static double Cos(double value) { return Detail::IsConstantEvaluated() ? Detail::ConstexprCos(value) : std::cos(value); }
+        constexpr static double Tan(double value)
+        {
+            return Detail::IsConstantEvaluated() ? Detail::ConstexprSin(value) / Detail::ConstexprCos(value) : std::tan(value);
+        }
+    };
+
+    /**
+     * @brief 按标量特性的容差判断两个标量是否相等
+     *
+     * @tparam T 元素类型
+     * @param lhs
+     * @param rhs
+     * @return true
+     * @return false
+     */
+    template<typename T> constexpr bool NearlyEqual(const T& lhs, const T& rhs)
+    {
+        const T epsilon = ScalarTraits<T>::Epsilon();
+        if (epsilon == T(0))
+        {
+            return lhs == rhs;
+        }
+        return lhs - rhs < epsilon && rhs - lhs < epsilon;
+    }
+}   // namespace Joy
@@ -0,0 +1,288 @@
+/**
+ * @file Simd.h
+ * @author JoyatY
+ * @brief 4通道SIMD向量封装(SSE2实现，不支持时回退到标量实现)
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JOY_SIMD_SSE2 1
+#    include <emmintrin.h>
+#else
+#    define JOY_SIMD_SSE2 0
+#endif
+
+namespace Joy
+{
+    namespace Simd
+    {
+        /**
+         * @brief 4通道单精度浮点SIMD向量
+         *
+         */
+        struct Float4
+        {
+#if JOY_SIMD_SSE2
+            __m128 m_Value;
+#else
+            float m_Value[4];
+#endif
+        };
+
+        /**
+         * @brief 4通道32位整数SIMD向量
+         *
+         */
+        struct Int4
+        {
+#if JOY_SIMD_SSE2
+            __m128i m_Value;
+#else
+            int32_t m_Value[4];
+#endif
+        };
+
+#if JOY_SIMD_SSE2
+        inline Float4 Load(const float* src) { return Float4{_mm_loadu_ps(src)}; }
+        inline void   Store(float* dst, Float4 value) { _mm_storeu_ps(dst, value.m_Value); }
+        inline Float4 Set(float x, float y, float z, float w) { return Float4{_mm_setr_ps(x, y, z, w)}; }
+        inline Float4 Splat(float value) { return Float4{_mm_set1_ps(value)}; }
+        inline Float4 operator+(Float4 lhs, Float4 rhs) { return Float4{_mm_add_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 operator-(Float4 lhs, Float4 rhs) { return Float4{_mm_sub_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 operator*(Float4 lhs, Float4 rhs) { return Float4{_mm_mul_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 operator/(Float4 lhs, Float4 rhs) { return Float4{_mm_div_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 Min(Float4 lhs, Float4 rhs) { return Float4{_mm_min_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 Max(Float4 lhs, Float4 rhs) { return Float4{_mm_max_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 Sqrt(Float4 value) { return Float4{_mm_sqrt_ps(value.m_Value)}; }
+        inline Float4 CmpLt(Float4 lhs, Float4 rhs) { return Float4{_mm_cmplt_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 CmpLe(Float4 lhs, Float4 rhs) { return Float4{_mm_cmple_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 CmpGt(Float4 lhs, Float4 rhs) { return Float4{_mm_cmpgt_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 CmpGe(Float4 lhs, Float4 rhs) { return Float4{_mm_cmpge_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 And(Float4 lhs, Float4 rhs) { return Float4{_mm_and_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline Float4 Or(Float4 lhs, Float4 rhs) { return Float4{_mm_or_ps(lhs.m_Value, rhs.m_Value)}; }
+        inline int    MoveMask(Float4 mask) { return _mm_movemask_ps(mask.m_Value); }
+
+        /**
+         * @brief 按掩码选择，掩码通道全1时取trueValue，否则取falseValue
+         *
+         */
+        inline Float4 Select(Float4 mask, Float4 trueValue, Float4 falseValue)
+        {
+            return Float4{_mm_or_ps(_mm_and_ps(mask.m_Value, trueValue.m_Value), _mm_andnot_ps(mask.m_Value, falseValue.m_Value))};
+        }
+
+        inline Int4 LoadInt(const int32_t* src) { return Int4{_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))}; }
+        inline void StoreInt(int32_t* dst, Int4 value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value.m_Value); }
+        inline Int4 SetInt(int32_t x, int32_t y, int32_t z, int32_t w) { return Int4{_mm_setr_epi32(x, y, z, w)}; }
+        inline Int4 SplatInt(int32_t value) { return Int4{_mm_set1_epi32(value)}; }
+        inline Int4 operator+(Int4 lhs, Int4 rhs) { return Int4{_mm_add_epi32(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 operator-(Int4 lhs, Int4 rhs) { return Int4{_mm_sub_epi32(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 operator&(Int4 lhs, Int4 rhs) { return Int4{_mm_and_si128(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 operator|(Int4 lhs, Int4 rhs) { return Int4{_mm_or_si128(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 operator^(Int4 lhs, Int4 rhs) { return Int4{_mm_xor_si128(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 CmpGt(Int4 lhs, Int4 rhs) { return Int4{_mm_cmpgt_epi32(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 CmpEq(Int4 lhs, Int4 rhs) { return Int4{_mm_cmpeq_epi32(lhs.m_Value, rhs.m_Value)}; }
+        inline Int4 Select(Int4 mask, Int4 trueValue, Int4 falseValue)
+        {
+            return Int4{_mm_or_si128(_mm_and_si128(mask.m_Value, trueValue.m_Value), _mm_andnot_si128(mask.m_Value, falseValue.m_Value))};
+        }
+        template<int Shift> inline Int4 ShiftLeft(Int4 value) { return Int4{_mm_slli_epi32(value.m_Value, Shift)}; }
+        template<int Shift> inline Int4 ShiftRightLogical(Int4 value) { return Int4{_mm_srli_epi32(value.m_Value, Shift)}; }
+        template<int Shift> inline Int4 ShiftRightArith(Int4 value) { return Int4{_mm_srai_epi32(value.m_Value, Shift)}; }
+
+        /**
+         * @brief 浮点转整数(就近舍入)
+         *
+         */
+        inline Int4 RoundToInt(Float4 value) { return Int4{_mm_cvtps_epi32(value.m_Value)}; }
+        inline Float4 ToFloat(Int4 value) { return Float4{_mm_cvtepi32_ps(value.m_Value)}; }
+
+        /**
+         * @brief 按位重解释
+         *
+         */
+        inline Int4   AsInt(Float4 value) { return Int4{_mm_castps_si128(value.m_Value)}; }
+        inline Float4 AsFloat(Int4 value) { return Float4{_mm_castsi128_ps(value.m_Value)}; }
+#else
+        inline Float4 Load(const float* src) { return Float4{{src[0], src[1], src[2], src[3]}}; }
+        inline void   Store(float* dst, Float4 value)
+        {
+            for (int i = 0; i < 4; ++i) dst[i] = value.m_Value[i];
+        }
+        inline Float4 Set(float x, float y, float z, float w) { return Float4{{x, y, z, w}}; }
+        inline Float4 Splat(float value) { return Float4{{value, value, value, value}}; }
+
+#    define JOY_SIMD_FLOAT4_BINARY(expr)                                                                                                   \
+        Float4 ret;                                                                                                                         \
+        for (int i = 0; i < 4; ++i) ret.m_Value[i] = (expr);                                                                               \
+        return ret;
+
+        inline Float4 operator+(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(lhs.m_Value[i] + rhs.m_Value[i]) }
+        inline Float4 operator-(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(lhs.m_Value[i] - rhs.m_Value[i]) }
+        inline Float4 operator*(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(lhs.m_Value[i] * rhs.m_Value[i]) }
+        inline Float4 operator/(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(lhs.m_Value[i] / rhs.m_Value[i]) }
+        inline Float4 Min(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(rhs.m_Value[i] < lhs.m_Value[i] ? rhs.m_Value[i] : lhs.m_Value[i]) }
+        inline Float4 Max(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(rhs.m_Value[i] > lhs.m_Value[i] ? rhs.m_Value[i] : lhs.m_Value[i]) }
+        inline Float4 Sqrt(Float4 value) { JOY_SIMD_FLOAT4_BINARY(std::sqrt(value.m_Value[i])) }
+
+        inline float MaskBits(bool value)
+        {
+            uint32_t bits = value ? 0xffffffffu : 0u;
+            float    ret  = 0.f;
+            static_assert(sizeof(bits) == sizeof(ret), "Float4 mask size mismatch.");
+            std::memcpy(&ret, &bits, sizeof(ret));
+            return ret;
+        }
+        inline uint32_t Bits(float value)
+        {
+            uint32_t ret = 0;
+            std::memcpy(&ret, &value, sizeof(ret));
+            return ret;
+        }
+        inline float FromBits(uint32_t value)
+        {
+            float ret = 0.f;
+            std::memcpy(&ret, &value, sizeof(ret));
+            return ret;
+        }
+
+        inline Float4 CmpLt(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(MaskBits(lhs.m_Value[i] < rhs.m_Value[i])) }
+        inline Float4 CmpLe(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(MaskBits(lhs.m_Value[i] <= rhs.m_Value[i])) }
+        inline Float4 CmpGt(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(MaskBits(lhs.m_Value[i] > rhs.m_Value[i])) }
+        inline Float4 CmpGe(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(MaskBits(lhs.m_Value[i] >= rhs.m_Value[i])) }
+        inline Float4 And(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(FromBits(Bits(lhs.m_Value[i]) & Bits(rhs.m_Value[i]))) }
+        inline Float4 Or(Float4 lhs, Float4 rhs) { JOY_SIMD_FLOAT4_BINARY(FromBits(Bits(lhs.m_Value[i]) | Bits(rhs.m_Value[i]))) }
+        inline Float4 Select(Float4 mask, Float4 trueValue, Float4 falseValue)
+        {
+            JOY_SIMD_FLOAT4_BINARY(Bits(mask.m_Value[i]) != 0 ? trueValue.m_Value[i] : falseValue.m_Value[i])
+        }
+        inline int MoveMask(Float4 mask)
+        {
+            int ret = 0;
+            for (int i = 0; i < 4; ++i) ret |= static_cast<int>(Bits(mask.m_Value[i]) >> 31) << i;
+            return ret;
+        }
+#    undef JOY_SIMD_FLOAT4_BINARY
+
+#    define JOY_SIMD_INT4_BINARY(expr)                                                                                                     \
+        Int4 ret;                                                                                                                           \
+        for (int i = 0; i < 4; ++i) ret.m_Value[i] = (expr);                                                                               \
+        return ret;
+
+        inline Int4 LoadInt(const int32_t* src) { return Int4{{src[0], src[1], src[2], src[3]}}; }
+        inline void StoreInt(int32_t* dst, Int4 value)
+        {
+            for (int i = 0; i < 4; ++i) dst[i] = value.m_Value[i];
+        }
+        inline Int4 SetInt(int32_t x, int32_t y, int32_t z, int32_t w) { return Int4{{x, y, z, w}}; }
+        inline Int4 SplatInt(int32_t value) { return Int4{{value, value, value, value}}; }
+        inline Int4 operator+(Int4 lhs, Int4 rhs)
+        {
+            JOY_SIMD_INT4_BINARY(static_cast<int32_t>(static_cast<uint32_t>(lhs.m_Value[i]) + static_cast<uint32_t>(rhs.m_Value[i])))
+        }
+        inline Int4 operator-(Int4 lhs, Int4 rhs)
+        {
+            JOY_SIMD_INT4_BINARY(static_cast<int32_t>(static_cast<uint32_t>(lhs.m_Value[i]) - static_cast<uint32_t>(rhs.m_Value[i])))
+        }
+        inline Int4 operator&(Int4 lhs, Int4 rhs) { JOY_SIMD_INT4_BINARY(lhs.m_Value[i] & rhs.m_Value[i]) }
+        inline Int4 operator|(Int4 lhs, Int4 rhs) { JOY_SIMD_INT4_BINARY(lhs.m_Value[i] | rhs.m_Value[i]) }
+        inline Int4 operator^(Int4 lhs, Int4 rhs) { JOY_SIMD_INT4_BINARY(lhs.m_Value[i] ^ rhs.m_Value[i]) }
+        inline Int4 CmpGt(Int4 lhs, Int4 rhs) { JOY_SIMD_INT4_BINARY(lhs.m_Value[i] > rhs.m_Value[i] ? -1 : 0) }
+        inline Int4 CmpEq(Int4 lhs, Int4 rhs) { JOY_SIMD_INT4_BINARY(lhs.m_Value[i] == rhs.m_Value[i] ? -1 : 0) }
+        inline Int4 Select(Int4 mask, Int4 trueValue, Int4 falseValue)
+        {
+            JOY_SIMD_INT4_BINARY((mask.m_Value[i] & trueValue.m_Value[i]) | (~mask.m_Value[i] & falseValue.m_Value[i]))
+        }
+        template<int Shift> inline Int4 ShiftLeft(Int4 value)
+        {
+            JOY_SIMD_INT4_BINARY(static_cast<int32_t>(static_cast<uint32_t>(value.m_Value[i]) << Shift))
+        }
+        template<int Shift> inline Int4 ShiftRightLogical(Int4 value)
+        {
+            JOY_SIMD_INT4_BINARY(static_cast<int32_t>(static_cast<uint32_t>(value.m_Value[i]) >> Shift))
+        }
+        template<int Shift> inline Int4 ShiftRightArith(Int4 value) { JOY_SIMD_INT4_BINARY(value.m_Value[i] >> Shift) }
+        inline Int4 RoundToInt(Float4 value) { JOY_SIMD_INT4_BINARY(static_cast<int32_t>(std::nearbyint(value.m_Value[i]))) }
+        inline Float4 ToFloat(Int4 value)
+        {
+            Float4 ret;
+            for (int i = 0; i < 4; ++i) ret.m_Value[i] = static_cast<float>(value.m_Value[i]);
+            return ret;
+        }
+        inline Int4 AsInt(Float4 value) { JOY_SIMD_INT4_BINARY(static_cast<int32_t>(Bits(value.m_Value[i]))) }
+        inline Float4 AsFloat(Int4 value)
+        {
+            Float4 ret;
+            for (int i = 0; i < 4; ++i) ret.m_Value[i] = FromBits(static_cast<uint32_t>(value.m_Value[i]));
+            return ret;
+        }
+#    undef JOY_SIMD_INT4_BINARY
+#endif
+
+        /**
+         * @brief 4x4转置，输入为4行，输出为4列(原地)
+         *
+         */
+        inline void Transpose4(Float4& row0, Float4& row1, Float4& row2, Float4& row3)
+        {
+#if JOY_SIMD_SSE2
+            _MM_TRANSPOSE4_PS(row0.m_Value, row1.m_Value, row2.m_Value, row3.m_Value);
+#else
+            Float4* rows[4] = {&row0, &row1, &row2, &row3};
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = i + 1; j < 4; ++j)
+                {
+                    float temp          = rows[i]->m_Value[j];
+                    rows[i]->m_Value[j] = rows[j]->m_Value[i];
+                    rows[j]->m_Value[i] = temp;
+                }
+            }
+#endif
+        }
+
+        /**
+         * @brief 乘加 a * b + c
+         *
+         */
+        inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return a * b + c; }
+
+        /**
+         * @brief 将value钳制在[minValue, maxValue]区间
+         *
+         */
+        inline Float4 Clamp(Float4 value, Float4 minValue, Float4 maxValue) { return Min(Max(value, minValue), maxValue); }
+
+        /**
+         * @brief 取出指定通道的值
+         *
+         */
+        inline float GetLane(Float4 value, int lane)
+        {
+            float data[4];
+            Store(data, value);
+            return data[lane];
+        }
+
+        /**
+         * @brief 四个通道求和
+         *
+         */
+        inline float HorizontalSum(Float4 value)
+        {
+            float data[4];
+            Store(data, value);
+            return (data[0] + data[1]) + (data[2] + data[3]);
+        }
+    }   // namespace Simd
+}   // namespace Joy
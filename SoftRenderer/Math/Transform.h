@@ -0,0 +1,172 @@
+/**
+ * @file Transform.h
+ * @author JoyatY
+ * @brief constexpr变换矩阵构建: 平移、旋转、缩放、观察与投影
+ * @version 0.1
+ * @date 2025-12-28
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "Mat.h"
+#include "Scalar.h"
+#include "Vec.h"
+
+namespace Joy
+{
+    /**
+     * @brief 平移矩阵
+     *
+     * @tparam T 元素类型
+     * @param offset 平移量
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> Translate(const Vec<3, T>& offset)
+    {
+        Mat<4, 4, T> ret = Mat<4, 4, T>::Identity();
+        ret[3]           = Vec<4, T>{offset[0], offset[1], offset[2], T(1)};
+        return ret;
+    }
+
+    /**
+     * @brief 缩放矩阵
+     *
+     * @tparam T 元素类型
+     * @param scale 各轴缩放系数
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> Scale(const Vec<3, T>& scale)
+    {
+        Mat<4, 4, T> ret{};
+        ret[0][0] = scale[0];
+        ret[1][1] = scale[1];
+        ret[2][2] = scale[2];
+        ret[3][3] = T(1);
+        return ret;
+    }
+
+    /**
+     * @brief 绕任意轴旋转的矩阵(罗德里格斯公式)
+     *
+     * @tparam T 元素类型
+     * @param radians 旋转角(弧度)，沿轴方向看去为逆时针
+     * @param axis 旋转轴，无需归一化
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> Rotate(const T& radians, const Vec<3, T>& axis)
+    {
+        const Vec<3, T> n   = Normalized(axis);
+        const T         s   = ScalarTraits<T>::Sin(radians);
+        const T         c   = ScalarTraits<T>::Cos(radians);
+        const T         t   = T(1) - c;
+        Mat<4, 4, T>    ret = Mat<4, 4, T>::Identity();
+        ret[0]              = Vec<4, T>{t * n[0] * n[0] + c, t * n[0] * n[1] + s * n[2], t * n[0] * n[2] - s * n[1], T(0)};
+        ret[1]              = Vec<4, T>{t * n[0] * n[1] - s * n[2], t * n[1] * n[1] + c, t * n[1] * n[2] + s * n[0], T(0)};
+        ret[2]              = Vec<4, T>{t * n[0] * n[2] + s * n[1], t * n[1] * n[2] - s * n[0], t * n[2] * n[2] + c, T(0)};
+        return ret;
+    }
+
+    /**
+     * @brief 沿给定朝向观察的观察矩阵(右手系，相机朝向-Z)
+     *
+     * @tparam T 元素类型
+     * @param eye 相机位置
+     * @param forward 朝向，须为单位向量
+     * @param worldUp 参考上方向，不能与朝向平行
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> LookTo(const Vec<3, T>& eye, const Vec<3, T>& forward, const Vec<3, T>& worldUp)
+    {
+        const Vec<3, T> right = Normalized(Cross(forward, worldUp));
+        const Vec<3, T> up    = Cross(right, forward);
+        // 行依次为right、up、-forward，平移为相机位置在各轴上的投影取反
+        Mat<4, 4, T> ret = Mat<4, 4, T>::Identity();
+        ret[0]           = Vec<4, T>{right[0], up[0], -forward[0], T(0)};
+        ret[1]           = Vec<4, T>{right[1], up[1], -forward[1], T(0)};
+        ret[2]           = Vec<4, T>{right[2], up[2], -forward[2], T(0)};
+        ret[3]           = Vec<4, T>{-Dot(right, eye), -Dot(up, eye), Dot(forward, eye), T(1)};
+        return ret;
+    }
+
+    /**
+     * @brief 看向目标点的观察矩阵
+     *
+     * @tparam T 元素类型
+     * @param eye 相机位置
+     * @param target 观察目标
+     * @param worldUp 参考上方向，不能与视线平行
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> LookAt(const Vec<3, T>& eye, const Vec<3, T>& target, const Vec<3, T>& worldUp)
+    {
+        return LookTo(eye, Normalized(target - eye), worldUp);
+    }
+
+    /**
+     * @brief 透视投影矩阵，投影到x、y在[-w, w]、z在[0, w]的裁剪空间
+     *
+     * @tparam T 元素类型
+     * @param fovDegrees 垂直FOV(角度)
+     * @param aspect 宽高比(宽 / 高)
+     * @param near 近平面距离
+     * @param far 远平面距离，infiniteFar时不参与计算
+     * @param reversedZ 近平面映射到1、远平面映射到0
+     * @param infiniteFar 远平面取无穷远
+     * @return Mat<4, 4, T>
+     */
+    template<typename T>
+    constexpr Mat<4, 4, T> Perspective(const T& fovDegrees, const T& aspect, const T& near, const T& far, bool reversedZ = false, bool infiniteFar = false)
+    {
+        // z_clip = depthScale * z_view + depthOffset，w_clip = -z_view
+        T depthScale  = T(0);
+        T depthOffset = T(0);
+        if (infiniteFar)
+        {
+            // far趋于无穷时的极限，避免 far / (near - far) 的精度损失
+            depthScale  = reversedZ ? T(0) : T(-1);
+            depthOffset = reversedZ ? near : -near;
+        }
+        else if (reversedZ)
+        {
+            depthScale  = near / (far - near);
+            depthOffset = near * far / (far - near);
+        }
+        else
+        {
+            depthScale  = far / (near - far);
+            depthOffset = near * far / (near - far);
+        }
+        const T      focal = T(1) / ScalarTraits<T>::Tan(fovDegrees * T(0.5) * T(3.14159265) / T(180));
+        Mat<4, 4, T> ret{};
+        ret[0] = Vec<4, T>{focal / aspect, T(0), T(0), T(0)};
+        ret[1] = Vec<4, T>{T(0), focal, T(0), T(0)};
+        ret[2] = Vec<4, T>{T(0), T(0), depthScale, T(-1)};
+        ret[3] = Vec<4, T>{T(0), T(0), depthOffset, T(0)};
+        return ret;
+    }
+
+    /**
+     * @brief 正交投影矩阵，深度线性映射到[0, 1]
+     *
+     * @tparam T 元素类型
+     * @param halfHeight 视口半高
+     * @param aspect 宽高比(宽 / 高)
+     * @param near 近平面距离
+     * @param far 远平面距离
+     * @param reversedZ 近平面映射到1、远平面映射到0
+     * @return Mat<4, 4, T>
+     */
+    template<typename T> constexpr Mat<4, 4, T> Orthographic(const T& halfHeight, const T& aspect, const T& near, const T& far, bool reversedZ = false)
+    {
+        const T      invDepthRange = T(1) / (far - near);
+        Mat<4, 4, T> ret{};
+        ret[0] = Vec<4, T>{T(1) / (halfHeight * aspect), T(0), T(0), T(0)};
+        ret[1] = Vec<4, T>{T(0), T(1) / halfHeight, T(0), T(0)};
+        ret[2] = Vec<4, T>{T(0), T(0), reversedZ ? invDepthRange : -invDepthRange, T(0)};
+        ret[3] = Vec<4, T>{T(0), T(0), reversedZ ? far * invDepthRange : -near * invDepthRange, T(1)};
+        return ret;
+    }
+}   // namespace Joy
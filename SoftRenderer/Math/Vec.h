@@ -11,15 +11,19 @@
 
 #pragma once
 
+#include "Scalar.h"
 #include <cassert>
 #include <cmath>
 #include <ostream>
+#include <type_traits>
 
 namespace Joy
 {
     /**
      * @brief N维向量模板
      *
+     * 元素类型可为float、double、整数或定点数(Fixed)，比较容差与开方由ScalarTraits<T>决定。
+     *
      * @tparam N
      * @tparam T
      */
@@ -32,10 +36,21 @@ namespace Joy
         {
             for (int i = 0; i < N; ++i)
             {
-                m_Data[i] = 0.f;
+                m_Data[i] = T(0);
             }
         }
 
+        /**
+         * @brief 逐分量构造，参数个数须等于维度
+         *
+         * @tparam TArgs 可转换为T的类型
+         * @param args
+         */
+        template<typename... TArgs, typename = std::enable_if_t<sizeof...(TArgs) == N && (std::is_convertible_v<TArgs, T> && ...)>>
+        constexpr Vec(TArgs... args)
+            : m_Data{static_cast<T>(args)...}
+        {}
+
     public:
         /**
          * @brief 获取N维向量指定维度的值 - 只读取版本
@@ -93,7 +108,7 @@ namespace Joy
     {
         for (int i = 0; i < N; ++i)
         {
-            if (std::abs(lhs[i] - rhs[i]) >= 1e-5f)
+            if (!NearlyEqual(lhs[i], rhs[i]))
             {
                 return false;
             }
@@ -217,7 +232,7 @@ namespace Joy
      */
     template<int N, typename T> constexpr Vec<N, T> operator/(const Vec<N, T>& lhs, const T& scale)
     {
-        assert(scale != 0.f);
+        assert(scale != T(0));
         Vec<N, T> ret = lhs;
         for (int i = 0; i < N; ++i)
         {
@@ -226,6 +241,46 @@ namespace Joy
         return ret;
     }
 
+    /**
+     * @brief 融合乘加 a * scale + b，单次循环完成，不产生中间向量
+     *
+     * @tparam N 向量维度
+     * @tparam T 向量元素类型
+     * @param a 被缩放向量
+     * @param scale 缩放系数
+     * @param b 累加向量
+     * @return constexpr Vec<N, T>
+     */
+    template<int N, typename T> constexpr Vec<N, T> MulAdd(const Vec<N, T>& a, const T& scale, const Vec<N, T>& b)
+    {
+        Vec<N, T> ret = b;
+        for (int i = 0; i < N; ++i)
+        {
+            ret[i] += a[i] * scale;
+        }
+        return ret;
+    }
+
+    /**
+     * @brief 线性插值 from + (to - from) * t，单次循环完成
+     *
+     * @tparam N 向量维度
+     * @tparam T 向量元素类型
+     * @param from 起点
+     * @param to 终点
+     * @param t 插值系数
+     * @return constexpr Vec<N, T>
+     */
+    template<int N, typename T> constexpr Vec<N, T> Lerp(const Vec<N, T>& from, const Vec<N, T>& to, const T& t)
+    {
+        Vec<N, T> ret = from;
+        for (int i = 0; i < N; ++i)
+        {
+            ret[i] += (to[i] - from[i]) * t;
+        }
+        return ret;
+    }
+
     /**
      * @brief 向量点积
      *
@@ -237,7 +292,7 @@ namespace Joy
      */
     template<int N, typename T> constexpr T Dot(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
     {
-        T ret = 0;
+        T ret = T(0);
         for (int i = 0; i < N; ++i)
         {
             ret += lhs[i] * rhs[i];
@@ -268,7 +323,7 @@ namespace Joy
      */
     template<int N, typename T> constexpr T Norm(const Vec<N, T>& vec)
     {
-        return std::sqrt(SqrNorm(vec));
+        return ScalarTraits<T>::Sqrt(SqrNorm(vec));
     }
 
     /**
@@ -282,13 +337,32 @@ namespace Joy
     template<int N, typename T> constexpr Vec<N, T> Normalized(const Vec<N, T>& vec)
     {
         T norm = Norm(vec);
-        if (norm == 0.f)
+        if (norm == T(0))
         {
             return Vec<N, T>::Zero();
         }
         return vec / norm;
     }
 
+    /**
+     * @brief 逐分量转换向量元素类型
+     *
+     * @tparam TTo 目标元素类型
+     * @tparam N 向量维度
+     * @tparam TFrom 源元素类型
+     * @param vec
+     * @return Vec<N, TTo>
+     */
+    template<typename TTo, int N, typename TFrom> constexpr Vec<N, TTo> VecCast(const Vec<N, TFrom>& vec)
+    {
+        Vec<N, TTo> ret{};
+        for (int i = 0; i < N; ++i)
+        {
+            ret[i] = static_cast<TTo>(vec[i]);
+        }
+        return ret;
+    }
+
     /**
      * @brief 打印N维向量
      *
@@ -322,8 +396,8 @@ namespace Joy
     {
     public:
         constexpr Vec(float x = 0.f, float y = 0.f)
-            : m_X(0.f)
-            , m_Y(0.f)
+            : m_X(x)
+            , m_Y(y)
         {}
 
     public:
@@ -456,6 +530,10 @@ namespace Joy
         float m_Z = 0.f;
         float m_W = 0.f;
 
+    public:
+        constexpr static Vec<4, float> Zero() { return Vec<4, float>(); }
+        constexpr static Vec<4, float> One() { return Vec<4, float>(1.f, 1.f, 1.f, 1.f); }
+
     public:
         constexpr static int DIMENSION = 4;
     };
@@ -478,6 +556,27 @@ namespace Joy
      */
     using Vec4f = Vec<4, float>;
 
+    /**
+     * @brief 双精度向量别名，用于远离原点的大世界坐标
+     *
+     */
+    using Vec2d = Vec<2, double>;
+    using Vec3d = Vec<3, double>;
+    using Vec4d = Vec<4, double>;
+
+    /**
+     * @brief 三维向量叉积 - 通用版本
+     *
+     * @tparam T 向量元素类型
+     * @param lhs
+     * @param rhs
+     * @return Vec<3, T>
+     */
+    template<typename T> constexpr Vec<3, T> Cross(const Vec<3, T>& lhs, const Vec<3, T>& rhs)
+    {
+        return Vec<3, T>{lhs[1] * rhs[2] - lhs[2] * rhs[1], lhs[2] * rhs[0] - lhs[0] * rhs[2], lhs[0] * rhs[1] - lhs[1] * rhs[0]};
+    }
+
     /**
      * @brief 二维浮点向量叉积 - 扩展
      *
@@ -485,7 +584,7 @@ namespace Joy
      * @param rhs
      * @return float
      */
-    inline float Cross(const Vec2f& lhs, const Vec2f& rhs)
+    constexpr float Cross(const Vec2f& lhs, const Vec2f& rhs)
     {
         return lhs.X() * rhs.Y() - lhs.Y() * rhs.X();
     }
@@ -497,7 +596,7 @@ namespace Joy
      * @param rhs
      * @return Vec3f
      */
-    inline Vec3f Cross(const Vec3f& lhs, const Vec3f& rhs)
+    constexpr Vec3f Cross(const Vec3f& lhs, const Vec3f& rhs)
     {
         return Vec3f{lhs.Y() * rhs.Z() - lhs.Z() * rhs.Y(), lhs.Z() * rhs.X() - lhs.X() * rhs.Z(), lhs.X() * rhs.Y() - lhs.Y() * rhs.X()};
     }
@@ -0,0 +1,138 @@
+
+#include "Core/Camera.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        static Vec3f Project(const Mat4x4f& mat, const Vec3f& position)
+        {
+            const Vec4f clip = mat * Vec4f{position.X(), position.Y(), position.Z(), 1.f};
+            return Vec3f{clip[0], clip[1], clip[2]} / clip[3];
+        }
+
+        TEST(CameraTest, ViewMatrixTest)
+        {
+            Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{1.f, 2.f, 3.f}, Vec3f{1.f, 2.f, -7.f});
+            // 相机位置映射到原点，朝向映射到-Z
+            EXPECT_EQ(Project(camera.GetViewMatrix(), Vec3f(1.f, 2.f, 3.f)), Vec3f(0.f, 0.f, 0.f));
+            EXPECT_EQ(Project(camera.GetViewMatrix(), Vec3f(1.f, 2.f, -2.f)), Vec3f(0.f, 0.f, -5.f));
+            EXPECT_EQ(Project(camera.GetViewMatrix(), Vec3f(2.f, 3.f, 3.f)), Vec3f(1.f, 1.f, 0.f));
+            // 竖直朝向时仍能得到正交基
+            camera.SetLookPosition(Vec3f{1.f, -5.f, 3.f});
+            EXPECT_EQ(Project(camera.GetViewMatrix(), Vec3f(1.f, 0.f, 3.f)), Vec3f(0.f, 0.f, -2.f));
+            EXPECT_NEAR(Determinant(camera.GetViewMatrix()), 1.f, 1e-5f);
+        }
+
+        TEST(CameraTest, ProjectionMatrixTest)
+        {
+            Camera perspective(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 1.f, 100.f, 90.f);
+            perspective.SetAspect(2.f);
+            const Mat4x4f viewProj = perspective.GetViewProjMatrix();
+            EXPECT_NEAR(Project(viewProj, Vec3f(0.f, 0.f, -1.f))[2], 0.f, 1e-6f);
+            EXPECT_NEAR(Project(viewProj, Vec3f(0.f, 0.f, -100.f))[2], 1.f, 1e-5f);
+            // 90度FOV: 距离d处的视口半高为d，宽高比2时半宽为2d
+            EXPECT_NEAR(Project(viewProj, Vec3f(20.f, 10.f, -10.f))[0], 1.f, 1e-5f);
+            EXPECT_NEAR(Project(viewProj, Vec3f(20.f, 10.f, -10.f))[1], 1.f, 1e-5f);
+
+            Camera ortho(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 10.f, 0.f}, Vec3f{0.f, 0.f, 0.f}, 0.f, 20.f, 5.f);
+            const Mat4x4f orthoViewProj = ortho.GetViewProjMatrix();
+            EXPECT_NEAR(Project(orthoViewProj, Vec3f(0.f, 10.f, 0.f))[2], 0.f, 1e-6f);
+            EXPECT_NEAR(Project(orthoViewProj, Vec3f(0.f, 0.f, 0.f))[2], 0.5f, 1e-6f);
+            EXPECT_NEAR(Project(orthoViewProj, Vec3f(0.f, -10.f, 0.f))[2], 1.f, 1e-6f);
+            EXPECT_NEAR(std::abs(Project(orthoViewProj, Vec3f(5.f, 0.f, 0.f))[0]), 1.f, 1e-6f);
+            EXPECT_EQ(ortho.GetProjMatrix()[3][3], 1.f);
+        }
+        TEST(CameraTest, DepthRangeTest)
+        {
+            Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 10000.f, 60.f);
+            const Vec3f near{0.f, 0.f, -0.1f};
+            const Vec3f middle{0.f, 0.f, -100.f};
+            const Vec3f far{0.f, 0.f, -10000.f};
+            EXPECT_EQ(camera.GetFarDepth(), 1.f);
+            const float standardMiddle = Project(camera.GetViewProjMatrix(), middle)[2];
+
+            // 反向Z: 近处为1，远处为0，深度顺序翻转
+            camera.SetDepthRange(Camera::EnumDepthRange::REVERSED);
+            EXPECT_EQ(camera.GetFarDepth(), 0.f);
+            EXPECT_NEAR(Project(camera.GetViewProjMatrix(), near)[2], 1.f, 1e-5f);
+            EXPECT_NEAR(Project(camera.GetViewProjMatrix(), far)[2], 0.f, 1e-5f);
+            EXPECT_NEAR(Project(camera.GetViewProjMatrix(), middle)[2], 1.f - standardMiddle, 1e-4f);
+            EXPECT_GT(Project(camera.GetViewProjMatrix(), Vec3f(0.f, 0.f, -999.f))[2], Project(camera.GetViewProjMatrix(), Vec3f(0.f, 0.f, -1000.f))[2]);
+
+            // 无穷远平面: 远平面之外仍在深度范围内
+            camera.SetInfiniteFar(true);
+            EXPECT_NEAR(Project(camera.GetViewProjMatrix(), near)[2], 1.f, 1e-5f);
+            EXPECT_GT(Project(camera.GetViewProjMatrix(), Vec3f(0.f, 0.f, -1e6f))[2], 0.f);
+            camera.SetDepthRange(Camera::EnumDepthRange::STANDARD);
+            EXPECT_NEAR(Project(camera.GetViewProjMatrix(), near)[2], 0.f, 1e-5f);
+            EXPECT_LT(Project(camera.GetViewProjMatrix(), Vec3f(0.f, 0.f, -1e6f))[2], 1.f);
+
+            // 正交相机的反向Z
+            Camera ortho(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 1.f, 11.f, 5.f);
+            ortho.SetDepthRange(Camera::EnumDepthRange::REVERSED);
+            EXPECT_NEAR(Project(ortho.GetViewProjMatrix(), Vec3f(0.f, 0.f, -1.f))[2], 1.f, 1e-6f);
+            EXPECT_NEAR(Project(ortho.GetViewProjMatrix(), Vec3f(0.f, 0.f, -6.f))[2], 0.5f, 1e-6f);
+            EXPECT_NEAR(Project(ortho.GetViewProjMatrix(), Vec3f(0.f, 0.f, -11.f))[2], 0.f, 1e-6f);
+
+            // 视锥截面四角
+            Vec3f corners[4];
+            camera.SetAspect(2.f);
+            camera.GetFrustumCorners(10.f, corners);
+            const float halfHeight = 10.f * std::tan(30.f * 3.14159265f / 180.f);
+            EXPECT_EQ(corners[0], Vec3f(-2.f * halfHeight, -halfHeight, -10.f));
+            EXPECT_EQ(corners[3], Vec3f(2.f * halfHeight, halfHeight, -10.f));
+        }
+
+        TEST(CameraTest, CameraRelativeTest)
+        {
+            // 距原点数万单位的相机与物体，物体位于相机前方约10单位
+            const Vec3d cameraPosition{30000.123, 12.5, -45000.789};
+            const Vec3d offset{1.5, 0.25, -10.0};
+            Camera      camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 100.f, 60.f);
+            camera.SetWorldPosition(cameraPosition);
+            camera.SetWorldLookPosition(cameraPosition + Vec3d{0.3, -0.1, -1.0});
+            EXPECT_EQ(camera.GetWorldPosition(), cameraPosition);
+            EXPECT_EQ(camera.ToCameraRelative(cameraPosition + offset), Vec3f(1.5f, 0.25f, -10.f));
+
+            // 参照: 位于原点、朝向相同的相机，物体直接放在相对位置
+            const Camera reference(Camera::EnumCameraType::PERSPECTIVE, Vec3f{}, Vec3f{0.3f, -0.1f, -1.f}, 0.1f, 100.f, 60.f);
+            EXPECT_EQ(camera.GetRelativeViewMatrix(), reference.GetViewMatrix());
+            // 朝向与观察矩阵同样在双精度下求得，不受单精度位置舍入的影响
+            EXPECT_EQ(camera.GetForward(), reference.GetForward());
+            const Mat4x4f& view = camera.GetViewMatrix();
+            EXPECT_NEAR(camera.GetForward().X(), -view[0][2], 1e-6f);
+            EXPECT_NEAR(camera.GetForward().Y(), -view[1][2], 1e-6f);
+            EXPECT_NEAR(camera.GetForward().Z(), -view[2][2], 1e-6f);
+
+            Mat4x4d worldModel = Mat4x4d::Identity() * 2.0;
+            worldModel[3]      = Vec4d{cameraPosition[0] + offset[0], cameraPosition[1] + offset[1], cameraPosition[2] + offset[2], 1.0};
+            Mat4x4f referenceModel = Mat4x4f::Identity() * 2.f;
+            referenceModel[3]      = Vec4f{1.5f, 0.25f, -10.f, 1.f};
+            EXPECT_EQ(camera.GetRelativeModelMatrix(worldModel), referenceModel);
+
+            const Mat4x4f relativeMvp  = camera.GetRelativeModelViewProjMatrix(worldModel);
+            const Mat4x4f referenceMvp = reference.GetViewProjMatrix() * referenceModel;
+            const Mat4x4f absoluteMvp  = camera.GetViewProjMatrix() * MatCast<float>(worldModel);
+            float         relativeError = 0.f;
+            float         absoluteError = 0.f;
+            for (const Vec3f& local : {Vec3f{0.f, 0.f, 0.f}, Vec3f{0.001f, 0.f, 0.f}, Vec3f{0.f, 0.002f, 0.001f}, Vec3f{-0.5f, 0.5f, 0.25f}})
+            {
+                const Vec3f expected = Project(referenceMvp, local);
+                const Vec3f relative = Project(relativeMvp, local);
+                const Vec3f absolute = Project(absoluteMvp, local);
+                for (int i = 0; i < 2; ++i)
+                {
+                    relativeError = std::max(relativeError, std::abs(relative[i] - expected[i]));
+                    absoluteError = std::max(absoluteError, std::abs(absolute[i] - expected[i]));
+                }
+            }
+            // 相机相对路径与原点处渲染一致；单精度绝对坐标路径的舍入误差达到毫米级，表现为顶点抖动
+            EXPECT_LT(relativeError, 1e-5f);
+            EXPECT_GT(absoluteError, 1e-4f);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
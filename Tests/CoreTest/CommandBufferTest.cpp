@@ -0,0 +1,300 @@
+
+#include "Core/CommandBuffer.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 返回mvp * position，输出固定颜色
+         *
+         */
+        struct FlatColorShader
+        {
+            constexpr static int VARYING_COUNT = 0;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float*) const
+            {
+                return mvp * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float*) const { return color; }
+
+            Vec4f   color;
+            Mat4x4f mvp = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 包围原点的正方体
+         *
+         */
+        static Mesh MakeCube(float halfSize)
+        {
+            Mesh mesh;
+            for (int i = 0; i < 8; ++i)
+            {
+                const Vec3f position{(i & 1) ? halfSize : -halfSize, (i & 2) ? halfSize : -halfSize, (i & 4) ? halfSize : -halfSize};
+                mesh.vertices.push_back(Joy::Vertex{position, Vec3f{}, Vec2f{}});
+            }
+            mesh.indices = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+            return mesh;
+        }
+
+        /**
+         * @brief 场景: 两种网格、两种着色器交替的随机物体
+         *
+         */
+        struct CommandScene
+        {
+            CommandScene()
+                : camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 100.f, 60.f)
+                , meshes{MakeCube(0.5f), MakeCube(0.3f)}
+                , shaders{FlatColorShader{Vec4f{1.f, 0.f, 0.f, 1.f}}, FlatColorShader{Vec4f{0.f, 0.f, 1.f, 1.f}}}
+            {
+                std::mt19937                          random(20251224u);
+                std::uniform_real_distribution<float> unit(-1.f, 1.f);
+                for (int i = 0; i < OBJECT_COUNT; ++i)
+                {
+                    Mat4x4f model = MAT4X4F_IDENTITY;
+                    model[3]      = Vec4f{unit(random) * 6.f, unit(random) * 4.f, -10.f + unit(random) * 6.f, 1.f};
+                    models.push_back(model);
+                }
+            }
+
+            const Mesh&            GetMesh(int i) const { return meshes[i % 2]; }
+            const FlatColorShader& GetShader(int i) const { return shaders[(i / 2) % 2]; }
+
+            constexpr static int OBJECT_COUNT = 160;
+
+            Camera               camera;
+            Mesh                 meshes[2];
+            FlatColorShader      shaders[2];
+            std::vector<Mat4x4f> models;
+        };
+
+        /**
+         * @brief 以threadCount个线程并行录制，第t个线程录制下标与t同余的物体
+         *
+         */
+        static std::vector<CommandBuffer> RecordParallel(const CommandScene& scene, int threadCount)
+        {
+            std::vector<CommandBuffer> buffers(threadCount);
+            std::vector<std::thread>   threads;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&scene, &buffers, t, threadCount] {
+                    CommandBuffer& buffer = buffers[t];
+                    buffer.SetCamera(scene.camera);
+                    for (int i = t; i < CommandScene::OBJECT_COUNT; i += threadCount)
+                    {
+                        buffer.BindMesh(scene.GetMesh(i));
+                        buffer.BindShader(scene.GetShader(i));
+                        buffer.Draw(scene.models[i]);
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+            return buffers;
+        }
+
+        static void ExpectSameImage(const Renderer& lhs, const Renderer& rhs)
+        {
+            for (int y = 0; y < lhs.GetHeight(); ++y)
+            {
+                for (int x = 0; x < lhs.GetWidth(); ++x)
+                {
+                    ASSERT_EQ(lhs.GetFrameBuffer().GetColor(x, y), rhs.GetFrameBuffer().GetColor(x, y)) << x << ", " << y;
+                    ASSERT_EQ(lhs.GetFrameBuffer().GetDepth(x, y), rhs.GetFrameBuffer().GetDepth(x, y)) << x << ", " << y;
+                }
+            }
+        }
+
+        TEST(CommandBufferTest, ParallelRecordTest)
+        {
+            constexpr int      WIDTH  = 160;
+            constexpr int      HEIGHT = 120;
+            const CommandScene scene;
+
+            // 参考结果: 按原始顺序立即绘制
+            Renderer reference(WIDTH, HEIGHT);
+            reference.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            const Mat4x4f viewProj = scene.camera.GetViewProjMatrix();
+            for (int i = 0; i < CommandScene::OBJECT_COUNT; ++i)
+            {
+                FlatColorShader shader = scene.GetShader(i);
+                shader.mvp             = viewProj * scene.models[i];
+                reference.Draw(scene.GetMesh(i), shader);
+            }
+
+            // 回放结果与线程数无关，且与立即绘制逐像素一致
+            for (int threadCount : {1, 3, 4})
+            {
+                const std::vector<CommandBuffer> buffers = RecordParallel(scene, threadCount);
+                CommandQueue                     queue;
+                for (const CommandBuffer& buffer : buffers)
+                {
+                    queue.Submit(buffer);
+                }
+                Renderer renderer(WIDTH, HEIGHT);
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                queue.Execute(renderer);
+
+                // 2种网格 x 2种着色器，合并为4个批次
+                ASSERT_EQ(queue.GetBatches().size(), 4u);
+                EXPECT_EQ(queue.GetBatchModels().size(), static_cast<size_t>(CommandScene::OBJECT_COUNT));
+                ExpectSameImage(renderer, reference);
+            }
+        }
+
+        TEST(CommandBufferTest, SortTest)
+        {
+            const CommandScene scene;
+            CommandBuffer      buffer;
+            Camera             shadowCamera(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 10.f, 0.f}, Vec3f{0.f, 0.f, -10.f}, 0.1f, 50.f, 10.f);
+            buffer.SetCamera(scene.camera);
+            buffer.BindShader(scene.shaders[1]);
+            buffer.BindMesh(scene.meshes[0]);
+            for (int i = 0; i < 8; ++i)
+            {
+                buffer.Draw(scene.models[i]);
+            }
+            buffer.SetCamera(shadowCamera);
+            buffer.Draw(scene.models[8]);
+            buffer.SetCamera(scene.camera);
+            buffer.BindShader(scene.shaders[0]);
+            buffer.BindMesh(scene.meshes[1]);
+            buffer.Draw(scene.models[9]);
+            buffer.BindMesh(scene.meshes[0]);
+            buffer.Draw(scene.models[10]);
+            EXPECT_EQ(buffer.GetDrawCount(), 11u);
+
+            CommandQueue queue;
+            queue.Submit(buffer);
+            Renderer renderer(64, 64);
+            queue.Execute(renderer);
+
+            // 相机、着色器、网格按首次出现顺序编号分组，第二次设置的主相机并入第一个相机，meshes[0]先于meshes[1]出现
+            const std::vector<CommandQueue::Batch>& batches = queue.GetBatches();
+            ASSERT_EQ(batches.size(), 4u);
+            EXPECT_EQ(batches[0].shader.shader, &scene.shaders[1]);
+            EXPECT_EQ(batches[0].modelCount, 8);
+            EXPECT_EQ(batches[1].shader.shader, &scene.shaders[0]);
+            EXPECT_EQ(batches[1].mesh, &scene.meshes[0]);
+            EXPECT_EQ(batches[2].shader.shader, &scene.shaders[0]);
+            EXPECT_EQ(batches[2].mesh, &scene.meshes[1]);
+            EXPECT_EQ(batches[3].viewProj, shadowCamera.GetViewProjMatrix());
+
+            // 批次内由近及远
+            const std::vector<Mat4x4f>& models = queue.GetBatchModels();
+            for (int i = 1; i < batches[0].modelCount; ++i)
+            {
+                EXPECT_GE(-models[i][3][2], -models[i - 1][3][2]);
+            }
+        }
+
+        TEST(CommandBufferTest, CameraMergeTest)
+        {
+            // 观察投影矩阵相差远小于1e-5的两个相机也不合并，各自的绘制使用自己的矩阵
+            const CommandScene scene;
+            Camera             nudged = scene.camera;
+            nudged.SetPosition(Vec3f{2e-6f, 0.f, 0.f});
+            const Mat4x4f lhs = scene.camera.GetViewProjMatrix();
+            const Mat4x4f rhs = nudged.GetViewProjMatrix();
+            ASSERT_TRUE(lhs == rhs);
+            ASSERT_NE(std::memcmp(&lhs[0][0], &rhs[0][0], sizeof(Mat4x4f)), 0);
+
+            CommandBuffer buffer;
+            buffer.BindShader(scene.shaders[0]);
+            buffer.BindMesh(scene.meshes[0]);
+            buffer.SetCamera(scene.camera);
+            buffer.Draw(scene.models[0]);
+            buffer.SetCamera(nudged);
+            buffer.Draw(scene.models[1]);
+            buffer.SetCamera(nudged);
+            buffer.Draw(scene.models[2]);
+            EXPECT_EQ(buffer.GetCameras().size(), 2u);
+
+            CommandBuffer other;
+            other.BindShader(scene.shaders[0]);
+            other.BindMesh(scene.meshes[0]);
+            other.SetCamera(scene.camera);
+            other.Draw(scene.models[3]);
+            CommandQueue queue;
+            queue.Submit(buffer);
+            queue.Submit(other);
+            Renderer renderer(64, 64);
+            queue.Execute(renderer);
+            const std::vector<CommandQueue::Batch>& batches = queue.GetBatches();
+            ASSERT_EQ(batches.size(), 2u);
+            EXPECT_EQ(std::memcmp(&batches[0].viewProj[0][0], &lhs[0][0], sizeof(Mat4x4f)), 0);
+            EXPECT_EQ(batches[0].modelCount, 2);
+            EXPECT_EQ(std::memcmp(&batches[1].viewProj[0][0], &rhs[0][0], sizeof(Mat4x4f)), 0);
+            EXPECT_EQ(batches[1].modelCount, 2);
+        }
+
+        TEST(CommandBufferTest, CachedListTest)
+        {
+            constexpr int      WIDTH  = 96;
+            constexpr int      HEIGHT = 64;
+            const CommandScene scene;
+
+            // 静态命令列表录制一次，每帧与动态命令列表一起重新提交
+            CommandBuffer staticList;
+            staticList.SetCamera(scene.camera);
+            staticList.BindShader(scene.shaders[0]);
+            staticList.BindMesh(scene.meshes[0]);
+            for (int i = 0; i < CommandScene::OBJECT_COUNT / 2; ++i)
+            {
+                staticList.Draw(scene.models[i]);
+            }
+
+            CommandQueue  queue;
+            CommandBuffer dynamicList;
+            Renderer      renderer(WIDTH, HEIGHT);
+            Renderer      first(WIDTH, HEIGHT);
+            for (int frame = 0; frame < 3; ++frame)
+            {
+                dynamicList.Reset();
+                dynamicList.SetCamera(scene.camera);
+                dynamicList.BindShader(scene.shaders[1]);
+                dynamicList.BindMesh(scene.meshes[1]);
+                dynamicList.Draw(scene.models[CommandScene::OBJECT_COUNT / 2 + frame]);
+
+                queue.Submit(staticList);
+                queue.Submit(dynamicList);
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                queue.Execute(renderer);
+                EXPECT_EQ(queue.GetBatchModels().size(), static_cast<size_t>(CommandScene::OBJECT_COUNT / 2 + 1));
+                if (frame == 0)
+                {
+                    first.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                    queue.Submit(staticList);
+                    queue.Submit(dynamicList);
+                    queue.Execute(first);
+                }
+            }
+            EXPECT_EQ(staticList.GetDrawCount(), static_cast<size_t>(CommandScene::OBJECT_COUNT / 2));
+
+            // 重复提交不改变命令列表
+            Renderer again(WIDTH, HEIGHT);
+            again.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            dynamicList.Reset();
+            dynamicList.SetCamera(scene.camera);
+            dynamicList.BindShader(scene.shaders[1]);
+            dynamicList.BindMesh(scene.meshes[1]);
+            dynamicList.Draw(scene.models[CommandScene::OBJECT_COUNT / 2]);
+            queue.Submit(staticList);
+            queue.Submit(dynamicList);
+            queue.Execute(again);
+            ExpectSameImage(again, first);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
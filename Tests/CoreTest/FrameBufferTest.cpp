@@ -0,0 +1,149 @@
+
+#include "Core/FrameBuffer.h"
+#include "Core/PixelFormat.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        TEST(FrameBufferTest, HalfConversionTest)
+        {
+            // 精确可表示的值往返不变
+            EXPECT_EQ(HalfToFloat(FloatToHalf(0.f)), 0.f);
+            EXPECT_EQ(HalfToFloat(FloatToHalf(1.f)), 1.f);
+            EXPECT_EQ(HalfToFloat(FloatToHalf(-2.5f)), -2.5f);
+            EXPECT_EQ(FloatToHalf(1.f), 0x3c00);
+            EXPECT_EQ(FloatToHalf(65504.f), 0x7bff);
+            // 溢出、非规格化数
+            EXPECT_EQ(FloatToHalf(1e6f), 0x7c00);
+            EXPECT_EQ(FloatToHalf(-1e6f), 0xfc00);
+            EXPECT_NEAR(HalfToFloat(FloatToHalf(1e-6f)), 1e-6f, 1e-7f);
+            EXPECT_NEAR(HalfToFloat(FloatToHalf(0.3333f)), 0.3333f, 1e-3f);
+        }
+
+        TEST(FrameBufferTest, ColorFormatTest)
+        {
+            const Vec4f colors[5] = {
+                Vec4f{0.f, 0.25f, 0.5f, 1.f},
+                Vec4f{1.f, 0.75f, 0.125f, 0.5f},
+                Vec4f{2.f, -1.f, 0.f, 0.f},
+                Vec4f{0.1f, 0.2f, 0.3f, 0.4f},
+                Vec4f{0.9f, 0.8f, 0.7f, 0.6f},
+            };
+            for (EnumColorFormat format : {EnumColorFormat::RGBA8, EnumColorFormat::R11G11B10F, EnumColorFormat::RGBA16F, EnumColorFormat::SRGBA8})
+            {
+                // 批量SIMD打包与逐像素打包结果一致
+                uint8_t batch[5 * 8]  = {};
+                uint8_t single[5 * 8] = {};
+                PackColors(format, colors, 5, batch);
+                for (int i = 0; i < 5; ++i)
+                {
+                    PackColor(format, colors[i], single + i * GetBytesPerPixel(format));
+                }
+                for (int i = 0; i < 5 * GetBytesPerPixel(format); ++i)
+                {
+                    EXPECT_EQ(batch[i], single[i]);
+                }
+                Vec4f unpacked[5];
+                UnpackColors(format, batch, 5, unpacked);
+                for (int i = 0; i < 5; ++i)
+                {
+                    EXPECT_EQ(UnpackColor(format, single + i * GetBytesPerPixel(format)), unpacked[i]);
+                }
+            }
+            // RGBA8钳制到[0, 1]
+            uint8_t rgba8[4];
+            PackColor(EnumColorFormat::RGBA8, colors[2], rgba8);
+            EXPECT_EQ(rgba8[0], 255);
+            EXPECT_EQ(rgba8[1], 0);
+            // R11G11B10F为无符号且无Alpha
+            Vec4f hdr = Vec4f{4.f, 0.5f, -3.f, 0.f};
+            uint8_t packed[4];
+            PackColor(EnumColorFormat::R11G11B10F, hdr, packed);
+            EXPECT_EQ(UnpackColor(EnumColorFormat::R11G11B10F, packed), Vec4f(4.f, 0.5f, 0.f, 1.f));
+            // SRGBA8只对RGB做sRGB编码，编码值往返不变
+            PackColor(EnumColorFormat::SRGBA8, Vec4f{0.5f, 0.f, 1.f, 0.5f}, packed);
+            EXPECT_EQ(packed[0], 188);
+            EXPECT_EQ(packed[2], 255);
+            EXPECT_EQ(packed[3], 128);
+            uint8_t repacked[4];
+            PackColor(EnumColorFormat::SRGBA8, UnpackColor(EnumColorFormat::SRGBA8, packed), repacked);
+            EXPECT_EQ(std::memcmp(packed, repacked, 4), 0);
+        }
+
+        TEST(FrameBufferTest, DepthFormatTest)
+        {
+            EXPECT_EQ(PackDepth(EnumDepthFormat::D16, 1.f), 0xffffu);
+            EXPECT_EQ(PackDepth(EnumDepthFormat::D24, 1.f), 0xffffffu);
+            EXPECT_EQ(UnpackDepth(EnumDepthFormat::D32F, PackDepth(EnumDepthFormat::D32F, 0.123456f)), 0.123456f);
+            EXPECT_NEAR(UnpackDepth(EnumDepthFormat::D16, PackDepth(EnumDepthFormat::D16, 0.3f)), 0.3f, 1.f / 65535.f);
+            EXPECT_NEAR(UnpackDepth(EnumDepthFormat::D24, PackDepth(EnumDepthFormat::D24, 0.3f)), 0.3f, 1.f / 16777215.f);
+        }
+
+        TEST(FrameBufferTest, FastClearTest)
+        {
+            FrameBuffer frameBuffer{40, 20, EnumColorFormat::RGBA16F, EnumDepthFormat::D24};
+            EXPECT_EQ(frameBuffer.GetTileCountX(), 3);
+            EXPECT_EQ(frameBuffer.GetTileCountY(), 2);
+            frameBuffer.ClearColor(Vec4f{0.5f, 0.25f, 1.f, 1.f});
+            frameBuffer.ClearDepth(1.f);
+            EXPECT_TRUE(frameBuffer.IsColorTileCleared(0, 0));
+            EXPECT_EQ(frameBuffer.GetColor(39, 19), Vec4f(0.5f, 0.25f, 1.f, 1.f));
+            // 写入只让所在分块落地，其余分块保持清除状态
+            frameBuffer.SetColor(17, 3, Vec4f{1.f, 0.f, 0.f, 1.f});
+            frameBuffer.SetDepth(17, 3, 0.5f);
+            EXPECT_FALSE(frameBuffer.IsColorTileCleared(1, 0));
+            EXPECT_FALSE(frameBuffer.IsDepthTileCleared(1, 0));
+            EXPECT_TRUE(frameBuffer.IsColorTileCleared(0, 0));
+            EXPECT_TRUE(frameBuffer.IsDepthTileCleared(2, 1));
+            EXPECT_EQ(frameBuffer.GetColor(17, 3), Vec4f(1.f, 0.f, 0.f, 1.f));
+            EXPECT_EQ(frameBuffer.GetColor(16, 0), Vec4f(0.5f, 0.25f, 1.f, 1.f));
+            EXPECT_NEAR(frameBuffer.GetDepth(17, 3), 0.5f, 1e-6f);
+            EXPECT_EQ(frameBuffer.GetDepth(18, 3), 1.f);
+            // 跨分块的连续写入
+            Vec4f span[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                span[i] = Vec4f{i / 8.f, 0.f, 0.f, 1.f};
+            }
+            frameBuffer.SetColorSpan(28, 18, 8, span);
+            EXPECT_FALSE(frameBuffer.IsColorTileCleared(1, 1));
+            EXPECT_FALSE(frameBuffer.IsColorTileCleared(2, 1));
+            EXPECT_EQ(frameBuffer.GetColor(35, 18), span[7]);
+            EXPECT_EQ(frameBuffer.GetColor(35, 17), Vec4f(0.5f, 0.25f, 1.f, 1.f));
+            // 落地所有清除
+            frameBuffer.ResolveFastClear();
+            EXPECT_FALSE(frameBuffer.IsColorTileCleared(0, 0));
+            EXPECT_EQ(frameBuffer.GetColor(0, 0), Vec4f(0.5f, 0.25f, 1.f, 1.f));
+            EXPECT_EQ(frameBuffer.GetDepth(0, 0), 1.f);
+        }
+
+        TEST(FrameBufferTest, ExternalColorStorageTest)
+        {
+            FrameBuffer          frameBuffer(40, 20, EnumColorFormat::RGBA8);
+            std::vector<uint8_t> storage(static_cast<size_t>(frameBuffer.GetColorPitch()) * frameBuffer.GetHeight(), 0xCD);
+            frameBuffer.SetDepth(3, 3, 0.25f);
+            frameBuffer.BindColorStorage(storage.data());
+            EXPECT_EQ(frameBuffer.GetColorData(), storage.data());
+            // 绑定后颜色回到清除状态，深度不受影响
+            EXPECT_TRUE(frameBuffer.IsColorTileCleared(0, 0));
+            EXPECT_FALSE(frameBuffer.IsDepthTileCleared(0, 0));
+            frameBuffer.ClearColor(Vec4f{0.f, 1.f, 0.f, 1.f});
+            frameBuffer.SetColor(39, 19, Vec4f{1.f, 0.f, 0.f, 1.f});
+            EXPECT_EQ(storage[(19 * 40 + 39) * 4], 255);
+            EXPECT_EQ(storage[0], 0xCD);
+            // 只落地颜色清除
+            frameBuffer.ResolveColorFastClear();
+            EXPECT_EQ(storage[0], 0);
+            EXPECT_EQ(storage[1], 255);
+            EXPECT_TRUE(frameBuffer.IsDepthTileCleared(2, 0));
+            // 恢复内部存储
+            frameBuffer.BindColorStorage(nullptr);
+            EXPECT_NE(frameBuffer.GetColorData(), storage.data());
+            EXPECT_EQ(frameBuffer.GetColor(39, 19), Vec4f(0.f, 1.f, 0.f, 1.f));
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,233 @@
+
+#include "Core/FrameGovernor.h"
+#include "Core/Renderer.h"
+#include "Core/Upscaler.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        static Vec4f GetUpscaleSourceColor(int x, int y)
+        {
+            return Vec4f{static_cast<float>(x % 7) / 7.f, static_cast<float>(y % 5) / 5.f, static_cast<float>((x * y) % 11) / 11.f, 1.f};
+        }
+
+        /**
+         * @brief 逐像素的双线性采样参考实现
+         *
+         */
+        static Vec4f SampleReference(const FrameBuffer& source, int destinationWidth, int destinationHeight, int x, int y)
+        {
+            auto map = [](int index, int sourceSize, int destinationSize, int& i0, int& i1, float& weight) {
+                const float position = std::min(std::max((index + 0.5f) * sourceSize / destinationSize - 0.5f, 0.f), static_cast<float>(sourceSize - 1));
+                i0                   = static_cast<int>(position);
+                i1                   = std::min(i0 + 1, sourceSize - 1);
+                weight               = position - static_cast<float>(i0);
+            };
+            int   x0 = 0;
+            int   x1 = 0;
+            int   y0 = 0;
+            int   y1 = 0;
+            float fx = 0.f;
+            float fy = 0.f;
+            map(x, source.GetWidth(), destinationWidth, x0, x1, fx);
+            map(y, source.GetHeight(), destinationHeight, y0, y1, fy);
+            const Vec4f top    = source.GetColor(x0, y0) * (1.f - fx) + source.GetColor(x1, y0) * fx;
+            const Vec4f bottom = source.GetColor(x0, y1) * (1.f - fx) + source.GetColor(x1, y1) * fx;
+            return top * (1.f - fy) + bottom * fy;
+        }
+
+        TEST(FrameGovernorTest, BilinearUpscaleTest)
+        {
+            FrameBuffer source(37, 23, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+            for (int y = 0; y < source.GetHeight(); ++y)
+            {
+                for (int x = 0; x < source.GetWidth(); ++x)
+                {
+                    source.SetColor(x, y, GetUpscaleSourceColor(x, y));
+                }
+            }
+
+            // 放大与缩小都与参考实现一致
+            BilinearUpscaler upscaler;
+            const int        sizes[2][2] = {{100, 61}, {20, 13}};
+            for (const auto& size : sizes)
+            {
+                FrameBuffer destination(size[0], size[1], EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+                upscaler.Process(source, destination);
+                for (int y = 0; y < destination.GetHeight(); ++y)
+                {
+                    for (int x = 0; x < destination.GetWidth(); ++x)
+                    {
+                        const Vec4f expected = SampleReference(source, destination.GetWidth(), destination.GetHeight(), x, y);
+                        const Vec4f actual   = destination.GetColor(x, y);
+                        for (int channel = 0; channel < 4; ++channel)
+                        {
+                            ASSERT_NEAR(actual[channel], expected[channel], 1e-3f) << x << ", " << y;
+                        }
+                    }
+                }
+            }
+
+            // 多线程结果与串行逐字节一致
+            FrameBuffer serial(150, 90);
+            FrameBuffer threaded(150, 90);
+            ThreadPool  threadPool(3);
+            upscaler.Process(source, serial);
+            BilinearUpscaler(&threadPool).Process(source, threaded);
+            EXPECT_EQ(std::memcmp(serial.GetColorData(), threaded.GetColorData(), static_cast<size_t>(serial.GetColorPitch()) * serial.GetHeight()), 0);
+
+            // 尺寸相同时原样复制
+            FrameBuffer same(serial.GetWidth(), serial.GetHeight());
+            upscaler.Process(serial, same);
+            EXPECT_EQ(std::memcmp(serial.GetColorData(), same.GetColorData(), static_cast<size_t>(serial.GetColorPitch()) * serial.GetHeight()), 0);
+        }
+
+        /**
+         * @brief 模拟一帧的各阶段耗时: 光栅化与渲染像素数、采样数成正比，其余为固定开销，带确定性的抖动与偶发慢帧
+         *
+         */
+        static void SimulateFrame(FrameGovernor& governor, float rasterMsAtFullResolution, int frameIndex)
+        {
+            const float pixelRatio = static_cast<float>(governor.GetRenderWidth() * governor.GetRenderHeight()) /
+                                     static_cast<float>(governor.GetOutputWidth() * governor.GetOutputHeight());
+            const float sampleCost = 1.f + 0.25f * static_cast<float>(governor.GetSampleCount() - 1);
+            const float lodCost    = 1.f / governor.GetLodErrorScale();
+            const float noise      = 1.f + 0.05f * static_cast<float>((frameIndex * 7) % 5 - 2) / 2.f + (frameIndex % 23 == 0 ? 0.3f : 0.f);
+            governor.BeginFrame();
+            governor.AddStageTime(EnumFrameStage::GEOMETRY, 2.f * lodCost * noise);
+            governor.AddStageTime(EnumFrameStage::RASTER, rasterMsAtFullResolution * pixelRatio * sampleCost * noise);
+            governor.AddStageTime(EnumFrameStage::UPSCALE, 1.f);
+            governor.EndFrame();
+        }
+
+        /**
+         * @brief 画质按固定顺序降低: 分辨率到下限后才降低采样数，采样数降到1后才增加LOD偏移
+         *
+         */
+        static void ExpectDegradationOrder(const FrameGovernor& governor)
+        {
+            const FrameGovernorSettings& settings = governor.GetSettings();
+            if (governor.GetSampleCount() < settings.maxSampleCount)
+            {
+                EXPECT_FLOAT_EQ(governor.GetResolutionScale(), settings.minResolutionScale);
+            }
+            if (governor.GetLodBias() > 0.f)
+            {
+                EXPECT_EQ(governor.GetSampleCount(), 1);
+            }
+            EXPECT_EQ(governor.GetRenderWidth() % FrameGovernor::RENDER_SIZE_ALIGNMENT, 0);
+            EXPECT_EQ(governor.GetRenderHeight() % FrameGovernor::RENDER_SIZE_ALIGNMENT, 0);
+        }
+
+        TEST(FrameGovernorTest, BudgetTest)
+        {
+            FrameGovernorSettings settings;
+            settings.maxSampleCount = 4;
+            FrameGovernor governor(1280, 720, settings);
+            EXPECT_EQ(governor.GetRenderWidth(), 1280);
+            EXPECT_EQ(governor.GetSampleCount(), 4);
+
+            // 满档画质耗时约38ms: 降低分辨率后稳定在预算以内
+            int frame = 0;
+            for (; frame < 200; ++frame)
+            {
+                SimulateFrame(governor, 20.f, frame);
+                ExpectDegradationOrder(governor);
+            }
+            EXPECT_LT(governor.GetResolutionScale(), 1.f);
+            EXPECT_EQ(governor.GetSampleCount(), 4);
+            EXPECT_LE(governor.GetEstimatedFrameTime(), settings.targetFrameMs);
+            int overBudget = 0;
+            for (const int end = frame + 100; frame < end; ++frame)
+            {
+                SimulateFrame(governor, 20.f, frame);
+                overBudget += governor.GetFrameTime() > settings.targetFrameMs ? 1 : 0;
+            }
+            // 只有偶发慢帧超出预算
+            EXPECT_LE(overBudget, 5);
+
+            // 负载远超预算: 分辨率到下限后依次降低采样数、增加LOD偏移
+            for (const int end = frame + 200; frame < end; ++frame)
+            {
+                SimulateFrame(governor, 200.f, frame);
+                ExpectDegradationOrder(governor);
+            }
+            EXPECT_FLOAT_EQ(governor.GetResolutionScale(), settings.minResolutionScale);
+            EXPECT_EQ(governor.GetRenderWidth(), 640);
+            EXPECT_EQ(governor.GetSampleCount(), 1);
+            EXPECT_FLOAT_EQ(governor.GetLodBias(), settings.maxLodBias);
+
+            // 负载减轻: 按相反顺序恢复满档画质
+            for (const int end = frame + 300; frame < end; ++frame)
+            {
+                SimulateFrame(governor, 4.f, frame);
+                ExpectDegradationOrder(governor);
+            }
+            EXPECT_FLOAT_EQ(governor.GetLodBias(), 0.f);
+            EXPECT_EQ(governor.GetSampleCount(), 4);
+            EXPECT_FLOAT_EQ(governor.GetResolutionScale(), 1.f);
+            EXPECT_EQ(governor.GetRenderWidth(), 1280);
+
+            // 决策应用到渲染器
+            Renderer renderer(1280, 720);
+            governor.Apply(renderer);
+            EXPECT_EQ(renderer.GetSampleCount(), 4);
+            for (; governor.GetResolutionScale() == 1.f; ++frame)
+            {
+                SimulateFrame(governor, 40.f, frame);
+            }
+            governor.Apply(renderer);
+            EXPECT_EQ(renderer.GetWidth(), governor.GetRenderWidth());
+            EXPECT_EQ(renderer.GetHeight(), governor.GetRenderHeight());
+            EXPECT_EQ(renderer.GetMultiSampleBuffer()->GetWidth(), governor.GetRenderWidth());
+        }
+
+        TEST(FrameGovernorTest, GeometryBoundTest)
+        {
+            // 只有几何阶段耗时: 降分辨率无效，直接降低多重采样、增加LOD偏移，且只在设置确实变化时报告变化
+            FrameGovernorSettings settings;
+            settings.maxSampleCount = 4;
+            FrameGovernor governor(1280, 720, settings);
+            int           changeCount = 0;
+            for (int frame = 0; frame < 200; ++frame)
+            {
+                const int   sampleCount = governor.GetSampleCount();
+                const float lodBias     = governor.GetLodBias();
+                governor.BeginFrame();
+                governor.AddStageTime(EnumFrameStage::GEOMETRY, 40.f);
+                const bool changed = governor.EndFrame();
+                EXPECT_EQ(changed, sampleCount != governor.GetSampleCount() || lodBias != governor.GetLodBias()) << frame;
+                changeCount += changed ? 1 : 0;
+            }
+            EXPECT_FLOAT_EQ(governor.GetResolutionScale(), 1.f);
+            EXPECT_EQ(governor.GetRenderWidth(), 1280);
+            EXPECT_EQ(governor.GetSampleCount(), 1);
+            EXPECT_FLOAT_EQ(governor.GetLodBias(), settings.maxLodBias);
+            EXPECT_GT(changeCount, 0);
+        }
+
+        TEST(FrameGovernorTest, StageTimerTest)
+        {
+            FrameGovernor governor(64, 64);
+            governor.BeginFrame();
+            governor.BeginStage(EnumFrameStage::POST_PROCESS);
+            volatile float sink = 0.f;
+            for (int i = 0; i < 100000; ++i)
+            {
+                sink = sink + std::sqrt(static_cast<float>(i));
+            }
+            governor.EndStage(EnumFrameStage::POST_PROCESS);
+            governor.AddStageTime(EnumFrameStage::PRESENT, 0.5f);
+            EXPECT_FALSE(governor.EndFrame());
+            EXPECT_GT(governor.GetStageTime(EnumFrameStage::POST_PROCESS), 0.f);
+            EXPECT_FLOAT_EQ(governor.GetStageTime(EnumFrameStage::PRESENT), 0.5f);
+            EXPECT_FLOAT_EQ(governor.GetFrameTime(), governor.GetStageTime(EnumFrameStage::POST_PROCESS) + 0.5f);
+            EXPECT_FLOAT_EQ(governor.GetEstimatedFrameTime(), governor.GetFrameTime());
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,207 @@
+
+#include "Core/Camera.h"
+#include "Core/DirtyTileTracker.h"
+#include "Core/Renderer.h"
+#include "gtest/gtest.h"
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 测试用着色器: 模型观察投影变换，法线作为颜色
+         *
+         */
+        struct TransformColorShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return modelViewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f modelViewProj;
+        };
+
+        /**
+         * @brief 场景中的一个物体: 单位正方形经平移放置
+         *
+         */
+        struct SceneObject
+        {
+            Vec3f offset;
+            Vec3f color;
+        };
+
+        static Mesh MakeUnitQuad(const Vec3f& color)
+        {
+            Mesh mesh;
+            mesh.vertices = {
+                Joy::Vertex{Vec3f{-0.5f, -0.5f, 0.f}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{0.5f, -0.5f, 0.f}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{0.5f, 0.5f, 0.f}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{-0.5f, 0.5f, 0.f}, color, Vec2f{}},
+            };
+            mesh.indices = {0, 1, 2, 0, 2, 3};
+            return mesh;
+        }
+
+        static Mat4x4f MakeTranslation(const Vec3f& offset)
+        {
+            Mat4x4f ret = MAT4X4F_IDENTITY;
+            ret[3]      = Vec4f{offset.X(), offset.Y(), offset.Z(), 1.f};
+            return ret;
+        }
+
+        /**
+         * @brief 提交场景到追踪器并增量重绘
+         *
+         */
+        static void RenderIncremental(Renderer& renderer, DirtyTileTracker& tracker, const Camera& camera, const std::vector<SceneObject>& scene)
+        {
+            const Mat4x4f viewProj = camera.GetViewProjMatrix();
+            std::vector<RasterRect> bounds(scene.size());
+            tracker.BeginFrame(camera.GetVersion());
+            for (size_t i = 0; i < scene.size(); ++i)
+            {
+                const Mat4x4f model = MakeTranslation(scene[i].offset);
+                bounds[i] = DirtyTileTracker::ComputeScreenBounds(Vec3f{-0.5f, -0.5f, 0.f}, Vec3f{0.5f, 0.5f, 0.f}, viewProj * model, renderer.GetWidth(),
+                                                                  renderer.GetHeight());
+                tracker.SubmitObject(static_cast<uint32_t>(i), model, 0, bounds[i]);
+            }
+            tracker.EndFrame();
+            renderer.RenderDirtyRegions(tracker, [&](const RasterRect&) {
+                for (size_t i = 0; i < scene.size(); ++i)
+                {
+                    if (!tracker.Intersects(bounds[i]))
+                    {
+                        continue;
+                    }
+                    TransformColorShader shader;
+                    shader.modelViewProj = viewProj * MakeTranslation(scene[i].offset);
+                    renderer.Draw(MakeUnitQuad(scene[i].color), shader);
+                }
+            });
+        }
+
+        static void RenderFull(Renderer& renderer, const Camera& camera, const std::vector<SceneObject>& scene)
+        {
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            for (const SceneObject& object : scene)
+            {
+                TransformColorShader shader;
+                shader.modelViewProj = camera.GetViewProjMatrix() * MakeTranslation(object.offset);
+                renderer.Draw(MakeUnitQuad(object.color), shader);
+            }
+            renderer.Resolve();
+        }
+
+        static void ExpectSameImage(const FrameBuffer& lhs, const FrameBuffer& rhs)
+        {
+            for (int y = 0; y < lhs.GetHeight(); ++y)
+            {
+                for (int x = 0; x < lhs.GetWidth(); ++x)
+                {
+                    ASSERT_EQ(lhs.GetColor(x, y), rhs.GetColor(x, y)) << x << ", " << y;
+                    ASSERT_EQ(lhs.GetDepth(x, y), rhs.GetDepth(x, y)) << x << ", " << y;
+                }
+            }
+        }
+
+        TEST(IncrementalRenderTest, MatchesFullRenderTest)
+        {
+            for (int sampleCount : {1, 4})
+            {
+                constexpr int WIDTH  = 96;
+                constexpr int HEIGHT = 64;
+                Camera        camera(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 0.f, 5.f}, Vec3f{0.f, 0.f, 0.f}, 0.1f, 10.f, 2.f);
+                camera.SetAspect(static_cast<float>(WIDTH) / HEIGHT);
+                std::vector<SceneObject> scene = {
+                    {Vec3f{-1.5f, 0.5f, 0.f}, Vec3f{1.f, 0.f, 0.f}},
+                    {Vec3f{0.f, 0.f, 0.5f}, Vec3f{0.f, 1.f, 0.f}},
+                    {Vec3f{1.5f, -1.f, 0.f}, Vec3f{0.f, 0.f, 1.f}},
+                };
+
+                Renderer incremental{WIDTH, HEIGHT};
+                incremental.SetSampleCount(sampleCount);
+                incremental.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                DirtyTileTracker tracker{WIDTH, HEIGHT};
+                Renderer         reference{WIDTH, HEIGHT};
+                reference.SetSampleCount(sampleCount);
+
+                // 首帧整帧重绘
+                RenderIncremental(incremental, tracker, camera, scene);
+                EXPECT_TRUE(tracker.IsFullFrameDirty());
+                RenderFull(reference, camera, scene);
+                ExpectSameImage(incremental.GetFrameBuffer(), reference.GetFrameBuffer());
+
+                // 场景不变时没有脏分块
+                RenderIncremental(incremental, tracker, camera, scene);
+                EXPECT_EQ(tracker.GetDirtyTileCount(), 0);
+                EXPECT_TRUE(tracker.GetDirtyRects().empty());
+
+                // 移动一个物体，只有其新旧包围盒覆盖的分块需要重绘，且与之重叠的静止物体被正确重绘
+                scene[1].offset = Vec3f{-1.f, 0.25f, 0.5f};
+                RenderIncremental(incremental, tracker, camera, scene);
+                EXPECT_GT(tracker.GetDirtyTileCount(), 0);
+                EXPECT_LT(tracker.GetDirtyTileCount(), tracker.GetTileCountX() * tracker.GetTileCountY());
+                EXPECT_FALSE(tracker.IsTileDirty(tracker.GetTileCountX() - 1, tracker.GetTileCountY() - 1));
+                RenderFull(reference, camera, scene);
+                ExpectSameImage(incremental.GetFrameBuffer(), reference.GetFrameBuffer());
+
+                // 移除物体，其旧包围盒被清除
+                scene.pop_back();
+                RenderIncremental(incremental, tracker, camera, scene);
+                EXPECT_TRUE(tracker.IsTileDirty(tracker.GetTileCountX() - 1, tracker.GetTileCountY() - 1));
+                RenderFull(reference, camera, scene);
+                ExpectSameImage(incremental.GetFrameBuffer(), reference.GetFrameBuffer());
+
+                // 相机变化时整帧失效
+                const uint32_t version = camera.GetVersion();
+                camera.SetPosition(Vec3f{0.25f, 0.f, 5.f});
+                EXPECT_NE(camera.GetVersion(), version);
+                RenderIncremental(incremental, tracker, camera, scene);
+                EXPECT_TRUE(tracker.IsFullFrameDirty());
+                RenderFull(reference, camera, scene);
+                ExpectSameImage(incremental.GetFrameBuffer(), reference.GetFrameBuffer());
+            }
+        }
+
+        TEST(IncrementalRenderTest, DirtyRectMergeTest)
+        {
+            DirtyTileTracker tracker{100, 70};
+            EXPECT_EQ(tracker.GetTileCountX(), 7);
+            EXPECT_EQ(tracker.GetTileCountY(), 5);
+            tracker.BeginFrame(0);
+            tracker.EndFrame();
+            // 整帧脏时合并为一个裁剪到屏幕内的矩形
+            ASSERT_EQ(tracker.GetDirtyRects().size(), 1u);
+            EXPECT_EQ(tracker.GetDirtyRects()[0].maxX, 100);
+            EXPECT_EQ(tracker.GetDirtyRects()[0].maxY, 70);
+
+            tracker.BeginFrame(0);
+            tracker.MarkDirty(RasterRect{20, 20, 40, 60});
+            tracker.MarkDirty(RasterRect{97, 0, 99, 5});
+            tracker.EndFrame();
+            EXPECT_EQ(tracker.GetDirtyTileCount(), 2 * 3 + 1);
+            ASSERT_EQ(tracker.GetDirtyRects().size(), 2u);
+            const RasterRect& corner = tracker.GetDirtyRects()[0];
+            EXPECT_EQ(corner.minX, 96);
+            EXPECT_EQ(corner.maxX, 100);
+            EXPECT_EQ(corner.maxY, 16);
+            const RasterRect& block = tracker.GetDirtyRects()[1];
+            EXPECT_EQ(block.minX, 16);
+            EXPECT_EQ(block.minY, 16);
+            EXPECT_EQ(block.maxX, 48);
+            EXPECT_EQ(block.maxY, 64);
+            EXPECT_TRUE(tracker.Intersects(RasterRect{40, 40, 41, 41}));
+            EXPECT_FALSE(tracker.Intersects(RasterRect{0, 0, 10, 10}));
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,210 @@
+
+#include "Core/Camera.h"
+#include "Core/Instancing.h"
+#include "Core/Renderer.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 输出mvp * position，法线作为颜色；mvp为单位矩阵时即返回模型空间位置
+         *
+         */
+        struct InstanceColorShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return mvp * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f mvp = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 中心在原点的四面体，每个面颜色不同
+         *
+         */
+        static Mesh MakeTetrahedron()
+        {
+            const Vec3f corners[4] = {Vec3f{1.f, 1.f, 1.f}, Vec3f{-1.f, -1.f, 1.f}, Vec3f{-1.f, 1.f, -1.f}, Vec3f{1.f, -1.f, -1.f}};
+            const int   faces[4][3] = {{0, 1, 3}, {0, 2, 1}, {0, 3, 2}, {1, 2, 3}};
+            Mesh        mesh;
+            for (int face = 0; face < 4; ++face)
+            {
+                const Vec3f color{face == 0 || face == 3 ? 1.f : 0.2f, face == 1 || face == 3 ? 1.f : 0.2f, face == 2 ? 1.f : 0.2f};
+                const auto  base = static_cast<uint32_t>(mesh.vertices.size());
+                for (int k = 0; k < 3; ++k)
+                {
+                    mesh.vertices.push_back(Joy::Vertex{corners[faces[face][k]], color, Vec2f{}});
+                }
+                mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2});
+            }
+            return mesh;
+        }
+
+        static std::vector<InstanceTransform> MakeRandomInstances(int count, uint32_t seed)
+        {
+            std::mt19937                          random(seed);
+            std::uniform_real_distribution<float> unit(-1.f, 1.f);
+            std::vector<InstanceTransform>        ret(count);
+            for (InstanceTransform& instance : ret)
+            {
+                instance.translation = Vec3f{unit(random) * 12.f, unit(random) * 12.f, -12.f + unit(random) * 10.f};
+                Vec3f axis{unit(random), unit(random), unit(random)};
+                axis               = axis / std::max(Norm(axis), 1e-3f);
+                const float angle  = unit(random) * 3.f;
+                instance.rotation  = Quat{axis.X() * std::sin(angle * 0.5f), axis.Y() * std::sin(angle * 0.5f), axis.Z() * std::sin(angle * 0.5f), std::cos(angle * 0.5f)};
+                instance.scale     = Vec3f{0.5f + 0.5f * std::abs(unit(random)), 0.5f + 0.5f * std::abs(unit(random)), 0.5f + 0.5f * std::abs(unit(random))};
+            }
+            return ret;
+        }
+
+        TEST(InstancingTest, ComposeTest)
+        {
+            const Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{1.f, 2.f, 3.f}, Vec3f{0.f, 0.f, -10.f}, 0.1f, 100.f, 60.f);
+            const std::vector<InstanceTransform> instances = MakeRandomInstances(37, 20251223u);
+            std::vector<Mat4x4f>                 models(instances.size());
+            std::vector<Mat4x4f>                 mvps(instances.size());
+            MakeInstanceMatrices(instances.data(), static_cast<int>(instances.size()), models.data());
+            ComposeInstanceMatrices(camera.GetViewProjMatrix(), models.data(), static_cast<int>(models.size()), mvps.data());
+
+            const Vec4f positions[3] = {Vec4f{0.3f, -0.7f, 0.2f, 1.f}, Vec4f{-1.f, 1.f, 1.f, 1.f}, Vec4f{2.f, 0.f, -3.f, 1.f}};
+            Vec4f       transformed[3];
+            for (size_t i = 0; i < instances.size(); ++i)
+            {
+                // TRS展开与矩阵乘积一致
+                Mat4x4f scale       = MAT4X4F_IDENTITY;
+                Mat4x4f translation = MAT4X4F_IDENTITY;
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    scale[axis][axis]    = instances[i].scale[axis];
+                    translation[3][axis] = instances[i].translation[axis];
+                }
+                const Mat4x4f expectedModel = translation * ToMat4x4f(instances[i].rotation) * scale;
+                for (int col = 0; col < 4; ++col)
+                {
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        EXPECT_NEAR(models[i][col][row], expectedModel[col][row], 1e-6f);
+                    }
+                }
+
+                // SIMD组合与变换的累加顺序与标量矩阵乘法相同，结果逐位一致
+                const Mat4x4f expectedMvp = camera.GetViewProjMatrix() * models[i];
+                EXPECT_EQ(mvps[i], expectedMvp);
+                TransformPositions(mvps[i], positions, 3, transformed);
+                for (int k = 0; k < 3; ++k)
+                {
+                    EXPECT_EQ(transformed[k], expectedMvp * positions[k]);
+                }
+            }
+
+            // 允许原地组合
+            ComposeInstanceMatrices(camera.GetViewProjMatrix(), models.data(), static_cast<int>(models.size()), models.data());
+            EXPECT_EQ(models, mvps);
+        }
+
+        TEST(InstancingTest, CullTest)
+        {
+            const Camera   camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 100.f, 60.f);
+            const Vec4f    corners[2] = {Vec4f{-1.f, -1.f, -1.f, 1.f}, Vec4f{1.f, 1.f, 1.f, 1.f}};
+            const auto     bounds     = ComputeBounds(corners, 2);
+            const Vec3f    offsets[]  = {Vec3f{0.f, 0.f, -10.f},    // 视野中央
+                                         Vec3f{0.f, 0.f, 10.f},     // 相机后方
+                                         Vec3f{-30.f, 0.f, -10.f},  // 左侧
+                                         Vec3f{0.f, 30.f, -10.f},   // 上方
+                                         Vec3f{0.f, 0.f, -200.f},   // 远平面外
+                                         Vec3f{6.5f, 0.f, -10.f},   // 跨越右侧平面
+                                         Vec3f{0.f, 0.f, -0.5f}};   // 跨越近平面
+            const bool     expected[] = {true, false, false, false, false, true, true};
+            constexpr int  COUNT      = static_cast<int>(sizeof(offsets) / sizeof(offsets[0]));
+            Mat4x4f        mvps[COUNT];
+            for (int i = 0; i < COUNT; ++i)
+            {
+                mvps[i] = MAT4X4F_IDENTITY;
+                mvps[i][3] = Vec4f{offsets[i].X(), offsets[i].Y(), offsets[i].Z(), 1.f};
+            }
+            ComposeInstanceMatrices(camera.GetViewProjMatrix(), mvps, COUNT, mvps);
+
+            uint32_t  visible[COUNT];
+            const int visibleCount = CullInstances(mvps, COUNT, bounds, visible);
+            int       cursor       = 0;
+            for (int i = 0; i < COUNT; ++i)
+            {
+                const bool isVisible = cursor < visibleCount && visible[cursor] == static_cast<uint32_t>(i);
+                EXPECT_EQ(isVisible, expected[i]) << "instance " << i;
+                cursor += isVisible ? 1 : 0;
+            }
+            EXPECT_EQ(cursor, visibleCount);
+        }
+
+        TEST(InstancingTest, DrawInstancedTest)
+        {
+            constexpr int WIDTH  = 128;
+            constexpr int HEIGHT = 96;
+            const Camera  camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 100.f, 60.f);
+            const Mesh    mesh = MakeTetrahedron();
+
+            const std::vector<InstanceTransform> instances = MakeRandomInstances(200, 7u);
+            std::vector<Mat4x4f>                 models(instances.size());
+            MakeInstanceMatrices(instances.data(), static_cast<int>(instances.size()), models.data());
+
+            for (int sampleCount : {1, 4})
+            {
+                Renderer instanced(WIDTH, HEIGHT);
+                Renderer reference(WIDTH, HEIGHT);
+                instanced.SetSampleCount(sampleCount);
+                reference.SetSampleCount(sampleCount);
+                instanced.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                reference.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+
+                const int visibleCount = instanced.DrawInstanced(mesh, InstanceColorShader{}, camera.GetViewProjMatrix(), models.data(), static_cast<int>(models.size()));
+                EXPECT_GT(visibleCount, 0);
+                EXPECT_LT(visibleCount, static_cast<int>(models.size()));
+                for (const Mat4x4f& model : models)
+                {
+                    reference.Draw(mesh, InstanceColorShader{camera.GetViewProjMatrix() * model});
+                }
+                instanced.Resolve();
+                reference.Resolve();
+
+                int coveredCount = 0;
+                for (int y = 0; y < HEIGHT; ++y)
+                {
+                    for (int x = 0; x < WIDTH; ++x)
+                    {
+                        ASSERT_EQ(instanced.GetFrameBuffer().GetColor(x, y), reference.GetFrameBuffer().GetColor(x, y)) << x << ", " << y;
+                        ASSERT_EQ(instanced.GetFrameBuffer().GetDepth(x, y), reference.GetFrameBuffer().GetDepth(x, y)) << x << ", " << y;
+                        coveredCount += instanced.GetFrameBuffer().GetDepth(x, y) < 1.f ? 1 : 0;
+                    }
+                }
+                EXPECT_GT(coveredCount, WIDTH * HEIGHT / 10);
+            }
+
+            // 全部实例被剔除或没有实例时不绘制
+            Renderer       renderer(WIDTH, HEIGHT);
+            const Mat4x4f behind = [] {
+                Mat4x4f ret = MAT4X4F_IDENTITY;
+                ret[3]      = Vec4f{0.f, 0.f, 20.f, 1.f};
+                return ret;
+            }();
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            EXPECT_EQ(renderer.DrawInstanced(mesh, InstanceColorShader{}, camera.GetViewProjMatrix(), &behind, 1), 0);
+            EXPECT_EQ(renderer.DrawInstanced(mesh, InstanceColorShader{}, camera.GetViewProjMatrix(), &behind, 0), 0);
+            EXPECT_EQ(renderer.GetFrameBuffer().GetDepth(WIDTH / 2, HEIGHT / 2), 1.f);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
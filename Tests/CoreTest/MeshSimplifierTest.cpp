@@ -0,0 +1,233 @@
+
+#include "Core/MeshSimplifier.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 顶点共享的闭合单位球面(两极各一个顶点，经线首尾相接)
+         *
+         */
+        static Mesh MakeClosedSphere(int rings, int segments)
+        {
+            constexpr float PI = 3.14159265f;
+            Mesh            ret;
+            ret.vertices.push_back(Joy::Vertex{Vec3f{0.f, 1.f, 0.f}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}});
+            for (int ring = 1; ring < rings; ++ring)
+            {
+                const float theta = PI * static_cast<float>(ring) / rings;
+                for (int segment = 0; segment < segments; ++segment)
+                {
+                    const float phi = 2.f * PI * static_cast<float>(segment) / segments;
+                    const Vec3f normal{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                    ret.vertices.push_back(Joy::Vertex{normal, normal, Vec2f{}});
+                }
+            }
+            ret.vertices.push_back(Joy::Vertex{Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, -1.f, 0.f}, Vec2f{}});
+            const uint32_t south = static_cast<uint32_t>(ret.vertices.size() - 1);
+            auto           index = [&](int ring, int segment) { return static_cast<uint32_t>(1 + (ring - 1) * segments + segment % segments); };
+            for (int segment = 0; segment < segments; ++segment)
+            {
+                ret.indices.insert(ret.indices.end(), {0u, index(1, segment + 1), index(1, segment)});
+                ret.indices.insert(ret.indices.end(), {south, index(rings - 1, segment), index(rings - 1, segment + 1)});
+                for (int ring = 1; ring < rings - 1; ++ring)
+                {
+                    const uint32_t i0 = index(ring, segment);
+                    const uint32_t i1 = index(ring, segment + 1);
+                    const uint32_t i2 = index(ring + 1, segment);
+                    const uint32_t i3 = index(ring + 1, segment + 1);
+                    ret.indices.insert(ret.indices.end(), {i0, i1, i3, i0, i3, i2});
+                }
+            }
+            return ret;
+        }
+
+        static float GetTriangleArea(const Mesh& mesh, size_t triangle)
+        {
+            const Vec3f& p0 = mesh.vertices[mesh.indices[triangle * 3]].position;
+            const Vec3f& p1 = mesh.vertices[mesh.indices[triangle * 3 + 1]].position;
+            const Vec3f& p2 = mesh.vertices[mesh.indices[triangle * 3 + 2]].position;
+            return Norm(Cross(p1 - p0, p2 - p0)) * 0.5f;
+        }
+
+        TEST(MeshSimplifierTest, ClosedMeshTest)
+        {
+            const Mesh sphere = MakeClosedSphere(24, 48);
+            ASSERT_EQ(sphere.indices.size() / 3, 2u * 48u * 23u);
+
+            float      error      = 0.f;
+            const Mesh simplified = SimplifyMesh(sphere, 300, &error);
+            const size_t triangleCount = simplified.indices.size() / 3;
+            EXPECT_LE(triangleCount, 300u);
+            EXPECT_GT(triangleCount, 100u);
+            EXPECT_GT(error, 0.f);
+            EXPECT_LT(error, 0.2f);
+
+            // 保持闭合流形: 每条边恰好被两个三角形使用，欧拉示性数为2
+            std::map<std::pair<uint32_t, uint32_t>, int> edgeUseCount;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                EXPECT_GT(GetTriangleArea(simplified, t), 0.f);
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = simplified.indices[t * 3 + k];
+                    const uint32_t b = simplified.indices[t * 3 + (k + 1) % 3];
+                    ASSERT_LT(a, simplified.vertices.size());
+                    ++edgeUseCount[std::make_pair(std::min(a, b), std::max(a, b))];
+                }
+            }
+            for (const auto& edge : edgeUseCount)
+            {
+                EXPECT_EQ(edge.second, 2);
+            }
+            EXPECT_EQ(static_cast<int>(simplified.vertices.size()) - static_cast<int>(edgeUseCount.size()) + static_cast<int>(triangleCount), 2);
+
+            // 三角形中心到球面的距离不超过报告的几何误差
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const Vec3f center = (simplified.vertices[simplified.indices[t * 3]].position + simplified.vertices[simplified.indices[t * 3 + 1]].position +
+                                      simplified.vertices[simplified.indices[t * 3 + 2]].position) /
+                                     3.f;
+                EXPECT_LE(1.f - Norm(center), error + 1e-4f);
+            }
+        }
+
+        TEST(MeshSimplifierTest, OpenBoundaryErrorTest)
+        {
+            // 北半球(赤道为开放边界)与闭合球面大幅简化: 报告的是真实距离，不超过球面直径，边界惩罚的权重不计入
+            const Mesh sphere = MakeClosedSphere(24, 48);
+            Mesh       hemisphere;
+            hemisphere.vertices = sphere.vertices;
+            for (size_t i = 0; i < sphere.indices.size(); i += 3)
+            {
+                const uint32_t* tri = &sphere.indices[i];
+                if (sphere.vertices[tri[0]].position.Y() > -1e-4f && sphere.vertices[tri[1]].position.Y() > -1e-4f &&
+                    sphere.vertices[tri[2]].position.Y() > -1e-4f)
+                {
+                    hemisphere.indices.insert(hemisphere.indices.end(), tri, tri + 3);
+                }
+            }
+            ASSERT_EQ(hemisphere.indices.size() * 2, sphere.indices.size());
+            float closedError = 0.f;
+            float openError   = 0.f;
+            SimplifyMesh(sphere, 48, &closedError);
+            EXPECT_LE(SimplifyMesh(hemisphere, 24, &openError).indices.size() / 3, 24u);
+            EXPECT_GT(closedError, 0.f);
+            EXPECT_LT(closedError, 2.f);
+            EXPECT_GT(openError, 0.f);
+            EXPECT_LT(openError, 2.f);
+
+            // 平面圆盘: 边界折叠只在平面内移动轮廓，表面到原始平面的距离为0
+            constexpr float PI       = 3.14159265f;
+            constexpr int   RINGS    = 6;
+            constexpr int   SEGMENTS = 24;
+            Mesh            disk;
+            disk.vertices.push_back(Joy::Vertex{Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, 1.f}, Vec2f{}});
+            for (int ring = 1; ring <= RINGS; ++ring)
+            {
+                for (int segment = 0; segment < SEGMENTS; ++segment)
+                {
+                    const float phi    = 2.f * PI * static_cast<float>(segment) / SEGMENTS;
+                    const float radius = static_cast<float>(ring) / RINGS;
+                    disk.vertices.push_back(Joy::Vertex{Vec3f{radius * std::cos(phi), radius * std::sin(phi), 0.f}, Vec3f{0.f, 0.f, 1.f}, Vec2f{}});
+                }
+            }
+            auto index = [](int ring, int segment) { return static_cast<uint32_t>(1 + (ring - 1) * SEGMENTS + segment % SEGMENTS); };
+            for (int segment = 0; segment < SEGMENTS; ++segment)
+            {
+                disk.indices.insert(disk.indices.end(), {0u, index(1, segment), index(1, segment + 1)});
+                for (int ring = 1; ring < RINGS; ++ring)
+                {
+                    const uint32_t i0 = index(ring, segment);
+                    const uint32_t i1 = index(ring, segment + 1);
+                    const uint32_t i2 = index(ring + 1, segment);
+                    const uint32_t i3 = index(ring + 1, segment + 1);
+                    disk.indices.insert(disk.indices.end(), {i0, i2, i3, i0, i3, i1});
+                }
+            }
+            float      diskError = 1.f;
+            const Mesh reduced   = SimplifyMesh(disk, 16, &diskError);
+            EXPECT_LT(reduced.vertices.size(), static_cast<size_t>(SEGMENTS));
+            EXPECT_NEAR(diskError, 0.f, 1e-5f);
+        }
+
+        TEST(MeshSimplifierTest, PlanarBoundaryTest)
+        {
+            // 16x16网格的单位正方形，内部与边界上的共线顶点均可零误差折叠，只有四角保留
+            constexpr int GRID = 16;
+            Mesh          plane;
+            for (int y = 0; y <= GRID; ++y)
+            {
+                for (int x = 0; x <= GRID; ++x)
+                {
+                    const Vec3f position{static_cast<float>(x) / GRID, static_cast<float>(y) / GRID, 0.f};
+                    plane.vertices.push_back(Joy::Vertex{position, Vec3f{0.f, 0.f, 1.f}, Vec2f{position.X(), position.Y()}});
+                }
+            }
+            for (uint32_t y = 0; y < GRID; ++y)
+            {
+                for (uint32_t x = 0; x < GRID; ++x)
+                {
+                    const uint32_t i0 = y * (GRID + 1) + x;
+                    const uint32_t i1 = i0 + GRID + 1;
+                    plane.indices.insert(plane.indices.end(), {i0, i0 + 1, i1 + 1, i0, i1 + 1, i1});
+                }
+            }
+
+            float      error      = 1.f;
+            const Mesh simplified = SimplifyMesh(plane, 2, &error);
+            EXPECT_NEAR(error, 0.f, 1e-4f);
+            EXPECT_LE(simplified.indices.size() / 3, 4u);
+            float area = 0.f;
+            for (size_t t = 0; t < simplified.indices.size() / 3; ++t)
+            {
+                area += GetTriangleArea(simplified, t);
+            }
+            EXPECT_NEAR(area, 1.f, 1e-5f);
+            // 顶点是原网格的子集，属性原样保留
+            for (const Joy::Vertex& vertex : simplified.vertices)
+            {
+                EXPECT_EQ(vertex.uv, Vec2f(vertex.position.X(), vertex.position.Y()));
+            }
+        }
+
+        TEST(MeshSimplifierTest, LodSelectionTest)
+        {
+            const MeshLodChain chain(MakeClosedSphere(32, 64), 5, 0.4f, 32);
+            ASSERT_GE(chain.GetLevelCount(), 4);
+            EXPECT_EQ(chain.GetLevel(0).geometricError, 0.f);
+            for (int level = 1; level < chain.GetLevelCount(); ++level)
+            {
+                EXPECT_LT(chain.GetLevel(level).mesh.indices.size(), chain.GetLevel(level - 1).mesh.indices.size());
+                EXPECT_GE(chain.GetLevel(level).geometricError, chain.GetLevel(level - 1).geometricError);
+            }
+
+            Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 0.f, 0.f}, Vec3f{0.f, 0.f, -1.f}, 0.1f, 1000.f, 60.f);
+            EXPECT_EQ(chain.SelectLevel(camera, Vec3f{0.f, 0.f, -2.f}, 1.f, 1080), 0);
+            EXPECT_EQ(chain.SelectLevel(camera, Vec3f{0.f, 0.f, -900.f}, 1.f, 1080), chain.GetLevelCount() - 1);
+
+            // 距离增大时级别单调变粗；缩放放大误差，窄FOV(放大)需要更精细的级别
+            int previous = 0;
+            for (float distance = 2.f; distance < 1000.f; distance *= 1.5f)
+            {
+                const int level = chain.SelectLevel(camera, Vec3f{0.f, 0.f, -distance}, 1.f, 1080);
+                EXPECT_GE(level, previous);
+                previous = level;
+            }
+            const Vec3f center{0.f, 0.f, -40.f};
+            const int   wide = chain.SelectLevel(camera, center, 1.f, 1080);
+            EXPECT_GT(wide, 0);
+            EXPECT_LT(chain.SelectLevel(camera, center, 8.f, 1080), wide);
+            camera.SetFov(10.f);
+            EXPECT_LT(chain.SelectLevel(camera, center, 1.f, 1080), wide);
+            EXPECT_EQ(&chain.Select(camera, center, 1.f, 1080), &chain.GetLevel(chain.SelectLevel(camera, center, 1.f, 1080)).mesh);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,136 @@
+
+#include "Core/Camera.h"
+#include "Core/Renderer.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 多视图着色器: 输出世界空间位置，法线作为颜色
+         *
+         */
+        struct WorldColorShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return viewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], 1.f}; }
+
+            Mat4x4f viewProj = MAT4X4F_IDENTITY;
+        };
+
+        /**
+         * @brief 包围原点的立方体，每个面颜色不同
+         *
+         */
+        static Mesh MakeColoredBox(float halfSize)
+        {
+            Mesh        mesh;
+            const Vec3f axes[3] = {Vec3f{1.f, 0.f, 0.f}, Vec3f{0.f, 1.f, 0.f}, Vec3f{0.f, 0.f, 1.f}};
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                for (float sign : {-1.f, 1.f})
+                {
+                    const Vec3f normal = axes[axis] * sign;
+                    const Vec3f u      = axes[(axis + 1) % 3] * halfSize;
+                    const Vec3f v      = axes[(axis + 2) % 3] * halfSize;
+                    const Vec3f center = normal * halfSize;
+                    const Vec3f color{axis == 0 ? 1.f : 0.f, axis == 1 ? 1.f : 0.f, sign > 0.f ? 1.f : 0.f};
+                    const auto  base = static_cast<uint32_t>(mesh.vertices.size());
+                    mesh.vertices.push_back(Joy::Vertex{center - u - v, color, Vec2f{}});
+                    mesh.vertices.push_back(Joy::Vertex{center + u - v, color, Vec2f{}});
+                    mesh.vertices.push_back(Joy::Vertex{center + u + v, color, Vec2f{}});
+                    mesh.vertices.push_back(Joy::Vertex{center - u + v, color, Vec2f{}});
+                    mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+                }
+            }
+            return mesh;
+        }
+
+        TEST(MultiViewTest, CubemapTest)
+        {
+            // 整套探针矩阵在编译期求出
+            constexpr Mat4x4f probeRig[CUBEMAP_FACE_COUNT] = {
+                MakeCubemapViewProj(0, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f), MakeCubemapViewProj(1, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f),
+                MakeCubemapViewProj(2, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f), MakeCubemapViewProj(3, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f),
+                MakeCubemapViewProj(4, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f), MakeCubemapViewProj(5, Vec3f{0.3f, -0.2f, 0.1f}, 0.1f, 10.f)};
+            // 立方体贴图的6个面，相机位于立方体内部，不剔除背面
+            const Vec3f directions[6] = {Vec3f{1.f, 0.f, 0.f},  Vec3f{-1.f, 0.f, 0.f}, Vec3f{0.f, 1.f, 0.f},
+                                         Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, 0.f, 1.f},  Vec3f{0.f, 0.f, -1.f}};
+            const Mesh  box           = MakeColoredBox(2.f);
+
+            std::vector<std::unique_ptr<Renderer>> multiTargets;
+            std::vector<std::unique_ptr<Renderer>> singleTargets;
+            RenderView                             views[6];
+            for (int face = 0; face < 6; ++face)
+            {
+                const Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.3f, -0.2f, 0.1f}, Vec3f{0.3f, -0.2f, 0.1f} + directions[face], 0.1f, 10.f, 90.f);
+                for (auto* targets : {&multiTargets, &singleTargets})
+                {
+                    targets->push_back(std::make_unique<Renderer>(16, 16));
+                    targets->back()->SetCullMode(EnumCullMode::NONE);
+                    targets->back()->Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                }
+                // 编译期的探针矩阵与相机一致
+                EXPECT_EQ(probeRig[face], camera.GetViewProjMatrix());
+                views[face] = RenderView{camera.GetViewProjMatrix(), multiTargets[face].get()};
+                // 对照: 逐视图独立绘制
+                WorldColorShader shader;
+                shader.viewProj = camera.GetViewProjMatrix();
+                singleTargets[face]->Draw(box, shader);
+            }
+            Renderer::DrawMultiView(box, WorldColorShader{}, views, 6);
+
+            for (int face = 0; face < 6; ++face)
+            {
+                for (int y = 0; y < 16; ++y)
+                {
+                    for (int x = 0; x < 16; ++x)
+                    {
+                        ASSERT_EQ(multiTargets[face]->GetFrameBuffer().GetColor(x, y), singleTargets[face]->GetFrameBuffer().GetColor(x, y));
+                        ASSERT_EQ(multiTargets[face]->GetFrameBuffer().GetDepth(x, y), singleTargets[face]->GetFrameBuffer().GetDepth(x, y));
+                    }
+                }
+            }
+            // 每个面的视图中心看到对应颜色的盒子面
+            EXPECT_EQ(multiTargets[0]->GetFrameBuffer().GetColor(8, 8), Vec4f(1.f, 0.f, 1.f, 1.f));
+            EXPECT_EQ(multiTargets[5]->GetFrameBuffer().GetColor(8, 8), Vec4f(0.f, 0.f, 0.f, 1.f));
+        }
+
+        TEST(MultiViewTest, TransformTest)
+        {
+            // 视图数不是4的倍数时，多余通道不写出
+            Mat4x4f matrices[5];
+            for (int view = 0; view < 5; ++view)
+            {
+                matrices[view]    = MAT4X4F_IDENTITY;
+                matrices[view][3] = Vec4f{static_cast<float>(view), 0.f, 0.5f, 1.f};
+            }
+            MultiViewTransform transform;
+            transform.SetViews(matrices, 5);
+            EXPECT_EQ(transform.GetGroupCount(), 2);
+            Vec4f   clipPositions[6];
+            uint8_t outcodes[6] = {0, 0, 0, 0, 0, 0xFF};
+            transform.Transform(Vec4f{0.f, 0.f, 0.f, 1.f}, clipPositions, outcodes);
+            for (int view = 0; view < 5; ++view)
+            {
+                EXPECT_EQ(clipPositions[view], Vec4f(static_cast<float>(view), 0.f, 0.5f, 1.f));
+            }
+            EXPECT_EQ(outcodes[0], 0);
+            EXPECT_EQ(outcodes[1], 0);
+            EXPECT_EQ(outcodes[2], CLIP_OUTSIDE_RIGHT);
+            EXPECT_EQ(outcodes[5], 0xFF);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,308 @@
+
+#include "Core/PostProcess.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        constexpr int POST_WIDTH  = 150;
+        constexpr int POST_HEIGHT = 100;
+
+        /**
+         * @brief HDR测试画面: 渐变背景、高亮圆盘与硬边斜线，尺寸不是分块的整数倍
+         *
+         */
+        static FrameBuffer MakeHdrFrame()
+        {
+            FrameBuffer frame(POST_WIDTH, POST_HEIGHT, EnumColorFormat::RGBA16F, EnumDepthFormat::D32F);
+            for (int y = 0; y < POST_HEIGHT; ++y)
+            {
+                for (int x = 0; x < POST_WIDTH; ++x)
+                {
+                    Vec4f       color{0.1f + 0.5f * x / POST_WIDTH, 0.2f, 0.1f + 0.4f * y / POST_HEIGHT, 1.f};
+                    const float dx = static_cast<float>(x) - 40.f;
+                    const float dy = static_cast<float>(y) - 50.f;
+                    if (dx * dx + dy * dy < 15.f * 15.f)
+                    {
+                        color = Vec4f{6.f, 4.f, 2.f, 0.5f};
+                    }
+                    if (x > 70 && 3 * (x - 70) > 2 * y)
+                    {
+                        color = Vec4f{0.9f, 0.9f, 0.05f, 1.f};
+                    }
+                    frame.SetColor(x, y, color);
+                }
+            }
+            return frame;
+        }
+
+        /**
+         * @brief 参考实现: 每个效果一次整帧的标量遍历
+         *
+         */
+        static std::vector<Vec4f> ReferencePostProcess(const FrameBuffer& source, const PostProcessSettings& settings, int bloomRadius)
+        {
+            const int          width  = source.GetWidth();
+            const int          height = source.GetHeight();
+            std::vector<Vec4f> image(static_cast<size_t>(width) * height);
+            std::vector<Vec4f> alpha(image.size());
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    alpha[y * width + x] = source.GetColor(x, y);
+                    image[y * width + x] = source.GetColor(x, y) * settings.exposure;
+                }
+            }
+            auto at = [&](std::vector<Vec4f>& pixels, int x, int y) -> Vec4f& {
+                return pixels[std::min(std::max(y, 0), height - 1) * width + std::min(std::max(x, 0), width - 1)];
+            };
+
+            if (settings.bloom)
+            {
+                std::vector<float> weights(bloomRadius * 2 + 1);
+                float              sum = 0.f;
+                for (int k = -bloomRadius; k <= bloomRadius; ++k)
+                {
+                    weights[k + bloomRadius] = std::exp(-static_cast<float>(k * k) / (2.f * settings.bloomSigma * settings.bloomSigma));
+                    sum += weights[k + bloomRadius];
+                }
+                std::vector<Vec4f> bright(image.size());
+                for (size_t i = 0; i < image.size(); ++i)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        bright[i][c] = std::max(image[i][c] - settings.bloomThreshold, 0.f);
+                    }
+                }
+                std::vector<Vec4f> horizontal(image.size(), Vec4f{});
+                std::vector<Vec4f> vertical(image.size(), Vec4f{});
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        for (int k = -bloomRadius; k <= bloomRadius; ++k)
+                        {
+                            horizontal[y * width + x] = horizontal[y * width + x] + at(bright, x + k, y) * (weights[k + bloomRadius] / sum);
+                        }
+                    }
+                }
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        for (int k = -bloomRadius; k <= bloomRadius; ++k)
+                        {
+                            vertical[y * width + x] = vertical[y * width + x] + at(horizontal, x, y + k) * (weights[k + bloomRadius] / sum);
+                        }
+                    }
+                }
+                for (size_t i = 0; i < image.size(); ++i)
+                {
+                    image[i] = image[i] + vertical[i] * settings.bloomIntensity;
+                }
+            }
+
+            std::vector<float> luma(image.size());
+            for (size_t i = 0; i < image.size(); ++i)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    float value = image[i][c];
+                    if (settings.toneMapping)
+                    {
+                        value = std::min(std::max(value * (2.51f * value + 0.03f) / (value * (2.43f * value + 0.59f) + 0.14f), 0.f), 1.f);
+                    }
+                    if (settings.gammaCorrection)
+                    {
+                        value = std::min(std::max(value, 0.f), 1.f);
+                        value = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+                    }
+                    image[i][c] = value;
+                }
+                image[i][3] = alpha[i][3];
+                luma[i]     = image[i][0] * 0.299f + image[i][1] * 0.587f + image[i][2] * 0.114f;
+            }
+
+            if (!settings.fxaa)
+            {
+                return image;
+            }
+            std::vector<Vec4f> result = image;
+            auto               sample = [&](float x, float y) {
+                const int   x0 = static_cast<int>(std::floor(x));
+                const int   y0 = static_cast<int>(std::floor(y));
+                const float fx = x - std::floor(x);
+                const float fy = y - std::floor(y);
+                const Vec4f top    = at(image, x0, y0) * (1.f - fx) + at(image, x0 + 1, y0) * fx;
+                const Vec4f bottom = at(image, x0, y0 + 1) * (1.f - fx) + at(image, x0 + 1, y0 + 1) * fx;
+                return top * (1.f - fy) + bottom * fy;
+            };
+            auto lumaAt = [&](int x, int y) { return luma[std::min(std::max(y, 0), height - 1) * width + std::min(std::max(x, 0), width - 1)]; };
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const float m = lumaAt(x, y), nw = lumaAt(x - 1, y - 1), ne = lumaAt(x + 1, y - 1), sw = lumaAt(x - 1, y + 1), se = lumaAt(x + 1, y + 1);
+                    const float lumaMin = std::min({m, nw, ne, sw, se});
+                    const float lumaMax = std::max({m, nw, ne, sw, se});
+                    if (lumaMax - lumaMin < std::max(1.f / 16.f, lumaMax / 8.f))
+                    {
+                        continue;
+                    }
+                    float       dirX      = -((nw + ne) - (sw + se));
+                    float       dirY      = (nw + sw) - (ne + se);
+                    const float reduce    = std::max((nw + ne + sw + se) * (0.25f / 8.f), 1.f / 128.f);
+                    const float rcpDirMin = 1.f / (std::min(std::abs(dirX), std::abs(dirY)) + reduce);
+                    dirX                  = std::min(std::max(dirX * rcpDirMin, -8.f), 8.f);
+                    dirY                  = std::min(std::max(dirY * rcpDirMin, -8.f), 8.f);
+                    const Vec4f rgbA  = (sample(x + dirX * (1.f / 3.f - 0.5f), y + dirY * (1.f / 3.f - 0.5f)) + sample(x + dirX * (2.f / 3.f - 0.5f), y + dirY * (2.f / 3.f - 0.5f))) * 0.5f;
+                    const Vec4f rgbB  = rgbA * 0.5f + (sample(x - dirX * 0.5f, y - dirY * 0.5f) + sample(x + dirX * 0.5f, y + dirY * 0.5f)) * 0.25f;
+                    const float lumaB = rgbB[0] * 0.299f + rgbB[1] * 0.587f + rgbB[2] * 0.114f;
+                    const Vec4f chosen = (lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB;
+                    result[y * width + x] = Vec4f{chosen[0], chosen[1], chosen[2], image[y * width + x][3]};
+                }
+            }
+            return result;
+        }
+
+        static void ExpectMatchesReference(const PostProcessSettings& settings)
+        {
+            const FrameBuffer source = MakeHdrFrame();
+            FrameBuffer       destination(POST_WIDTH, POST_HEIGHT);
+            PostProcessor     processor;
+            processor.SetSettings(settings);
+            processor.Process(source, destination);
+
+            const std::vector<Vec4f> expected = ReferencePostProcess(source, settings, processor.GetBloomRadius());
+            for (int y = 0; y < POST_HEIGHT; ++y)
+            {
+                for (int x = 0; x < POST_WIDTH; ++x)
+                {
+                    const Vec4f actual = destination.GetColor(x, y);
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        ASSERT_NEAR(actual[c], std::min(std::max(expected[y * POST_WIDTH + x][c], 0.f), 1.f), 1.5f / 255.f) << x << ", " << y << ", " << c;
+                    }
+                }
+            }
+        }
+
+        TEST(PostProcessTest, ToneMapGammaTest)
+        {
+            PostProcessSettings settings;
+            settings.exposure = 0.8f;
+            ExpectMatchesReference(settings);
+        }
+
+        TEST(PostProcessTest, BloomTest)
+        {
+            PostProcessSettings settings;
+            settings.bloom          = true;
+            settings.bloomSigma     = 3.f;
+            settings.bloomThreshold = 1.5f;
+            settings.bloomIntensity = 0.7f;
+            settings.gammaCorrection = false;
+            ExpectMatchesReference(settings);
+
+            // 高亮区域外也出现泛光
+            const FrameBuffer source = MakeHdrFrame();
+            FrameBuffer       withBloom(POST_WIDTH, POST_HEIGHT);
+            FrameBuffer       withoutBloom(POST_WIDTH, POST_HEIGHT);
+            PostProcessor     processor;
+            processor.SetSettings(settings);
+            processor.Process(source, withBloom);
+            settings.bloom = false;
+            processor.SetSettings(settings);
+            processor.Process(source, withoutBloom);
+            EXPECT_GT(withBloom.GetColor(40, 68)[0], withoutBloom.GetColor(40, 68)[0] + 0.05f);
+            EXPECT_EQ(withBloom.GetColor(130, 95), withoutBloom.GetColor(130, 95));
+        }
+
+        TEST(PostProcessTest, FxaaTest)
+        {
+            PostProcessSettings settings;
+            settings.toneMapping     = false;
+            settings.gammaCorrection = false;
+            settings.fxaa            = true;
+            ExpectMatchesReference(settings);
+
+            // 斜边上出现过渡色，平坦区域不变
+            const FrameBuffer source = MakeHdrFrame();
+            FrameBuffer       destination(POST_WIDTH, POST_HEIGHT);
+            PostProcessor     processor;
+            processor.SetSettings(settings);
+            processor.Process(source, destination);
+            int blended = 0;
+            for (int y = 0; y < POST_HEIGHT; ++y)
+            {
+                for (int x = 71; x < POST_WIDTH; ++x)
+                {
+                    const float blue = destination.GetColor(x, y)[2];
+                    blended += (blue > 0.1f && blue < 0.15f) ? 1 : 0;
+                }
+            }
+            EXPECT_GT(blended, 10);
+            FrameBuffer withoutFxaa(POST_WIDTH, POST_HEIGHT);
+            settings.fxaa = false;
+            processor.SetSettings(settings);
+            processor.Process(source, withoutFxaa);
+            EXPECT_EQ(destination.GetColor(140, 10), withoutFxaa.GetColor(140, 10));
+            EXPECT_EQ(destination.GetColor(10, 10), withoutFxaa.GetColor(10, 10));
+        }
+
+        TEST(PostProcessTest, ThreadCountTest)
+        {
+            PostProcessSettings settings;
+            settings.bloom = true;
+            settings.fxaa  = true;
+            const FrameBuffer source = MakeHdrFrame();
+            FrameBuffer       serial(POST_WIDTH, POST_HEIGHT);
+            PostProcessor     serialProcessor;
+            serialProcessor.SetSettings(settings);
+            serialProcessor.Process(source, serial);
+
+            for (int threadCount : {2, 4})
+            {
+                ThreadPool    pool(threadCount);
+                PostProcessor processor(&pool);
+                processor.SetSettings(settings);
+                FrameBuffer parallel(POST_WIDTH, POST_HEIGHT);
+                processor.Process(source, parallel);
+                for (int y = 0; y < POST_HEIGHT; ++y)
+                {
+                    for (int x = 0; x < POST_WIDTH; ++x)
+                    {
+                        ASSERT_EQ(parallel.GetColor(x, y), serial.GetColor(x, y)) << x << ", " << y;
+                    }
+                }
+            }
+        }
+
+        TEST(PostProcessTest, ThreadPoolTest)
+        {
+            ThreadPool pool(4);
+            EXPECT_EQ(pool.GetThreadCount(), 4);
+            for (int round = 0; round < 20; ++round)
+            {
+                std::vector<int>  visits(257, 0);
+                std::atomic<int>  maxThread{0};
+                pool.ParallelFor(static_cast<int>(visits.size()), [&](int taskIndex, int threadIndex) {
+                    ++visits[taskIndex];
+                    int previous = maxThread.load();
+                    while (previous < threadIndex && !maxThread.compare_exchange_weak(previous, threadIndex))
+                    {
+                    }
+                });
+                EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+                EXPECT_LT(maxThread.load(), 4);
+            }
+            pool.ParallelFor(0, [](int, int) { FAIL(); });
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
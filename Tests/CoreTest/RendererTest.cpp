@@ -0,0 +1,559 @@
+
+#include "Core/Camera.h"
+#include "Core/Renderer.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 测试用着色器: 顶点位置直接作为NDC坐标，法线作为颜色
+         *
+         */
+        struct NdcColorShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const
+            {
+                if (fragmentCount != nullptr)
+                {
+                    ++*fragmentCount;
+                }
+                return Vec4f{varyings[0], varyings[1], varyings[2], 1.f};
+            }
+
+            int* fragmentCount = nullptr;
+        };
+
+        static Mesh MakeQuad(float minX, float minY, float maxX, float maxY, float depth, const Vec3f& color)
+        {
+            Mesh mesh;
+            mesh.vertices = {
+                Joy::Vertex{Vec3f{minX, minY, depth}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{maxX, minY, depth}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{maxX, maxY, depth}, color, Vec2f{}},
+                Joy::Vertex{Vec3f{minX, maxY, depth}, color, Vec2f{}},
+            };
+            mesh.indices = {0, 1, 2, 0, 2, 3};
+            return mesh;
+        }
+
+        TEST(RendererTest, SingleSampleTest)
+        {
+            Renderer renderer{32, 32};
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            // 共享边的两个三角形，每个像素恰好着色一次
+            int            fragmentCount = 0;
+            NdcColorShader shader;
+            shader.fragmentCount = &fragmentCount;
+            renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.5f, Vec3f{1.f, 0.f, 0.f}), shader);
+            EXPECT_EQ(fragmentCount, 32 * 32);
+            EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 0), Vec4f(1.f, 0.f, 0.f, 1.f));
+            EXPECT_EQ(renderer.GetFrameBuffer().GetDepth(31, 31), 0.5f);
+            // 深度测试: 更远的绘制被拒绝，更近的绘制通过
+            fragmentCount = 0;
+            renderer.Draw(MakeQuad(-1.f, -1.f, 0.f, 0.f, 0.8f, Vec3f{0.f, 1.f, 0.f}), shader);
+            EXPECT_EQ(fragmentCount, 0);
+            renderer.Draw(MakeQuad(-1.f, -1.f, 0.f, 0.f, 0.2f, Vec3f{0.f, 0.f, 1.f}), shader);
+            EXPECT_EQ(fragmentCount, 16 * 16);
+            EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 31), Vec4f(0.f, 0.f, 1.f, 1.f));
+            EXPECT_EQ(renderer.GetFrameBuffer().GetColor(31, 0), Vec4f(1.f, 0.f, 0.f, 1.f));
+        }
+
+        /**
+         * @brief 测试用alpha测试着色器: 插值变量x分量小于0.5的片元被丢弃
+         *
+         */
+        struct AlphaTestShader : NdcColorShader
+        {
+            constexpr static bool DISCARDS = true;
+
+            bool Fragment(const float* varyings, Vec4f& color, float& depth) const
+            {
+                ++*fragmentCount;
+                color = Vec4f{varyings[0], 0.f, 1.f, 1.f};
+                depth = 0.f;   // 未声明WRITES_DEPTH，改写的深度被忽略
+                return varyings[0] >= 0.5f;
+            }
+        };
+
+        /**
+         * @brief 测试用改写深度的着色器: 所有片元输出固定深度
+         *
+         */
+        struct DepthOutputShader : NdcColorShader
+        {
+            constexpr static bool WRITES_DEPTH = true;
+
+            bool Fragment(const float*, Vec4f& color, float& depth) const
+            {
+                ++*fragmentCount;
+                color = Vec4f{0.f, 1.f, 0.f, 1.f};
+                depth = outputDepth;
+                return true;
+            }
+
+            float outputDepth = 0.1f;
+        };
+
+        TEST(RendererTest, FragmentDepthBehaviorTest)
+        {
+            static_assert(!Detail::HasFragmentOutputs<NdcColorShader>(), "early-Z shader");
+            static_assert(Detail::ShaderDiscards<AlphaTestShader>::value && !Detail::ShaderWritesDepth<AlphaTestShader>::value, "discarding shader");
+            static_assert(Detail::ShaderWritesDepth<DepthOutputShader>::value && Detail::HasFragmentOutputs<DepthOutputShader>(), "depth output shader");
+            for (int sampleCount : {1, 4})
+            {
+                Renderer renderer{32, 32};
+                renderer.SetSampleCount(sampleCount);
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.5f, Vec3f{1.f, 0.f, 0.f}), NdcColorShader());
+                auto getDepth = [&](int x, int y) {
+                    return sampleCount == 1 ? renderer.GetFrameBuffer().GetDepth(x, y) : renderer.GetMultiSampleBuffer()->GetSampleDepth(x, y, 0);
+                };
+
+                // 横向渐变的插值变量，左半边被丢弃
+                Mesh gradient               = MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.8f, Vec3f{0.f, 0.f, 0.f});
+                gradient.vertices[1].normal = Vec3f{1.f, 0.f, 0.f};
+                gradient.vertices[2].normal = Vec3f{1.f, 0.f, 0.f};
+                int             fragmentCount = 0;
+                AlphaTestShader alphaTest;
+                alphaTest.fragmentCount = &fragmentCount;
+                // 丢弃片元的着色器仍先做深度测试: 被遮挡时一次也不着色
+                renderer.Draw(gradient, alphaTest);
+                EXPECT_EQ(fragmentCount, 0);
+                // 位于前方时丢弃的片元不写入颜色与深度，其余片元写入插值深度
+                for (Joy::Vertex& vertex : gradient.vertices)
+                {
+                    vertex.position[2] = 0.2f;
+                }
+                renderer.Draw(gradient, alphaTest);
+                renderer.Resolve();
+                EXPECT_GT(fragmentCount, 0);
+                if (sampleCount == 1)
+                {
+                    EXPECT_EQ(fragmentCount, 32 * 32);
+                }
+                EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 5), Vec4f(1.f, 0.f, 0.f, 1.f));
+                EXPECT_FLOAT_EQ(getDepth(0, 5), 0.5f);
+                EXPECT_GT(renderer.GetFrameBuffer().GetColor(31, 5)[0], 0.5f);
+                EXPECT_FLOAT_EQ(renderer.GetFrameBuffer().GetColor(31, 5)[2], 1.f);
+                EXPECT_FLOAT_EQ(getDepth(31, 5), 0.2f);
+
+                // 改写深度的着色器先着色再测试: 位于后方的四边形以输出深度通过测试
+                fragmentCount = 0;
+                DepthOutputShader depthOutput;
+                depthOutput.fragmentCount = &fragmentCount;
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.9f, Vec3f{0.f, 0.f, 0.f}), depthOutput);
+                renderer.Resolve();
+                EXPECT_GT(fragmentCount, 0);
+                EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 5), Vec4f(0.f, 1.f, 0.f, 1.f));
+                EXPECT_EQ(renderer.GetFrameBuffer().GetColor(31, 5), Vec4f(0.f, 1.f, 0.f, 1.f));
+                EXPECT_FLOAT_EQ(getDepth(0, 5), 0.1f);
+                // 输出深度未通过测试时不写入，但着色仍会执行
+                const int shadedBefore  = fragmentCount;
+                depthOutput.outputDepth = 0.3f;
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.05f, Vec3f{0.f, 0.f, 0.f}), depthOutput);
+                EXPECT_GT(fragmentCount, shadedBefore);
+                EXPECT_FLOAT_EQ(getDepth(0, 5), 0.1f);
+            }
+        }
+
+        TEST(RendererTest, CullAndClipTest)
+        {
+            Renderer renderer{16, 16};
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            // 顺时针三角形被背面剔除
+            Mesh mesh = MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.5f, Vec3f{1.f, 1.f, 1.f});
+            mesh.indices = {0, 2, 1};
+            int            fragmentCount = 0;
+            NdcColorShader shader;
+            shader.fragmentCount = &fragmentCount;
+            renderer.Draw(mesh, shader);
+            EXPECT_EQ(fragmentCount, 0);
+            renderer.SetCullMode(EnumCullMode::NONE);
+            renderer.Draw(mesh, shader);
+            EXPECT_GT(fragmentCount, 0);
+            // 跨越近平面的三角形被裁剪后只绘制z >= 0的部分
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+            fragmentCount = 0;
+            Mesh clipped  = MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.f, Vec3f{1.f, 1.f, 1.f});
+            clipped.vertices[0].position = Vec3f{-1.f, -1.f, -1.f};
+            clipped.vertices[1].position = Vec3f{1.f, -1.f, -1.f};
+            clipped.vertices[2].position = Vec3f{1.f, 1.f, 1.f};
+            clipped.vertices[3].position = Vec3f{-1.f, 1.f, 1.f};
+            renderer.Draw(clipped, shader);
+            EXPECT_EQ(fragmentCount, 16 * 8);
+            EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 0), Vec4f(1.f, 1.f, 1.f, 1.f));
+            EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 15), Vec4f(0.f, 0.f, 0.f, 1.f));
+        }
+
+        TEST(RendererTest, MultiSampleTest)
+        {
+            for (int sampleCount : {4, 8})
+            {
+                Renderer renderer{16, 16};
+                renderer.SetSampleCount(sampleCount);
+                EXPECT_EQ(renderer.GetSampleCount(), sampleCount);
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                // 完全覆盖的像素保持压缩存储，每像素只着色一次
+                int            fragmentCount = 0;
+                NdcColorShader shader;
+                shader.fragmentCount = &fragmentCount;
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.5f, Vec3f{1.f, 1.f, 1.f}), shader);
+                const MultiSampleBuffer* msBuffer = renderer.GetMultiSampleBuffer();
+                ASSERT_NE(msBuffer, nullptr);
+                EXPECT_TRUE(msBuffer->IsPixelCompressed(3, 7));
+                // 对角线三角形: 边缘像素展开，内部像素压缩
+                Mesh triangle;
+                triangle.vertices = {
+                    Joy::Vertex{Vec3f{-1.f, -1.f, 0.2f}, Vec3f{0.f, 0.f, 0.f}, Vec2f{}},
+                    Joy::Vertex{Vec3f{1.f, -1.f, 0.2f}, Vec3f{0.f, 0.f, 0.f}, Vec2f{}},
+                    Joy::Vertex{Vec3f{-1.f, 1.f, 0.2f}, Vec3f{0.f, 0.f, 0.f}, Vec2f{}},
+                };
+                triangle.indices = {0, 1, 2};
+                fragmentCount    = 0;
+                renderer.Draw(triangle, shader);
+                EXPECT_LE(fragmentCount, 16 * 17 / 2 + 16);
+                EXPECT_TRUE(msBuffer->IsPixelCompressed(0, 15));
+                EXPECT_TRUE(msBuffer->IsPixelCompressed(15, 3));
+                EXPECT_FALSE(msBuffer->IsPixelCompressed(4, 4));
+                // 解析: 压缩像素直接输出，边缘像素为采样平均
+                renderer.Resolve();
+                const FrameBuffer& frameBuffer = renderer.GetFrameBuffer();
+                EXPECT_EQ(frameBuffer.GetColor(0, 15), Vec4f(0.f, 0.f, 0.f, 1.f));
+                EXPECT_EQ(frameBuffer.GetColor(15, 3), Vec4f(1.f, 1.f, 1.f, 1.f));
+                EXPECT_EQ(frameBuffer.GetColor(15, 0), Vec4f(1.f, 1.f, 1.f, 1.f));
+                const float edge = frameBuffer.GetColor(4, 4)[0];
+                EXPECT_GT(edge, 0.f);
+                EXPECT_LT(edge, 1.f);
+                EXPECT_NEAR(edge, 0.5f, 0.2f);
+                EXPECT_EQ(frameBuffer.GetDepth(0, 15), 0.2f);
+            }
+        }
+        TEST(RendererTest, ReverseZTest)
+        {
+            for (int sampleCount : {1, 4})
+            {
+                Renderer renderer{16, 16};
+                renderer.SetSampleCount(sampleCount);
+                renderer.SetDepthTest(EnumDepthTest::GREATER);
+                EXPECT_EQ(renderer.GetDepthTest(), EnumDepthTest::GREATER);
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f}, 0.f);
+                // 反向Z中深度越大越近，后绘制的较远平面被拒绝
+                int            fragmentCount = 0;
+                NdcColorShader shader;
+                shader.fragmentCount = &fragmentCount;
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.8f, Vec3f{1.f, 0.f, 0.f}), shader);
+                // MSAA下对角线上的像素被两个三角形各着色一次
+                EXPECT_GE(fragmentCount, 16 * 16);
+                fragmentCount = 0;
+                renderer.Draw(MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.2f, Vec3f{0.f, 1.f, 0.f}), shader);
+                EXPECT_EQ(fragmentCount, 0);
+                renderer.Draw(MakeQuad(-1.f, -1.f, 0.f, 0.f, 0.9f, Vec3f{0.f, 0.f, 1.f}), shader);
+                EXPECT_GE(fragmentCount, 8 * 8);
+                EXPECT_LE(fragmentCount, 8 * 8 + 8);
+                renderer.Resolve();
+                EXPECT_EQ(renderer.GetFrameBuffer().GetColor(0, 15), Vec4f(0.f, 0.f, 1.f, 1.f));
+                EXPECT_EQ(renderer.GetFrameBuffer().GetColor(15, 0), Vec4f(1.f, 0.f, 0.f, 1.f));
+                EXPECT_EQ(renderer.GetFrameBuffer().GetDepth(15, 0), 0.8f);
+            }
+        }
+
+        /**
+         * @brief 测试用着色器: 顶点经相机的观察投影矩阵变换，输出白色
+         *
+         */
+        struct ViewProjShader
+        {
+            constexpr static int VARYING_COUNT = 0;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float*) const { return viewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f}; }
+
+            Vec4f Fragment(const float*) const { return Vec4f{1.f, 1.f, 1.f, 1.f}; }
+
+            Mat4x4f viewProj;
+        };
+
+        TEST(RendererTest, ReverseZNearClipTest)
+        {
+            // 地面三角形的一个顶点位于相机后方，需经近平面裁剪；反向Z与无穷远平面下覆盖范围与标准深度一致
+            Mesh ground;
+            ground.vertices = {
+                Joy::Vertex{Vec3f{-5.f, 0.f, -20.f}, Vec3f{}, Vec2f{}},
+                Joy::Vertex{Vec3f{5.f, 0.f, -20.f}, Vec3f{}, Vec2f{}},
+                Joy::Vertex{Vec3f{0.f, 0.f, 5.f}, Vec3f{}, Vec2f{}},
+            };
+            ground.indices = {0, 1, 2};
+
+            std::vector<bool> coverages[2];
+            for (int reversed = 0; reversed < 2; ++reversed)
+            {
+                for (int sampleCount : {1, 4})
+                {
+                    Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 1.f, 0.f}, Vec3f{0.f, 1.f, -1.f}, 0.1f, 100.f, 60.f);
+                    camera.SetAspect(1.f);
+                    if (reversed != 0)
+                    {
+                        camera.SetDepthRange(Camera::EnumDepthRange::REVERSED);
+                        camera.SetInfiniteFar(true);
+                    }
+                    Renderer renderer{64, 64};
+                    renderer.SetSampleCount(sampleCount);
+                    renderer.SetCullMode(EnumCullMode::NONE);
+                    renderer.SetDepthTest(reversed != 0 ? EnumDepthTest::GREATER : EnumDepthTest::LESS);
+                    renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f}, camera.GetFarDepth());
+                    ViewProjShader shader;
+                    shader.viewProj = camera.GetViewProjMatrix();
+                    renderer.Draw(ground, shader);
+                    renderer.Resolve();
+
+                    std::vector<bool> coverage(64 * 64);
+                    int               coveredCount = 0;
+                    for (int y = 0; y < 64; ++y)
+                    {
+                        for (int x = 0; x < 64; ++x)
+                        {
+                            coverage[y * 64 + x] = renderer.GetFrameBuffer().GetColor(x, y)[0] > 0.f;
+                            coveredCount += coverage[y * 64 + x] ? 1 : 0;
+                        }
+                    }
+                    EXPECT_GT(coveredCount, 64 * 16) << reversed << " " << sampleCount;
+                    if (sampleCount == 1)
+                    {
+                        coverages[reversed] = coverage;
+                    }
+                }
+            }
+            int differentCount = 0;
+            for (size_t i = 0; i < coverages[0].size(); ++i)
+            {
+                differentCount += coverages[0][i] != coverages[1][i] ? 1 : 0;
+            }
+            // 两种深度范围的近平面裁剪点因浮点舍入略有差异，只允许边缘处个别像素不同
+            EXPECT_LE(differentCount, 8);
+        }
+
+        TEST(RendererTest, FixedPointSetupTest)
+        {
+            // 共享顶点的三角扇，顶点位于任意子像素位置: 定点建立保证共享边上每个像素恰好被一个三角形覆盖
+            constexpr int    SIZE         = 64;
+            constexpr int    SEGMENTS     = 17;
+            const RasterRect scissor{0, 0, SIZE, SIZE};
+            std::vector<int> coverage(SIZE * SIZE, 0);
+            const float      centerX = 31.337f;
+            const float      centerY = 30.91f;
+            for (int i = 0; i < SEGMENTS; ++i)
+            {
+                const float  angle0 = 6.2831853f * static_cast<float>(i) / SEGMENTS;
+                const float  angle1 = 6.2831853f * static_cast<float>(i + 1) / SEGMENTS;
+                RasterVertex v0{centerX, centerY, 0.5f, 1.f};
+                RasterVertex v1{centerX + 50.f * std::cos(angle0), centerY + 50.f * std::sin(angle0), 0.5f, 1.f};
+                RasterVertex v2{centerX + 50.f * std::cos(angle1), centerY + 50.f * std::sin(angle1), 0.5f, 1.f};
+                RasterTriangle tri;
+                if (SetupTriangle(v0, v1, v2, EnumCullMode::NONE, scissor, tri))
+                {
+                    RasterizeTriangle(tri, 1, [&](int x, int y, uint32_t, const float*, const float*) { ++coverage[y * SIZE + x]; });
+                }
+            }
+            for (int i = 0; i < SIZE * SIZE; ++i)
+            {
+                ASSERT_EQ(coverage[i], 1) << i % SIZE << ", " << i / SIZE;
+            }
+            // 超出保护带或为NaN的顶点被丢弃
+            RasterTriangle tri;
+            EXPECT_FALSE(SetupTriangle(RasterVertex{0.f, 0.f, 0.5f, 1.f}, RasterVertex{1e8f, 0.f, 0.5f, 1.f}, RasterVertex{0.f, 10.f, 0.5f, 1.f},
+                                       EnumCullMode::NONE, scissor, tri));
+            EXPECT_FALSE(SetupTriangle(RasterVertex{0.f, 0.f, 0.5f, 1.f}, RasterVertex{NAN, 0.f, 0.5f, 1.f}, RasterVertex{0.f, 10.f, 0.5f, 1.f},
+                                       EnumCullMode::NONE, scissor, tri));
+        }
+
+        /**
+         * @brief 带随机扰动的细密网格(类似扫描网格)，每个格子约1.3像素，覆盖整个屏幕
+         *
+         */
+        static std::vector<RasterVertex> MakeJitteredGrid(int cellCount, float size, uint32_t seed)
+        {
+            std::mt19937                          random(seed);
+            std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+            std::uniform_real_distribution<float> depth(0.2f, 0.8f);
+            const float                           cellSize = size / static_cast<float>(cellCount);
+            std::vector<RasterVertex>             grid;
+            for (int y = 0; y <= cellCount; ++y)
+            {
+                for (int x = 0; x <= cellCount; ++x)
+                {
+                    // 边界顶点不扰动，保证网格覆盖整个屏幕
+                    const bool interiorX = x > 0 && x < cellCount;
+                    const bool interiorY = y > 0 && y < cellCount;
+                    grid.push_back(RasterVertex{(static_cast<float>(x) + (interiorX ? jitter(random) : 0.f)) * cellSize,
+                                                (static_cast<float>(y) + (interiorY ? jitter(random) : 0.f)) * cellSize,
+                                                depth(random),
+                                                1.f / (1.f + depth(random))});
+                }
+            }
+            return grid;
+        }
+
+        TEST(RendererTest, MicroTriangleBatchTest)
+        {
+            constexpr int    SIZE      = 32;
+            constexpr int    CELLS     = 24;
+            const RasterRect scissor{2, 3, 30, 29};
+            const auto       grid = MakeJitteredGrid(CELLS, static_cast<float>(SIZE), 20251222u);
+            std::vector<int> microCoverage(SIZE * SIZE, 0);
+
+            for (EnumCullMode cullMode : {EnumCullMode::NONE, EnumCullMode::BACK, EnumCullMode::FRONT})
+            {
+                std::fill(microCoverage.begin(), microCoverage.end(), 0);
+                MicroTriangleBatch              batch;
+                std::vector<std::array<int, 3>> batchTriangles;
+                auto                            flush = [&]() {
+                    RasterizeMicroBatch(batch, cullMode, scissor, [&](int lane, int x, int y, float depth, const float* bary) {
+                        ++microCoverage[y * SIZE + x];
+                        // 与通用路径逐像素比较深度与重心坐标
+                        const std::array<int, 3>& indices = batchTriangles[lane];
+                        RasterTriangle            tri;
+                        ASSERT_TRUE(SetupTriangle(grid[indices[0]], grid[indices[1]], grid[indices[2]], cullMode, scissor, tri));
+                        bool found = false;
+                        RasterizeTriangle(tri, 1, [&](int rx, int ry, uint32_t, const float* sampleDepths, const float* referenceBary) {
+                            if (rx == x && ry == y)
+                            {
+                                found = true;
+                                EXPECT_NEAR(depth, sampleDepths[0], 1e-5f);
+                                for (int k = 0; k < 3; ++k)
+                                {
+                                    EXPECT_NEAR(bary[k], referenceBary[k], 1e-5f);
+                                }
+                            }
+                        });
+                        EXPECT_TRUE(found) << x << ", " << y;
+                    });
+                    batch.Reset();
+                    batchTriangles.clear();
+                };
+
+                int generalPixelCount = 0;
+                for (int y = 0; y < CELLS; ++y)
+                {
+                    for (int x = 0; x < CELLS; ++x)
+                    {
+                        const int i0 = y * (CELLS + 1) + x;
+                        const int i1 = i0 + CELLS + 1;
+                        // 两个三角形绕序相反，剔除模式各保留一半
+                        for (const std::array<int, 3>& indices : {std::array<int, 3>{i0, i0 + 1, i1 + 1}, std::array<int, 3>{i0, i1, i1 + 1}})
+                        {
+                            RasterTriangle tri;
+                            if (SetupTriangle(grid[indices[0]], grid[indices[1]], grid[indices[2]], cullMode, scissor, tri))
+                            {
+                                RasterizeTriangle(tri, 1, [&](int, int, uint32_t, const float*, const float*) { ++generalPixelCount; });
+                            }
+                            ASSERT_TRUE(AddMicroTriangle(batch, grid[indices[0]], grid[indices[1]], grid[indices[2]]));
+                            batchTriangles.push_back(indices);
+                            if (batch.IsFull())
+                            {
+                                flush();
+                            }
+                        }
+                    }
+                }
+                flush();
+
+                // 覆盖像素总数与通用路径一致；不剔除时裁剪矩形内每个像素恰好被覆盖一次
+                int microPixelCount = 0;
+                for (int y = 0; y < SIZE; ++y)
+                {
+                    for (int x = 0; x < SIZE; ++x)
+                    {
+                        const bool inScissor = x >= scissor.minX && x < scissor.maxX && y >= scissor.minY && y < scissor.maxY;
+                        microPixelCount += microCoverage[y * SIZE + x];
+                        if (!inScissor || cullMode == EnumCullMode::NONE)
+                        {
+                            ASSERT_EQ(microCoverage[y * SIZE + x], inScissor ? 1 : 0) << x << ", " << y;
+                        }
+                    }
+                }
+                EXPECT_EQ(microPixelCount, generalPixelCount);
+            }
+
+            // 包围盒超出4x4像素的三角形不进入批次
+            MicroTriangleBatch batch;
+            EXPECT_FALSE(AddMicroTriangle(batch, RasterVertex{0.f, 0.f, 0.5f, 1.f}, RasterVertex{4.5f, 0.f, 0.5f, 1.f}, RasterVertex{0.f, 1.f, 0.5f, 1.f}));
+            EXPECT_TRUE(AddMicroTriangle(batch, RasterVertex{0.5f, 0.f, 0.5f, 1.f}, RasterVertex{4.f, 0.f, 0.5f, 1.f}, RasterVertex{0.5f, 3.9f, 0.5f, 1.f}));
+            EXPECT_FALSE(AddMicroTriangle(batch, RasterVertex{0.5f, 0.f, 0.5f, 1.f}, RasterVertex{NAN, 0.f, 0.5f, 1.f}, RasterVertex{0.5f, 1.f, 0.5f, 1.f}));
+            EXPECT_EQ(batch.count, 1);
+        }
+
+        TEST(RendererTest, SmallTriangleFastPathTest)
+        {
+            // NDC中的细密网格(红色)之后绘制同深度的整屏四边形(绿色): 批次必须先于后续的通用三角形写入，LESS测试下红色保留
+            constexpr int SIZE  = 48;
+            constexpr int CELLS = 40;
+            Mesh          mesh;
+            for (int y = 0; y <= CELLS; ++y)
+            {
+                for (int x = 0; x <= CELLS; ++x)
+                {
+                    const float ndcX = -1.f + 2.f * static_cast<float>(x) / CELLS;
+                    const float ndcY = -1.f + 2.f * static_cast<float>(y) / CELLS;
+                    mesh.vertices.push_back(Joy::Vertex{Vec3f{ndcX, ndcY, 0.5f}, Vec3f{1.f, 0.5f + 0.25f * ndcX, 0.5f + 0.25f * ndcY}, Vec2f{}});
+                }
+            }
+            for (uint32_t y = 0; y < CELLS; ++y)
+            {
+                for (uint32_t x = 0; x < CELLS; ++x)
+                {
+                    const uint32_t i0 = y * (CELLS + 1) + x;
+                    const uint32_t i1 = i0 + CELLS + 1;
+                    mesh.indices.insert(mesh.indices.end(), {i0, i0 + 1, i1 + 1, i0, i1 + 1, i1});
+                }
+            }
+            const Mesh     quad      = MakeQuad(-1.f, -1.f, 1.f, 1.f, 0.5f, Vec3f{0.f, 1.f, 0.f});
+            const uint32_t quadStart = static_cast<uint32_t>(mesh.vertices.size());
+            mesh.vertices.insert(mesh.vertices.end(), quad.vertices.begin(), quad.vertices.end());
+            for (uint32_t index : quad.indices)
+            {
+                mesh.indices.push_back(quadStart + index);
+            }
+
+            Renderer fast{SIZE, SIZE};
+            Renderer general{SIZE, SIZE};
+            general.SetSmallTriangleFastPath(false);
+            EXPECT_TRUE(fast.IsSmallTriangleFastPathEnabled());
+            int fastFragments    = 0;
+            int generalFragments = 0;
+            for (Renderer* renderer : {&fast, &general})
+            {
+                NdcColorShader shader;
+                shader.fragmentCount = renderer == &fast ? &fastFragments : &generalFragments;
+                renderer->Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer->Draw(mesh, shader);
+            }
+            EXPECT_EQ(fastFragments, generalFragments);
+            EXPECT_EQ(fastFragments, SIZE * SIZE);
+            for (int y = 0; y < SIZE; ++y)
+            {
+                for (int x = 0; x < SIZE; ++x)
+                {
+                    const Vec4f color = fast.GetFrameBuffer().GetColor(x, y);
+                    ASSERT_EQ(color[0], 1.f) << x << ", " << y;
+                    EXPECT_EQ(color, general.GetFrameBuffer().GetColor(x, y));
+                    EXPECT_EQ(fast.GetFrameBuffer().GetDepth(x, y), general.GetFrameBuffer().GetDepth(x, y));
+                }
+            }
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,88 @@
+
+#include "Core/ShadowMap.h"
+#include "gtest/gtest.h"
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 生成平行于XZ平面的四边形(法线朝+Y)
+         *
+         */
+        static Mesh MakeHorizontalQuad(float minX, float minZ, float maxX, float maxZ, float height)
+        {
+            Mesh mesh;
+            mesh.vertices = {
+                Joy::Vertex{Vec3f{minX, height, minZ}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}},
+                Joy::Vertex{Vec3f{minX, height, maxZ}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}},
+                Joy::Vertex{Vec3f{maxX, height, maxZ}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}},
+                Joy::Vertex{Vec3f{maxX, height, minZ}, Vec3f{0.f, 1.f, 0.f}, Vec2f{}},
+            };
+            mesh.indices = {0, 1, 2, 0, 2, 3};
+            return mesh;
+        }
+
+        TEST(ShadowMapTest, DepthOnlyAndPcfTest)
+        {
+            // 正交光源自上而下照射，遮挡体覆盖左半部分
+            const Camera light(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 10.f, 0.f}, Vec3f{0.f, 0.f, 0.f}, 0.f, 20.f, 4.f);
+            ShadowMap    shadowMap(30);
+            shadowMap.RenderDepth(MakeHorizontalQuad(-4.f, -4.f, 0.f, 4.f, 2.f), light.GetViewProjMatrix());
+            int covered = 0;
+            for (int y = 0; y < 30; ++y)
+            {
+                for (int x = 0; x < 30; ++x)
+                {
+                    covered += shadowMap.GetDepth(x, y) < 1.f;
+                }
+            }
+            EXPECT_EQ(covered, 15 * 30);
+            // 自上而下观察时光源右方向为世界-X，遮挡体位于阴影图右半部分
+            EXPECT_NEAR(shadowMap.GetDepth(26, 3), 0.4f, 1e-5f);
+            EXPECT_EQ(shadowMap.GetDepth(3, 3), 1.f);
+
+            const Vec4f shadowed = light.GetViewProjMatrix() * Vec4f{-2.f, 0.f, 1.f, 1.f};
+            const Vec4f lit      = light.GetViewProjMatrix() * Vec4f{2.f, 0.f, 1.f, 1.f};
+            const auto  sample   = [&](const Vec4f& clip) { return shadowMap.SampleCompare(clip[0] * 0.5f + 0.5f, 0.5f - clip[1] * 0.5f, clip[2] - 0.001f); };
+            EXPECT_EQ(sample(shadowed), 0.f);
+            EXPECT_EQ(sample(lit), 1.f);
+            // 遮挡体边缘处PCF产生半影
+            const float edge = sample(light.GetViewProjMatrix() * Vec4f{0.f, 0.f, 1.f, 1.f});
+            EXPECT_GT(edge, 0.f);
+            EXPECT_LT(edge, 1.f);
+            // 遮挡体自身不被遮挡(深度相等时受光)
+            EXPECT_EQ(sample(light.GetViewProjMatrix() * Vec4f{-2.f, 2.f, 1.f, 1.f}), 1.f);
+        }
+
+        TEST(ShadowMapTest, CascadeTest)
+        {
+            float splits[CascadedShadowMap::MAX_CASCADE_COUNT + 1];
+            CascadedShadowMap::ComputeSplitDistances(1.f, 100.f, 4, 1.f, splits);
+            EXPECT_FLOAT_EQ(splits[0], 1.f);
+            EXPECT_NEAR(splits[2], 10.f, 1e-4f);
+            EXPECT_FLOAT_EQ(splits[4], 100.f);
+
+            Camera camera(Camera::EnumCameraType::PERSPECTIVE, Vec3f{0.f, 5.f, 10.f}, Vec3f{0.f, 0.f, 0.f}, 0.5f, 60.f, 60.f);
+            CascadedShadowMap shadowMaps(256, 3);
+            shadowMaps.Update(camera, Vec3f{0.2f, -1.f, 0.1f});
+            for (int cascade = 0; cascade + 1 < shadowMaps.GetCascadeCount(); ++cascade)
+            {
+                EXPECT_LT(shadowMaps.GetSplitDistance(cascade), shadowMaps.GetSplitDistance(cascade + 1));
+                EXPECT_LT(shadowMaps.GetLightCamera(cascade).GetSize(), shadowMaps.GetLightCamera(cascade + 1).GetSize());
+            }
+            EXPECT_EQ(shadowMaps.SelectCascade(0.1f), -1);
+            EXPECT_EQ(shadowMaps.SelectCascade(0.6f), 0);
+            EXPECT_EQ(shadowMaps.SelectCascade(59.f), 2);
+            EXPECT_EQ(shadowMaps.SelectCascade(61.f), -1);
+
+            // 地面上方悬浮的平板在地面投下阴影
+            shadowMaps.Render(MakeHorizontalQuad(-1.f, -1.f, 1.f, 1.f, 1.f), MAT4X4F_IDENTITY);
+            shadowMaps.Render(MakeHorizontalQuad(-50.f, -50.f, 50.f, 50.f, 0.f), MAT4X4F_IDENTITY);
+            EXPECT_EQ(shadowMaps.Sample(Vec3f{0.2f, 0.f, 0.1f}), 0.f);
+            EXPECT_EQ(shadowMaps.Sample(Vec3f{3.f, 0.f, 0.f}), 1.f);
+            EXPECT_EQ(shadowMaps.Sample(Vec3f{0.f, 1.f, 0.f}), 1.f);
+            EXPECT_EQ(shadowMaps.Sample(Vec3f{-20.f, 0.f, -30.f}), 1.f);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
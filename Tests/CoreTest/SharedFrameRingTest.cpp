@@ -0,0 +1,161 @@
+
+#include "Core/SharedFrameRing.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        constexpr int SHARED_FRAME_WIDTH  = 64;
+        constexpr int SHARED_FRAME_HEIGHT = 48;
+
+        static std::string GetRingName(const char* testName) { return std::string("/JoySharedFrameTest_") + testName + "_" + std::to_string(getpid()); }
+
+        /**
+         * @brief 每帧的图案: 偶数行逐行写入、奇数行来自快速清除，颜色随序号变化，撕裂的帧必然对不上
+         *
+         */
+        static Vec4f GetPatternColor(uint64_t sequence, int y)
+        {
+            return Vec4f{static_cast<float>(sequence % 200) / 255.f, (y % 2) * 0.5f, static_cast<float>((sequence * 7) % 256) / 255.f, 1.f};
+        }
+
+        static void RenderPattern(SharedFrameRing& ring, FrameBuffer& frameBuffer, uint64_t sequence)
+        {
+            ring.BeginFrame(frameBuffer);
+            frameBuffer.ClearColor(GetPatternColor(sequence, 1));
+            std::vector<Vec4f> row(SHARED_FRAME_WIDTH, GetPatternColor(sequence, 0));
+            for (int y = 0; y < SHARED_FRAME_HEIGHT; y += 2)
+            {
+                frameBuffer.SetColorSpan(0, y, SHARED_FRAME_WIDTH, row.data());
+            }
+            EXPECT_EQ(ring.PublishFrame(frameBuffer), sequence);
+        }
+
+        static bool MatchesPattern(const uint8_t* data, int pitch, uint64_t sequence)
+        {
+            for (int y = 0; y < SHARED_FRAME_HEIGHT; ++y)
+            {
+                uint8_t expected[4];
+                PackColor(EnumColorFormat::RGBA8, GetPatternColor(sequence, y), expected);
+                for (int x = 0; x < SHARED_FRAME_WIDTH; ++x)
+                {
+                    if (std::memcmp(&data[y * pitch + x * 4], expected, 4) != 0)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        TEST(SharedFrameRingTest, PublishAcquireTest)
+        {
+            const std::string name = GetRingName("PublishAcquire");
+            SharedFrameRing   producer;
+            ASSERT_TRUE(producer.Create(name, SHARED_FRAME_WIDTH, SHARED_FRAME_HEIGHT, EnumColorFormat::RGBA8, 4));
+            SharedFrameRing consumer;
+            ASSERT_TRUE(consumer.Open(name));
+            EXPECT_EQ(consumer.GetWidth(), SHARED_FRAME_WIDTH);
+            EXPECT_EQ(consumer.GetHeight(), SHARED_FRAME_HEIGHT);
+            EXPECT_EQ(consumer.GetColorFormat(), EnumColorFormat::RGBA8);
+            EXPECT_EQ(consumer.GetColorPitch(), SHARED_FRAME_WIDTH * 4);
+            EXPECT_EQ(consumer.GetSlotCount(), 4);
+            EXPECT_EQ(consumer.AcquireLatestFrame(), nullptr);
+            EXPECT_EQ(consumer.GetLatestSequence(), 0u);
+
+            // 渲染直接写入共享内存，消费者看到的就是帧缓冲的颜色存储
+            FrameBuffer frameBuffer(SHARED_FRAME_WIDTH, SHARED_FRAME_HEIGHT, EnumColorFormat::RGBA8);
+            RenderPattern(producer, frameBuffer, 1);
+            uint64_t       sequence = 0;
+            const uint8_t* frame    = consumer.AcquireLatestFrame(&sequence);
+            ASSERT_NE(frame, nullptr);
+            EXPECT_EQ(sequence, 1u);
+            EXPECT_TRUE(MatchesPattern(frame, consumer.GetColorPitch(), 1));
+            consumer.ReleaseFrame();
+
+            // 消费者持有的帧不会被覆盖，之后取到的总是最新帧
+            frame = consumer.AcquireLatestFrame(&sequence);
+            for (uint64_t next = 2; next <= 20; ++next)
+            {
+                RenderPattern(producer, frameBuffer, next);
+                EXPECT_TRUE(MatchesPattern(frame, consumer.GetColorPitch(), 1));
+            }
+            EXPECT_EQ(consumer.GetLatestSequence(), 20u);
+            frame = consumer.AcquireLatestFrame(&sequence);
+            EXPECT_EQ(sequence, 20u);
+            EXPECT_TRUE(MatchesPattern(frame, consumer.GetColorPitch(), 20));
+
+            // 生产者关闭后对象被删除，已映射的消费者仍可读取
+            producer.Close();
+            EXPECT_TRUE(MatchesPattern(frame, consumer.GetColorPitch(), 20));
+            SharedFrameRing late;
+            EXPECT_FALSE(late.Open(name));
+        }
+
+        TEST(SharedFrameRingTest, ConsumerProcessTest)
+        {
+            // 子进程作为独立的消费者，逐帧检查没有撕裂且序号单调
+            constexpr uint64_t FRAME_COUNT = 300;
+            const std::string  name        = GetRingName("ConsumerProcess");
+            SharedFrameRing    producer;
+            ASSERT_TRUE(producer.Create(name, SHARED_FRAME_WIDTH, SHARED_FRAME_HEIGHT, EnumColorFormat::RGBA8));
+
+            const pid_t child = fork();
+            ASSERT_GE(child, 0);
+            if (child == 0)
+            {
+                SharedFrameRing consumer;
+                if (!consumer.Open(name))
+                {
+                    _exit(3);
+                }
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+                uint64_t   lastSeen = 0;
+                while (lastSeen < FRAME_COUNT)
+                {
+                    if (std::chrono::steady_clock::now() > deadline)
+                    {
+                        _exit(2);
+                    }
+                    if (consumer.GetLatestSequence() == lastSeen)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    uint64_t       sequence = 0;
+                    const uint8_t* frame    = consumer.AcquireLatestFrame(&sequence);
+                    if (sequence <= lastSeen)
+                    {
+                        _exit(4);
+                    }
+                    if (!MatchesPattern(frame, consumer.GetColorPitch(), sequence))
+                    {
+                        _exit(1);
+                    }
+                    consumer.ReleaseFrame();
+                    lastSeen = sequence;
+                }
+                _exit(0);
+            }
+
+            FrameBuffer frameBuffer(SHARED_FRAME_WIDTH, SHARED_FRAME_HEIGHT, EnumColorFormat::RGBA8);
+            for (uint64_t sequence = 1; sequence <= FRAME_COUNT; ++sequence)
+            {
+                RenderPattern(producer, frameBuffer, sequence);
+                std::this_thread::yield();
+            }
+            int status = 0;
+            ASSERT_EQ(waitpid(child, &status, 0), child);
+            ASSERT_TRUE(WIFEXITED(status));
+            EXPECT_EQ(WEXITSTATUS(status), 0) << "1: torn frame, 2: timeout, 3: open failed, 4: sequence went backwards";
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,176 @@
+
+#include "Core/Rasterizer.h"
+#include "Core/SimdKernels.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 本机可用的全部内核路径
+         *
+         */
+        static std::vector<const SimdKernels*> GetAvailableKernels()
+        {
+            std::vector<const SimdKernels*> ret;
+            for (EnumSimdLevel level : {EnumSimdLevel::SCALAR, EnumSimdLevel::SSE2, EnumSimdLevel::AVX2, EnumSimdLevel::AVX512})
+            {
+                if (const SimdKernels* kernels = FindSimdKernels(level))
+                {
+                    ret.push_back(kernels);
+                }
+            }
+            return ret;
+        }
+
+        static bool BitEqual(const void* lhs, const void* rhs, size_t size) { return std::memcmp(lhs, rhs, size) == 0; }
+
+        TEST(SimdKernelsTest, DispatchTest)
+        {
+            const std::vector<const SimdKernels*> available = GetAvailableKernels();
+            ASSERT_FALSE(available.empty());
+            // 默认选择检测到的最宽路径(未通过JOY_SIMD_LEVEL强制时)
+            EXPECT_EQ(FindSimdKernels(DetectSimdLevel()), available.back());
+            const EnumSimdLevel previous = GetSimdLevel();
+            for (const SimdKernels* kernels : available)
+            {
+                EXPECT_TRUE(SetSimdLevel(kernels->level));
+                EXPECT_EQ(&GetSimdKernels(), kernels);
+                EXPECT_EQ(GetSimdLevel(), kernels->level);
+                EXPECT_STRNE(GetSimdLevelName(kernels->level), "Unknown");
+            }
+            EXPECT_EQ(SetSimdLevel(static_cast<EnumSimdLevel>(static_cast<int>(EnumSimdLevel::AVX512) + 1)), false);
+            EXPECT_TRUE(SetSimdLevel(previous));
+        }
+
+        TEST(SimdKernelsTest, ForcedLevelTest)
+        {
+            // 不超过检测结果的每个等级(含标量)都能被强制选中，且选中的就是该等级
+            const EnumSimdLevel previous = GetSimdLevel();
+            for (int level = static_cast<int>(EnumSimdLevel::SCALAR); level <= static_cast<int>(DetectSimdLevel()); ++level)
+            {
+                const EnumSimdLevel forced = static_cast<EnumSimdLevel>(level);
+#if !(defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+                // 非x86只编译了标量路径
+                if (forced != EnumSimdLevel::SCALAR)
+                {
+                    continue;
+                }
+#endif
+                const SimdKernels* kernels = FindSimdKernels(forced);
+                ASSERT_NE(kernels, nullptr) << GetSimdLevelName(forced);
+                EXPECT_EQ(kernels->level, forced);
+                EXPECT_TRUE(SetSimdLevel(forced)) << GetSimdLevelName(forced);
+                EXPECT_EQ(GetSimdLevel(), forced);
+            }
+            EXPECT_EQ(FindSimdKernels(EnumSimdLevel::SCALAR), &Detail::GetScalarSimdKernels());
+            EXPECT_TRUE(SetSimdLevel(previous));
+
+            // CMake选项JOY_SIMD_LEVEL指定的等级在CPU支持时成为默认路径
+#ifdef JOY_FORCE_SIMD_LEVEL
+            const EnumSimdLevel configured = static_cast<EnumSimdLevel>(JOY_FORCE_SIMD_LEVEL);
+            if (static_cast<int>(configured) <= static_cast<int>(DetectSimdLevel()))
+            {
+                EXPECT_EQ(GetDefaultSimdLevel(), configured);
+            }
+#else
+            EXPECT_EQ(GetDefaultSimdLevel(), DetectSimdLevel());
+#endif
+        }
+
+        TEST(SimdKernelsTest, BitExactTest)
+        {
+            // 所有路径与基准实现逐位一致，覆盖各种尾部长度
+            const std::vector<const SimdKernels*> available = GetAvailableKernels();
+            const SimdKernels&                    baseline  = *available.front();
+            std::mt19937                          random(20251226u);
+            std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+            Mat4x4f mat;
+            for (int col = 0; col < 4; ++col)
+            {
+                mat[col] = Vec4f{unit(random), unit(random), unit(random), unit(random)} * 3.f;
+            }
+            std::vector<Vec4f> positions(37);
+            for (Vec4f& position : positions)
+            {
+                position = Vec4f{unit(random) * 10.f, unit(random) * 10.f, unit(random) * 10.f, 1.f};
+            }
+            std::vector<float> weights(9);
+            for (float& weight : weights)
+            {
+                weight = unit(random) * 0.5f + 0.5f;
+            }
+
+            for (const SimdKernels* kernels : available)
+            {
+                for (size_t count : {size_t{1}, size_t{2}, size_t{3}, size_t{5}, size_t{16}, size_t{37}})
+                {
+                    std::vector<Vec4f> expected(count);
+                    std::vector<Vec4f> actual(count);
+                    baseline.transformPositions(mat, positions.data(), count, expected.data());
+                    kernels->transformPositions(mat, positions.data(), count, actual.data());
+                    EXPECT_TRUE(BitEqual(expected.data(), actual.data(), count * sizeof(Vec4f))) << GetSimdLevelName(kernels->level) << " " << count;
+                    // 原地变换
+                    std::vector<Vec4f> inPlace(positions.begin(), positions.begin() + count);
+                    kernels->transformPositions(mat, inPlace.data(), count, inPlace.data());
+                    EXPECT_TRUE(BitEqual(expected.data(), inPlace.data(), count * sizeof(Vec4f))) << GetSimdLevelName(kernels->level) << " " << count;
+
+                    const int rowCount = static_cast<int>(count);
+                    std::vector<Vec4f> taps(positions.begin(), positions.begin() + count);
+                    taps.insert(taps.end(), positions.begin(), positions.begin() + weights.size());
+                    std::vector<Vec4f> expectedRow(count);
+                    std::vector<Vec4f> actualRow(count);
+                    baseline.convolveRow(taps.data(), weights.data(), static_cast<int>(weights.size()), rowCount, expectedRow.data());
+                    kernels->convolveRow(taps.data(), weights.data(), static_cast<int>(weights.size()), rowCount, actualRow.data());
+                    EXPECT_TRUE(BitEqual(expectedRow.data(), actualRow.data(), count * sizeof(Vec4f))) << GetSimdLevelName(kernels->level) << " " << count;
+                    baseline.accumulateRow(positions.data(), weights[1], rowCount, expectedRow.data());
+                    kernels->accumulateRow(positions.data(), weights[1], rowCount, actualRow.data());
+                    EXPECT_TRUE(BitEqual(expectedRow.data(), actualRow.data(), count * sizeof(Vec4f))) << GetSimdLevelName(kernels->level) << " " << count;
+                }
+
+                for (int count = 1; count <= SimdKernels::SPAN_SIZE; count += 7)
+                {
+                    float depths[SimdKernels::SPAN_SIZE];
+                    float stored[SimdKernels::SPAN_SIZE];
+                    for (int i = 0; i < count; ++i)
+                    {
+                        depths[i] = unit(random);
+                        stored[i] = i % 5 == 0 ? depths[i] : unit(random);
+                    }
+                    for (EnumDepthTest depthTest : {EnumDepthTest::LESS, EnumDepthTest::GREATER})
+                    {
+                        EXPECT_EQ(kernels->depthTestSpan(depthTest, depths, stored, count), baseline.depthTestSpan(depthTest, depths, stored, count));
+                    }
+
+                    for (int trial = 0; trial < 8; ++trial)
+                    {
+                        EdgeSpan span;
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            span.edgeA[k]       = unit(random);
+                            span.edgeRow[k]     = unit(random) * 40.f;
+                            span.edgeTopLeft[k] = (trial >> k) & 1;
+                        }
+                        span.depthA   = unit(random) * 0.05f;
+                        span.depthRow = unit(random) + 0.5f;
+                        float          expectedDepths[SimdKernels::SPAN_SIZE];
+                        float          actualDepths[SimdKernels::SPAN_SIZE];
+                        const int      x            = trial * 13 - 20;
+                        const uint64_t expectedMask = baseline.coverSpan(span, x, count, expectedDepths);
+                        EXPECT_EQ(kernels->coverSpan(span, x, count, actualDepths), expectedMask) << GetSimdLevelName(kernels->level) << " " << count;
+                        EXPECT_TRUE(BitEqual(expectedDepths, actualDepths, count * sizeof(float)));
+                        if (count < SimdKernels::SPAN_SIZE)
+                        {
+                            EXPECT_EQ(expectedMask >> count, 0u);
+                        }
+                    }
+                }
+            }
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,89 @@
+
+#include "Core/Skinning.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        TEST(SkinningTest, PaletteTest)
+        {
+            const Quat     rotation = Quat::FromAxisAngle(Vec3f{0.f, 1.f, 0.f}, 0.6f);
+            const Vec3f    translation{1.f, 2.f, 3.f};
+            Mat4x4f        mat = ToMat4x4f(rotation);
+            mat[3]             = Vec4f{translation.X(), translation.Y(), translation.Z(), 1.f};
+            SkinningMatrix fromQuat = MakeSkinningMatrix(rotation, translation);
+            SkinningMatrix fromMat  = MakeSkinningMatrix(mat);
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    EXPECT_NEAR(fromQuat.rows[row][col], fromMat.rows[row][col], 1e-6f);
+                }
+            }
+            // 骨骼变换乘以绑定姿态逆矩阵，绑定姿态下得到单位矩阵
+            const SkinningMatrix inverseBind = MakeSkinningMatrix(InverseRigid(mat));
+            SkinningMatrix       palette;
+            BuildSkinningPalette(&fromMat, &inverseBind, 1, &palette);
+            const SkinningMatrix identity = MakeSkinningMatrix(MAT4X4F_IDENTITY);
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    EXPECT_NEAR(palette.rows[row][col], identity.rows[row][col], 1e-5f);
+                }
+            }
+        }
+
+        TEST(SkinningTest, SkinVerticesTest)
+        {
+            // 两根骨骼: 平移与绕Z轴旋转90度
+            Mat4x4f bone0 = MAT4X4F_IDENTITY;
+            bone0[3]      = Vec4f{0.f, 0.f, 2.f, 1.f};
+            const Mat4x4f bone1 = ToMat4x4f(Quat::FromAxisAngle(Vec3f{0.f, 0.f, 1.f}, 1.5707963f));
+            const SkinningMatrix palette[2] = {MakeSkinningMatrix(bone0), MakeSkinningMatrix(bone1)};
+
+            // 7个顶点，覆盖完整的一组与不足4个的尾部
+            constexpr int         vertexCount = 7;
+            std::vector<float>    px(vertexCount), py(vertexCount), pz(vertexCount);
+            std::vector<float>    nx(vertexCount, 1.f), ny(vertexCount, 0.f), nz(vertexCount, 0.f);
+            std::vector<uint16_t> index0(vertexCount, 0), index1(vertexCount, 1);
+            std::vector<float>    weight0(vertexCount), weight1(vertexCount);
+            for (int i = 0; i < vertexCount; ++i)
+            {
+                px[i]      = static_cast<float>(i);
+                py[i]      = 1.f;
+                pz[i]      = -1.f;
+                weight0[i] = static_cast<float>(i) / static_cast<float>(vertexCount - 1);
+                weight1[i] = 1.f - weight0[i];
+            }
+            SkinningInput input;
+            input.vertexCount    = vertexCount;
+            input.positionX      = px.data();
+            input.positionY      = py.data();
+            input.positionZ      = pz.data();
+            input.normalX        = nx.data();
+            input.normalY        = ny.data();
+            input.normalZ        = nz.data();
+            input.boneIndices[0] = index0.data();
+            input.boneIndices[1] = index1.data();
+            input.boneWeights[0] = weight0.data();
+            input.boneWeights[1] = weight1.data();
+
+            std::vector<float> outX(vertexCount), outY(vertexCount), outZ(vertexCount);
+            std::vector<float> outNX(vertexCount), outNY(vertexCount), outNZ(vertexCount);
+            SkinVertices(palette, input, SkinningOutput{outX.data(), outY.data(), outZ.data(), outNX.data(), outNY.data(), outNZ.data()});
+
+            for (int i = 0; i < vertexCount; ++i)
+            {
+                // 参考实现: 逐顶点混合四阶矩阵
+                Mat4x4f blended = bone0 * weight0[i] + bone1 * weight1[i];
+                Vec4f   expect  = blended * Vec4f{px[i], py[i], pz[i], 1.f};
+                EXPECT_EQ(Vec3f(outX[i], outY[i], outZ[i]), Vec3f(expect[0], expect[1], expect[2]));
+                Vec4f normal = blended * Vec4f{1.f, 0.f, 0.f, 0.f};
+                EXPECT_EQ(Vec3f(outNX[i], outNY[i], outNZ[i]), Normalized(Vec3f(normal[0], normal[1], normal[2])));
+            }
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
@@ -0,0 +1,134 @@
+
+#include "Core/Camera.h"
+#include "Core/Renderer.h"
+#include "Core/TemporalAccumulator.h"
+#include "gtest/gtest.h"
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 测试用着色器: 观察投影变换，输出白色
+         *
+         */
+        struct WhiteShader
+        {
+            constexpr static int VARYING_COUNT = 0;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float*) const
+            {
+                return viewProj * Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float*) const { return Vec4f{1.f, 1.f, 1.f, 1.f}; }
+
+            Mat4x4f viewProj;
+        };
+
+        TEST(TemporalAccumulatorTest, HaltonJitterTest)
+        {
+            Vec2f sum{0.f, 0.f};
+            for (int i = 0; i < 16; ++i)
+            {
+                const Vec2f jitter = TemporalAccumulator::GetHaltonJitter(i);
+                EXPECT_GE(jitter.X(), -0.5f);
+                EXPECT_LT(jitter.X(), 0.5f);
+                EXPECT_GE(jitter.Y(), -0.5f);
+                EXPECT_LT(jitter.Y(), 0.5f);
+                sum = sum + jitter;
+            }
+            EXPECT_NEAR(TemporalAccumulator::GetHaltonJitter(0).X(), 0.f, 1e-6f);
+            EXPECT_NEAR(TemporalAccumulator::GetHaltonJitter(1).X(), -0.25f, 1e-6f);
+            EXPECT_NEAR(TemporalAccumulator::GetHaltonJitter(0).Y(), 1.f / 3.f - 0.5f, 1e-6f);
+            // 低差异序列的均值接近像素中心
+            EXPECT_NEAR(sum.X() / 16.f, 0.f, 0.05f);
+            EXPECT_NEAR(sum.Y() / 16.f, 0.f, 0.05f);
+        }
+
+        TEST(TemporalAccumulatorTest, CameraJitterTest)
+        {
+            for (Camera::EnumCameraType cameraType : {Camera::EnumCameraType::PERSPECTIVE, Camera::EnumCameraType::ORTHOGRAPHIC})
+            {
+                const float    viewportParam = cameraType == Camera::EnumCameraType::PERSPECTIVE ? 60.f : 4.f;
+                Camera         camera(cameraType, Vec3f{1.f, 2.f, 3.f}, Vec3f{1.f, 2.f, -2.f}, 0.5f, 50.f, viewportParam);
+                const uint32_t version       = camera.GetVersion();
+                const Mat4x4f  unjittered    = camera.GetProjMatrix();
+                camera.SetJitter(Vec2f{0.1f, -0.2f});
+                // 抖动只平移NDC，不改变版本号与未抖动矩阵
+                EXPECT_EQ(camera.GetVersion(), version);
+                EXPECT_EQ(camera.GetUnjitteredProjMatrix(), unjittered);
+                for (const Vec3f& point : {Vec3f{1.f, 2.f, -2.f}, Vec3f{2.f, 1.f, -10.f}})
+                {
+                    const Vec4f base     = unjittered * camera.GetViewMatrix() * Vec4f{point.X(), point.Y(), point.Z(), 1.f};
+                    const Vec4f jittered = camera.GetViewProjMatrix() * Vec4f{point.X(), point.Y(), point.Z(), 1.f};
+                    EXPECT_NEAR(jittered[0] / jittered[3] - base[0] / base[3], 0.1f, 1e-5f);
+                    EXPECT_NEAR(jittered[1] / jittered[3] - base[1] / base[3], -0.2f, 1e-5f);
+                    EXPECT_NEAR(jittered[2] / jittered[3], base[2] / base[3], 1e-6f);
+                }
+                // 修改投影参数后抖动仍然保留
+                camera.SetNearPlane(1.f);
+                EXPECT_NE(camera.GetVersion(), version);
+                EXPECT_FALSE(camera.GetProjMatrix() == camera.GetUnjitteredProjMatrix());
+                camera.SetJitter(Vec2f{0.f, 0.f});
+                EXPECT_EQ(camera.GetProjMatrix(), camera.GetUnjitteredProjMatrix());
+            }
+        }
+
+        TEST(TemporalAccumulatorTest, ProgressiveRefinementTest)
+        {
+            constexpr int SIZE = 16;
+            // 正交相机视口半高为1，世界坐标x、y即为NDC
+            Camera camera(Camera::EnumCameraType::ORTHOGRAPHIC, Vec3f{0.f, 0.f, 1.f}, Vec3f{0.f, 0.f, 0.f}, 0.1f, 2.f, 1.f);
+            // 竖直边位于x = 0.3，即屏幕x = 10.4，像素10被覆盖40%
+            Mesh quad;
+            quad.vertices = {
+                Joy::Vertex{Vec3f{-1.f, -1.f, 0.f}, Vec3f{}, Vec2f{}},
+                Joy::Vertex{Vec3f{0.3f, -1.f, 0.f}, Vec3f{}, Vec2f{}},
+                Joy::Vertex{Vec3f{0.3f, 1.f, 0.f}, Vec3f{}, Vec2f{}},
+                Joy::Vertex{Vec3f{-1.f, 1.f, 0.f}, Vec3f{}, Vec2f{}},
+            };
+            quad.indices = {0, 1, 2, 0, 2, 3};
+
+            Renderer            renderer{SIZE, SIZE};
+            TemporalAccumulator accumulator{SIZE, SIZE, 16};
+            auto                renderFrame = [&]() {
+                accumulator.Update(camera.GetVersion());
+                if (accumulator.IsConverged())
+                {
+                    return;
+                }
+                camera.SetJitter(accumulator.GetNdcJitter());
+                renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f});
+                renderer.Draw(quad, WhiteShader{camera.GetViewProjMatrix()});
+                accumulator.Accumulate(renderer.GetFrameBuffer());
+            };
+
+            // 首帧即为单采样预览
+            renderFrame();
+            EXPECT_EQ(accumulator.GetSampleCount(), 1);
+            const float preview = accumulator.GetColor(10, 8)[0];
+            EXPECT_TRUE(preview == 0.f || preview == 1.f);
+
+            for (int frame = 1; frame < 20; ++frame)
+            {
+                renderFrame();
+            }
+            EXPECT_TRUE(accumulator.IsConverged());
+            EXPECT_EQ(accumulator.GetSampleCount(), 16);
+            EXPECT_EQ(accumulator.GetColor(3, 8), Vec4f(1.f, 1.f, 1.f, 1.f));
+            EXPECT_EQ(accumulator.GetColor(14, 8), Vec4f(0.f, 0.f, 0.f, 1.f));
+            EXPECT_NEAR(accumulator.GetColor(10, 8)[0], 0.4f, 0.07f);
+
+            FrameBuffer output{SIZE, SIZE};
+            accumulator.Resolve(output);
+            EXPECT_NEAR(output.GetColor(10, 8)[0], 0.4f, 0.07f);
+            EXPECT_EQ(output.GetColor(3, 3), Vec4f(1.f, 1.f, 1.f, 1.f));
+
+            // 相机移动后历史被丢弃
+            camera.SetPosition(Vec3f{0.5f, 0.f, 1.f});
+            renderFrame();
+            EXPECT_EQ(accumulator.GetSampleCount(), 1);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
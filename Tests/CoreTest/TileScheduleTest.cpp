@@ -0,0 +1,234 @@
+
+#include "Core/FrameBuffer.h"
+#include "Core/TileSchedule.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+    #include <sched.h>
+#endif
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 按亲和性均分给threadCount个线程后，分属不同线程的相邻分块对数
+         *
+         */
+        static int CountOwnerBoundaries(const TileSchedule& schedule, int threadCount)
+        {
+            const int        tileCount = schedule.GetTileCount();
+            std::vector<int> owners(tileCount);
+            for (int position = 0; position < tileCount; ++position)
+            {
+                owners[schedule.GetTile(position)] = static_cast<int>(static_cast<int64_t>(position) * threadCount / tileCount);
+            }
+            int boundaries = 0;
+            for (int tileY = 0; tileY < schedule.GetTileCountY(); ++tileY)
+            {
+                for (int tileX = 0; tileX < schedule.GetTileCountX(); ++tileX)
+                {
+                    const int tileIndex = tileY * schedule.GetTileCountX() + tileX;
+                    boundaries += tileX + 1 < schedule.GetTileCountX() && owners[tileIndex] != owners[tileIndex + 1] ? 1 : 0;
+                    boundaries += tileY + 1 < schedule.GetTileCountY() && owners[tileIndex] != owners[tileIndex + schedule.GetTileCountX()] ? 1 : 0;
+                }
+            }
+            return boundaries;
+        }
+
+        TEST(TileScheduleTest, OrderTest)
+        {
+            // 任意尺寸下都是全部分块的一个排列
+            for (const EnumTileOrder order : {EnumTileOrder::ROW_MAJOR, EnumTileOrder::MORTON, EnumTileOrder::HILBERT})
+            {
+                const TileSchedule schedule(13, 7, order);
+                ASSERT_EQ(schedule.GetTileCount(), 13 * 7);
+                std::vector<int> tiles(schedule.GetTileCount());
+                for (int position = 0; position < schedule.GetTileCount(); ++position)
+                {
+                    tiles[position] = schedule.GetTile(position);
+                }
+                std::sort(tiles.begin(), tiles.end());
+                for (int tileIndex = 0; tileIndex < schedule.GetTileCount(); ++tileIndex)
+                {
+                    EXPECT_EQ(tiles[tileIndex], tileIndex);
+                }
+            }
+
+            // Morton: 前4个分块为左上角的2x2块
+            const TileSchedule morton(8, 8, EnumTileOrder::MORTON);
+            EXPECT_EQ(morton.GetTile(0), 0);
+            EXPECT_EQ(morton.GetTile(1), 1);
+            EXPECT_EQ(morton.GetTile(2), 8);
+            EXPECT_EQ(morton.GetTile(3), 9);
+
+            // Hilbert: 2的幂边长时顺序上相邻的分块在画面上也相邻
+            const TileSchedule hilbert(16, 16, EnumTileOrder::HILBERT);
+            for (int position = 1; position < hilbert.GetTileCount(); ++position)
+            {
+                const int previous = hilbert.GetTile(position - 1);
+                const int current  = hilbert.GetTile(position);
+                EXPECT_EQ(std::abs(previous % 16 - current % 16) + std::abs(previous / 16 - current / 16), 1) << position;
+            }
+
+            // 均分给多个线程时，空间填充曲线的区域边界比按行均分少，相邻分块多在同一线程上
+            for (const int threadCount : {4, 16})
+            {
+                const int rowMajor = CountOwnerBoundaries(TileSchedule(60, 34, EnumTileOrder::ROW_MAJOR), threadCount);
+                EXPECT_LT(CountOwnerBoundaries(TileSchedule(60, 34, EnumTileOrder::HILBERT), threadCount), rowMajor);
+                EXPECT_LT(CountOwnerBoundaries(TileSchedule(60, 34, EnumTileOrder::MORTON), threadCount), rowMajor);
+            }
+
+            // 尺寸不变时不重新生成
+            TileSchedule resized(EnumTileOrder::HILBERT);
+            EXPECT_EQ(resized.GetTileCount(), 0);
+            resized.Resize(16, 16);
+            EXPECT_EQ(resized.GetTile(5), hilbert.GetTile(5));
+            resized.SetOrder(EnumTileOrder::ROW_MAJOR, EnumTileScheduling::DYNAMIC);
+            EXPECT_EQ(resized.GetTile(5), 5);
+            EXPECT_EQ(resized.GetScheduling(), EnumTileScheduling::DYNAMIC);
+        }
+
+        TEST(TileScheduleTest, AffineThreadPoolTest)
+        {
+            ThreadPool pool(4, true);
+            for (int round = 0; round < 20; ++round)
+            {
+                // 每个任务恰好执行一次
+                std::vector<int> visits(257 + round, 0);
+                pool.ParallelForAffine(static_cast<int>(visits.size()), [&](int taskIndex, int threadIndex) {
+                    ++visits[taskIndex];
+                    ASSERT_LT(threadIndex, 4);
+#if defined(__linux__)
+                    // 绑定后线程只在自己的CPU上运行
+                    if (pool.IsPinned())
+                    {
+                        ASSERT_EQ(sched_getcpu(), pool.GetPinnedCpu(threadIndex));
+                    }
+#endif
+                });
+                EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+            }
+            pool.ParallelForAffine(0, [](int, int) { FAIL(); });
+#if defined(__linux__)
+            EXPECT_TRUE(pool.IsPinned());
+#endif
+            EXPECT_EQ(ThreadPool(2).GetPinnedCpu(0), -1);
+
+            // 分块调度两种分配方式都恰好处理每个分块一次
+            for (const EnumTileScheduling scheduling : {EnumTileScheduling::DYNAMIC, EnumTileScheduling::AFFINE})
+            {
+                const TileSchedule            schedule(11, 9, EnumTileOrder::HILBERT, scheduling);
+                std::vector<std::atomic<int>> tileVisits(schedule.GetTileCount());
+                schedule.ForEach(&pool, [&](int tileIndex, int) { ++tileVisits[tileIndex]; });
+                schedule.ForEach(nullptr, [&](int tileIndex, int threadIndex) {
+                    EXPECT_EQ(threadIndex, 0);
+                    ++tileVisits[tileIndex];
+                });
+                EXPECT_TRUE(std::all_of(tileVisits.begin(), tileVisits.end(), [](const std::atomic<int>& count) { return count.load() == 2; }));
+            }
+        }
+
+        TEST(TileScheduleTest, AffineStealTest)
+        {
+            // 第0段的任务较慢，其他线程会来帮忙: 帮忙只从区间尾部领取，每个线程执行的总是自己区间的连续前缀
+            ThreadPool pool(4);
+            const int  taskCount = 64;
+            for (int round = 0; round < 10; ++round)
+            {
+                std::vector<int> owners(taskCount, -1);
+                pool.ParallelForAffine(taskCount, [&](int taskIndex, int threadIndex) {
+                    owners[taskIndex] = threadIndex;
+                    if (taskIndex < taskCount / 4)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    }
+                });
+                for (int threadIndex = 0; threadIndex < 4; ++threadIndex)
+                {
+                    const int begin = taskCount * threadIndex / 4;
+                    const int end   = taskCount * (threadIndex + 1) / 4;
+                    int       own   = begin;
+                    while (own < end && owners[own] == threadIndex)
+                    {
+                        ++own;
+                    }
+                    for (int taskIndex = own; taskIndex < end; ++taskIndex)
+                    {
+                        EXPECT_NE(owners[taskIndex], threadIndex) << taskIndex;
+                        EXPECT_GE(owners[taskIndex], 0);
+                    }
+                }
+            }
+        }
+
+        TEST(TileScheduleTest, CpuTopologyTest)
+        {
+            EXPECT_EQ(Detail::ParseCpuList("0-3,8-11"), (std::vector<int>{0, 1, 2, 3, 8, 9, 10, 11}));
+            EXPECT_EQ(Detail::ParseCpuList("5"), (std::vector<int>{5}));
+            EXPECT_EQ(Detail::ParseCpuList("1,3-4\n"), (std::vector<int>{1, 3, 4}));
+            EXPECT_TRUE(Detail::ParseCpuList("").empty());
+
+            // 双路交错编号: 偶数CPU在节点0，奇数在节点1，超线程为N + 4
+            const std::vector<int>              allowed = {0, 1, 2, 3, 4, 5, 6, 7};
+            const std::vector<std::vector<int>> nodeCpus = {{0, 2, 4, 6}, {1, 3, 5, 7}};
+            std::vector<int>                    nodes;
+            EXPECT_EQ(Detail::OrderCpusByTopology(allowed, nodeCpus, {0, 1, 2, 3}, nodes), (std::vector<int>{0, 2, 4, 6, 1, 3, 5, 7}));
+            EXPECT_EQ(nodes, (std::vector<int>{0, 0, 0, 0, 1, 1, 1, 1}));
+
+            // 节点内先物理核心后超线程；受限的可用CPU与未知节点的CPU排在最后
+            const std::vector<std::vector<int>> smtNodes = {{0, 1, 2, 3, 8, 9, 10, 11}, {4, 5, 6, 7, 12, 13, 14, 15}};
+            EXPECT_EQ(Detail::OrderCpusByTopology({1, 4, 9, 12, 20}, smtNodes, {0, 1, 2, 3, 4, 5, 6, 7}, nodes), (std::vector<int>{1, 9, 4, 12, 20}));
+            EXPECT_EQ(nodes, (std::vector<int>{0, 0, 1, 1, -1}));
+            EXPECT_EQ(Detail::OrderCpusByTopology({3, 1}, {}, {}, nodes), (std::vector<int>{3, 1}));
+
+            // 本机绑定后编号相邻的线程按节点分组
+            ThreadPool pool(4, true);
+            if (pool.IsPinned())
+            {
+                std::set<int> seen;
+                for (int threadIndex = 0; threadIndex < pool.GetThreadCount() && seen.insert(pool.GetPinnedCpu(threadIndex)).second; ++threadIndex)
+                {
+                    if (threadIndex > 0)
+                    {
+                        EXPECT_GE(pool.GetPinnedNode(threadIndex), pool.GetPinnedNode(threadIndex - 1));
+                    }
+                }
+            }
+        }
+
+        TEST(TileScheduleTest, FirstTouchTest)
+        {
+            // 按调度并行落地的结果与串行一致
+            ThreadPool   pool(3, true);
+            FrameBuffer  serial(100, 70, EnumColorFormat::RGBA16F, EnumDepthFormat::D24);
+            FrameBuffer  scheduled(100, 70, EnumColorFormat::RGBA16F, EnumDepthFormat::D24);
+            TileSchedule schedule(scheduled.GetTileCountX(), scheduled.GetTileCountY());
+            for (FrameBuffer* frameBuffer : {&serial, &scheduled})
+            {
+                frameBuffer->ClearColor(Vec4f{0.25f, 0.5f, 0.75f, 1.f});
+                frameBuffer->ClearDepth(0.5f);
+                frameBuffer->SetColor(37, 21, Vec4f{1.f, 0.f, 0.f, 1.f});
+            }
+            serial.ResolveFastClear();
+            scheduled.ResolveFastClear(schedule, &pool);
+            for (int tileY = 0; tileY < scheduled.GetTileCountY(); ++tileY)
+            {
+                for (int tileX = 0; tileX < scheduled.GetTileCountX(); ++tileX)
+                {
+                    EXPECT_FALSE(scheduled.IsColorTileCleared(tileX, tileY));
+                    EXPECT_FALSE(scheduled.IsDepthTileCleared(tileX, tileY));
+                }
+            }
+            EXPECT_EQ(std::memcmp(serial.GetColorData(), scheduled.GetColorData(), static_cast<size_t>(serial.GetColorPitch()) * serial.GetHeight()), 0);
+            EXPECT_FLOAT_EQ(scheduled.GetDepth(99, 69), serial.GetDepth(99, 69));
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
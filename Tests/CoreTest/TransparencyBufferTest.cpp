@@ -0,0 +1,276 @@
+
+#include "Core/Renderer.h"
+#include "Core/TransparencyBuffer.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        constexpr int TRANSPARENCY_SIZE = 32;
+
+        /**
+         * @brief 测试用着色器: 顶点位置直接作为NDC坐标，法线作为RGB，纹理坐标u作为Alpha
+         *
+         */
+        struct TransparentColorShader
+        {
+            constexpr static int VARYING_COUNT = 4;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                varyings[3] = vertex.uv[0];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const { return Vec4f{varyings[0], varyings[1], varyings[2], varyings[3]}; }
+        };
+
+        /**
+         * @brief 透明四边形，左右两侧可有不同深度(用于相互穿插的网格)
+         *
+         */
+        static Mesh MakeLayer(float minX, float minY, float maxX, float maxY, float leftDepth, float rightDepth, const Vec4f& color)
+        {
+            const Vec3f rgb{color[0], color[1], color[2]};
+            const Vec2f alpha{color[3], 0.f};
+            Mesh        mesh;
+            mesh.vertices = {
+                Joy::Vertex{Vec3f{minX, minY, leftDepth}, rgb, alpha},
+                Joy::Vertex{Vec3f{maxX, minY, rightDepth}, rgb, alpha},
+                Joy::Vertex{Vec3f{maxX, maxY, rightDepth}, rgb, alpha},
+                Joy::Vertex{Vec3f{minX, maxY, leftDepth}, rgb, alpha},
+            };
+            mesh.indices = {0, 1, 2, 0, 2, 3};
+            return mesh;
+        }
+
+        /**
+         * @brief 由远及近的参考合成
+         *
+         */
+        static Vec4f CompositeReference(Vec4f destination, std::vector<std::pair<float, Vec4f>> layers)
+        {
+            std::sort(layers.begin(), layers.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+            for (const auto& layer : layers)
+            {
+                const float alpha = layer.second[3];
+                for (int channel = 0; channel < 3; ++channel)
+                {
+                    destination[channel] = layer.second[channel] * alpha + destination[channel] * (1.f - alpha);
+                }
+                destination[3] = alpha + destination[3] * (1.f - alpha);
+            }
+            return destination;
+        }
+
+        static void ExpectColorNear(const Vec4f& actual, const Vec4f& expected, float tolerance)
+        {
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                EXPECT_NEAR(actual[channel], expected[channel], tolerance) << "channel " << channel;
+            }
+        }
+
+        /**
+         * @brief 绘制不透明背景(左上角有更近的遮挡物)后，按给定顺序提交透明层并合成
+         *
+         */
+        static void RenderScene(Renderer& renderer, TransparencyBuffer& transparency, const std::vector<Mesh>& layers, const std::vector<int>& order)
+        {
+            // 反向Z时不透明物体的深度同样翻转
+            TransparentColorShader shader;
+            const bool             reverseZ = renderer.GetDepthTest() == EnumDepthTest::GREATER;
+            auto                   opaque   = [reverseZ](float depth) { return reverseZ ? 1.f - depth : depth; };
+            renderer.Clear(Vec4f{0.f, 0.f, 0.f, 1.f}, reverseZ ? 0.f : 1.f);
+            renderer.Draw(MakeLayer(-1.f, -1.f, 1.f, 1.f, opaque(0.9f), opaque(0.9f), Vec4f{0.2f, 0.2f, 0.2f, 1.f}), shader);
+            renderer.Draw(MakeLayer(-1.f, 0.f, 0.f, 1.f, opaque(0.3f), opaque(0.3f), Vec4f{1.f, 1.f, 0.f, 1.f}), shader);
+            renderer.Resolve();
+            transparency.Clear();
+            renderer.SetTransparencyTarget(&transparency);
+            for (const int index : order)
+            {
+                renderer.Draw(layers[index], shader);
+            }
+            renderer.SetTransparencyTarget(nullptr);
+            transparency.Resolve(renderer.GetFrameBuffer());
+        }
+
+        static std::vector<Mesh> MakeLayers(bool reverseZ = false)
+        {
+            auto depth = [reverseZ](float value) { return reverseZ ? 1.f - value : value; };
+            return {MakeLayer(-1.f, -1.f, 1.f, 1.f, depth(0.5f), depth(0.5f), Vec4f{1.f, 0.f, 0.f, 0.5f}),
+                    MakeLayer(-1.f, -1.f, 1.f, 1.f, depth(0.7f), depth(0.7f), Vec4f{0.f, 1.f, 0.f, 0.4f}),
+                    MakeLayer(-1.f, -1.f, 1.f, 1.f, depth(0.2f), depth(0.2f), Vec4f{0.f, 0.f, 1.f, 0.3f})};
+        }
+
+        TEST(TransparencyBufferTest, FragmentListTest)
+        {
+            Renderer           renderer(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            TransparencyBuffer transparency(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumTransparencyMode::FRAGMENT_LIST);
+            const std::vector<Mesh> layers = MakeLayers();
+            const Vec4f background = Vec4f{0.2f, 0.2f, 0.2f, 1.f};
+            const Vec4f occluder   = Vec4f{1.f, 1.f, 0.f, 1.f};
+            const Vec4f visible    = CompositeReference(background, {{0.5f, Vec4f{1.f, 0.f, 0.f, 0.5f}}, {0.7f, Vec4f{0.f, 1.f, 0.f, 0.4f}}, {0.2f, Vec4f{0.f, 0.f, 1.f, 0.3f}}});
+            const Vec4f occluded   = CompositeReference(occluder, {{0.2f, Vec4f{0.f, 0.f, 1.f, 0.3f}}});
+
+            // 任意提交顺序的结果都与排序后的参考一致
+            std::vector<int> order = {0, 1, 2};
+            do
+            {
+                RenderScene(renderer, transparency, layers, order);
+                // 被遮挡的层在深度测试中剔除，不产生片元
+                EXPECT_EQ(transparency.GetFragmentCount(), static_cast<size_t>(TRANSPARENCY_SIZE * TRANSPARENCY_SIZE * 3 - TRANSPARENCY_SIZE * TRANSPARENCY_SIZE / 4 * 2));
+                ExpectColorNear(renderer.GetFrameBuffer().GetColor(24, 24), visible, 2e-3f);
+                ExpectColorNear(renderer.GetFrameBuffer().GetColor(4, 4), occluded, 2e-3f);
+                // 透明层不写入深度
+                EXPECT_FLOAT_EQ(renderer.GetFrameBuffer().GetDepth(24, 24), 0.9f);
+            } while (std::next_permutation(order.begin(), order.end()));
+
+            // 相互穿插的两层: 左侧红色在前，右侧绿色在前
+            const std::vector<Mesh> crossing = {MakeLayer(-1.f, -1.f, 1.f, 1.f, 0.4f, 0.8f, Vec4f{1.f, 0.f, 0.f, 0.6f}),
+                                                MakeLayer(-1.f, -1.f, 1.f, 1.f, 0.8f, 0.4f, Vec4f{0.f, 1.f, 0.f, 0.6f})};
+            RenderScene(renderer, transparency, crossing, {0, 1});
+            ExpectColorNear(renderer.GetFrameBuffer().GetColor(2, 24),
+                            CompositeReference(background, {{0.4f, Vec4f{1.f, 0.f, 0.f, 0.6f}}, {0.8f, Vec4f{0.f, 1.f, 0.f, 0.6f}}}), 2e-3f);
+            ExpectColorNear(renderer.GetFrameBuffer().GetColor(29, 24),
+                            CompositeReference(background, {{0.8f, Vec4f{1.f, 0.f, 0.f, 0.6f}}, {0.4f, Vec4f{0.f, 1.f, 0.f, 0.6f}}}), 2e-3f);
+        }
+
+        TEST(TransparencyBufferTest, WeightedBlendedTest)
+        {
+            Renderer           renderer(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            TransparencyBuffer weighted(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumTransparencyMode::WEIGHTED_BLENDED);
+            TransparencyBuffer exact(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumTransparencyMode::FRAGMENT_LIST);
+            const std::vector<Mesh> layers = MakeLayers();
+
+            // 单层时与精确合成一致
+            RenderScene(renderer, exact, layers, {0});
+            const Vec4f exactSingle = renderer.GetFrameBuffer().GetColor(24, 24);
+            RenderScene(renderer, weighted, layers, {0});
+            ExpectColorNear(renderer.GetFrameBuffer().GetColor(24, 24), exactSingle, 2e-3f);
+
+            // 多层时结果与提交顺序无关: 总覆盖率与精确合成一致，颜色为按深度加权的近似，越近的层权重越大
+            RenderScene(renderer, exact, layers, {0, 1, 2});
+            const Vec4f      exactColor = renderer.GetFrameBuffer().GetColor(24, 24);
+            std::vector<int> order      = {0, 1, 2};
+            RenderScene(renderer, weighted, layers, order);
+            const Vec4f weightedColor = renderer.GetFrameBuffer().GetColor(24, 24);
+            EXPECT_NEAR(weightedColor[3], exactColor[3], 2e-3f);
+            EXPECT_GT(weightedColor[2], weightedColor[0]);
+            EXPECT_GT(weightedColor[0], weightedColor[1]);
+            while (std::next_permutation(order.begin(), order.end()))
+            {
+                RenderScene(renderer, weighted, layers, order);
+                ExpectColorNear(renderer.GetFrameBuffer().GetColor(24, 24), weightedColor, 2e-3f);
+            }
+            // 总不透明度是精确的: 只有遮挡物前的一层时与精确结果一致
+            RenderScene(renderer, exact, layers, {0, 1, 2});
+            const Vec4f exactOccluded = renderer.GetFrameBuffer().GetColor(4, 4);
+            RenderScene(renderer, weighted, layers, {0, 1, 2});
+            ExpectColorNear(renderer.GetFrameBuffer().GetColor(4, 4), exactOccluded, 2e-3f);
+        }
+
+        TEST(TransparencyBufferTest, ReverseDepthTest)
+        {
+            // 反向Z(GREATER，深度越大越近)的结果与正向Z一致
+            for (const EnumTransparencyMode mode : {EnumTransparencyMode::FRAGMENT_LIST, EnumTransparencyMode::WEIGHTED_BLENDED})
+            {
+                Renderer           forward(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+                Renderer           reverse(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+                TransparencyBuffer transparency(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, mode);
+                reverse.SetDepthTest(EnumDepthTest::GREATER);
+                RenderScene(forward, transparency, MakeLayers(), {1, 0, 2});
+                RenderScene(reverse, transparency, MakeLayers(true), {1, 0, 2});
+                ExpectColorNear(reverse.GetFrameBuffer().GetColor(24, 24), forward.GetFrameBuffer().GetColor(24, 24), 2e-3f);
+                ExpectColorNear(reverse.GetFrameBuffer().GetColor(4, 4), forward.GetFrameBuffer().GetColor(4, 4), 2e-3f);
+                EXPECT_FLOAT_EQ(reverse.GetFrameBuffer().GetDepth(24, 24), 1.f - 0.9f);
+                if (mode == EnumTransparencyMode::FRAGMENT_LIST)
+                {
+                    ExpectColorNear(reverse.GetFrameBuffer().GetColor(24, 24),
+                                    CompositeReference(Vec4f{0.2f, 0.2f, 0.2f, 1.f}, {{0.5f, Vec4f{1.f, 0.f, 0.f, 0.5f}},
+                                                                                     {0.7f, Vec4f{0.f, 1.f, 0.f, 0.4f}},
+                                                                                     {0.2f, Vec4f{0.f, 0.f, 1.f, 0.3f}}}),
+                                    2e-3f);
+                }
+            }
+
+            // 多重采样路径同样翻转
+            Renderer           reverse(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            Renderer           forward(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            TransparencyBuffer transparency(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE);
+            reverse.SetDepthTest(EnumDepthTest::GREATER);
+            reverse.SetSampleCount(4);
+            forward.SetSampleCount(4);
+            RenderScene(forward, transparency, MakeLayers(), {2, 1, 0});
+            RenderScene(reverse, transparency, MakeLayers(true), {2, 1, 0});
+            ExpectColorNear(reverse.GetFrameBuffer().GetColor(24, 24), forward.GetFrameBuffer().GetColor(24, 24), 2e-3f);
+        }
+
+        TEST(TransparencyBufferTest, ParallelResolveTest)
+        {
+            // 大量随机小四边形，模拟粒子
+            std::vector<Mesh> particles;
+            for (int i = 0; i < 200; ++i)
+            {
+                const float x     = static_cast<float>((i * 37) % 100) / 50.f - 1.f;
+                const float y     = static_cast<float>((i * 61) % 100) / 50.f - 1.f;
+                const float depth = 0.1f + static_cast<float>((i * 13) % 70) / 100.f;
+                particles.push_back(MakeLayer(x - 0.2f, y - 0.2f, x + 0.2f, y + 0.2f, depth, depth, Vec4f{depth, 1.f - depth, 0.5f, 0.3f}));
+            }
+            std::vector<int> order(particles.size());
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                order[i] = static_cast<int>(i);
+            }
+            std::vector<int> reversed(order.rbegin(), order.rend());
+
+            for (const EnumTransparencyMode mode : {EnumTransparencyMode::FRAGMENT_LIST, EnumTransparencyMode::WEIGHTED_BLENDED})
+            {
+                ThreadPool         threadPool(3);
+                Renderer           serialRenderer(TRANSPARENCY_SIZE * 2, TRANSPARENCY_SIZE * 2);
+                Renderer           threadedRenderer(TRANSPARENCY_SIZE * 2, TRANSPARENCY_SIZE * 2);
+                TransparencyBuffer serial(TRANSPARENCY_SIZE * 2, TRANSPARENCY_SIZE * 2, mode);
+                TransparencyBuffer threaded(TRANSPARENCY_SIZE * 2, TRANSPARENCY_SIZE * 2, mode, &threadPool);
+                const size_t       byteCount = static_cast<size_t>(serialRenderer.GetFrameBuffer().GetColorPitch()) * serialRenderer.GetHeight();
+                RenderScene(serialRenderer, serial, particles, order);
+                RenderScene(threadedRenderer, threaded, particles, order);
+                EXPECT_EQ(std::memcmp(serialRenderer.GetFrameBuffer().GetColorData(), threadedRenderer.GetFrameBuffer().GetColorData(), byteCount), 0);
+
+                // 片元池在帧间复用，Clear后重新提交的结果不受上一帧影响
+                std::vector<uint8_t> firstFrame(serialRenderer.GetFrameBuffer().GetColorData(), serialRenderer.GetFrameBuffer().GetColorData() + byteCount);
+                RenderScene(threadedRenderer, threaded, particles, order);
+                EXPECT_EQ(std::memcmp(firstFrame.data(), threadedRenderer.GetFrameBuffer().GetColorData(), byteCount), 0);
+                if (mode == EnumTransparencyMode::FRAGMENT_LIST)
+                {
+                    // 精确合成与提交顺序无关(深度互不相同)
+                    RenderScene(threadedRenderer, threaded, particles, reversed);
+                    EXPECT_EQ(std::memcmp(firstFrame.data(), threadedRenderer.GetFrameBuffer().GetColorData(), byteCount), 0);
+                }
+                threaded.Clear();
+                EXPECT_EQ(threaded.GetFragmentCount(), 0u);
+            }
+        }
+
+        TEST(TransparencyBufferTest, MultiSampleTest)
+        {
+            // 完全覆盖的像素与单采样结果一致
+            const std::vector<Mesh> layers = MakeLayers();
+            Renderer                singleSample(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            Renderer                multiSample(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE, EnumColorFormat::RGBA16F);
+            multiSample.SetSampleCount(4);
+            TransparencyBuffer transparency(TRANSPARENCY_SIZE, TRANSPARENCY_SIZE);
+            RenderScene(singleSample, transparency, layers, {2, 0, 1});
+            RenderScene(multiSample, transparency, layers, {2, 0, 1});
+            ExpectColorNear(multiSample.GetFrameBuffer().GetColor(24, 24), singleSample.GetFrameBuffer().GetColor(24, 24), 2e-3f);
+            ExpectColorNear(multiSample.GetFrameBuffer().GetColor(4, 4), singleSample.GetFrameBuffer().GetColor(4, 4), 2e-3f);
+            EXPECT_FLOAT_EQ(multiSample.GetMultiSampleBuffer()->GetSampleDepth(24, 24, 0), 0.9f);
+        }
+    }   // namespace UnitTest
+}   // namespace Joy
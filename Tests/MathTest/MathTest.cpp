@@ -1,8 +1,14 @@
 
 #include "Math/Vec.h"
+#include "Math/Expr.h"
+#include "Math/Fixed.h"
 #include "Math/Mat.h"
+#include "Math/LookupTable.h"
+#include "Math/Quat.h"
+#include "Math/Transform.h"
 #include "gtest/gtest.h"
 #include <gtest/gtest.h>
+#include <cmath>
 #include <iostream>
 
 namespace Joy
@@ -121,6 +127,242 @@ namespace Joy
             mat23_transpose[1][2] = 6;
             EXPECT_EQ(mat23_1.Transpose(), mat23_transpose);
             EXPECT_EQ(mat23_transpose.Transpose(), mat23_1);
+            // 矩阵右乘向量运算
+            EXPECT_EQ(mat23_1 * Vec3f(1.f, 2.f, 3.f), Vec2f(22.f, 28.f));
+            EXPECT_EQ(MAT4X4F_IDENTITY * Vec4f(1.f, 2.f, 3.f, 4.f), Vec4f(1.f, 2.f, 3.f, 4.f));
+        }
+        TEST(MathTest, MatInverseTest)
+        {
+            // 行列式: 通用版本与展开版本一致
+            Mat3x3f mat33{};
+            mat33[0] = Vec3f{2.f, 0.f, 1.f};
+            mat33[1] = Vec3f{1.f, 3.f, 2.f};
+            mat33[2] = Vec3f{1.f, 1.f, 2.f};
+            EXPECT_FLOAT_EQ(Determinant(mat33), 6.f);
+            EXPECT_FLOAT_EQ((Determinant<3, float>(mat33)), 6.f);
+            Mat4x4f mat44{};
+            mat44[0] = Vec4f{4.f, 0.f, 0.f, 1.f};
+            mat44[1] = Vec4f{2.f, 3.f, 1.f, 0.f};
+            mat44[2] = Vec4f{0.f, 1.f, 5.f, 2.f};
+            mat44[3] = Vec4f{1.f, -2.f, 3.f, 1.f};
+            EXPECT_NEAR(Determinant(mat44), (Determinant<4, float>(mat44)), 1e-4f);
+            EXPECT_FLOAT_EQ(Determinant(MAT4X4F_IDENTITY), 1.f);
+            EXPECT_FLOAT_EQ(Determinant(MAT4X4F_ZERO), 0.f);
+            // 逆矩阵: 通用版本与展开版本一致，且与原矩阵相乘为单位矩阵
+            EXPECT_EQ(mat33 * Inverse(mat33), MAT3X3F_IDENTITY);
+            EXPECT_EQ(Inverse(mat33), (Inverse<3, float>(mat33)));
+            EXPECT_EQ(mat44 * Inverse(mat44), MAT4X4F_IDENTITY);
+            EXPECT_EQ(Inverse(mat44) * mat44, MAT4X4F_IDENTITY);
+            EXPECT_EQ(Inverse(mat44), (Inverse<4, float>(mat44)));
+            Mat<5, 5, float> mat55 = Mat<5, 5, float>::Identity();
+            mat55[4][0]            = 3.f;
+            mat55[1][2]            = -2.f;
+            EXPECT_EQ(mat55 * Inverse(mat55), (Mat<5, 5, float>::Identity()));
+            // 仿射与刚体变换求逆
+            Mat4x4f rigid = MAT4X4F_IDENTITY;
+            rigid[0]      = Vec4f{0.f, 1.f, 0.f, 0.f};
+            rigid[1]      = Vec4f{-1.f, 0.f, 0.f, 0.f};
+            rigid[3]      = Vec4f{3.f, -2.f, 5.f, 1.f};
+            EXPECT_EQ(InverseRigid(rigid), Inverse(rigid));
+            EXPECT_EQ(InverseAffine(rigid), Inverse(rigid));
+            Mat4x4f affine = rigid;
+            affine[0]      = Vec4f{0.f, 2.f, 0.f, 0.f};
+            affine[2]      = Vec4f{0.5f, 0.f, 3.f, 0.f};
+            EXPECT_EQ(InverseAffine(affine), Inverse(affine));
+            EXPECT_EQ(affine * InverseAffine(affine), MAT4X4F_IDENTITY);
+            // 编译期求值
+            constexpr Mat4x4f constInverse = InverseRigid(MAT4X4F_IDENTITY);
+            static_assert(constInverse[3][3] == 1.f && constInverse[0][0] == 1.f, "constexpr inverse");
+            constexpr Mat3x3f constInverse33 = Inverse<3, float>(MAT3X3F_IDENTITY);
+            static_assert(constInverse33[1][1] == 1.f, "constexpr generic inverse");
+        }
+        TEST(MathTest, QuatTest)
+        {
+            const float halfPi = 1.5707963f;
+            const Quat  rotZ   = Quat::FromAxisAngle(Vec3f{0.f, 0.f, 1.f}, halfPi);
+            const Quat  rotX   = Quat::FromAxisAngle(Vec3f{1.f, 0.f, 0.f}, halfPi);
+            EXPECT_EQ(Rotate(rotZ, Vec3f(1.f, 0.f, 0.f)), Vec3f(0.f, 1.f, 0.f));
+            EXPECT_EQ(Rotate(Conjugate(rotZ), Vec3f(0.f, 1.f, 0.f)), Vec3f(1.f, 0.f, 0.f));
+            // 复合旋转: 先绕X再绕Z
+            const Quat  composed = rotZ * rotX;
+            const Vec3f vec{0.3f, -0.7f, 0.2f};
+            EXPECT_EQ(Rotate(composed, vec), Rotate(rotZ, Rotate(rotX, vec)));
+            // 旋转矩阵与四元数旋转一致
+            const Mat4x4f mat     = ToMat4x4f(composed);
+            const Vec4f   rotated = mat * Vec4f{vec.X(), vec.Y(), vec.Z(), 1.f};
+            EXPECT_EQ(Vec3f(rotated[0], rotated[1], rotated[2]), Rotate(composed, vec));
+            EXPECT_EQ(Determinant(mat), 1.f);
+            // 插值端点与中点
+            const Quat identity = Quat::Identity();
+            EXPECT_EQ(Slerp(identity, rotZ, 0.f), identity);
+            EXPECT_EQ(Slerp(identity, rotZ, 1.f), rotZ);
+            EXPECT_EQ(Slerp(identity, rotZ, 0.5f), Quat::FromAxisAngle(Vec3f{0.f, 0.f, 1.f}, halfPi * 0.5f));
+            EXPECT_EQ(Nlerp(identity, rotZ, 0.5f), Quat::FromAxisAngle(Vec3f{0.f, 0.f, 1.f}, halfPi * 0.5f));
+            // 最短路径: q与-q表示相同旋转
+            const Quat negZ{-rotZ.X(), -rotZ.Y(), -rotZ.Z(), -rotZ.W()};
+            EXPECT_EQ(Slerp(identity, negZ, 0.5f), Slerp(identity, rotZ, 0.5f));
+            EXPECT_NEAR(Dot(Normalized(Quat{1.f, 2.f, 3.f, 4.f}), Normalized(Quat{1.f, 2.f, 3.f, 4.f})), 1.f, 1e-6f);
+        }
+        TEST(MathTest, FusedExprTest)
+        {
+            const Vec4f a{1.f, 2.f, 3.f, 4.f};
+            const Vec4f b{-1.f, 0.5f, 2.f, 0.f};
+            const Vec4f c{0.25f, 0.25f, 0.25f, 0.25f};
+            EXPECT_EQ(MulAdd(a, 2.f, b), a * 2.f + b);
+            EXPECT_EQ(Lerp(a, b, 0.25f), a + (b - a) * 0.25f);
+            // 惰性表达式与立即求值结果一致
+            const Vec4f lazy = Lazy(a) * 2.f + Lazy(b) * 3.f - Lazy(c);
+            EXPECT_EQ(lazy, a * 2.f + b * 3.f - c);
+            EXPECT_EQ((-Lazy(a) + 0.5f * Lazy(b)).Eval(), b * 0.5f - a);
+            Mat3x3f mat   = MAT3X3F_IDENTITY;
+            mat[2]        = Vec3f{1.f, 2.f, 3.f};
+            Mat3x3f fused = Lazy(mat) * 0.5f + Lazy(MAT3X3F_IDENTITY) - Lazy(mat);
+            EXPECT_EQ(fused, mat * 0.5f + MAT3X3F_IDENTITY - mat);
+            EXPECT_EQ(MulAdd(mat, 2.f, MAT3X3F_IDENTITY), mat * 2.f + MAT3X3F_IDENTITY);
+            // 编译期求值
+            constexpr Vec3f constExpr = (Lazy(Vec3f::One()) * 2.f).Eval();
+            static_assert(constExpr[1] == 2.f, "constexpr expression");
+        }
+        TEST(MathTest, GenericScalarTest)
+        {
+            // 双精度: 比较容差远小于float，远离原点时仍能区分毫米级差异
+            const Vec3d far{1.0e7, 2.0, -3.0};
+            EXPECT_NE(far + Vec3d(1e-3, 0.0, 0.0), far);
+            EXPECT_EQ(Vec3d(1.0, 2.0, 3.0) + Vec3d(1.0, 1.0, 1.0), Vec3d(2.0, 3.0, 4.0));
+            EXPECT_EQ(Cross(Vec3d{1.0, 0.0, 0.0}, Vec3d{0.0, 1.0, 0.0}), Vec3d(0.0, 0.0, 1.0));
+            EXPECT_NEAR(Norm(Normalized(Vec3d{3.0, 4.0, 12.0})), 1.0, 1e-15);
+            EXPECT_EQ(Normalized(Vec3d{}), Vec3d::Zero());
+            EXPECT_EQ(VecCast<float>(Vec3d{1.5, -2.0, 0.25}), Vec3f(1.5f, -2.f, 0.25f));
+            Mat4x4d transform = Mat4x4d::Identity();
+            transform[0]      = Vec4d{0.0, 2.0, 0.0, 0.0};
+            transform[1]      = Vec4d{-2.0, 0.0, 0.0, 0.0};
+            transform[3]      = Vec4d{1.0e6, -5.0e5, 3.0, 1.0};
+            EXPECT_EQ(Inverse(transform) * transform, Mat4x4d::Identity());
+            EXPECT_NEAR(Determinant(transform), 4.0, 1e-12);
+            EXPECT_EQ(MatCast<float>(Mat4x4d::Identity()), MAT4X4F_IDENTITY);
+            // 整数: 默认零初始化，精确比较
+            const Vec<3, int> ints{1, 2, 3};
+            EXPECT_EQ((Vec<3, int>{}), (Vec<3, int>::Zero()));
+            EXPECT_EQ(Dot(ints, ints), 14);
+            EXPECT_NE(ints, (Vec<3, int>(1, 2, 4)));
+        }
+
+        TEST(MathTest, ConstexprTransformTest)
+        {
+            // 编译期标量函数与标准库一致
+            constexpr double sqrt2 = ScalarTraits<double>::Sqrt(2.0);
+            constexpr double sin1  = ScalarTraits<double>::Sin(1.0);
+            constexpr double tan7  = ScalarTraits<double>::Tan(-7.0);
+            constexpr double pow   = Detail::ConstexprPow(0.3, 2.4);
+            EXPECT_NEAR(sqrt2, std::sqrt(2.0), 1e-15);
+            EXPECT_NEAR(sin1, std::sin(1.0), 1e-15);
+            EXPECT_NEAR(tan7, std::tan(-7.0), 1e-14);
+            EXPECT_NEAR(pow, std::pow(0.3, 2.4), 1e-15);
+            EXPECT_EQ(ScalarTraits<float>::Sqrt(2.f), std::sqrt(2.f));
+
+            // 平移、缩放与旋转
+            constexpr Mat4x4f translate = Translate(Vec3f{1.f, 2.f, 3.f});
+            constexpr Mat4x4f scale     = Scale(Vec3f{2.f, 3.f, 4.f});
+            constexpr Mat4x4f rotate    = Rotate(1.5707963f, Vec3f{0.f, 0.f, 2.f});
+            static_assert(translate[3][2] == 3.f && translate[3][3] == 1.f, "constexpr translate");
+            static_assert(scale[1][1] == 3.f, "constexpr scale");
+            EXPECT_EQ(rotate * Vec4f(1.f, 0.f, 0.f, 1.f), Vec4f(0.f, 1.f, 0.f, 1.f));
+            EXPECT_EQ(ToMat4x4f(Quat::FromAxisAngle(Vec3f{0.6f, 0.f, 0.8f}, 0.7f)), Rotate(0.7f, Vec3f{0.6f, 0.f, 0.8f}));
+            EXPECT_EQ(translate * scale * Vec4f(1.f, 1.f, 1.f, 1.f), Vec4f(3.f, 5.f, 7.f, 1.f));
+
+            // 固定的相机在编译期求出，与运行期构建结果一致
+            constexpr Vec3f   eye{3.f, 2.f, 5.f};
+            constexpr Mat4x4f view = LookAt(eye, Vec3f{0.f, 0.5f, 0.f}, Vec3f{0.f, 1.f, 0.f});
+            constexpr Mat4x4f proj = Perspective(60.f, 16.f / 9.f, 0.1f, 100.f);
+            constexpr Mat4x4f ortho = Orthographic(5.f, 2.f, 0.5f, 50.f, true);
+            const Vec4f       eyeView = view * Vec4f{eye.X(), eye.Y(), eye.Z(), 1.f};
+            EXPECT_EQ(eyeView, Vec4f(0.f, 0.f, 0.f, 1.f));
+            EXPECT_EQ(view, LookAt(Vec3f{3.f, 2.f, 5.f}, Vec3f{0.f, 0.5f, 0.f}, Vec3f{0.f, 1.f, 0.f}));
+            EXPECT_EQ(proj, Perspective(60.f, 16.f / 9.f, 0.1f, 100.f));
+            EXPECT_NEAR(proj[1][1], 1.f / std::tan(3.14159265f / 6.f), 1e-6f);
+            // 近平面映射到0，远平面映射到1；反向Z的正交投影近平面映射到1
+            const Vec4f nearClip = proj * Vec4f{0.f, 0.f, -0.1f, 1.f};
+            const Vec4f farClip  = proj * Vec4f{0.f, 0.f, -100.f, 1.f};
+            EXPECT_NEAR(nearClip[2] / nearClip[3], 0.f, 1e-6f);
+            EXPECT_NEAR(farClip[2] / farClip[3], 1.f, 1e-6f);
+            EXPECT_NEAR((ortho * Vec4f{0.f, 0.f, -0.5f, 1.f})[2], 1.f, 1e-6f);
+        }
+
+        TEST(MathTest, LookupTableTest)
+        {
+            // sRGB解码表与标准公式一致
+            static_assert(SRGB_TO_LINEAR_TABLE[0] == 0.f && SRGB_TO_LINEAR_TABLE[255] == 1.f, "constexpr sRGB table");
+            for (int code = 0; code < 256; ++code)
+            {
+                const float encoded = code / 255.f;
+                const float linear  = encoded <= 0.04045f ? encoded / 12.92f : std::pow((encoded + 0.055f) / 1.055f, 2.4f);
+                EXPECT_NEAR(SrgbToLinear(static_cast<uint8_t>(code)), linear, 1e-6f);
+                // 编码值往返不变
+                EXPECT_EQ(LinearToSrgb(SrgbToLinear(static_cast<uint8_t>(code))), code);
+            }
+            // 编码就近舍入，与逐像素幂函数的结果一致(允许恰好落在分界上的舍入差异)
+            for (int i = 0; i <= 1000; ++i)
+            {
+                const float linear  = i / 1000.f;
+                const float encoded = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.f / 2.4f) - 0.055f;
+                EXPECT_NEAR(LinearToSrgb(linear), encoded * 255.f, 0.5001f);
+            }
+            EXPECT_EQ(LinearToSrgb(-1.f), 0);
+            EXPECT_EQ(LinearToSrgb(2.f), 255);
+            EXPECT_EQ(LinearToSrgb(std::nanf("")), 0);
+
+            // Morton编码
+            static_assert(MortonEncode2D(0xFFFF, 0) == 0x55555555u && MortonEncode2D(0, 0xFFFF) == 0xAAAAAAAAu, "constexpr morton");
+            EXPECT_EQ(MortonEncode2D(5, 3), 0x1Bu);
+            for (uint32_t code : {0u, 1u, 0x1234u, 0xDEADBEEFu, 0xFFFFFFFFu})
+            {
+                uint16_t x = 0;
+                uint16_t y = 0;
+                MortonDecode2D(code, x, y);
+                EXPECT_EQ(MortonEncode2D(x, y), code);
+            }
+        }
+
+        TEST(MathTest, FixedPointTest)
+        {
+            // 与浮点的转换四舍五入(远离零)，取整遵循向下/向上取整语义
+            EXPECT_EQ(Fixed24_8{1.5f}.Raw(), 384);
+            EXPECT_EQ(Fixed24_8{-0.001f}.Raw(), 0);
+            EXPECT_EQ(Fixed24_8{-0.003f}.Raw(), -1);
+            EXPECT_EQ(Fixed24_8{-1.25f}.Floor(), -2);
+            EXPECT_EQ(Fixed24_8{-1.25f}.Ceil(), -1);
+            EXPECT_EQ(Fixed24_8{3}.Floor(), 3);
+            EXPECT_EQ(Fixed24_8{3}.Ceil(), 3);
+            EXPECT_EQ(Fixed24_8{2.75f}.Ceil(), 3);
+            // 四则运算
+            const Fixed16_16 a{2.5f};
+            const Fixed16_16 b{-0.75f};
+            EXPECT_EQ(a + b, Fixed16_16{1.75f});
+            EXPECT_EQ(a - b, Fixed16_16{3.25f});
+            EXPECT_EQ(a * b, Fixed16_16{-1.875f});
+            EXPECT_EQ(a / Fixed16_16{0.5f}, Fixed16_16{5});
+            // 乘除都向负无穷截断: 商为负且不能整除时取更小的原始值
+            EXPECT_EQ((Fixed16_16::FromRaw(1) * Fixed16_16{-0.5f}).Raw(), -1);
+            EXPECT_EQ((Fixed16_16::FromRaw(1) * Fixed16_16{0.5f}).Raw(), 0);
+            EXPECT_EQ((Fixed16_16{1} / Fixed16_16{-3}).Raw(), -21846);
+            EXPECT_EQ((Fixed16_16{-1} / Fixed16_16{3}).Raw(), -21846);
+            EXPECT_EQ((Fixed16_16{1} / Fixed16_16{3}).Raw(), 21845);
+            EXPECT_EQ((Fixed16_16{-1} / Fixed16_16{-3}).Raw(), 21845);
+            EXPECT_EQ(Fixed16_16{-3} / Fixed16_16{2}, Fixed16_16{-1.5f});
+            EXPECT_LT(b, a);
+            EXPECT_FLOAT_EQ(Fixed16_16::FromRaw(1).ToFloat(), 1.f / 65536.f);
+            // 作为向量/矩阵元素类型
+            using Vec2x = Vec<2, Fixed16_16>;
+            const Vec2x v{Fixed16_16{3}, Fixed16_16{4}};
+            EXPECT_EQ(Dot(v, v), Fixed16_16{25});
+            EXPECT_EQ(Norm(v), Fixed16_16{5});
+            EXPECT_NEAR(Normalized(v)[0].ToFloat(), 0.6f, 1e-4f);
+            EXPECT_NEAR(Normalized(v)[1].ToFloat(), 0.8f, 1e-4f);
+            EXPECT_EQ(v * Fixed16_16{0.5f} + v, Vec2x(Fixed16_16{4.5f}, Fixed16_16{6}));
+            Mat<2, 2, Fixed16_16> mat = Mat<2, 2, Fixed16_16>::Identity();
+            mat[1][0]                 = Fixed16_16{2};
+            EXPECT_EQ(mat * v, Vec2x(Fixed16_16{11}, Fixed16_16{4}));
+            EXPECT_EQ(Inverse(mat) * (mat * v), v);
         }
     }   // namespace UnitTest
 
@@ -0,0 +1,482 @@
+
+#include "Core/CommandBuffer.h"
+#include "Core/PostProcess.h"
+#include "Core/SimdKernels.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Joy
+{
+    namespace UnitTest
+    {
+        /**
+         * @brief 参与比较的线程数，第一个作为基准，其余的结果必须与之逐位一致
+         *
+         */
+        constexpr int REGRESSION_THREAD_COUNTS[] = {1, 2, 3, 4};
+
+        constexpr int REGRESSION_WIDTH  = 160;
+        constexpr int REGRESSION_HEIGHT = 120;
+
+        /**
+         * @brief 8位RGB图像，与黄金图像文件(二进制PPM)一一对应
+         *
+         */
+        struct Image
+        {
+            int                  width  = 0;
+            int                  height = 0;
+            std::vector<uint8_t> rgb;
+        };
+
+        /**
+         * @brief 一个场景在某个线程数下的渲染结果与统计
+         *
+         */
+        struct SceneFrame
+        {
+            std::vector<Vec4f> pixels;
+            int64_t            triangleCount = 0;
+            int64_t            fragmentCount = 0;
+            double             seconds       = 0.0;
+        };
+
+        /**
+         * @brief 与黄金图像比较的容差: 任一通道相差超过channelTolerance的像素数不能超过maxMismatchedPixels
+         *
+         */
+        struct ImageTolerance
+        {
+            int channelTolerance    = 2;
+            int maxMismatchedPixels = 0;
+        };
+
+        static std::string GetGoldenPath(const char* sceneName) { return std::string(JOY_GOLDEN_IMAGE_DIR) + "/" + sceneName + ".ppm"; }
+
+        static bool ReadPpm(const std::string& path, Image& image)
+        {
+            std::ifstream file(path, std::ios::binary);
+            std::string   magic;
+            int           maxValue = 0;
+            if (!(file >> magic >> image.width >> image.height >> maxValue) || magic != "P6" || maxValue != 255)
+            {
+                return false;
+            }
+            file.get();
+            image.rgb.resize(static_cast<size_t>(image.width) * image.height * 3);
+            file.read(reinterpret_cast<char*>(image.rgb.data()), static_cast<std::streamsize>(image.rgb.size()));
+            return static_cast<bool>(file);
+        }
+
+        static bool WritePpm(const std::string& path, const Image& image)
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "P6\n" << image.width << " " << image.height << "\n255\n";
+            file.write(reinterpret_cast<const char*>(image.rgb.data()), static_cast<std::streamsize>(image.rgb.size()));
+            return static_cast<bool>(file);
+        }
+
+        static std::vector<Vec4f> ReadPixels(const FrameBuffer& frameBuffer)
+        {
+            const int          width = frameBuffer.GetWidth();
+            std::vector<Vec4f> pixels(static_cast<size_t>(width) * frameBuffer.GetHeight());
+            for (int y = 0; y < frameBuffer.GetHeight(); ++y)
+            {
+                frameBuffer.GetColorSpan(0, y, width, &pixels[static_cast<size_t>(y) * width]);
+            }
+            return pixels;
+        }
+
+        static Image ToImage(const std::vector<Vec4f>& pixels, int width, int height)
+        {
+            Image image{width, height, std::vector<uint8_t>(pixels.size() * 3)};
+            for (size_t i = 0; i < pixels.size(); ++i)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    image.rgb[i * 3 + c] = static_cast<uint8_t>(std::lround(std::min(std::max(pixels[i][c], 0.f), 1.f) * 255.f));
+                }
+            }
+            return image;
+        }
+
+        /**
+         * @brief 统计超出容差的像素数
+         *
+         */
+        static int CountMismatchedPixels(const Image& actual, const Image& golden, int channelTolerance)
+        {
+            int mismatched = 0;
+            for (size_t i = 0; i < actual.rgb.size(); i += 3)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (std::abs(static_cast<int>(actual.rgb[i + c]) - static_cast<int>(golden.rgb[i + c])) > channelTolerance)
+                    {
+                        ++mismatched;
+                        break;
+                    }
+                }
+            }
+            return mismatched;
+        }
+
+        /**
+         * @brief 与黄金图像比较；设置环境变量JOY_UPDATE_GOLDEN后改为用当前结果覆盖黄金图像
+         *
+         */
+        static void CompareWithGolden(const char* sceneName, const Image& actual, const ImageTolerance& tolerance)
+        {
+            const std::string path = GetGoldenPath(sceneName);
+            if (std::getenv("JOY_UPDATE_GOLDEN") != nullptr)
+            {
+                ASSERT_TRUE(WritePpm(path, actual)) << path;
+                std::printf("[ GOLDEN   ] updated %s\n", path.c_str());
+                return;
+            }
+            Image golden;
+            ASSERT_TRUE(ReadPpm(path, golden)) << "missing golden image " << path << ", run with JOY_UPDATE_GOLDEN=1 to create it";
+            ASSERT_EQ(golden.width, actual.width);
+            ASSERT_EQ(golden.height, actual.height);
+            EXPECT_LE(CountMismatchedPixels(actual, golden, tolerance.channelTolerance), tolerance.maxMismatchedPixels) << path;
+        }
+
+        /**
+         * @brief 记录帧时间与吞吐量，写入GoogleTest的XML报告并打印
+         *
+         */
+        static void RecordPerformance(const char* sceneName, int threadCount, const SceneFrame& frame)
+        {
+            const std::string prefix            = "T" + std::to_string(threadCount) + "_";
+            const double      frameTimeMs       = frame.seconds * 1000.0;
+            const double      trianglesPerSec   = frame.triangleCount / frame.seconds;
+            const double      fragmentsPerSec   = frame.fragmentCount / frame.seconds;
+            testing::Test::RecordProperty(prefix + "FrameTimeUs", std::to_string(static_cast<int64_t>(frame.seconds * 1e6)));
+            testing::Test::RecordProperty(prefix + "TrianglesPerSec", std::to_string(static_cast<int64_t>(trianglesPerSec)));
+            testing::Test::RecordProperty(prefix + "FragmentsPerSec", std::to_string(static_cast<int64_t>(fragmentsPerSec)));
+            std::printf("[ PERF     ] %-16s threads %d  %8.3f ms  %10.3f Mtri/s  %10.3f Mfrag/s\n", sceneName, threadCount, frameTimeMs,
+                        trianglesPerSec * 1e-6, fragmentsPerSec * 1e-6);
+        }
+
+        /**
+         * @brief 以每个线程数与每条SIMD路径各渲染一次，检查结果逐位一致并与黄金图像比较
+         *
+         * @tparam TScene 提供SceneFrame Render(int threadCount)
+         */
+        template<typename TScene> static void RunRegression(const char* sceneName, TScene& scene, const ImageTolerance& tolerance)
+        {
+            std::vector<Vec4f> reference;
+            for (int threadCount : REGRESSION_THREAD_COUNTS)
+            {
+                // 取多次渲染中最快的一次作为帧时间，结果每次都必须一致
+                SceneFrame frame;
+                frame.seconds = 1e30;
+                for (int repeat = 0; repeat < 3; ++repeat)
+                {
+                    const auto start   = std::chrono::steady_clock::now();
+                    SceneFrame current = scene.Render(threadCount);
+                    current.seconds    = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    if (repeat > 0)
+                    {
+                        ASSERT_TRUE(current.pixels == frame.pixels) << sceneName << " is not deterministic with " << threadCount << " threads";
+                    }
+                    current.seconds = std::min(current.seconds, frame.seconds);
+                    frame           = std::move(current);
+                }
+                ASSERT_GT(frame.fragmentCount, 0);
+                RecordPerformance(sceneName, threadCount, frame);
+                if (reference.empty())
+                {
+                    reference = frame.pixels;
+                    continue;
+                }
+                ASSERT_EQ(frame.pixels.size(), reference.size());
+                for (size_t i = 0; i < reference.size(); ++i)
+                {
+                    ASSERT_EQ(frame.pixels[i], reference[i]) << sceneName << " differs with " << threadCount << " threads at pixel " << i;
+                }
+            }
+            // 运行时分派的每条SIMD路径也必须逐位一致
+            const EnumSimdLevel previous = GetSimdLevel();
+            for (EnumSimdLevel level : {EnumSimdLevel::SCALAR, EnumSimdLevel::SSE2, EnumSimdLevel::AVX2, EnumSimdLevel::AVX512})
+            {
+                if (level == previous || !SetSimdLevel(level))
+                {
+                    continue;
+                }
+                const bool identical = scene.Render(1).pixels == reference;
+                SetSimdLevel(previous);
+                ASSERT_TRUE(identical) << sceneName << " differs on the " << GetSimdLevelName(level) << " path";
+            }
+            CompareWithGolden(sceneName, ToImage(reference, REGRESSION_WIDTH, REGRESSION_HEIGHT), tolerance);
+        }
+
+        /**
+         * @brief 模型空间位置输出，法线参与半兰伯特光照，可乘以亮度生成HDR颜色
+         *
+         */
+        struct LitShader
+        {
+            constexpr static int VARYING_COUNT = 3;
+
+            Vec4f Vertex(const Joy::Vertex& vertex, float* varyings) const
+            {
+                varyings[0] = vertex.normal[0];
+                varyings[1] = vertex.normal[1];
+                varyings[2] = vertex.normal[2];
+                return Vec4f{vertex.position[0], vertex.position[1], vertex.position[2], 1.f};
+            }
+
+            Vec4f Fragment(const float* varyings) const
+            {
+                ++*fragmentCount;
+                const float lambert = varyings[0] * 0.48f + varyings[1] * 0.8f + varyings[2] * 0.36f;
+                const float light   = (lambert * 0.5f + 0.5f) * intensity;
+                return Vec4f{color[0] * light, color[1] * light, color[2] * light, 1.f};
+            }
+
+            Vec3f    color;
+            float    intensity     = 1.f;
+            int64_t* fragmentCount = nullptr;
+        };
+
+        static Mesh MakeCube(float halfSize)
+        {
+            // 每个面独立4个顶点，法线为面法线
+            Mesh        mesh;
+            const Vec3f normals[6] = {Vec3f{1.f, 0.f, 0.f},  Vec3f{-1.f, 0.f, 0.f}, Vec3f{0.f, 1.f, 0.f},
+                                      Vec3f{0.f, -1.f, 0.f}, Vec3f{0.f, 0.f, 1.f},  Vec3f{0.f, 0.f, -1.f}};
+            for (const Vec3f& normal : normals)
+            {
+                const Vec3f tangent   = std::abs(normal[1]) > 0.5f ? Vec3f{1.f, 0.f, 0.f} : Vec3f{0.f, 1.f, 0.f};
+                const Vec3f bitangent = Cross(normal, tangent);
+                const auto  base      = static_cast<uint32_t>(mesh.vertices.size());
+                const float signs[4][2] = {{-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}};
+                for (const auto& sign : signs)
+                {
+                    mesh.vertices.push_back(Joy::Vertex{(normal + tangent * sign[0] + bitangent * sign[1]) * halfSize, normal, Vec2f{}});
+                }
+                mesh.indices.insert(mesh.indices.end(), {base, base + 2, base + 1, base, base + 3, base + 2});
+            }
+            return mesh;
+        }
+
+        static Mesh MakeSphere(float radius, int stacks, int slices)
+        {
+            Mesh mesh;
+            for (int stack = 0; stack <= stacks; ++stack)
+            {
+                const float theta = 3.14159265f * stack / stacks;
+                for (int slice = 0; slice <= slices; ++slice)
+                {
+                    const float phi = 6.28318531f * slice / slices;
+                    const Vec3f normal{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                    mesh.vertices.push_back(Joy::Vertex{normal * radius, normal, Vec2f{}});
+                }
+            }
+            for (int stack = 0; stack < stacks; ++stack)
+            {
+                for (int slice = 0; slice < slices; ++slice)
+                {
+                    const auto i0 = static_cast<uint32_t>(stack * (slices + 1) + slice);
+                    const auto i1 = i0 + static_cast<uint32_t>(slices + 1);
+                    mesh.indices.insert(mesh.indices.end(), {i0, i0 + 1, i1, i0 + 1, i1 + 1, i1});
+                }
+            }
+            return mesh;
+        }
+
+        static Mat4x4f MakeModel(const Vec3f& translation, const Vec3f& axis, float radians, float scale)
+        {
+            return MakeInstanceMatrix(InstanceTransform{translation, Quat::FromAxisAngle(Normalized(axis), radians), Vec3f{scale, scale, scale}});
+        }
+
+        /**
+         * @brief 物体交替使用的网格与着色器，在threadCount个线程中并行录制命令缓冲后统一回放
+         *
+         */
+        struct CommandScene
+        {
+            CommandScene(const Vec3f& eye, const Vec3f& target)
+                : camera(Camera::EnumCameraType::PERSPECTIVE, eye, target, 0.1f, 100.f, 60.f)
+                , meshes{MakeCube(0.5f), MakeSphere(0.5f, 12, 24)}
+                , shaders()
+                , models()
+            {
+                camera.SetAspect(static_cast<float>(REGRESSION_WIDTH) / REGRESSION_HEIGHT);
+            }
+
+            /**
+             * @brief 录制并回放所有物体，返回提交的三角形数
+             *
+             */
+            int64_t Record(Renderer& renderer, int threadCount, int64_t* fragmentCount)
+            {
+                for (LitShader& shader : shaders)
+                {
+                    shader.fragmentCount = fragmentCount;
+                }
+                ThreadPool                 pool(threadCount);
+                std::vector<CommandBuffer> buffers(threadCount);
+                pool.ParallelFor(threadCount, [&](int taskIndex, int) {
+                    CommandBuffer& buffer = buffers[taskIndex];
+                    buffer.SetCamera(camera);
+                    for (size_t i = taskIndex; i < models.size(); i += threadCount)
+                    {
+                        buffer.BindMesh(meshes[i % 2]);
+                        buffer.BindShader(shaders[(i / 2) % 2]);
+                        buffer.Draw(models[i]);
+                    }
+                });
+                CommandQueue queue;
+                for (const CommandBuffer& buffer : buffers)
+                {
+                    queue.Submit(buffer);
+                }
+                queue.Execute(renderer);
+                int64_t triangleCount = 0;
+                for (size_t i = 0; i < models.size(); ++i)
+                {
+                    triangleCount += static_cast<int64_t>(meshes[i % 2].indices.size() / 3);
+                }
+                return triangleCount;
+            }
+
+            Camera               camera;
+            Mesh                 meshes[2];
+            LitShader            shaders[2];
+            std::vector<Mat4x4f> models;
+        };
+
+        /**
+         * @brief 网格状排列、各自旋转的立方体与球体
+         *
+         */
+        struct ObjectGridScene : CommandScene
+        {
+            ObjectGridScene()
+                : CommandScene(Vec3f{0.f, 4.f, 9.f}, Vec3f{0.f, 0.f, 0.f})
+            {
+                shaders[0].color = Vec3f{0.9f, 0.3f, 0.2f};
+                shaders[1].color = Vec3f{0.2f, 0.5f, 0.9f};
+                for (int z = 0; z < 7; ++z)
+                {
+                    for (int x = 0; x < 7; ++x)
+                    {
+                        const float angle = 0.37f * (x * 7 + z);
+                        models.push_back(MakeModel(Vec3f{(x - 3) * 1.4f, 0.f, (z - 3) * 1.4f}, Vec3f{1.f, 2.f, 0.5f}, angle, 0.8f));
+                    }
+                }
+            }
+
+            SceneFrame Render(int threadCount)
+            {
+                Renderer renderer(REGRESSION_WIDTH, REGRESSION_HEIGHT);
+                renderer.Clear(Vec4f{0.05f, 0.05f, 0.08f, 1.f});
+                SceneFrame frame;
+                frame.triangleCount = Record(renderer, threadCount, &frame.fragmentCount);
+                frame.pixels        = ReadPixels(renderer.GetFrameBuffer());
+                return frame;
+            }
+        };
+
+        /**
+         * @brief 大量远处的小物体，覆盖微小三角形的批量路径与4倍多重采样
+         *
+         */
+        struct DenseFieldScene : CommandScene
+        {
+            DenseFieldScene()
+                : CommandScene(Vec3f{0.f, 6.f, 16.f}, Vec3f{0.f, 0.f, -20.f})
+            {
+                shaders[0].color = Vec3f{0.3f, 0.8f, 0.3f};
+                shaders[1].color = Vec3f{0.9f, 0.8f, 0.2f};
+                for (int z = 0; z < 48; ++z)
+                {
+                    for (int x = 0; x < 48; ++x)
+                    {
+                        const float height = std::sin(x * 0.4f) * std::cos(z * 0.3f);
+                        models.push_back(MakeModel(Vec3f{(x - 23.5f) * 1.2f, height, -z * 1.2f}, Vec3f{0.f, 1.f, 0.2f}, 0.11f * (x + z), 0.35f));
+                    }
+                }
+            }
+
+            SceneFrame Render(int threadCount)
+            {
+                Renderer renderer(REGRESSION_WIDTH, REGRESSION_HEIGHT);
+                renderer.SetSampleCount(4);
+                renderer.Clear(Vec4f{0.5f, 0.6f, 0.8f, 1.f});
+                SceneFrame frame;
+                frame.triangleCount = Record(renderer, threadCount, &frame.fragmentCount);
+                renderer.Resolve();
+                frame.pixels = ReadPixels(renderer.GetFrameBuffer());
+                return frame;
+            }
+        };
+
+        /**
+         * @brief HDR渲染后经过泛光、色调映射、Gamma校正与FXAA的完整后处理链
+         *
+         */
+        struct HdrPostScene : CommandScene
+        {
+            HdrPostScene()
+                : CommandScene(Vec3f{0.f, 2.f, 7.f}, Vec3f{0.f, 0.f, 0.f})
+            {
+                shaders[0].color     = Vec3f{0.8f, 0.8f, 0.8f};
+                shaders[1].color     = Vec3f{1.f, 0.6f, 0.2f};
+                shaders[1].intensity = 6.f;
+                for (int i = 0; i < 12; ++i)
+                {
+                    const float angle = 0.5236f * i;
+                    models.push_back(MakeModel(Vec3f{std::cos(angle) * 3.f, 0.f, std::sin(angle) * 3.f}, Vec3f{0.f, 1.f, 0.f}, angle, 1.f));
+                }
+            }
+
+            SceneFrame Render(int threadCount)
+            {
+                Renderer renderer(REGRESSION_WIDTH, REGRESSION_HEIGHT, EnumColorFormat::RGBA16F);
+                renderer.Clear(Vec4f{0.02f, 0.02f, 0.03f, 1.f});
+                SceneFrame frame;
+                frame.triangleCount = Record(renderer, threadCount, &frame.fragmentCount);
+
+                PostProcessSettings settings;
+                settings.bloom = true;
+                settings.fxaa  = true;
+                ThreadPool    pool(threadCount);
+                PostProcessor processor(&pool);
+                processor.SetSettings(settings);
+                FrameBuffer output(REGRESSION_WIDTH, REGRESSION_HEIGHT);
+                processor.Process(renderer.GetFrameBuffer(), output);
+                frame.pixels = ReadPixels(output);
+                return frame;
+            }
+        };
+
+        TEST(RenderRegressionTest, ObjectGridTest)
+        {
+            ObjectGridScene scene;
+            RunRegression("ObjectGrid", scene, ImageTolerance{2, 8});
+        }
+
+        TEST(RenderRegressionTest, DenseFieldTest)
+        {
+            DenseFieldScene scene;
+            RunRegression("DenseField", scene, ImageTolerance{2, 16});
+        }
+
+        TEST(RenderRegressionTest, HdrPostTest)
+        {
+            HdrPostScene scene;
+            RunRegression("HdrPost", scene, ImageTolerance{2, 8});
+        }
+    }   // namespace UnitTest
+}   // namespace Joy